@@ -0,0 +1,8 @@
+#! /usr/bin/env python
+
+# Programs that are runnable.
+ns3_runnable_programs = ['build/src/MoReV2X/examples/ns3.22-HIGHWAY.cc-debug', 'build/src/MoReV2X/examples/ns3.22-nr-v2x-selection-replay-debug', 'build/src/bridge/examples/ns3.22-csma-bridge-debug', 'build/src/bridge/examples/ns3.22-csma-bridge-one-hop-debug', 'build/src/buildings/examples/ns3.22-buildings-pathloss-profiler-debug', 'build/src/config-store/examples/ns3.22-config-store-save-debug', 'build/src/core/examples/ns3.22-main-callback-debug', 'build/src/core/examples/ns3.22-sample-simulator-debug', 'build/src/core/examples/ns3.22-main-ptr-debug', 'build/src/core/examples/ns3.22-main-random-variable-debug', 'build/src/core/examples/ns3.22-main-random-variable-stream-debug', 'build/src/core/examples/ns3.22-sample-random-variable-debug', 'build/src/core/examples/ns3.22-sample-random-variable-stream-debug', 'build/src/core/examples/ns3.22-command-line-example-debug', 'build/src/core/examples/ns3.22-hash-example-debug', 'build/src/core/examples/ns3.22-main-test-sync-debug', 'build/src/csma/examples/ns3.22-csma-one-subnet-debug', 'build/src/csma/examples/ns3.22-csma-broadcast-debug', 'build/src/csma/examples/ns3.22-csma-packet-socket-debug', 'build/src/csma/examples/ns3.22-csma-multicast-debug', 'build/src/csma/examples/ns3.22-csma-raw-ip-socket-debug', 'build/src/csma/examples/ns3.22-csma-ping-debug', 'build/src/fd-net-device/examples/ns3.22-dummy-network-debug', 'build/src/fd-net-device/examples/ns3.22-fd2fd-onoff-debug', 'build/src/fd-net-device/examples/ns3.22-realtime-dummy-network-debug', 'build/src/fd-net-device/examples/ns3.22-realtime-fd2fd-onoff-debug', 'build/src/fd-net-device/examples/ns3.22-fd-emu-ping-debug', 'build/src/fd-net-device/examples/ns3.22-fd-emu-udp-echo-debug', 'build/src/fd-net-device/examples/ns3.22-fd-emu-onoff-debug', 'build/src/fd-net-device/examples/ns3.22-fd-tap-ping-debug', 'build/src/fd-net-device/examples/ns3.22-fd-tap-ping6-debug', 'build/src/internet/examples/ns3.22-main-simple-debug', 'build/src/internet/examples/ns3.22-codel-vs-droptail-basic-test-debug', 'build/src/internet/examples/ns3.22-codel-vs-droptail-asymmetric-debug', 'build/src/lte/examples/ns3.22-lena-cqi-threshold-debug', 'build/src/lte/examples/ns3.22-lena-dual-stripe-debug', 'build/src/lte/examples/ns3.22-lena-fading-debug', 'build/src/lte/examples/ns3.22-lena-intercell-interference-debug', 'build/src/lte/examples/ns3.22-lena-pathloss-traces-debug', 'build/src/lte/examples/ns3.22-lena-profiling-debug', 'build/src/lte/examples/ns3.22-lena-rem-debug', 'build/src/lte/examples/ns3.22-lena-rem-sector-antenna-debug', 'build/src/lte/examples/ns3.22-lena-rlc-traces-debug', 'build/src/lte/examples/ns3.22-lena-simple-debug', 'build/src/lte/examples/ns3.22-lena-simple-epc-debug', 'build/src/lte/examples/ns3.22-lena-deactivate-bearer-debug', 'build/src/lte/examples/ns3.22-lena-x2-handover-debug', 'build/src/lte/examples/ns3.22-lena-x2-handover-measures-debug', 'build/src/lte/examples/ns3.22-lena-frequency-reuse-debug', 'build/src/lte/examples/ns3.22-lena-distributed-ffr-debug', 'build/src/lte/examples/ns3.22-lena-uplink-power-control-debug', 'build/src/mobility/examples/ns3.22-main-grid-topology-debug', 'build/src/mobility/examples/ns3.22-main-random-topology-debug', 'build/src/mobility/examples/ns3.22-main-random-walk-debug', 'build/src/mobility/examples/ns3.22-mobility-trace-example-debug', 'build/src/mobility/examples/ns3.22-ns2-mobility-trace-debug', 'build/src/mobility/examples/ns3.22-bonnmotion-ns2-example-debug', 'build/src/network/examples/ns3.22-main-packet-header-debug', 'build/src/network/examples/ns3.22-main-packet-tag-debug', 'build/src/network/examples/ns3.22-packet-socket-apps-debug', 'build/src/point-to-point/examples/ns3.22-main-attribute-value-debug', 'build/src/propagation/examples/ns3.22-main-propagation-loss-debug', 'build/src/propagation/examples/ns3.22-jakes-propagation-model-example-debug', 'build/src/spectrum/examples/ns3.22-adhoc-aloha-ideal-phy-debug', 'build/src/spectrum/examples/ns3.22-adhoc-aloha-ideal-phy-matrix-propagation-loss-model-debug', 'build/src/spectrum/examples/ns3.22-adhoc-aloha-ideal-phy-with-microwave-oven-debug', 'build/src/stats/examples/ns3.22-gnuplot-example-debug', 'build/src/stats/examples/ns3.22-double-probe-example-debug', 'build/src/stats/examples/ns3.22-time-probe-example-debug', 'build/src/stats/examples/ns3.22-gnuplot-aggregator-example-debug', 'build/src/stats/examples/ns3.22-gnuplot-helper-example-debug', 'build/src/stats/examples/ns3.22-file-aggregator-example-debug', 'build/src/stats/examples/ns3.22-file-helper-example-debug', 'build/src/virtual-net-device/examples/ns3.22-virtual-net-device-debug', 'build/examples/tcp/ns3.22-tcp-large-transfer-debug', 'build/examples/tcp/ns3.22-tcp-nsc-lfn-debug', 'build/examples/tcp/ns3.22-tcp-nsc-zoo-debug', 'build/examples/tcp/ns3.22-tcp-star-server-debug', 'build/examples/tcp/ns3.22-tcp-bulk-send-debug', 'build/examples/routing/ns3.22-dynamic-global-routing-debug', 'build/examples/routing/ns3.22-static-routing-slash32-debug', 'build/examples/routing/ns3.22-global-routing-slash32-debug', 'build/examples/routing/ns3.22-global-injection-slash32-debug', 'build/examples/routing/ns3.22-simple-alternate-routing-debug', 'build/examples/routing/ns3.22-mixed-global-routing-debug', 'build/examples/routing/ns3.22-simple-routing-ping6-debug', 'build/examples/routing/ns3.22-ripng-simple-network-debug', 'build/examples/udp-client-server/ns3.22-udp-client-server-debug', 'build/examples/udp-client-server/ns3.22-udp-trace-client-server-debug', 'build/examples/error-model/ns3.22-simple-error-model-debug', 'build/examples/tutorial/ns3.22-hello-simulator-debug', 'build/examples/tutorial/ns3.22-first-debug', 'build/examples/tutorial/ns3.22-second-debug', 'build/examples/tutorial/ns3.22-fourth-debug', 'build/examples/tutorial/ns3.22-fifth-debug', 'build/examples/tutorial/ns3.22-sixth-debug', 'build/examples/tutorial/ns3.22-seventh-debug', 'build/examples/udp/ns3.22-udp-echo-debug', 'build/examples/socket/ns3.22-socket-bound-static-routing-debug', 'build/examples/socket/ns3.22-socket-bound-tcp-static-routing-debug', 'build/examples/socket/ns3.22-socket-options-ipv4-debug', 'build/examples/socket/ns3.22-socket-options-ipv6-debug', 'build/examples/realtime/ns3.22-realtime-udp-echo-debug', 'build/examples/naming/ns3.22-object-names-debug', 'build/examples/ipv6/ns3.22-icmpv6-redirect-debug', 'build/examples/ipv6/ns3.22-ping6-debug', 'build/examples/ipv6/ns3.22-radvd-debug', 'build/examples/ipv6/ns3.22-radvd-two-prefix-debug', 'build/examples/ipv6/ns3.22-test-ipv6-debug', 'build/examples/ipv6/ns3.22-fragmentation-ipv6-debug', 'build/examples/ipv6/ns3.22-fragmentation-ipv6-two-MTU-debug', 'build/examples/ipv6/ns3.22-loose-routing-ipv6-debug', 'build/scratch/ns3.22-HIGHWAY-debug']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = ['csma-bridge.py', 'sample-simulator.py', 'simple-routing-ping6.py', 'first.py', 'realtime-udp-echo.py']
+
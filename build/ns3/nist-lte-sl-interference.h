@@ -0,0 +1,220 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 CTTC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Nicola Baldo <nbaldo@cttc.es>
+ * Modified by: NIST
+ */
+
+
+#ifndef NIST_LTE_SL_INTERFERENCE_H
+#define NIST_LTE_SL_INTERFERENCE_H
+
+#include <ns3/object.h>
+#include <ns3/packet.h>
+#include <ns3/nstime.h>
+#include <ns3/spectrum-value.h>
+
+#include <list>
+
+namespace ns3 {
+
+class NistLteSlChunkProcessor;
+
+
+
+/**
+ * This class implements a gaussian interference model, i.e., all
+ * incoming signals are added to the total interference.
+ *
+ */
+class NistLteSlInterference : public Object
+{
+public:
+  NistLteSlInterference ();
+  virtual ~NistLteSlInterference ();
+
+  // inherited from Object
+  static TypeId GetTypeId (void);
+  virtual void DoDispose ();
+
+  /**
+   * Add a NistLteSlChunkProcessor that will use the time-vs-frequency SINR
+   * calculated by this NistLteSlInterference instance. Note that all the
+   * added NistLteSlChunkProcessors will work in parallel.
+   *
+   * @param p
+   */
+  void AddSinrChunkProcessor (Ptr<NistLteSlChunkProcessor> p);
+
+  /**
+   * Add a NistLteSlChunkProcessor that will use the time-vs-frequency
+   *  interference calculated by this NistLteSlInterference instance. Note 
+   *  that all the added NistLteSlChunkProcessors will work in parallel.
+   *
+   * @param p
+   */
+  void AddInterferenceChunkProcessor (Ptr<NistLteSlChunkProcessor> p);
+
+  /**
+   * Add a NistLteSlChunkProcessor that will use the time-vs-frequency
+   *  power calculated by this NistLteSlInterference instance. Note
+   *  that all the added NistLteSlChunkProcessors will work in parallel.
+   *
+   * @param p
+   */
+  void AddRsPowerChunkProcessor (Ptr<NistLteSlChunkProcessor> p);
+
+  /**
+   * notify that the PHY is starting a RX attempt
+   *
+   * @param rxPsd the power spectral density of the signal being RX
+   */
+  void StartRx (Ptr<const SpectrumValue> rxPsd);
+
+  /**
+   * notify that the RX attempt has ended. The receiving PHY must call
+   * this method when RX ends or RX is aborted.
+   *
+   */
+  void EndRx ();
+
+
+  /**
+   * notify that a new signal is being perceived in the medium. This
+   * method is to be called for all incoming signal, regardless of
+   * wether they're useful signals or interferers.
+   *
+   * @param spd the power spectral density of the new signal
+   * @param duration the duration of the new signal
+   */
+  void AddSignal (Ptr<const SpectrumValue> spd, const Time duration);
+
+
+  /**
+   *
+   * @param noisePsd the Noise Power Spectral Density in power units
+   * (Watt, Pascal...) per Hz.
+   */
+  void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
+
+  /**
+   * Enable or disable the lazy evaluation of the SINR. When enabled, the
+   * chunk processors are bypassed: only the total received power of each
+   * chunk is stored, and the SINR of a signal is computed by EvaluateSinr
+   * when (and if) the receiver asks for it.
+   *
+   * @param lazy true to defer the SINR evaluation
+   */
+  void SetLazySinrEvaluation (bool lazy);
+
+  /**
+   * Compute the time-averaged SINR of a signal of the last reception.
+   * Only the RBs occupied by the signal are evaluated, the others are left
+   * to zero. Values are identical to the ones returned by the SINR chunk
+   * processor over the same RBs.
+   *
+   * @param index the index of the signal (order of the StartRx calls)
+   * @return the SINR of the signal
+   */
+  SpectrumValue EvaluateSinr (uint32_t index) const;
+
+  /**
+   * Same as EvaluateSinr, but the values are written to a plain vector
+   * (one per RB), so that several signals can be evaluated concurrently:
+   * no reference counted object is created or copied.
+   *
+   * @param index the index of the signal (order of the StartRx calls)
+   * @param sinr the SINR of the signal
+   */
+  void EvaluateSinr (uint32_t index, std::vector<double>& sinr) const;
+
+  /**
+   * Store the chunk ending now, if any, so that EvaluateSinr can be called
+   * before EndRx. Has no effect on the outcome of the reception.
+   */
+  void PrepareSinrEvaluation ();
+
+  /**
+   * @return the number of signals of the current (or last) reception
+   */
+  uint32_t GetNSignals (void) const;
+
+private:
+  void ConditionallyEvaluateChunk ();
+  void DoAddSignal  (Ptr<const SpectrumValue> spd);
+  void DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId);
+
+   bool m_receiving;
+
+  /** Total power and noise perceived during a chunk, stored when the SINR
+      evaluation is deferred */
+  struct NistLteSlInterferenceChunk
+  {
+    Ptr<SpectrumValue> m_allSignals; //!< sum of the incoming signals
+    Ptr<const SpectrumValue> m_noise; //!< noise PSD
+    Time m_duration; //!< duration of the chunk
+  };
+
+  bool m_lazySinr;
+
+  std::vector<NistLteSlInterferenceChunk> m_chunks; /**< chunks of the
+                                                     * current (or last)
+                                                     * reception
+                                                     */
+
+  std::vector <Ptr<SpectrumValue> > m_rxSignal; /**< stores the power spectral density of
+                                  * the signal whose RX is being
+                                  * attempted
+                                  */
+
+  Ptr<SpectrumValue> m_allSignals; /**< stores the spectral
+                                    * power density of the sum of incoming signals;
+                                    * does not include noise, includes the SPD of the signal being RX
+                                    */
+
+  Ptr<const SpectrumValue> m_noise;
+
+  Time m_lastChangeTime;     /**< the time of the last change in
+                                m_TotalPower */
+
+  uint32_t m_lastSignalId;
+  uint32_t m_lastSignalIdBeforeReset;
+
+  /** all the processor instances that need to be notified whenever
+  a new interference chunk is calculated */
+  std::list<Ptr<NistLteSlChunkProcessor> > m_rsPowerChunkProcessorList;
+
+  /** all the processor instances that need to be notified whenever
+      a new SINR chunk is calculated */
+  std::list<Ptr<NistLteSlChunkProcessor> > m_sinrChunkProcessorList;
+
+  /** all the processor instances that need to be notified whenever
+      a new interference chunk is calculated */
+  std::list<Ptr<NistLteSlChunkProcessor> > m_interfChunkProcessorList;
+
+
+};
+
+
+
+} // namespace ns3
+
+
+
+
+
+#endif /* NIST_LTE_SL_INTERFERENCE_H */
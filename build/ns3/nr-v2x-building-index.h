@@ -0,0 +1,99 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#ifndef NR_V2X_BUILDING_INDEX_H
+#define NR_V2X_BUILDING_INDEX_H
+
+#include <ns3/ptr.h>
+#include <ns3/vector.h>
+#include <ns3/box.h>
+#include <ns3/building.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Uniform grid over the footprints of the buildings of BuildingList.
+ *
+ * Every cell lists the buildings overlapping it, so a point is checked
+ * against the buildings of its cell only, and a segment against the
+ * buildings of the cells it crosses. The cost of a query depends on the
+ * density of the buildings, not on their number.
+ *
+ * The buildings are assumed not to move once indexed. Build must be called
+ * again when buildings are added.
+ */
+class NrV2XBuildingIndex
+{
+public:
+  NrV2XBuildingIndex ();
+
+  /**
+   * Index the buildings currently in BuildingList
+   *
+   * \param cellSize the side of the grid cells (m). It is increased if the
+   *        grid would have much more cells than buildings
+   */
+  void Build (double cellSize);
+
+  /**
+   * \return the number of indexed buildings
+   */
+  uint32_t GetNBuildings (void) const;
+
+  /**
+   * \return the building the position is inside of, 0 if it is outdoor
+   */
+  Ptr<Building> GetBuilding (const Vector& position) const;
+
+  /**
+   * \return true if the segment from a to b does not cross any building
+   */
+  bool IsLineOfSight (const Vector& a, const Vector& b) const;
+
+  /**
+   * \return true if the segment from a to b crosses the box
+   */
+  static bool Intersects (const Box& box, const Vector& a, const Vector& b);
+
+private:
+  uint32_t GetCellX (double x) const;
+  uint32_t GetCellY (double y) const;
+
+  double m_cellSize; // (m)
+  double m_xMin;
+  double m_yMin;
+  uint32_t m_nCellsX;
+  uint32_t m_nCellsY;
+  std::vector<Ptr<Building> > m_buildings;
+  std::vector<Box> m_boxes;
+  std::vector<std::vector<uint32_t> > m_cells; // indexes in m_buildings, row-major
+  mutable std::vector<uint32_t> m_lastQuery; // per building, to test it once per segment
+  mutable uint32_t m_query;
+};
+
+} // namespace ns3
+
+#endif /* NR_V2X_BUILDING_INDEX_H */
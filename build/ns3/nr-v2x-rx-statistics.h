@@ -0,0 +1,153 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#ifndef NR_V2X_RX_STATISTICS_H
+#define NR_V2X_RX_STATISTICS_H
+
+#include <ns3/object.h>
+
+#include <map>
+#include <vector>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * Histogram with logarithmically spaced buckets (HDR-style): values are
+ * quantized with a fixed resolution, and every power of two is split into
+ * 2^subBucketBits buckets, so the relative error is bounded by
+ * 2^-subBucketBits whatever the magnitude of the value.
+ */
+class NrV2XLogHistogram
+{
+public:
+  NrV2XLogHistogram ();
+  NrV2XLogHistogram (double resolution, uint8_t subBucketBits);
+
+  void Add (double value);
+
+  uint32_t GetNBuckets (void) const;
+  uint64_t GetCount (uint32_t index) const;
+  double GetLowerBound (uint32_t index) const;
+  double GetUpperBound (uint32_t index) const;
+
+  uint64_t GetTotalCount (void) const;
+  /**
+   * \param q the quantile, in [0, 1]
+   * \return the upper bound of the bucket holding the q-quantile
+   */
+  double GetQuantile (double q) const;
+
+private:
+  uint32_t GetIndex (uint64_t units) const;
+  uint64_t GetLowerBoundUnits (uint32_t index) const;
+
+  double m_resolution;
+  uint8_t m_subBucketBits;
+  std::vector<uint64_t> m_counts;
+};
+
+
+/**
+ * Online aggregation of the sidelink reception statistics. The outcome of
+ * every reception, as logged in ReceivedLog.txt, is accumulated into
+ * distance-binned PDR counters, a latency histogram and an inter-packet gap
+ * histogram, per traffic type and selection trigger. Only the aggregates are
+ * written, at Simulator::Destroy. All the outputs are counters, so that the
+ * files of several runs can be merged by summing the rows with the same keys.
+ */
+class NrV2XRxStatistics : public Object
+{
+public:
+  NrV2XRxStatistics ();
+  virtual ~NrV2XRxStatistics ();
+
+  static TypeId GetTypeId (void);
+
+  /**
+   * \return the instance shared by all the receivers. It is created at the
+   * first call, and its aggregates are saved at Simulator::Destroy
+   */
+  static Ptr<NrV2XRxStatistics> GetInstance (void);
+
+  /**
+   * Account for the outcome of a reception
+   *
+   * \param txId the node ID of the transmitter
+   * \param rxId the node ID of the receiver
+   * \param trafficType the V2X traffic type (0x00 periodic, 0x01 aperiodic)
+   * \param selectionTrigger the trigger of the resource selection used by the transmitter
+   * \param packetId the ID of the packet
+   * \param distance the Tx-Rx distance [m]
+   * \param lossType the loss type (see NrV2XSpectrumPhy), 9 if decoded
+   * \param latency the time elapsed since the packet generation [s]
+   */
+  void AddReception (uint32_t txId, uint32_t rxId, uint8_t trafficType, uint16_t selectionTrigger, uint64_t packetId,
+                     double distance, uint16_t lossType, double latency);
+
+  /**
+   * Write the aggregates in the output path
+   */
+  void Save (void);
+
+private:
+  static void SaveInstance (void);
+
+  struct OutcomeCounters
+  {
+    uint64_t decoded;
+    uint64_t lost[4]; // indexed by the loss type
+  };
+
+  struct Aggregates
+  {
+    std::vector<OutcomeCounters> pdr; // indexed by the distance bin
+    NrV2XLogHistogram latency;
+    NrV2XLogHistogram ipg;
+  };
+
+  struct LastDecoded
+  {
+    uint64_t packetId;
+    double time;
+  };
+
+  typedef std::pair<uint8_t, uint16_t> StatsKey_t; // traffic type, selection trigger
+
+  Aggregates& GetAggregates (uint8_t trafficType, uint16_t selectionTrigger);
+
+  static Ptr<NrV2XRxStatistics> s_instance;
+
+  std::map<StatsKey_t, Aggregates> m_aggregates;
+  std::map<uint64_t, LastDecoded> m_lastDecoded; // last decoded packet of each (rx, tx) link, used for the IPG
+
+  double m_distanceBinWidth;
+  double m_latencyResolution;
+  double m_ipgResolution;
+  uint8_t m_subBucketBits;
+  std::string m_outputPath;
+};
+
+} // namespace ns3
+
+#endif /* NR_V2X_RX_STATISTICS_H */
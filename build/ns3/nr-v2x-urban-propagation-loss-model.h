@@ -0,0 +1,164 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#ifndef NR_V2X_URBAN_PROPAGATION_LOSS_MODEL_H
+#define NR_V2X_URBAN_PROPAGATION_LOSS_MODEL_H
+
+#include <ns3/buildings-propagation-loss-model.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/nstime.h>
+#include "ns3/nr-v2x-building-index.h"
+
+#include <unordered_map>
+
+namespace ns3 {
+
+/**
+ * \brief V2V pathloss in the urban grid of 3GPP TR 37.885, with buildings
+ *
+ * A link is in NLOS if the segment between the two nodes crosses a building
+ * of BuildingList, otherwise it is in LOS with probability
+ * min(1, 1.05 exp(-0.0114 d)) and in NLOSv (blocked by vehicles) otherwise:
+ * - LOS and NLOSv: PL = 38.77 + 16.7 log10(d) + 18.2 log10(fc), plus the
+ *   NLOSv additional loss for the latter;
+ * - NLOS: PL = 36.85 + 30 log10(d) + 18.9 log10(fc).
+ *
+ * As in NrV2XPropagationLossModel, the pathloss, the LOS state and the
+ * shadowing are kept per link and updated every CoherenceTime, with the
+ * shadowing decorrelated over the distance the link changed by. The links
+ * are created when first evaluated and dropped when not evaluated for
+ * LinkTimeout, so the state follows the links in use rather than all the
+ * node pairs. Optionally, a Nakagami fast fading is drawn at every
+ * evaluation.
+ *
+ * The point-in-building and segment-building tests go through a grid over
+ * the building footprints (NrV2XBuildingIndex), built at the first loss
+ * evaluation and again whenever the number of buildings changes.
+ *
+ * The MobilityBuildingInfo of the nodes, when aggregated, is updated with
+ * the building the node is inside of, and the external wall loss of that
+ * building is added.
+ */
+class NrV2XUrbanPropagationLossModel : public BuildingsPropagationLossModel
+{
+public:
+  static TypeId GetTypeId (void);
+  NrV2XUrbanPropagationLossModel ();
+  virtual ~NrV2XUrbanPropagationLossModel ();
+
+  struct ChannelModel
+  {
+    bool LOS;
+    bool Blocked; // by a building
+    double Distance;
+    double Pathloss;
+    double Shadowing;
+    double ShadowingNLOSv;
+    Time LastUpdate;
+  };
+
+  /**
+   * \param a the mobility model of the source
+   * \param b the mobility model of the destination
+   * \return the propagation loss (in dB)
+   */
+  virtual double GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+  /**
+   * \return the log-normal shadowing of the link, NLOSv loss included (in dB)
+   */
+  virtual double GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+  /**
+   * Pathloss, shadowing and fast fading, with a single lookup of the link
+   */
+  virtual double DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+  /**
+   * \return the state of the link between the nodes of a and b, updated
+   *         if older than CoherenceTime. Valid until the next evaluation
+   */
+  const ChannelModel& GetChannelModel (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+  /**
+   * \return the number of links with a channel model
+   */
+  uint32_t GetNChannelModels (void) const;
+
+  /**
+   * \return true if no building obstructs the link between a and b
+   */
+  bool IsLineOfSight (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+private:
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  /**
+   * Index the buildings again if some were added
+   */
+  void UpdateBuildingIndex (void) const;
+
+  /**
+   * Compute the pathloss, LOS state and shadowing of the link
+   *
+   * \param first true if the link has no previous shadowing to decorrelate from
+   */
+  void UpdateChannelModel (ChannelModel& link, Ptr<MobilityModel> a, Ptr<MobilityModel> b, bool first) const;
+
+  /**
+   * Drop the links not evaluated for LinkTimeout
+   */
+  void ExpireChannelModels (void) const;
+
+  /**
+   * Update the MobilityBuildingInfo of the node, if any
+   *
+   * \return the penetration loss of the building the node is inside of (dB)
+   */
+  double IndoorLoss (Ptr<MobilityModel> mobility) const;
+
+  double m_frequency; // (GHz)
+  double m_sigmaLos;
+  double m_sigmaNlos;
+  double m_sigmaNlosv;
+  double m_decorrDistance;
+  double m_cellSize;
+  Time m_coherenceTime;
+  Time m_linkTimeout;
+  bool m_nakagami;
+
+  mutable NrV2XBuildingIndex m_buildingIndex;
+  // (lower node ID << 32) | higher node ID -> channel model
+  mutable std::unordered_map<uint64_t, ChannelModel> m_channelModels;
+  mutable Time m_nextExpiry;
+
+  // Created once and reused by all the evaluations
+  Ptr<UniformRandomVariable> m_randomUniform;
+  Ptr<NormalRandomVariable> m_shadowing;
+  Ptr<NormalRandomVariable> m_shadowingNLOSv;
+  Ptr<GammaRandomVariable> m_fading;
+};
+
+} // namespace ns3
+
+#endif /* NR_V2X_URBAN_PROPAGATION_LOSS_MODEL_H */
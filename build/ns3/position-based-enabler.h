@@ -0,0 +1,110 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>	
+ * University of Modena and Reggio Emilia 
+ * 
+ */
+
+#ifndef POSITION_BASED_ENABLER_H
+#define POSITION_BASED_ENABLER_H
+
+#include "ns3/vector.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <stdint.h>
+
+
+namespace ns3 {
+
+
+struct Point{
+  int x;
+  int y;
+};
+
+struct BoundingBox{  // Bounding box
+  int x1;
+  int x2;
+  int y1;
+  int y2;
+};
+
+class PosEnabler
+{
+  public:
+    PosEnabler ();   
+    // Register the polygon under the name polyType ("TX" or "RX") and return its handle
+    int initPolygon(Point polygon[], int n, std::string polyType);
+    // Register a polygon and return the handle to be used with isInsidePoly
+    int registerPolygon(Point polygon[], int n);
+    int getPolygonHandle(std::string polyType);
+    void initBBs(std::vector<BoundingBox> BBs);
+
+    void EnableChecker(void);
+    void DisableChecker(void);
+    
+    //Polygons
+    bool onSegment(Point p, Point q, Point r);
+    int orientation(Point p, Point q, Point r);
+    bool doIntersect(Point p1, Point q1, Point p2, Point q2);
+    bool isInsidePoly(std::string polyType, Point p);
+    bool isInsidePoly(int polygon, Point p);
+
+    //Bounding boxes
+    bool isEnabled(Vector pos); 
+
+  private: 
+    // Outcome of the ray-casting test, before applying m_enabled
+    enum RayCast
+    {
+      OUTSIDE = 0,          // even number of crossings
+      INSIDE = 1,           // odd number of crossings
+      ON_EDGE = 2,          // collinear with a crossed side and on it
+      COLLINEAR_OUTSIDE = 3 // collinear with a crossed side but not on it
+    };
+
+    /*
+      Registered polygon. Inside the bounding box the ray-casting outcome of every integer point is cached
+      in a raster, filled one row at a time. The first column of each row holds the outcome of the points
+      on the left of the bounding box, which is the same for all of them
+    */
+    struct Polygon
+    {
+      std::vector<Point> vertices;
+      int minX, maxX, minY, maxY;
+      bool rasterized;
+      std::vector<uint8_t> raster;
+      std::vector<bool> rowReady;
+    };
+
+    RayCast rayCast(const std::vector<Point>& polygon, Point p);
+    RayCast classify(Polygon& polygon, Point p);
+
+    std::vector<Polygon> m_polygons;
+    std::map<std::string, int> m_polygonNames;
+    std::vector<BoundingBox> m_BBs; 
+    bool m_enabled;
+
+};
+
+
+
+} //namespace ns3
+#endif /* POSITION_BASED_ENABLER_H */
@@ -24,11 +24,19 @@
 #include "ns3/buildings-helper.h"
 #include "ns3/nr-v2x-propagation-loss-model.h"
 #include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <limits>
 #include "ns3/rng-seed-manager.h"
 #include "ns3/nr-v2x-tag.h"
 #include "ns3/nr-v2x-utils.h"
 #include <random>
 #include <ns3/nr-v2x-amc.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <cstdio>
+#include "ns3/system-path.h"
 
 NS_LOG_COMPONENT_DEFINE ("DebugScript");
 
@@ -42,14 +50,14 @@ std::discrete_distribution<int> distribution {8, 2};
 
 Ipv4Address groupAddress; //use multicast address as destination --> broadcast 
 
-int TrepPrint = 100; // (ms). Set the interval for printing the V-UE stats
+int TrepPrint = 100; // (ms). Set the interval for sampling the V-UE positions
+int PositionLogInterval = 0; // (ms). Sampling interval of the position log written at the end of the run. 0 disables it
 //int PDBaperiodic = 50;
 int Tgen_aperiodic_c, Tgen_periodic;
 
 std::vector<uint16_t> AperiodicPKTs_Size, PeriodicPKTs_Size;
 uint16_t LargestAperiodicSize, LargestPeriodicSize, LargestCAMSize;
 
-double MeasInterval;
 Ptr<ExponentialRandomVariable> RndExp;
 
 bool ExponentialModel;
@@ -57,8 +65,18 @@ bool ExponentialModel;
 std::map< uint32_t, std::vector< std::pair<int,int> > > CAMtraces;
 
 std::vector<double> Periodic_Tgen;
-std::vector<double> PrevX, PrevY, PrevZ, VelX, VelY, VelZ; 
-std::vector<bool> EnableTX;
+/*
+  The V-UEs move with piecewise-constant velocity: instead of polling the mobility models every TrepPrint ms,
+  a segment is stored at every course change and the positions are computed analytically when needed
+*/
+struct MobilitySegment
+{
+  double start; // (s)
+  Vector position;
+  Vector velocity;
+};
+std::vector< std::vector<MobilitySegment> > MobilitySegments; // indexed by ID-1
+std::vector<bool> ActiveVehicles; // V-UEs bound to a vehicle of the mobility trace, indexed by ID-1
 std::vector<uint8_t> VehicleTrafficType;
 std::vector<uint16_t> Pattern_index;
 
@@ -66,9 +84,14 @@ bool ETSITraffic;
 
 void LoadCAMtraces (NodeContainer VehicleUEs);
 
-void Print (NodeContainer VehicleUEs);
+void TrackMobility (NodeContainer VehicleUEs);
+
+bool IsEnabledTX (uint32_t ID);
+
+void WritePositionLog (NodeContainer VehicleUEs, double stopTime);
 
 PosEnabler PositionChecker;
+int PolygonTX, PolygonRX; // handles of the TX and RX polygons in PositionChecker
 
 bool UrbanScenario;
 
@@ -128,7 +151,7 @@ UdpClient::Send (void)
 
   Ptr<UniformRandomVariable> packetSize_index = CreateObject<UniformRandomVariable>();
 
-  if (EnableTX[nodeId-1]) //Not all nodes are enabled to transmit (see SUMO simulation details)
+  if (IsEnabledTX(nodeId)) //Not all nodes are enabled to transmit (see SUMO simulation details)
   {
     SeqTsHeader seqTs;  // Packet header for UDP Client/Server application
     seqTs.SetSeq (m_sent); // The packet header must be sequentially increased. Use the packet number m_sent
@@ -154,7 +177,7 @@ UdpClient::Send (void)
         v2xTag.SetPdb ((double)100); // @LUCA modified later 
         m_size = CAMtraces[nodeId][Pattern_index[nodeId-1]].second;
         ReservationSize = LargestCAMSize;
-        NS_LOG_UNCOND("Udp node " << nodeId << ": transmitting packet with size: " << m_size << " and reserving resources using " << ReservationSize);
+        NR_V2X_CONSOLE (VERBOSE, "Udp node " << nodeId << ": transmitting packet with size: " << m_size << " and reserving resources using " << ReservationSize);
         v2xTag.SetPrsvp ((uint32_t)100); // the required PHY reservation interval 
         v2xTag.SetReservationSize((uint16_t) ReservationSize + 34);
 
@@ -168,7 +191,7 @@ UdpClient::Send (void)
         //m_size = PacketSizeDistribution();
       //  ReservationSize = LargestAperiodicSize;
         ReservationSize = m_size;
-        NS_LOG_UNCOND("Udp: transmitting packet with size: " << m_size+34 << " and reserving resources using " << ReservationSize+34 << ". Next packet in " << T_gen << " ms");
+        NR_V2X_CONSOLE (VERBOSE, "Udp: transmitting packet with size: " << m_size+34 << " and reserving resources using " << ReservationSize+34 << ". Next packet in " << T_gen << " ms");
         v2xTag.SetPrsvp ((uint32_t) Tgen_aperiodic_c*2); // the required PHY reservation interval 
         v2xTag.SetReservationSize((uint16_t) ReservationSize + 34);
       }
@@ -184,7 +207,7 @@ UdpClient::Send (void)
       m_size = PeriodicPKTs_Size[Pattern_index[nodeId-1]%5];
    //   ReservationSize = LargestPeriodicSize;
       ReservationSize = m_size;
-      NS_LOG_UNCOND("Udp: transmitting packet with size: " << m_size+34 << " and reserving resources using " << ReservationSize+34 << ". Next packet in " << T_gen << " ms");
+      NR_V2X_CONSOLE (VERBOSE, "Udp: transmitting packet with size: " << m_size+34 << " and reserving resources using " << ReservationSize+34 << ". Next packet in " << T_gen << " ms");
    //   std::cin.get();
       v2xTag.SetPacketSize((uint16_t) m_size + 34);
       v2xTag.SetReservationSize((uint16_t) ReservationSize + 34);
@@ -218,7 +241,7 @@ UdpClient::Send (void)
       CAMdebug.close();
     }
     Point point = {(int)xPosition, (int)yPosition}; 
-    insideTX = PositionChecker.isInsidePoly("TX", point);
+    insideTX = PositionChecker.isInsidePoly(PolygonTX, point);
  //   if ((xPosition >= 1500) && (xPosition <= 3500)){
   /*  if (insideTX){
     std::ofstream filetest;
@@ -353,7 +376,7 @@ void PacketSink::HandleRead (Ptr<Socket> socket)
       nodeState -> SetLastRcvPacketId(rxPacketID);
 
       //NS_LOG_UNCOND("\nOk: " << rxPacketID << ", rebroadcast: " << rebroadcast);
-      NS_LOG_UNCOND("\nOk: " << rxPacketID);
+      NR_V2X_CONSOLE (VERBOSE, "\nOk: " << rxPacketID);
       tGenSec = rxV2xTag.GetDoubleValue();
       //TXnodeId = rxV2xTag.GetNodeId();
       genPosX = rxV2xTag.GetGenPosX();
@@ -371,7 +394,7 @@ void PacketSink::HandleRead (Ptr<Socket> socket)
     uint32_t currentSequenceNumber = seqTs.GetSeq ();
     currentSequenceNumber+=0;
     Point p = {(int)rxPosX, (int)rxPosY}; 
-    insideRX = PositionChecker.isInsidePoly("RX", p);
+    insideRX = PositionChecker.isInsidePoly(PolygonRX, p);
    /* if (insideRX)
     {
       filetest.open(FilePath + "RxFile.txt",std::ios_base::app);
@@ -408,7 +431,7 @@ void LoadCAMtraces (NodeContainer VehicleUEs)
              row.push_back(word);
              row_int.push_back(std::stoi(word));
           }
-          NS_LOG_UNCOND("Node ID " << ID << " row " << row_int[1]);
+          NR_V2X_CONSOLE (VERBOSE, "Node ID " << ID << " row " << row_int[1]);
    //       CAMtraces[ID].push_back(row_int);
           CAMtraces[ID].push_back(std::make_pair(row_int[1],row_int[2]));
         }
@@ -421,54 +444,231 @@ void LoadCAMtraces (NodeContainer VehicleUEs)
 
 
 
-void Print (NodeContainer VehicleUEs) {
-        uint32_t ID;
-        bool inside;
-//        std::ofstream positFile;  
-//        positFile.open(FilePath + "posFile.txt",std::ofstream::app);
-        for (NodeContainer::Iterator L = VehicleUEs.Begin(); L != VehicleUEs.End(); ++L)
-        {
-            Ptr<Node> node = *L;
-            ID = node->GetId ();
-                
-            Ptr<MobilityModel> mob = node->GetObject<MobilityModel> ();
-            if (! mob) continue; // Strange -- node has no mobility model installed. Skip.
-            Vector pos = mob->GetPosition ();
-          //  Vector vel = mob->GetVelocity ();
-            Vector vel;
-            VelX[ID-1] = 0;
-            VelY[ID-1] = 0;
-            VelZ[ID-1] = 0;
-
-            VelX[ID-1] = (pos.x-PrevX[ID-1])/MeasInterval;
-            VelY[ID-1] = (pos.y-PrevY[ID-1])/MeasInterval;
-            VelZ[ID-1] = (pos.z-PrevZ[ID-1])/MeasInterval;
-
-       //     vel.x = VelX[ID-1];
-       //     vel.y = VelY[ID-1];
-       //     vel.z = VelZ[ID-1];
-
-            Point p = {(int)pos.x, (int)pos.y}; 
-            inside = PositionChecker.isInsidePoly("RX", p);
-
-/*            if (inside){
-              positFile << Simulator::Now().GetSeconds() << "," << ID << "," << pos.x << "," << pos.y << "," << pos.z << "," << VelX[ID-1] << "," << VelY[ID-1] << "," << VelZ[ID-1] << "," << (int)VehicleTrafficType[ID-1] << "," << "1" << "\r\n";
-            }
-            else
-              positFile << Simulator::Now().GetSeconds() << "," << ID << "," << pos.x << "," << pos.y << "," << pos.z << "," << VelX[ID-1] << "," << VelY[ID-1] << "," << VelZ[ID-1] << "," << (int)VehicleTrafficType[ID-1] << "," << "0" << "\r\n";
+void CourseChange (uint32_t ID, Ptr<const MobilityModel> mob)
+{
+  MobilitySegment segment = {Simulator::Now().GetSeconds(), mob->GetPosition(), mob->GetVelocity()};
+  std::vector<MobilitySegment>& segments = MobilitySegments[ID-1];
+  if ((!segments.empty()) && (segments.back().start == segment.start))
+    segments.back() = segment; // Several course changes at the same time: the last one holds
+  else
+    segments.push_back(segment);
+  if (PositionLogInterval == 0)
+  {
+    // Without the position log, only the segments after the last position sample are needed
+    double lastSample = segment.start - ((double)TrepPrint)/1000;
+    std::vector<MobilitySegment>::iterator first = segments.begin();
+    while (((first + 1) != segments.end()) && ((first + 1)->start <= lastSample))
+      ++first;
+    segments.erase(segments.begin(), first);
+  }
+}
+
+
+// The channel models of the V-UEs follow the vehicles of the mobility trace
+void VehicleEnters (Ptr<NrV2XPropagationLossModel> channelModels, uint32_t ID)
+{
+  ActiveVehicles[ID-1] = true;
+  channelModels->ActivateNode(ID);
+}
+
+
+void VehicleLeaves (Ptr<NrV2XPropagationLossModel> channelModels, uint32_t ID)
+{
+  ActiveVehicles[ID-1] = false;
+  channelModels->RetireNode(ID);
+}
+
+
+void TrackMobility (NodeContainer VehicleUEs)
+{
+  MobilitySegments.resize(VehicleUEs.GetN());
+  for (NodeContainer::Iterator L = VehicleUEs.Begin(); L != VehicleUEs.End(); ++L)
+  {
+    Ptr<Node> node = *L;
+    Ptr<MobilityModel> mob = node->GetObject<MobilityModel> ();
+    if (! mob) continue; // Strange -- node has no mobility model installed. Skip.
+    CourseChange(node->GetId (), mob);
+    mob->TraceConnectWithoutContext("CourseChange", MakeBoundCallback(&CourseChange, node->GetId ()));
+  }
+}
+
+
+Vector PositionAt (uint32_t ID, double t)
+{
+  std::vector<MobilitySegment>& segments = MobilitySegments[ID-1];
+  NS_ASSERT_MSG(!segments.empty(), "No mobility segment for V-UE " << ID);
+  // Last segment started at or before t
+  std::vector<MobilitySegment>::iterator it = segments.end();
+  do
+  {
+    --it;
+  } while ((it != segments.begin()) && (it->start > t));
+  double dt = t - it->start;
+  return Vector(it->position.x + it->velocity.x*dt, it->position.y + it->velocity.y*dt, it->position.z + it->velocity.z*dt);
+}
+
+
+// The TX enabler is evaluated at the last position sample, i.e. every TrepPrint ms
+bool IsEnabledTX (uint32_t ID)
+{
+  if (!ActiveVehicles[ID-1])
+    return false;
+  int64_t sample = (Simulator::Now().GetMilliSeconds() / TrepPrint) * TrepPrint;
+  return PositionChecker.isEnabled(PositionAt(ID, sample/1000.0));
+}
+
+
+// Write the positions of the V-UEs sampled every PositionLogInterval ms from the start to stopTime
+void WritePositionLog (NodeContainer VehicleUEs, double stopTime)
+{
+  std::ofstream positFile;
+  positFile.open(FilePath + "posFile.txt");
+  double interval = ((double)PositionLogInterval)/1000;
+  for (int64_t sample = 0; sample*interval <= stopTime; sample++)
+  {
+    double t = sample*interval;
+    for (NodeContainer::Iterator L = VehicleUEs.Begin(); L != VehicleUEs.End(); ++L)
+    {
+      uint32_t ID = (*L)->GetId ();
+      Vector pos = PositionAt(ID, t);
+      Vector prev = PositionAt(ID, std::max(t - interval, 0.0));
+      Vector vel = Vector((pos.x-prev.x)/interval, (pos.y-prev.y)/interval, (pos.z-prev.z)/interval);
+      Point p = {(int)pos.x, (int)pos.y}; 
+      bool inside = PositionChecker.isInsidePoly(PolygonRX, p);
+      positFile << t << "," << ID << "," << pos.x << "," << pos.y << "," << pos.z << "," << vel.x << "," << vel.y << "," << vel.z << "," << (int)VehicleTrafficType[ID-1] << "," << (inside ? "1" : "0") << "\r\n";
+    }
+  }
+  positFile.close();
+}
+
+
+std::vector<pid_t> ForkedRuns; // Processes forked at the end of the warm-up
+
+// Signals the spectrum channel did not deliver because of the maximum coupling loss
+struct CouplingLossCutoff
+{
+  uint64_t links; // links evaluated by the spectrum channel
+  uint64_t discarded;
+  double discardedEnergy; // (J)
+  double minDiscardedLoss; // (dB)
+};
+CouplingLossCutoff Cutoff = {0, 0, 0.0, std::numeric_limits<double>::infinity()};
+
+void LinkEvaluated (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb)
+{
+  Cutoff.links++;
+}
+
+void SignalDiscarded (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb, double energy, Ptr<const SpectrumSignalParameters> txParams)
+{
+  Cutoff.discarded++;
+  Cutoff.discardedEnergy += energy;
+  Cutoff.minDiscardedLoss = std::min(Cutoff.minDiscardedLoss, lossDb);
+  // The receiver records the packet as lost below the sensitivity through the sink connected by NistLteHelper
+}
+
+void WriteCutoffReport (double maxCouplingLoss, double txPower, double rssiThreshold)
+{
+  std::ofstream report;
+  report.open (FilePath + "CouplingLossCutoff.txt");
+  report << "Max coupling loss = " << maxCouplingLoss << " dB" << std::endl;
+  report << "Links evaluated = " << Cutoff.links << std::endl;
+  report << "Signals discarded = " << Cutoff.discarded << std::endl;
+  report << "Interference energy discarded = " << Cutoff.discardedEnergy << " J" << std::endl;
+  if (Cutoff.discarded > 0)
+  {
+    report << "Mean energy per discarded signal = " << Cutoff.discardedEnergy / Cutoff.discarded << " J" << std::endl;
+    report << "Strongest discarded signal = " << txPower - Cutoff.minDiscardedLoss << " dBm" << std::endl;
+  }
+  // StartRx passes the signals below the sensitivity to the RSSI callback too
+  report << "The discarded signals are recorded as lost below the sensitivity, but are not measured by the S-RSSI nor counted in the CBR (S-RSSI threshold = " << rssiThreshold << " dBm)" << std::endl;
+  report.close ();
+}
+
+bool
+IsDirectory (std::string path)
+{
+  struct stat info;
+  return stat (path.c_str (), &info) == 0 && S_ISDIR (info.st_mode);
+}
+
+/*
+  Copy the files of the folder from (ending with '/') in the folder to, creating it
+  or removing the files left there by a previous run
+*/
+void
+CopyOutputFolder (std::string from, std::string to)
+{
+  if (IsDirectory (to))
+  {
+    std::list<std::string> stale = SystemPath::ReadFiles (to);
+    for (std::list<std::string>::iterator it = stale.begin (); it != stale.end (); ++it)
+    {
+      std::string file = to + *it;
+      if (!IsDirectory (file))
+        NS_ABORT_MSG_IF (std::remove (file.c_str ()) != 0, "Unable to remove " << file);
+    }
+  }
+  else
+  {
+    SystemPath::MakeDirectories (to);
+    NS_ABORT_MSG_IF (!IsDirectory (to), "Unable to create the folder " << to);
+  }
+  std::list<std::string> files = SystemPath::ReadFiles (from);
+  for (std::list<std::string>::iterator it = files.begin (); it != files.end (); ++it)
+  {
+    if (IsDirectory (from + *it))
+      continue;
+    std::ifstream in ((from + *it).c_str (), std::ios_base::binary);
+    std::ofstream out ((to + *it).c_str (), std::ios_base::binary);
+    NS_ABORT_MSG_IF (!in.is_open () || !out.is_open (), "Unable to copy " << from + *it << " in " << to);
+    if (in.peek () != std::ifstream::traits_type::eof ())
+      out << in.rdbuf ();
+    out.close ();
+    NS_ABORT_MSG_IF (out.fail (), "Unable to copy " << from + *it << " in " << to);
+  }
+}
+
+/*
+  At the end of the warm-up, fork the simulation into forks-1 child processes. Every child inherits
+  the whole simulator state (sensing databases, RLC buffers, event queue, mobility, channel matrix),
+  moves to a different run number and writes its results in fork<k>/<outputPath>
 */
-            EnableTX[ID-1] = true;
-            if (!PositionChecker.isEnabled(pos))
-              EnableTX[ID-1] = false;
-
-
-           PrevX[ID-1] = pos.x;
-           PrevY[ID-1] = pos.y;
-           PrevZ[ID-1] = pos.z;
-        }         
-     //   Simulator::Schedule (MilliSeconds (TrepPrint), &Print);
-        Simulator::Schedule (MilliSeconds (TrepPrint), &Print, VehicleUEs);      
-//        positFile.close();
+void
+ForkAfterWarmUp (uint32_t forks, uint32_t runNumber, Ptr<NistLteHelper> lteHelper, NetDeviceContainer ueDevs, Ptr<NrV2XPropagationLossModel> channelModel)
+{
+  std::cout.flush ();
+  std::cerr.flush ();
+  // The children do not inherit the threads: join them, each process starts its own pool when needed
+  NrV2XSpectrumPhy::ShutdownDecodeWorkers ();
+  for (uint32_t k = 1; k < forks; k++)
+  {
+    pid_t pid = fork ();
+    NS_ABORT_MSG_IF (pid < 0, "Unable to fork the simulation after the warm-up");
+    if (pid == 0)
+    {
+      ForkedRuns.clear ();
+      std::string forkPath = "fork" + std::to_string(k) + "/";
+      CopyOutputFolder (FilePath, forkPath + FilePath);
+      NS_ABORT_MSG_IF (chdir (forkPath.c_str ()) != 0, "Unable to enter the fork output folder");
+
+      // The random variables created from now on use the new run. The long-lived ones are re-seeded explicitly
+      RngSeedManager::SetRun (runNumber + k);
+      int64_t stream = 0;
+      stream += lteHelper->AssignStreams (ueDevs, stream);
+      stream += channelModel->AssignStreams (stream);
+      if (RndExp != 0)
+        RndExp->SetStream (stream++);
+      generator.seed (runNumber + k);
+
+      std::ofstream readme;
+      readme.open (FilePath + "simREADME.txt", std::ios_base::app);
+      readme << " - forked at t = " << Simulator::Now ().GetSeconds () << " s with run = " << runNumber + k << std::endl;
+      readme.close ();
+      return;
+    }
+    ForkedRuns.push_back (pid);
+  }
 }
 
 
@@ -506,6 +706,8 @@ main (int argc, char *argv[])
   double ueTxPower = 23.0; // [dBm]
   uint32_t ueCount = 4; // Number of V-UEs 
   bool verbose = true;
+  uint32_t Verbosity = NrV2XConsole::VERBOSE; // 0 = heartbeat only, 1 = configuration summaries, 2 = per-packet and per-frame messages
+  double HeartbeatInterval = 1.0; // (s)
 
   //Default configuration
   uint16_t OFDM_numerology = 0; //Default value is 0 = 15 KHz SCS
@@ -516,6 +718,8 @@ main (int argc, char *argv[])
   bool IBE = false;
  
   std::string outputPath;
+  std::string MobilityTrace = ""; // SUMO FCD (.xml) or ns-2 trace. If empty, the V-UEs are dropped on the highway
+  double TraceLookAhead = 1.0; // (s)
 
   bool ReEvaluation = false; //Default
   bool AllSlots_ReEvaluation = false; //Default
@@ -538,6 +742,30 @@ main (int argc, char *argv[])
 
   bool RxCresel = false;
 
+  bool OnlineStats = false; // If true, aggregate PDR, latency and IPG in the simulator instead of logging every reception
+  double WarmUp = 0; // (s). Time at which the simulation is forked
+  bool MeasurementSink = false; // If true, the received packets are accounted for at the PHY and not delivered to the applications
+  uint32_t Forks = 1; // Number of runs sharing the warm-up. Fork k (k > 0) uses run runNumber+k
+  bool RecordSelections = false; // If true, the inputs of every Mode 2 selection are saved in SelectionInputs.txt
+  double MaxCouplingLoss = 0; // (dB). Signals with a larger pathloss plus shadowing are not delivered. 0 disables the cutoff
+  double MaxDistance = 0; // (m). If > 0, sets MaxCouplingLoss to the pathloss at this distance plus ShadowingMargin
+  double ShadowingMargin = 10; // (dB)
+
+  // Partitioning of the highway in segments, simulated by independent processes (e.g. one per MPI rank)
+  double RoadLength = 5000; // (m)
+  uint32_t Segments = 1;
+  uint32_t Segment = 0; // Defaults to the MPI rank, when launched by mpirun
+  double Halo = 2000; // (m). Vehicles simulated beyond the segment borders, as interferers only
+  double StatsXMin = 0; // (m). Region of the receivers accounted for in the statistics
+  double StatsXMax = 3500; // (m)
+  double CbrXMin = 1500; // (m). Region of the UEs evaluating the CBR
+  double CbrXMax = 3500; // (m)
+  const char* rank = std::getenv ("OMPI_COMM_WORLD_RANK");
+  if (rank == NULL)
+    rank = std::getenv ("PMI_RANK");
+  if (rank != NULL)
+    Segment = std::atoi (rank);
+
 // Change the random run  
   uint32_t seed = 867; // this is the default seed;
   uint32_t runNumber = 1; // this is the default run --> this will be overridden shortly...
@@ -590,13 +818,37 @@ main (int argc, char *argv[])
   cmd.AddValue ("Percentage", "In mixed mode, the percentage of periodic UEs", PeriodicPercentage);
 
   cmd.AddValue ("ETSI", "Enable the ETSI-Algorithm for the CAMs generation", ETSITraffic);
+  cmd.AddValue ("OnlineStats", "Aggregate the reception statistics online instead of saving ReceivedLog.txt", OnlineStats);
+  cmd.AddValue ("WarmUp", "Simulated time (s) after which the simulation is forked into the runs", WarmUp);
+  cmd.AddValue ("MobilityTrace", "SUMO FCD (.xml) or ns-2 mobility trace. The V-UEs are the pool the vehicles are bound to", MobilityTrace);
+  cmd.AddValue ("TraceLookAhead", "How far ahead (s) the mobility trace is read", TraceLookAhead);
+  cmd.AddValue ("PositionLog", "Sampling interval (ms) of the V-UE positions saved in posFile.txt at the end of the run. 0 disables it", PositionLogInterval);
+  cmd.AddValue ("Verbosity", "Console output: 0 = heartbeat only, 1 = configuration summaries, 2 = per-packet and per-frame messages", Verbosity);
+  cmd.AddValue ("Heartbeat", "Simulated time (s) between progress messages when Verbosity < 2. 0 disables them", HeartbeatInterval);
+  cmd.AddValue ("MeasurementSink", "Account for the receptions at the PHY only, without delivering the packets to the upper layers", MeasurementSink);
+  cmd.AddValue ("Forks", "Number of runs sharing the warm-up. Fork k > 0 uses run runNo+k and writes in fork<k>/", Forks);
+  cmd.AddValue ("RecordSelections", "Save the inputs of every Mode 2 selection in SelectionInputs.txt, for nr-v2x-selection-replay", RecordSelections);
+  cmd.AddValue ("MaxCouplingLoss", "Pathloss plus shadowing (dB) beyond which the signals are not delivered to the receivers. 0 disables the cutoff", MaxCouplingLoss);
+  cmd.AddValue ("MaxDistance", "Distance (m) defining MaxCouplingLoss, together with ShadowingMargin", MaxDistance);
+  cmd.AddValue ("ShadowingMargin", "Shadowing margin (dB) added to the pathloss at MaxDistance", ShadowingMargin);
+  cmd.AddValue ("RoadLength", "Length (m) of the highway the vehicles are dropped on", RoadLength);
+  cmd.AddValue ("Segments", "Number of highway segments, each simulated by its own process", Segments);
+  cmd.AddValue ("Segment", "Segment simulated by this process. Defaults to the MPI rank", Segment);
+  cmd.AddValue ("Halo", "Distance (m) beyond the segment borders within which the vehicles are simulated as interferers", Halo);
+  cmd.AddValue ("StatsXMin", "Lower x coordinate (m) of the receivers accounted for in the statistics", StatsXMin);
+  cmd.AddValue ("StatsXMax", "Upper x coordinate (m) of the receivers accounted for in the statistics", StatsXMax);
+  cmd.AddValue ("CbrXMin", "Lower x coordinate (m) of the UEs evaluating the CBR", CbrXMin);
+  cmd.AddValue ("CbrXMax", "Upper x coordinate (m) of the UEs evaluating the CBR", CbrXMax);
 
   cmd.Parse(argc, argv);
 
+  NS_ASSERT_MSG (Verbosity <= NrV2XConsole::VERBOSE, "Verbosity must be 0, 1 or 2");
+  NrV2XConsole::SetVerbosity ((NrV2XConsole::Verbosity) Verbosity);
+
   if (SCS_factor.find(OFDM_numerology) == SCS_factor.end())
     NS_ASSERT_MSG(false, "Non-valid OFDM numerology configuration");
   else
-    NS_LOG_UNCOND("Adopted OFDM numerology is " << (uint32_t) OFDM_numerology << ", SCS = " << (15*SCS_factor[OFDM_numerology]) << " kHz");
+    NR_V2X_CONSOLE (INFO, "Adopted OFDM numerology is " << (uint32_t) OFDM_numerology << ", SCS = " << (15*SCS_factor[OFDM_numerology]) << " kHz");
   NS_ASSERT_MSG(OFDM_numerology != 3, "120 kHz SCS is not supported in FR1");
 
 
@@ -605,31 +857,46 @@ main (int argc, char *argv[])
   NS_ASSERT_MSG(subchannelSize > 0, "Subchannel size must be larger than zero");
   NS_ASSERT_MSG(channelBW_RBs >= subchannelSize, "Channel bandwidth must be larger than the subchannel size");
 
-  NS_LOG_UNCOND("Channel BW = " << channelBW << " MHz. Channel BW = " <<channelBW_RBs << " RBs. Subchannel size = " << subchannelSize << " RBs");
+  NR_V2X_CONSOLE (INFO, "Channel BW = " << channelBW << " MHz. Channel BW = " <<channelBW_RBs << " RBs. Subchannel size = " << subchannelSize << " RBs");
 
   RefSensitivity = GetRefSensitivity(15*SCS_factor[OFDM_numerology], channelBW);
 
-  NS_LOG_UNCOND("UE reference sensitivity = " << RefSensitivity);
+  NR_V2X_CONSOLE (INFO, "UE reference sensitivity = " << RefSensitivity);
+
+  NS_ASSERT_MSG (Segments > 0, "The number of segments must be larger than zero");
+  NS_ASSERT_MSG (Segment < Segments, "Segment " << Segment << " does not exist: there are " << Segments << " segments");
+  NS_ASSERT_MSG (MobilityTrace == "" || Segments == 1, "Mobility traces cannot be partitioned in segments");
+  double segmentStart = RoadLength * Segment / Segments;
+  double segmentEnd = RoadLength * (Segment + 1) / Segments;
+  if (Segments > 1)
+  {
+    // Each receiver is accounted for, and evaluates the CBR, in the process owning its segment only
+    StatsXMin = std::max (StatsXMin, segmentStart);
+    StatsXMax = std::min (StatsXMax, segmentEnd);
+    CbrXMin = std::max (CbrXMin, segmentStart);
+    CbrXMax = std::min (CbrXMax, segmentEnd);
+    NR_V2X_CONSOLE (INFO, "Segment " << Segment << " of " << Segments << ": [" << segmentStart << ", " << segmentEnd << "] m, halo = " << Halo << " m");
+  }
 
  /* Ptr<NrV2XAmc> NRamc = CreateObject <NrV2XAmc> ();
   for (uint16_t i=1; i< 20; i++)
   {
     uint16_t TBlen_subCH, TBlen_RBs;
     NRamc->GetSlSubchAndTbSizeFromMcs(i*100+32, mcs, subchannelSize, channelBW_RBs, &TBlen_subCH, &TBlen_RBs);
-    NS_LOG_UNCOND("Pkt size = " << i*100 << ", RBs " << TBlen_RBs << " Subchannels = " << TBlen_subCH);
+    NR_V2X_CONSOLE (INFO, "Pkt size = " << i*100 << ", RBs " << TBlen_RBs << " Subchannels = " << TBlen_subCH);
   }*/
   /*for (uint16_t i=0; i< 6; i++)
   {
     uint16_t TBlen_subCH, TBlen_RBs;
     NRamc->GetSlSubchAndTbSizeFromMcs(200+i*200, mcs, subchannelSize, channelBW_RBs, &TBlen_subCH, &TBlen_RBs);
-    NS_LOG_UNCOND("Pkt size = " << 200+i*200 << ", RBs " << TBlen_RBs << " Subchannels = " << TBlen_subCH);
+    NR_V2X_CONSOLE (INFO, "Pkt size = " << 200+i*200 << ", RBs " << TBlen_RBs << " Subchannels = " << TBlen_subCH);
   }
 
   uint16_t TBlen_subCH, TBlen_RBs;
   NRamc->GetSlSubchAndTbSizeFromMcs(156+34, mcs, subchannelSize, channelBW_RBs, &TBlen_subCH, &TBlen_RBs);
-  NS_LOG_UNCOND("Pkt size = " << 190 << ", RBs " << TBlen_RBs << " Subchannels = " << TBlen_subCH);
+  NR_V2X_CONSOLE (INFO, "Pkt size = " << 190 << ", RBs " << TBlen_RBs << " Subchannels = " << TBlen_subCH);
   NRamc->GetSlSubchAndTbSizeFromMcs(266+34, mcs, subchannelSize, channelBW_RBs, &TBlen_subCH, &TBlen_RBs);
-  NS_LOG_UNCOND("Pkt size = " << 300 << ", RBs " << TBlen_RBs << " Subchannels = " << TBlen_subCH);
+  NR_V2X_CONSOLE (INFO, "Pkt size = " << 300 << ", RBs " << TBlen_RBs << " Subchannels = " << TBlen_subCH);
   std::cin.get();*/
 
  // std::cin.get();
@@ -686,6 +953,9 @@ main (int argc, char *argv[])
   else
     outputPath = "results/sidelink_" + std::to_string(seed) + "_" + std::to_string(runNumber) + "/"; 
 
+  if (Segments > 1)
+    outputPath = outputPath.substr (0, outputPath.size () - 1) + "_seg" + std::to_string (Segment) + "/";
+
   FilePath = outputPath;
   //Clear the results folder 
 
@@ -713,6 +983,9 @@ main (int argc, char *argv[])
 //  readme << " --- Exponential Model: " << ExponentialModel << std::endl;
 //  readme << " --- CAM trace Model: " << CAMtraceModel << ", Ground truth? " << GT_CAMtrace << ", Machine Learning? " << ML_CAMtrace << std::endl;
   readme << " - Periodic traffic = " << PeriodicTraffic << std::endl;
+  readme << " - Segment = " << Segment << " of " << Segments << ", [" << segmentStart << ", " << segmentEnd << "] m, halo = " << Halo << " m" << std::endl;
+  readme << " - Statistics region = [" << StatsXMin << ", " << StatsXMax << "] m" << std::endl;
+  readme << " - CBR region = [" << CbrXMin << ", " << CbrXMax << "] m" << std::endl;
   readme.close ();
 
 // Set the random seed and run
@@ -721,8 +994,8 @@ main (int argc, char *argv[])
 
 
   //Initialize the position checker
-  PositionChecker.initPolygon(polygonTX, (int)sizeof(polygonTX)/sizeof(polygonTX[0]), "TX"); //Filter TX users
-  PositionChecker.initPolygon(polygonRX, (int)sizeof(polygonRX)/sizeof(polygonRX[0]), "RX"); //Filter TX users
+  PolygonTX = PositionChecker.initPolygon(polygonTX, (int)sizeof(polygonTX)/sizeof(polygonTX[0]), "TX"); //Filter TX users
+  PolygonRX = PositionChecker.initPolygon(polygonRX, (int)sizeof(polygonRX)/sizeof(polygonRX[0]), "RX"); //Filter TX users
   PositionChecker.initBBs(BBs); 
   PositionChecker.DisableChecker(); // Disable the UEs position checker
 
@@ -752,10 +1025,17 @@ main (int argc, char *argv[])
   Config::SetDefault ("ns3::NrV2XSpectrumPhy::ReferenceSensitivity", DoubleValue (RefSensitivity));  
   Config::SetDefault ("ns3::NrV2XSpectrumPhy::CtrlErrorModelEnabled", BooleanValue (CtrlErrorModelEnabled));  // Set but not used
   Config::SetDefault ("ns3::NrV2XSpectrumPhy::CtrlFullDuplexEnabled", BooleanValue (!CtrlErrorModelEnabled)); // Set but not used
-  Config::SetDefault ("ns3::NrV2XSpectrumPhy::SaveCollisionLossesUnimore", BooleanValue (true)); //fare var apposta   // Enable the collision and propagation loss event saving
+  Config::SetDefault ("ns3::NrV2XSpectrumPhy::SaveCollisionLossesUnimore", BooleanValue (!OnlineStats)); //fare var apposta   // Enable the collision and propagation loss event saving
+  Config::SetDefault ("ns3::NrV2XSpectrumPhy::EnableRxStatistics", BooleanValue (OnlineStats)); // Only the aggregates are written, at the end of the simulation
+  Config::SetDefault ("ns3::NrV2XSpectrumPhy::MeasurementSink", BooleanValue (MeasurementSink)); // PDR and latency come from the PHY records anyway
+  Config::SetDefault ("ns3::NrV2XSpectrumPhy::StatisticsXMin", DoubleValue (StatsXMin));
+  Config::SetDefault ("ns3::NrV2XSpectrumPhy::StatisticsXMax", DoubleValue (StatsXMax));
+  Config::SetDefault ("ns3::NrV2XUePhy::CbrXMin", DoubleValue (CbrXMin));
+  Config::SetDefault ("ns3::NrV2XUePhy::CbrXMax", DoubleValue (CbrXMax));
 
   // Used for 
   Config::SetDefault ("ns3::NrV2XUeMac::RandomV2VSelection", BooleanValue (randomV2VSelection));
+  Config::SetDefault ("ns3::NrV2XUeMac::RecordSelectionInputs", BooleanValue (RecordSelections));
 
   NS_LOG_INFO ("Starting network configuration...");
 
@@ -768,6 +1048,8 @@ main (int argc, char *argv[])
   Config::SetDefault ("ns3::NrV2XUeMac::OutputPath", StringValue (outputPath)); 
   Config::SetDefault ("ns3::NrV2XUePhy::OutputPath", StringValue (outputPath)); 
   Config::SetDefault ("ns3::NrV2XSpectrumPhy::OutputPath", StringValue (outputPath)); 
+  Config::SetDefault ("ns3::NrV2XRxStatistics::OutputPath", StringValue (outputPath)); 
+  Config::SetDefault ("ns3::NrV2XProfiler::OutputPath", StringValue (outputPath));
   // Configure the saving period------------------------------------------------------------------------------------
   Config::SetDefault ("ns3::NrV2XUeMac::SavingPeriod", DoubleValue (2.0)); 
   Config::SetDefault ("ns3::NrV2XUePhy::SavingPeriod", DoubleValue (2.0)); 
@@ -849,6 +1131,18 @@ main (int argc, char *argv[])
 
   Config::SetDefault ("ns3::NrV2XSpectrumPhy::ChannelMatrix", PointerValue (Sl3GPPChannelMatrix)); 
 
+  // Far receivers: the signals are neither copied nor scheduled. The discarded energy is reported in CouplingLossCutoff.txt
+  if (MaxDistance > 0)
+    MaxCouplingLoss = Sl3GPPChannelMatrix->GetMaxCouplingLoss(MaxDistance, ShadowingMargin);
+  if (MaxCouplingLoss > 0)
+  {
+    lteHelper->SetSpectrumChannelAttribute ("MaxLossDb", DoubleValue (MaxCouplingLoss));
+    std::ofstream readme;
+    readme.open (outputPath + "simREADME.txt", std::ios_base::app);
+    readme << " - Max coupling loss = " << MaxCouplingLoss << " dB (the discarded signals are recorded as below the sensitivity)" << std::endl;
+    readme.close ();
+  }
+
  
 
 
@@ -857,6 +1151,12 @@ main (int argc, char *argv[])
 
   lteHelper->Initialize (); // Invoke DoInitialize() on all Objects aggregated to this one
 
+  if (MaxCouplingLoss > 0)
+  {
+    Config::ConnectWithoutContext ("/ChannelList/*/$ns3::MultiModelSpectrumChannel/PathLoss", MakeCallback (&LinkEvaluated));
+    Config::ConnectWithoutContext ("/ChannelList/*/$ns3::MultiModelSpectrumChannel/SignalDiscarded", MakeCallback (&SignalDiscarded));
+  }
+
   Ptr<NistLteProseHelper> proseHelper = CreateObject<NistLteProseHelper> ();
   proseHelper->SetLteHelper (lteHelper);
 
@@ -865,9 +1165,27 @@ main (int argc, char *argv[])
 
 //@DOC: Now the UEs (actually, V-UEs are created)
   NodeContainer ueResponders;
- 
-   
+  MobilityHelper mobilityUE;
+
+  Ptr<UniformRandomVariable> laneNumber = CreateObject<UniformRandomVariable>();
+  Ptr<UniformRandomVariable> Xposition = CreateObject<UniformRandomVariable>();
+  double laneWidth = 4.0;
+
+  // All the processes draw the same vehicles. Each one creates only those that can reach its
+  // segment, plus the halo, before the end of the simulation
+  double drift = 19.44 * (simTime + 1);
+  std::vector<Vector> positions;
   for (uint32_t t=0; t<ueCount; ++t)
+  {
+    double yPos = laneNumber->GetInteger(1,6)*laneWidth;
+    double xPos = Xposition->GetValue(0,RoadLength);
+    if ((Segments == 1) || ((xPos >= segmentStart - Halo - drift) && (xPos <= segmentEnd + Halo + drift)))
+      positions.push_back(Vector(xPos, yPos, 0));
+  }
+  if (Segments > 1)
+    NR_V2X_CONSOLE (INFO, "Segment " << Segment << " simulates " << positions.size () << " of " << ueCount << " vehicles");
+   
+  for (uint32_t t=0; t<positions.size(); ++t)
   {
     Ptr<Node> lteNode = CreateObject<Node> ();
     // LTENodeState is a new class developed from scratch. Defined before the main()
@@ -877,24 +1195,15 @@ main (int argc, char *argv[])
     ueResponders.Add(lteNode);
   }
  
-  MobilityHelper mobilityUE;
-
-  Ptr<UniformRandomVariable> laneNumber = CreateObject<UniformRandomVariable>();
-  Ptr<UniformRandomVariable> Xposition = CreateObject<UniformRandomVariable>();
-  double laneWidth = 4.0;
-
   Ptr<ListPositionAllocator> positionAlloc = CreateObject <ListPositionAllocator>();
 
-  for (NodeContainer::Iterator L = ueResponders.Begin(); L != ueResponders.End(); ++L)
-  {  
-    double yPos = laneNumber->GetInteger(1,6)*laneWidth;
-    double xPos = Xposition->GetValue(0,5000);
-    positionAlloc ->Add(Vector(xPos, yPos, 0)); 
-  }
+  for (uint32_t t=0; t<positions.size(); ++t)
+    positionAlloc ->Add(positions[t]); 
   mobilityUE.SetPositionAllocator(positionAlloc);
   mobilityUE.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
   //mobilityUE->SetVelocity({20,0,0});
   mobilityUE.Install (ueResponders);
+  TrackMobility (ueResponders); // Record the velocity segments of the V-UEs, starting from the initial velocities set below
 
   for (NodeContainer::Iterator L = ueResponders.Begin(); L != ueResponders.End(); ++L)
   {  
@@ -907,6 +1216,17 @@ main (int argc, char *argv[])
       VelMob->SetVelocity(Vector(-19.44, 0, 0));     
   }
 
+  ActiveVehicles.assign(ueResponders.GetN(), MobilityTrace == "");
+  Ptr<NrV2XTraceMobilityHelper> traceMobility;
+  if (MobilityTrace != "")
+  {
+    traceMobility = CreateObject<NrV2XTraceMobilityHelper> ();
+    traceMobility->SetAttribute("LookAhead", TimeValue (Seconds (TraceLookAhead)));
+    traceMobility->SetEnterCallback(MakeBoundCallback(&VehicleEnters, Sl3GPPChannelMatrix));
+    traceMobility->SetLeaveCallback(MakeBoundCallback(&VehicleLeaves, Sl3GPPChannelMatrix));
+    traceMobility->Install(MobilityTrace, ueResponders);
+  }
+
   for (NodeContainer::Iterator L = ueResponders.Begin(); L != ueResponders.End(); ++L)
   {  
     int ID;
@@ -915,15 +1235,6 @@ main (int argc, char *argv[])
   //   std::cin.get();
     Ptr<MobilityModel> mob = node->GetObject<MobilityModel> ();
     if (! mob) continue; // Strange -- node has no mobility model installed. Skip.
-    Vector pos = mob->GetPosition ();
-
-    PrevX.push_back(pos.x);
-    PrevY.push_back(pos.y);
-    PrevZ.push_back(pos.z);
-
-    VelX.push_back(0);
-    VelY.push_back(0);
-    VelZ.push_back(0);
 //     PrevX[ID-1] = pos.x;
 //     PrevY[ID-1] = pos.y;
 //     PrevZ[ID-1] = pos.z;
@@ -960,14 +1271,17 @@ main (int argc, char *argv[])
     }
 
 //    EnableTX[ID-1] = true; //Enable a UE to transmit
-    EnableTX.push_back(true); //Enable a UE to transmit
     
   }
-
-  Print(ueResponders);  // Print the initial position of the nodes in the output file
    
 
   Sl3GPPChannelMatrix->InitChannelMatrix(ueResponders);
+  if (MobilityTrace != "")
+  {
+    // The V-UEs get their channel models when a vehicle of the trace is bound to them
+    for (NodeContainer::Iterator L = ueResponders.Begin(); L != ueResponders.End(); ++L)
+      Sl3GPPChannelMatrix->RetireNode((*L)->GetId ());
+  }
 
  // UpdateChannels(ueResponders,true);
 
@@ -1034,7 +1348,6 @@ main (int argc, char *argv[])
 
    }
    
-   MeasInterval = ((double)TrepPrint)/1000;
 
   //mobility.SetPositionAllocator (positionAlloc);
 
@@ -1093,7 +1406,8 @@ main (int argc, char *argv[])
 //  Ipv4AddressGenerator::Init(Ipv4Address ("225.0.0.0"), Ipv4Mask ("255.0.0.0"));
 //  groupAddress = Ipv4AddressGenerator::NextAddress (Ipv4Mask ("255.0.0.0"));
   groupAddress = "225.0.0.1";
-  std::cout << "Group address " << groupAddress << std::endl;
+  if (NrV2XConsole::IsEnabled (NrV2XConsole::INFO))
+    std::cout << "Group address " << groupAddress << std::endl;
   UdpClientHelper udpClient (groupAddress , 8000); //set destination IP address and UDP port (8000 in this case). The group address is used to set the Sidelink Bearers
 
   udpClient.SetAttribute ("MaxPackets", UintegerValue (100000));
@@ -1156,7 +1470,8 @@ main (int argc, char *argv[])
   for (uint32_t i = 0 ; i < pscchLength; i++) {
     pscchBitmapValue = pscchBitmapValue >> 1 | 0x8000000000;
   }
-  std::cout << "bitmap=" << std::hex << pscchBitmapValue << '\n'; // this is the PSCCH subframe pool bitmap, from NIST D2D implementation
+  if (NrV2XConsole::IsEnabled (NrV2XConsole::INFO))
+    std::cout << "bitmap=" << std::hex << pscchBitmapValue << '\n'; // this is the PSCCH subframe pool bitmap, from NIST D2D implementation
 
   pfactory.SetControlBitmap (pscchBitmapValue);
   pfactory.SetControlPeriod (period);
@@ -1175,14 +1490,38 @@ main (int argc, char *argv[])
 
 //  std::cin.get();
 
+  if (Forks > 1)
+  {
+    NS_ASSERT_MSG (WarmUp < simTime, "The warm-up must end before the simulation");
+    Simulator::Schedule (Seconds (WarmUp), &ForkAfterWarmUp, Forks, runNumber, lteHelper, ueDevs, Sl3GPPChannelMatrix);
+  }
+
   NS_LOG_INFO ("Starting simulation...");
   Simulator::Stop (Seconds (simTime+1)); 
+  if (!NrV2XConsole::IsEnabled (NrV2XConsole::VERBOSE) && HeartbeatInterval > 0)
+    NrV2XConsole::EnableHeartbeat (Seconds (HeartbeatInterval));
   Simulator::Run ();
   /*
     Put code to evaluate KPIs here
   */
+  if (PositionLogInterval > 0)
+    WritePositionLog (ueResponders, Simulator::Now ().GetSeconds ());
+  if (MobilityTrace != "")
+    std::cout << "Vehicles dropped because all the V-UEs were in use: " << traceMobility->GetDroppedVehicles () << std::endl;
+  if (MaxCouplingLoss > 0)
+  {
+    DoubleValue rssiThreshold;
+    DynamicCast<NistLteUeNetDevice> (ueDevs.Get (0))->GetPhy ()->GetAttribute ("RSSIthreshold", rssiThreshold);
+    WriteCutoffReport (MaxCouplingLoss, ueTxPower, rssiThreshold.Get ());
+  }
   Simulator::Destroy ();
 
+  for (std::vector<pid_t>::iterator it = ForkedRuns.begin (); it != ForkedRuns.end (); it++)
+  {
+    int status;
+    waitpid (*it, &status, 0);
+  }
+
   NS_LOG_INFO ("Done.");
 
   return 0;
@@ -0,0 +1,147 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+/*
+ * Offline replay of the Mode 2 selections recorded by a scenario with
+ * ns3::NrV2XUeMac::RecordSelectionInputs (SelectionInputs.txt in the
+ * output folder). Each selection is run again through SelectionWindow and
+ * Mode2Step1, without PHY, channel and event scheduler, so that variants of
+ * the selection can be profiled and compared in seconds.
+ *
+ * ./waf --run "nr-v2x-selection-replay --Input=results/Periodic_867_1/SelectionInputs.txt --Repetitions=100"
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/nr-v2x-ue-mac.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("NrV2XSelectionReplay");
+
+int
+main (int argc, char *argv[])
+{
+  std::string input = "results/sidelink/SelectionInputs.txt";
+  std::string output = ""; // one line per recorded selection
+  uint32_t repetitions = 1;
+  double rsrpThreshold = 0; // (dBm). 0 keeps the recorded threshold
+  double sizeThreshold = 0; // 0 keeps the recorded one
+  double pdb = 0; // (ms). 0 keeps the recorded one
+
+  CommandLine cmd;
+  cmd.AddValue ("Input", "Selection inputs recorded with ns3::NrV2XUeMac::RecordSelectionInputs", input);
+  cmd.AddValue ("Output", "If not empty, CSV file with the recorded and the replayed outcome of every selection", output);
+  cmd.AddValue ("Repetitions", "Number of times every selection is replayed", repetitions);
+  cmd.AddValue ("RsrpThreshold", "Initial RSRP threshold (dBm). 0 keeps the recorded one", rsrpThreshold);
+  cmd.AddValue ("SizeThreshold", "Minimum fraction of the candidates left by the exclusions. 0 keeps the recorded one", sizeThreshold);
+  cmd.AddValue ("Pdb", "Packet delay budget (ms), which sets the end of the selection window. 0 keeps the recorded one", pdb);
+  cmd.Parse (argc, argv);
+
+  std::ifstream inputFile (input.c_str ());
+  NS_ABORT_MSG_UNLESS (inputFile.is_open (), "Cannot open " << input);
+  std::vector<NrV2XUeMac::SelectionInputs> selections;
+  std::vector<NrV2XUeMac::SelectionOutcome> recorded;
+  NrV2XUeMac::SelectionInputs inputs;
+  NrV2XUeMac::SelectionOutcome outcome;
+  while (NrV2XUeMac::ReadSelectionInputs (inputFile, &inputs, &outcome))
+    {
+      if (rsrpThreshold != 0)
+        {
+          inputs.rsrpThreshold = rsrpThreshold;
+        }
+      if (sizeThreshold != 0)
+        {
+          inputs.sizeThreshold = sizeThreshold;
+        }
+      if (pdb != 0)
+        {
+          inputs.pdb = pdb;
+        }
+      selections.push_back (inputs);
+      recorded.push_back (outcome);
+    }
+  inputFile.close ();
+  std::cout << "Read " << selections.size () << " selections from " << input << std::endl;
+  if (selections.empty ())
+    {
+      return 0;
+    }
+
+  bool unchanged = (rsrpThreshold == 0) && (sizeThreshold == 0) && (pdb == 0);
+  Ptr<NrV2XUeMac> mac = CreateObject<NrV2XUeMac> ();
+  std::vector<NrV2XUeMac::SelectionOutcome> replayed (selections.size ());
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  for (uint32_t r = 0; r < repetitions; r++)
+    {
+      for (uint32_t i = 0; i < selections.size (); i++)
+        {
+          replayed[i] = mac->ReplaySelection (selections[i]);
+        }
+    }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+
+  uint32_t mismatches = 0;
+  uint64_t iterations = 0, recordedIterations = 0;
+  std::ofstream outputFile;
+  if (output != "")
+    {
+      outputFile.open (output.c_str ());
+      outputFile << "nodeId,time,pdb,rri,cresel,recordedIterations,recordedThreshold,recordedL1,iterations,threshold,initial,pastTx,L1" << std::endl;
+    }
+  for (uint32_t i = 0; i < selections.size (); i++)
+    {
+      iterations += replayed[i].iterations;
+      recordedIterations += recorded[i].iterations;
+      if (replayed[i].iterations != recorded[i].iterations || replayed[i].rsrpThreshold != recorded[i].rsrpThreshold
+          || replayed[i].nCSRpastTx != recorded[i].nCSRpastTx || replayed[i].nCSRfinal != recorded[i].nCSRfinal)
+        {
+          mismatches++;
+        }
+      if (output != "")
+        {
+          outputFile << selections[i].nodeId << "," << selections[i].time << "," << selections[i].pdb << "," << selections[i].rri << "," << selections[i].cresel << ","
+                     << recorded[i].iterations << "," << recorded[i].rsrpThreshold << "," << recorded[i].nCSRfinal << ","
+                     << replayed[i].iterations << "," << replayed[i].rsrpThreshold << "," << replayed[i].nCSRinitial << "," << replayed[i].nCSRpastTx << ","
+                     << replayed[i].nCSRfinal << std::endl;
+        }
+    }
+  if (output != "")
+    {
+      outputFile.close ();
+    }
+
+  uint64_t nReplayed = (uint64_t) selections.size () * repetitions;
+  std::cout << "Replayed " << nReplayed << " selections in " << elapsed.count () << " s, " << nReplayed / std::max (elapsed.count (), 1e-9) << " selections/s" << std::endl;
+  std::cout << "RSRP threshold increases per selection: recorded " << (double) recordedIterations / selections.size ()
+            << ", replayed " << (double) iterations / selections.size () << std::endl;
+  std::cout << mismatches << " selections differ from the recorded outcome" << std::endl;
+
+  mac->Dispose ();
+  Simulator::Destroy ();
+  return (unchanged && mismatches > 0) ? 1 : 0;
+}
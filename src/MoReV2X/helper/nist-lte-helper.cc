@@ -55,7 +55,8 @@ NS_LOG_COMPONENT_DEFINE ("NistLteHelper");
 NS_OBJECT_ENSURE_REGISTERED (NistLteHelper);
 
 NistLteHelper::NistLteHelper (void)
-  : m_imsiCounter (0)
+  : m_imsiCounter (0),
+    m_slSignalDiscardedConnected (false)
 {
   NS_LOG_FUNCTION (this);
   m_ueNetDeviceFactory.SetTypeId (NistLteUeNetDevice::GetTypeId ());
@@ -69,6 +70,7 @@ NistLteHelper::DoInitialize (void)
   NS_LOG_FUNCTION (this);
   m_downlinkChannel = m_channelFactory.Create<SpectrumChannel> ();
   m_uplinkChannel = m_channelFactory.Create<SpectrumChannel> ();
+  m_slSignalDiscardedConnected = false;
 
   m_downlinkPathlossModel = m_dlPathlossModelFactory.Create ();
   Ptr<SpectrumPropagationLossModel> dlSplm = m_downlinkPathlossModel->GetObject<SpectrumPropagationLossModel> ();
@@ -306,6 +308,17 @@ NistLteHelper::InstallUeDevice (NodeContainer c)
 }
 
 
+void
+NistLteHelper::SlSignalDiscarded (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb, double energy, Ptr<const SpectrumSignalParameters> txParams)
+{
+  NS_LOG_FUNCTION (txPhy << rxPhy << lossDb << energy);
+  Ptr<NrV2XSpectrumPhy> nrRxPhy = DynamicCast<NrV2XSpectrumPhy> (rxPhy);
+  if (nrRxPhy != 0)
+    {
+      nrRxPhy->NotifyV2XSlSignalDiscarded (txParams);
+    }
+}
+
 Ptr<NetDevice>
 NistLteHelper::InstallSingleUeDevice (Ptr<Node> n)
 {
@@ -386,6 +399,11 @@ NistLteHelper::InstallSingleUeDevice (Ptr<Node> n)
   ulPhy->SetChannel (m_uplinkChannel);
   if (m_useSidelink || m_useDiscovery) {
     slPhy->SetChannel (m_uplinkChannel); //the sidelink channel is actually modelled as an uplink channel from the PHY Layer point of view
+    if (!m_slSignalDiscardedConnected)
+      {
+        // One sink for all the PHYs: it is called with the receiving one. Only MultiModelSpectrumChannel has the trace
+        m_slSignalDiscardedConnected = m_uplinkChannel->TraceConnectWithoutContext ("SignalDiscarded", MakeCallback (&NistLteHelper::SlSignalDiscarded));
+      }
   }
 
 
@@ -706,6 +724,28 @@ NistLteHelper::InstallSidelinkConfiguration (Ptr<NetDevice> ueDevice, Ptr<LteUeR
   ueConfig->SetDiscInterFreq (slConfiguration->GetDiscInterFreq ());
 }
 
+int64_t
+NistLteHelper::AssignStreams (NetDeviceContainer c, int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  int64_t currentStream = stream;
+  for (NetDeviceContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<NistLteUeNetDevice> ueDev = DynamicCast<NistLteUeNetDevice> (*i);
+      if (ueDev)
+        {
+          Ptr<NrV2XUePhy> uePhy = ueDev->GetPhy ();
+          if (uePhy->GetSlSpectrumPhy () != 0)
+            {
+              currentStream += uePhy->GetSlSpectrumPhy ()->AssignStreams (currentStream);
+            }
+          currentStream += uePhy->AssignStreams (currentStream);
+          currentStream += ueDev->GetMac ()->AssignStreams (currentStream);
+        }
+    }
+  return (currentStream - stream);
+}
+
 /**
  * Compute the RSRP between the given nodes for the given propagation loss model
  * This code is derived from the multi-model-spectrum-channel class
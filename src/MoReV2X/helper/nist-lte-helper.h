@@ -376,6 +376,20 @@ public:
    */
   void InstallSidelinkConfiguration (Ptr<NetDevice> ueDevice, Ptr<LteUeRrcSl> slConfiguration);
 
+  /**
+   * Assign a fixed random variable stream number to the random variables used
+   * by the UE devices (sidelink spectrum phy, phy and MAC).
+   *
+   * The InstallUeDevice method should have previously been called by the user
+   * on the given devices.
+   *
+   * \param c NetDeviceContainer of the set of net devices for which the
+   *          NistLteUeNetDevice should be modified to use a fixed stream
+   * \param stream first stream index to use
+   * \return the number of stream indices (possibly zero) that have been assigned
+   */
+  int64_t AssignStreams (NetDeviceContainer c, int64_t stream);
+
   /**
    * Compute the RSRP between the given nodes for the given propagation loss model
    * This code is derived from the multi-model-spectrum-channel class. It can be used for both uplink and downlink
@@ -431,6 +445,12 @@ private:
    */
   Ptr<NetDevice> InstallSingleUeDevice (Ptr<Node> n);
 
+  /**
+   * Sink of the SignalDiscarded trace of the uplink channel: the receiving
+   * PHY accounts for the V2X SL signals dropped by the maximum coupling loss
+   */
+  static void SlSignalDiscarded (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb, double energy, Ptr<const SpectrumSignalParameters> txParams);
+
 
   /// The downlink LTE channel used in the simulation.
   Ptr<SpectrumChannel> m_downlinkChannel;
@@ -522,6 +542,9 @@ private:
    */
   bool m_sameUlDlPropagationCondition;
 
+  /// Whether SlSignalDiscarded is connected to the uplink channel
+  bool m_slSignalDiscardedConnected;
+
 }; // end of `class NistLteHelper`
 
 
@@ -0,0 +1,463 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#include "nr-v2x-trace-mobility-helper.h"
+
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/node.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrV2XTraceMobilityHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (NrV2XTraceMobilityHelper);
+
+NrV2XTraceMobilityHelper::NrV2XTraceMobilityHelper ()
+  : m_fcd (false),
+    m_endOfTrace (false),
+    m_parsedTime (0.0),
+    m_dropped (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+NrV2XTraceMobilityHelper::~NrV2XTraceMobilityHelper ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+NrV2XTraceMobilityHelper::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::NrV2XTraceMobilityHelper")
+    .SetParent<Object> ()
+    .AddConstructor<NrV2XTraceMobilityHelper> ()
+    .AddAttribute ("LookAhead",
+                   "How far in the future the trace is parsed and scheduled",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&NrV2XTraceMobilityHelper::m_lookAhead),
+                   MakeTimeChecker ())
+    .AddAttribute ("ParkingPosition",
+                   "Position of the free nodes of the pool. The i-th node is parked 1 km east of the (i-1)-th",
+                   VectorValue (Vector (-1e6, -1e6, 0)),
+                   MakeVectorAccessor (&NrV2XTraceMobilityHelper::m_parkingPosition),
+                   MakeVectorChecker ())
+  ;
+  return tid;
+}
+
+void
+NrV2XTraceMobilityHelper::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<EventId>::iterator it = m_stopEvents.begin (); it != m_stopEvents.end (); it++)
+    {
+      it->Cancel ();
+    }
+  m_pool.clear ();
+  m_trace.close ();
+  m_enterCallback = MakeNullCallback<void, uint32_t> ();
+  m_leaveCallback = MakeNullCallback<void, uint32_t> ();
+  Object::DoDispose ();
+}
+
+void
+NrV2XTraceMobilityHelper::SetEnterCallback (Callback<void, uint32_t> cb)
+{
+  m_enterCallback = cb;
+}
+
+void
+NrV2XTraceMobilityHelper::SetLeaveCallback (Callback<void, uint32_t> cb)
+{
+  m_leaveCallback = cb;
+}
+
+uint32_t
+NrV2XTraceMobilityHelper::GetDroppedVehicles (void) const
+{
+  return m_dropped;
+}
+
+void
+NrV2XTraceMobilityHelper::Install (std::string fileName, NodeContainer pool)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  m_trace.open (fileName.c_str ());
+  if (!m_trace.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open the mobility trace " << fileName);
+    }
+  m_fcd = (fileName.size () >= 4) && (fileName.compare (fileName.size () - 4, 4, ".xml") == 0);
+
+  for (uint32_t index = 0; index < pool.GetN (); index++)
+    {
+      Ptr<ConstantVelocityMobilityModel> mob = pool.Get (index)->GetObject<ConstantVelocityMobilityModel> ();
+      NS_ASSERT_MSG (mob != 0, "The nodes driven by the trace need a ConstantVelocityMobilityModel");
+      m_pool.push_back (mob);
+      m_stopEvents.push_back (EventId ());
+      mob->SetPosition (ParkingPosition (index));
+      mob->SetVelocity (Vector (0, 0, 0));
+    }
+  for (uint32_t index = pool.GetN (); index > 0; index--)
+    {
+      m_freeNodes.push_back (index - 1); // the first free node is at the back
+    }
+
+  ReadAhead ();
+}
+
+void
+NrV2XTraceMobilityHelper::ReadAhead (void)
+{
+  NS_LOG_FUNCTION (this);
+  Time horizon = Simulator::Now () + m_lookAhead;
+  while (true)
+    {
+      // The records in m_pending were parsed together (an FCD timestep, or an ns-2 setdest with the
+      // initial positions before it) and are scheduled together
+      if (!m_pending.empty ())
+        {
+          // Compared as Time, so that the next call is always in the future
+          if (Seconds (m_pending.front ().time) > horizon)
+            {
+              Simulator::Schedule (Seconds (m_pending.front ().time) - horizon, &NrV2XTraceMobilityHelper::ReadAhead, this);
+              return;
+            }
+          for (std::vector<Record>::iterator it = m_pending.begin (); it != m_pending.end (); it++)
+            {
+              Schedule (*it);
+            }
+          m_pending.clear ();
+        }
+      if (m_endOfTrace)
+        {
+          return;
+        }
+      m_endOfTrace = m_fcd ? !ReadFcdTimestep () : !ReadNs2Line ();
+    }
+}
+
+bool
+NrV2XTraceMobilityHelper::ReadAttribute (const std::string& line, std::string name, std::string* value)
+{
+  std::string key = " " + name + "=\"";
+  std::string::size_type start = line.find (key);
+  if (start == std::string::npos)
+    {
+      return false;
+    }
+  start += key.size ();
+  std::string::size_type end = line.find ('"', start);
+  if (end == std::string::npos)
+    {
+      return false;
+    }
+  *value = line.substr (start, end - start);
+  return true;
+}
+
+bool
+NrV2XTraceMobilityHelper::ReadFcdTimestep (void)
+{
+  std::string line, value;
+  std::vector<Record> vehicles;
+  std::set<std::string> present;
+  bool inTimestep = false;
+  double time = m_parsedTime;
+  while (std::getline (m_trace, line))
+    {
+      if (line.find ("<timestep") != std::string::npos)
+        {
+          if (!ReadAttribute (line, "time", &value))
+            {
+              NS_FATAL_ERROR ("Timestep without time in the FCD trace: " << line);
+            }
+          time = std::atof (value.c_str ());
+          inTimestep = true;
+          if (line.find ("/>") == std::string::npos)
+            {
+              continue;
+            }
+        }
+      else if (inTimestep && line.find ("<vehicle") != std::string::npos)
+        {
+          Record record;
+          record.time = time;
+          record.leave = false;
+          record.teleport = true;
+          record.position = Vector (0, 0, 0);
+          record.speed = 0.0;
+          record.angle = 0.0;
+          if (!ReadAttribute (line, "id", &record.vehicle))
+            {
+              NS_FATAL_ERROR ("Vehicle without id in the FCD trace: " << line);
+            }
+          if (ReadAttribute (line, "x", &value))
+            record.position.x = std::atof (value.c_str ());
+          if (ReadAttribute (line, "y", &value))
+            record.position.y = std::atof (value.c_str ());
+          if (ReadAttribute (line, "z", &value))
+            record.position.z = std::atof (value.c_str ());
+          if (ReadAttribute (line, "speed", &value))
+            record.speed = std::atof (value.c_str ());
+          if (ReadAttribute (line, "angle", &value))
+            record.angle = std::atof (value.c_str ());
+          present.insert (record.vehicle);
+          vehicles.push_back (record);
+          continue;
+        }
+      else if (line.find ("</timestep>") == std::string::npos)
+        {
+          continue;
+        }
+
+      // End of the timestep: the vehicles that are missing leave before the new ones enter
+      if (time < m_parsedTime)
+        {
+          NS_FATAL_ERROR ("The FCD trace is not sorted by time (" << time << " s after " << m_parsedTime << " s)");
+        }
+      m_parsedTime = time;
+      for (std::set<std::string>::iterator it = m_fcdPresent.begin (); it != m_fcdPresent.end (); it++)
+        {
+          if (present.find (*it) == present.end ())
+            {
+              Record record;
+              record.time = time;
+              record.vehicle = *it;
+              record.leave = true;
+              record.teleport = false;
+              record.speed = 0.0;
+              record.angle = 0.0;
+              m_pending.push_back (record);
+            }
+        }
+      m_pending.insert (m_pending.end (), vehicles.begin (), vehicles.end ());
+      m_fcdPresent.swap (present);
+      return true;
+    }
+  return false;
+}
+
+bool
+NrV2XTraceMobilityHelper::ReadNs2Line (void)
+{
+  std::string line;
+  while (std::getline (m_trace, line))
+    {
+      std::string::size_type nodeStart = line.find ("$node_(");
+      if (nodeStart == std::string::npos)
+        {
+          continue;
+        }
+      uint32_t node = std::atoi (line.c_str () + nodeStart + 7);
+      std::string::size_type command = line.find (')', nodeStart);
+      if (command == std::string::npos)
+        {
+          continue;
+        }
+      std::istringstream tokens (line.substr (command + 1));
+      std::string keyword;
+      tokens >> keyword;
+
+      std::string::size_type at = line.find ("$ns_ at ");
+      if ((at == std::string::npos) && (keyword == "set"))
+        {
+          // Initial position, applied together with the other coordinates of the node
+          std::string coordinate;
+          double value;
+          tokens >> coordinate >> value;
+          Vector& position = m_ns2Initial[node];
+          if (coordinate == "X_")
+            position.x = value;
+          else if (coordinate == "Y_")
+            position.y = value;
+          else if (coordinate == "Z_")
+            position.z = value;
+          continue;
+        }
+      if ((at == std::string::npos) || (keyword != "setdest"))
+        {
+          NS_LOG_LOGIC ("Skipping the ns-2 trace line " << line);
+          continue;
+        }
+      double time = std::atof (line.c_str () + at + 8);
+      if (time < m_parsedTime)
+        {
+          NS_FATAL_ERROR ("The ns-2 trace is not sorted by time (" << time << " s after " << m_parsedTime << " s)");
+        }
+      for (std::map<uint32_t, Vector>::iterator it = m_ns2Initial.begin (); it != m_ns2Initial.end (); it++)
+        {
+          Record record;
+          record.time = m_parsedTime;
+          record.vehicle = std::to_string (it->first);
+          record.leave = false;
+          record.teleport = true;
+          record.position = it->second;
+          record.speed = 0.0;
+          record.angle = 0.0;
+          m_pending.push_back (record);
+        }
+      m_ns2Initial.clear ();
+
+      Record record;
+      record.time = time;
+      record.vehicle = std::to_string (node);
+      record.leave = false;
+      record.teleport = false;
+      record.speed = 0.0;
+      record.angle = -1.0;
+      tokens >> record.position.x >> record.position.y >> record.speed;
+      m_parsedTime = time;
+      m_pending.push_back (record);
+      return true;
+    }
+
+  for (std::map<uint32_t, Vector>::iterator it = m_ns2Initial.begin (); it != m_ns2Initial.end (); it++)
+    {
+      Record record;
+      record.time = m_parsedTime;
+      record.vehicle = std::to_string (it->first);
+      record.leave = false;
+      record.teleport = true;
+      record.position = it->second;
+      record.speed = 0.0;
+      record.angle = 0.0;
+      m_pending.push_back (record);
+    }
+  m_ns2Initial.clear ();
+  return false;
+}
+
+void
+NrV2XTraceMobilityHelper::Schedule (Record record)
+{
+  Time delay = Seconds (record.time) - Simulator::Now ();
+  if (delay.IsNegative ())
+    {
+      delay = Seconds (0);
+    }
+
+  // The vehicles are bound while parsing: the records are in time order, so a node freed at t is reused from t on
+  std::map<std::string, uint32_t>::iterator it = m_bound.find (record.vehicle);
+  if (record.leave)
+    {
+      if (it != m_bound.end ())
+        {
+          m_freeNodes.push_back (it->second);
+          Simulator::Schedule (delay, &NrV2XTraceMobilityHelper::Leave, this, it->second);
+          m_bound.erase (it);
+        }
+      m_droppedVehicles.erase (record.vehicle);
+      return;
+    }
+
+  bool enter = false;
+  if (it == m_bound.end ())
+    {
+      if (m_droppedVehicles.find (record.vehicle) != m_droppedVehicles.end ())
+        {
+          return;
+        }
+      if (m_freeNodes.empty ())
+        {
+          NS_LOG_WARN ("No free node for vehicle " << record.vehicle << " at " << record.time << " s: dropped");
+          m_droppedVehicles.insert (record.vehicle);
+          m_dropped++;
+          return;
+        }
+      it = m_bound.insert (std::make_pair (record.vehicle, m_freeNodes.back ())).first;
+      m_freeNodes.pop_back ();
+      enter = true;
+    }
+  Simulator::Schedule (delay, &NrV2XTraceMobilityHelper::Apply, this, it->second, record, enter);
+}
+
+void
+NrV2XTraceMobilityHelper::Apply (uint32_t index, Record record, bool enter)
+{
+  NS_LOG_FUNCTION (this << index << record.vehicle);
+  Ptr<ConstantVelocityMobilityModel> mob = m_pool[index];
+  m_stopEvents[index].Cancel ();
+  if (record.teleport)
+    {
+      mob->SetPosition (record.position);
+      double angle = record.angle * M_PI / 180.0;
+      mob->SetVelocity (Vector (record.speed * std::sin (angle), record.speed * std::cos (angle), 0));
+    }
+  else
+    {
+      // ns-2 setdest: move towards the destination at the given speed, then stop
+      Vector position = mob->GetPosition ();
+      Vector destination = Vector (record.position.x, record.position.y, position.z);
+      double distance = CalculateDistance (position, destination);
+      if ((distance > 0) && (record.speed > 0))
+        {
+          mob->SetVelocity (Vector ((destination.x - position.x) * record.speed / distance,
+                                    (destination.y - position.y) * record.speed / distance, 0));
+          m_stopEvents[index] = Simulator::Schedule (Seconds (distance / record.speed), &NrV2XTraceMobilityHelper::Stop, this, index, destination);
+        }
+      else
+        {
+          mob->SetVelocity (Vector (0, 0, 0));
+        }
+    }
+  if (enter && !m_enterCallback.IsNull ())
+    {
+      m_enterCallback (mob->GetObject<Node> ()->GetId ());
+    }
+}
+
+Vector
+NrV2XTraceMobilityHelper::ParkingPosition (uint32_t index) const
+{
+  return Vector (m_parkingPosition.x + 1000.0 * index, m_parkingPosition.y, m_parkingPosition.z);
+}
+
+void
+NrV2XTraceMobilityHelper::Stop (uint32_t index, Vector destination)
+{
+  m_pool[index]->SetPosition (destination);
+  m_pool[index]->SetVelocity (Vector (0, 0, 0));
+}
+
+void
+NrV2XTraceMobilityHelper::Leave (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  Ptr<ConstantVelocityMobilityModel> mob = m_pool[index];
+  m_stopEvents[index].Cancel ();
+  mob->SetPosition (ParkingPosition (index));
+  mob->SetVelocity (Vector (0, 0, 0));
+  if (!m_leaveCallback.IsNull ())
+    {
+      m_leaveCallback (mob->GetObject<Node> ()->GetId ());
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,152 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#ifndef NR_V2X_TRACE_MOBILITY_HELPER_H
+#define NR_V2X_TRACE_MOBILITY_HELPER_H
+
+#include <ns3/object.h>
+#include <ns3/nstime.h>
+#include <ns3/vector.h>
+#include <ns3/callback.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+#include <ns3/constant-velocity-mobility-model.h>
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Drives a pool of V-UEs with a SUMO trace, read incrementally in time order.
+ *
+ * Two formats are supported, chosen by the file extension:
+ * - SUMO FCD output (.xml), one element per line. At every timestep the
+ *   vehicles are placed at the reported position and move with the
+ *   reported speed and angle. A vehicle enters at its first timestep and
+ *   leaves at the first timestep it is missing from;
+ * - ns-2 mobility traces (any other extension), as written by the SUMO
+ *   traceExporter: "$node_(i) set X_/Y_/Z_" and
+ *   "$ns_ at t "$node_(i) setdest x y speed"". A vehicle enters at its
+ *   first record and never leaves.
+ *
+ * The trace must be sorted by time. Only the records within LookAhead of
+ * the current simulation time are parsed and scheduled, so memory does not
+ * grow with the length of the trace.
+ *
+ * V-UEs cannot be created while the simulation runs, so the vehicles are
+ * bound to the nodes of a pool installed with ConstantVelocityMobilityModel.
+ * Free nodes are parked far away and still. The enter and leave callbacks
+ * report the binding, so that the scenario can enable the applications and
+ * release the channel state of the absent nodes. Vehicles entering when the
+ * pool is exhausted are dropped.
+ */
+class NrV2XTraceMobilityHelper : public Object
+{
+public:
+  NrV2XTraceMobilityHelper ();
+  virtual ~NrV2XTraceMobilityHelper ();
+
+  static TypeId GetTypeId (void);
+  virtual void DoDispose (void);
+
+  /**
+   * \param fileName the SUMO FCD (.xml) or ns-2 trace
+   * \param pool the nodes the vehicles are bound to
+   */
+  void Install (std::string fileName, NodeContainer pool);
+
+  /**
+   * \param cb called with the node ID when a vehicle is bound to the node
+   */
+  void SetEnterCallback (Callback<void, uint32_t> cb);
+
+  /**
+   * \param cb called with the node ID when the vehicle bound to the node leaves
+   */
+  void SetLeaveCallback (Callback<void, uint32_t> cb);
+
+  /**
+   * \return the number of vehicles dropped because the pool was exhausted
+   */
+  uint32_t GetDroppedVehicles (void) const;
+
+private:
+  struct Record
+  {
+    double time; // (s)
+    std::string vehicle;
+    bool leave;
+    bool teleport; // set the position, otherwise move towards it
+    Vector position;
+    double speed; // (m/s)
+    double angle; // (degrees, clockwise from north). Negative for ns-2 setdest
+  };
+
+  /**
+   * Parse the trace up to the look-ahead horizon and schedule the records
+   */
+  void ReadAhead (void);
+
+  /**
+   * \return false at the end of the trace
+   */
+  bool ReadFcdTimestep (void);
+  bool ReadNs2Line (void);
+
+  void Schedule (Record record);
+  void Apply (uint32_t index, Record record, bool enter);
+  void Stop (uint32_t index, Vector destination);
+  void Leave (uint32_t index);
+  Vector ParkingPosition (uint32_t index) const;
+
+  static bool ReadAttribute (const std::string& line, std::string name, std::string* value);
+
+  Time m_lookAhead;
+  Vector m_parkingPosition;
+
+  std::ifstream m_trace;
+  bool m_fcd;
+  bool m_endOfTrace;
+  double m_parsedTime; // time of the last parsed record (s)
+  std::vector<Record> m_pending; // parsed beyond the look-ahead horizon
+  std::map<uint32_t, Vector> m_ns2Initial; // ns-2 "set" positions not yet applied
+
+  std::vector<Ptr<ConstantVelocityMobilityModel> > m_pool;
+  std::vector<EventId> m_stopEvents; // end of the ns-2 setdest movements
+  std::vector<uint32_t> m_freeNodes; // pool indexes
+  std::map<std::string, uint32_t> m_bound; // vehicle -> pool index
+  std::set<std::string> m_droppedVehicles; // ignored until they leave
+  std::set<std::string> m_fcdPresent; // vehicles of the last FCD timestep
+  uint32_t m_dropped;
+
+  Callback<void, uint32_t> m_enterCallback;
+  Callback<void, uint32_t> m_leaveCallback;
+};
+
+} // namespace ns3
+
+#endif /* NR_V2X_TRACE_MOBILITY_HELPER_H */
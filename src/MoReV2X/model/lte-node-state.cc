@@ -23,6 +23,7 @@
 
 
 #include "ns3/lte-node-state.h"
+#include "ns3/simulator.h"
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -33,6 +34,7 @@ LTENodeState::LTENodeState (void) // sets the initial (default state)
 {
   m_vehicle = true;  // It's always a vehicle
   m_lastRcvPacketId = 0;
+  m_duplicateWindow = Seconds (1.0);
 }
 
 
@@ -42,6 +44,11 @@ LTENodeState::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::LTENodeState")
     .SetParent<Object> ()
     .AddConstructor<LTENodeState> ()
+    .AddAttribute ("DuplicateWindow",
+                   "Time a received packet is remembered for the duplicate detection, after its last reception",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&LTENodeState::m_duplicateWindow),
+                   MakeTimeChecker (Seconds (0)))
     /*.AddAttribute ("IsVehicle",
                    "Is the LTE node a vehicle UE?",
                    BooleanValue (true),
@@ -57,25 +64,56 @@ LTENodeState::GetInstanceTypeId (void) const
   return GetTypeId ();
 }
 
+void 
+LTENodeState::AddNewReceivedPacket (uint32_t source, uint32_t packetID)
+{
+  ExpireReceivedPackets ();
+  uint64_t key = ((uint64_t) source << 32) | packetID;
+  Time now = Simulator::Now ();
+  m_receivedPackets[key] = now;
+  m_receptionOrder.push_back (std::make_pair (now, key));
+}
+
+bool
+LTENodeState::HasReceivedPacket (uint32_t source, uint32_t packetID)
+{
+  ExpireReceivedPackets ();
+  uint64_t key = ((uint64_t) source << 32) | packetID;
+  return m_receivedPackets.find (key) != m_receivedPackets.end ();
+}
+
 void 
 LTENodeState::AddNewReceivedPacket (uint32_t packetID)
 {
-  m_receivedPacketIds.push_back(packetID);
+  AddNewReceivedPacket (0, packetID);
 }
 
 bool
 LTENodeState::HasReceivedPacket (uint32_t packetID)
 {
-  bool received = false;
-  for(std::vector<uint32_t>::iterator it = m_receivedPacketIds.begin(); it != m_receivedPacketIds.end(); ++it)
+  return HasReceivedPacket (0, packetID);
+}
+
+uint32_t
+LTENodeState::GetNReceivedPackets (void) const
+{
+  return m_receivedPackets.size ();
+}
+
+void
+LTENodeState::ExpireReceivedPackets (void)
+{
+  Time horizon = Simulator::Now () - m_duplicateWindow;
+  while (!m_receptionOrder.empty () && m_receptionOrder.front ().first < horizon)
   {
-     if(*it == packetID)
+     std::unordered_map<uint64_t, Time>::iterator it = m_receivedPackets.find (m_receptionOrder.front ().second);
+     // A packet received again is kept until its last reception expires
+     if (it != m_receivedPackets.end () && it->second == m_receptionOrder.front ().first)
      {
-        return true;
+        m_receivedPackets.erase (it);
      }
+     m_receptionOrder.pop_front ();
   }
-  
-  return received;
 }
 
 // Getters
@@ -26,6 +26,10 @@
 
 #include "ns3/vector.h"
 #include "ns3/node.h"
+#include "ns3/nstime.h"
+
+#include <deque>
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -37,8 +41,13 @@ class LTENodeState : public Object
       static TypeId GetTypeId (void);
       virtual TypeId GetInstanceTypeId (void) const; 
    
-      void AddNewReceivedPacket (uint32_t packetID);
-      bool HasReceivedPacket (uint32_t packetID);
+      // Duplicate detection: a packet is remembered for DuplicateWindow
+      // after its last reception, then forgotten
+      void AddNewReceivedPacket (uint32_t source, uint32_t packetID);
+      bool HasReceivedPacket (uint32_t source, uint32_t packetID);
+      void AddNewReceivedPacket (uint32_t packetID); // source 0
+      bool HasReceivedPacket (uint32_t packetID); // source 0
+      uint32_t GetNReceivedPackets (void) const; // packets currently remembered
       
       // Getters
       bool IsVehicle(void) const;
@@ -53,7 +62,11 @@ class LTENodeState : public Object
       bool m_vehicle;
       uint32_t m_lastRcvPacketId;
       Ptr<Node> m_node;
-      std::vector<uint32_t> m_receivedPacketIds;
+      void ExpireReceivedPackets (void);
+
+      Time m_duplicateWindow;
+      std::unordered_map<uint64_t, Time> m_receivedPackets; // (source, packet ID) -> last reception
+      std::deque<std::pair<Time, uint64_t> > m_receptionOrder; // receptions in time order, for the expiry
       
 };
 
@@ -51,6 +51,8 @@ NistEpcTftClassifier::Add (Ptr<NistEpcTft> tft, uint32_t id)
   NS_LOG_FUNCTION (this << tft);
   
   m_tftMap[id] = tft;  
+  m_uplinkFlows.clear ();
+  m_downlinkFlows.clear ();
   
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
@@ -61,6 +63,8 @@ NistEpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+  m_uplinkFlows.clear ();
+  m_downlinkFlows.clear ();
 }
 
  
@@ -68,98 +72,126 @@ uint32_t
 NistEpcTftClassifier::Classify (Ptr<Packet> p, NistEpcTft::Direction direction)
 {
   NS_LOG_FUNCTION (this << p << direction);
+  return Classify (GetFlow (p, direction), direction);
+}
 
-  Ptr<Packet> pCopy = p->Copy ();
-
-  Ipv4Header ipv4Header;
-  pCopy->RemoveHeader (ipv4Header);
+uint32_t 
+NistEpcTftClassifier::Classify (const Flow& flow, NistEpcTft::Direction direction)
+{
+  NS_LOG_FUNCTION (this << direction);
 
-  Ipv4Address localAddress;
-  Ipv4Address remoteAddress;
+  std::unordered_map<Flow, uint32_t, FlowHash>& flows = (direction == NistEpcTft::UPLINK) ? m_uplinkFlows : m_downlinkFlows;
+  std::unordered_map<Flow, uint32_t, FlowHash>::const_iterator cached = flows.find (flow);
+  if (cached != flows.end ())
+    {
+      return cached->second;
+    }
 
-  
-  if (direction ==  NistEpcTft::UPLINK)
+  uint32_t id = 0; // no match
+  Ipv4Address localAddress (flow.localAddress);
+  Ipv4Address remoteAddress (flow.remoteAddress);
+  if (flow.protocol != UdpL4Protocol::PROT_NUMBER && flow.protocol != TcpL4Protocol::PROT_NUMBER)
     {
-      localAddress = ipv4Header.GetSource ();
-      remoteAddress = ipv4Header.GetDestination ();
+      NS_LOG_INFO ("Unknown protocol: " << (uint16_t) flow.protocol);
     }
   else
-    { 
-      NS_ASSERT (direction ==  NistEpcTft::DOWNLINK);
-      remoteAddress = ipv4Header.GetSource ();
-      localAddress = ipv4Header.GetDestination ();      
+    {
+      NS_LOG_INFO ("Classifing packet:"
+                   << " localAddr="  << localAddress 
+                   << " remoteAddr=" << remoteAddress 
+                   << " localPort="  << flow.localPort 
+                   << " remotePort=" << flow.remotePort 
+                   << " tos=0x" << (uint16_t) flow.tos );
+
+      // now it is possible to classify the packet!
+      // we use a reverse iterator since filter priority is not implemented properly.
+      // This way, since the default bearer is expected to be added first, it will be evaluated last.
+      std::map <uint32_t, Ptr<NistEpcTft> >::const_reverse_iterator it;
+      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
+
+      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
+        {
+          NS_LOG_LOGIC ("TFT id: " << it->first );
+          NS_LOG_LOGIC (" Ptr<NistEpcTft>: " << it->second);
+          Ptr<NistEpcTft> tft = it->second;         
+          if (tft->Matches (direction, remoteAddress, localAddress, flow.remotePort, flow.localPort, flow.tos))
+            {
+              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
+              id = it->first; // the id of the matching TFT
+              break;
+            }
+        }
+      if (id == 0)
+        {
+          NS_LOG_LOGIC ("no match");
+        }
     }
-  
-  uint8_t protocol = ipv4Header.GetProtocol ();
 
-  uint8_t tos = ipv4Header.GetTos ();
-
-  uint16_t localPort = 0;
-  uint16_t remotePort = 0;
+  // The flows of the applications are few and long-lived. Bound the cache anyway, in case of many short TCP connections
+  if (flows.size () >= 4096)
+    {
+      flows.clear ();
+    }
+  flows[flow] = id;
+  return id;
+}
 
-  if (protocol == UdpL4Protocol::PROT_NUMBER)
+NistEpcTftClassifier::Flow
+NistEpcTftClassifier::GetFlow (Ptr<const Packet> p, NistEpcTft::Direction direction)
+{
+  // IPv4 header (up to 60 bytes with the options) and the ports of the transport header
+  uint8_t buffer[64];
+  uint32_t size = p->CopyData (buffer, sizeof (buffer));
+  NS_ASSERT_MSG (size >= 20 && (buffer[0] >> 4) == 4, "The outmost header is not an IPv4 header");
+  uint32_t headerLength = (buffer[0] & 0x0f) * 4;
+
+  uint32_t source = ((uint32_t) buffer[12] << 24) | ((uint32_t) buffer[13] << 16) | ((uint32_t) buffer[14] << 8) | buffer[15];
+  uint32_t destination = ((uint32_t) buffer[16] << 24) | ((uint32_t) buffer[17] << 16) | ((uint32_t) buffer[18] << 8) | buffer[19];
+  uint16_t sourcePort = 0;
+  uint16_t destinationPort = 0;
+
+  Flow flow;
+  flow.protocol = buffer[9];
+  flow.tos = buffer[1];
+  if ((flow.protocol == UdpL4Protocol::PROT_NUMBER || flow.protocol == TcpL4Protocol::PROT_NUMBER) && size >= headerLength + 4)
     {
-      UdpHeader udpHeader;
-      pCopy->RemoveHeader (udpHeader);
-
-      if (direction ==  NistEpcTft::UPLINK)
-	{
-	  localPort = udpHeader.GetSourcePort ();
-	  remotePort = udpHeader.GetDestinationPort ();
-	}
-      else
-	{
-	  remotePort = udpHeader.GetSourcePort ();
-	  localPort = udpHeader.GetDestinationPort ();
-	}
+      // UDP and TCP both start with the source and destination ports
+      sourcePort = (buffer[headerLength] << 8) | buffer[headerLength + 1];
+      destinationPort = (buffer[headerLength + 2] << 8) | buffer[headerLength + 3];
     }
-  else if (protocol == TcpL4Protocol::PROT_NUMBER)
+
+  if (direction ==  NistEpcTft::UPLINK)
     {
-      TcpHeader tcpHeader;
-      pCopy->RemoveHeader (tcpHeader);
-      if (direction ==  NistEpcTft::UPLINK)
-	{
-	  localPort = tcpHeader.GetSourcePort ();
-	  remotePort = tcpHeader.GetDestinationPort ();
-	}
-      else
-	{
-	  remotePort = tcpHeader.GetSourcePort ();
-	  localPort = tcpHeader.GetDestinationPort ();
-	}
+      flow.localAddress = source;
+      flow.remoteAddress = destination;
+      flow.localPort = sourcePort;
+      flow.remotePort = destinationPort;
     }
   else
-    {
-      NS_LOG_INFO ("Unknown protocol: " << protocol);
-      return 0;  // no match
+    { 
+      NS_ASSERT (direction ==  NistEpcTft::DOWNLINK);
+      flow.remoteAddress = source;
+      flow.localAddress = destination;
+      flow.remotePort = sourcePort;
+      flow.localPort = destinationPort;
     }
+  return flow;
+}
 
-  NS_LOG_INFO ("Classifing packet:"
-	       << " localAddr="  << localAddress 
-	       << " remoteAddr=" << remoteAddress 
-	       << " localPort="  << localPort 
-	       << " remotePort=" << remotePort 
-	       << " tos=0x" << (uint16_t) tos );
-
-  // now it is possible to classify the packet!
-  // we use a reverse iterator since filter priority is not implemented properly.
-  // This way, since the default bearer is expected to be added first, it will be evaluated last.
-  std::map <uint32_t, Ptr<NistEpcTft> >::const_reverse_iterator it;
-  NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
+bool
+NistEpcTftClassifier::Flow::operator== (const Flow& other) const
+{
+  return localAddress == other.localAddress && remoteAddress == other.remoteAddress
+         && localPort == other.localPort && remotePort == other.remotePort
+         && protocol == other.protocol && tos == other.tos;
+}
 
-  for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-    {
-      NS_LOG_LOGIC ("TFT id: " << it->first );
-      NS_LOG_LOGIC (" Ptr<NistEpcTft>: " << it->second);
-      Ptr<NistEpcTft> tft = it->second;         
-      if (tft->Matches (direction, remoteAddress, localAddress, remotePort, localPort, tos))
-        {
-	  NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-	  return it->first; // the id of the matching TFT
-        }
-    }
-  NS_LOG_LOGIC ("no match");
-  return 0;  // no match
+size_t
+NistEpcTftClassifier::FlowHash::operator() (const Flow& flow) const
+{
+  uint64_t addresses = ((uint64_t) flow.localAddress << 32) | flow.remoteAddress;
+  uint64_t rest = ((uint64_t) flow.localPort << 32) | ((uint64_t) flow.remotePort << 16) | ((uint64_t) flow.protocol << 8) | flow.tos;
+  return std::hash<uint64_t> () (addresses ^ (rest * 0x9e3779b97f4a7c15ULL));
 }
 
 
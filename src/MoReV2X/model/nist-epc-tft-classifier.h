@@ -28,6 +28,7 @@
 #include "ns3/nist-epc-tft.h"
 
 #include <map>
+#include <unordered_map>
 
 
 namespace ns3 {
@@ -43,6 +44,27 @@ class Packet;
 class NistEpcTftClassifier : public SimpleRefCount<NistEpcTftClassifier>
 {
 public:
+
+  /**
+   * The fields of an IP packet the TFTs are matched against. The addresses
+   * are in host byte order, as in Ipv4Address::Get ()
+   */
+  struct Flow
+  {
+    uint32_t localAddress;
+    uint32_t remoteAddress;
+    uint16_t localPort;
+    uint16_t remotePort;
+    uint8_t protocol;
+    uint8_t tos;
+
+    bool operator== (const Flow& other) const;
+  };
+
+  struct FlowHash
+  {
+    size_t operator() (const Flow& flow) const;
+  };
   
   NistEpcTftClassifier ();
   
@@ -70,10 +92,31 @@ public:
    * \return the identifier (>0) of the first TFT that matches with the IP packet; 0 if no TFT matched.
    */
   uint32_t Classify (Ptr<Packet> p, NistEpcTft::Direction direction);
+
+  /** 
+   * classify a flow. The outcome is cached until a TFT is added or deleted
+   * 
+   * \param flow the flow, as returned by GetFlow
+   * 
+   * \return the identifier (>0) of the first TFT that matches with the flow; 0 if no TFT matched.
+   */
+  uint32_t Classify (const Flow& flow, NistEpcTft::Direction direction);
+
+  /** 
+   * read the flow of an IP packet from the bytes of its IPv4 and UDP/TCP
+   * headers, without copying the packet. The ports of the other protocols are 0.
+   * 
+   * \param p the IP packet. It is assumed that the outmost header is an IPv4 header.
+   */
+  static Flow GetFlow (Ptr<const Packet> p, NistEpcTft::Direction direction);
   
 protected:
   
   std::map <uint32_t, Ptr<NistEpcTft> > m_tftMap;
+
+  // Outcome of the classification of the flows seen so far, per direction
+  std::unordered_map<Flow, uint32_t, FlowHash> m_uplinkFlows;
+  std::unordered_map<Flow, uint32_t, FlowHash> m_downlinkFlows;
   
 };
 
@@ -217,34 +217,22 @@ NistEpcUeNas::Send (Ptr<Packet> packet)
 
         //First Check if there is any sidelink bearer for the destination
         //otherwise it may use the default bearer 
-        Ptr<Packet> pCopy = packet->Copy ();
-        Ipv4Header ipv4Header;
-        pCopy->RemoveHeader (ipv4Header);
-
-
-        for (std::list<Ptr<NistSlTft> >::iterator it = m_slBearersActivatedList.begin ();
-             it != m_slBearersActivatedList.end ();
-             it++)
+        NistEpcTftClassifier::Flow flow = NistEpcTftClassifier::GetFlow (packet, NistEpcTft::UPLINK);
+        bool pending = false;
+        Ptr<NistSlTft> slTft = LookupSidelinkBearer (flow.remoteAddress, &pending);
+        if (slTft)
           {
-            if ((*it)->Matches(ipv4Header.GetDestination ())) {
-              //Found sidelink
-              m_asSapProvider->SendData (packet, (*it)->GetGroupL2Address());
-              return true;
-            }
+            //Found sidelink
+            m_asSapProvider->SendData (packet, slTft->GetGroupL2Address());
+            return true;
           }
-        //check if pending
-        for (std::list<Ptr<NistSlTft> >::iterator it = m_pendingSlBearersList.begin ();
-             it != m_pendingSlBearersList.end ();
-             it++)
+        if (pending)
           {
-            if ((*it)->Matches(ipv4Header.GetDestination ()))
-              {
-                NS_LOG_WARN (this << "Matching sidelink bearer still pending, discarding packet");
-                return false;
-              }
+            NS_LOG_WARN (this << "Matching sidelink bearer still pending, discarding packet");
+            return false;
           }
         //No sidelink found
-        uint32_t id = m_tftClassifier.Classify (packet, NistEpcTft::UPLINK);
+        uint32_t id = m_tftClassifier.Classify (flow, NistEpcTft::UPLINK);
         NS_ASSERT ((id & 0xFFFFFF00) == 0);
         uint8_t bid = (uint8_t) (id & 0x000000FF);
         if (bid == 0)
@@ -261,26 +249,15 @@ NistEpcUeNas::Send (Ptr<Packet> packet)
     case OFF:
       {
         //Check if there is any sidelink bearer for the destination
-        Ptr<Packet> pCopy = packet->Copy ();
-        Ipv4Header ipv4Header;
-        pCopy->RemoveHeader (ipv4Header);
-        
-     /*   NrV2XTag v2xTag;
-        if (pCopy -> FindFirstMatchingByteTag (v2xTag))
-        {
-             std::cout << "PPPP: " << (int) v2xTag.GetPPPP () << ", V2X Message Type: " << (int) v2xTag.GetMessageType () << "\r\n" ;
-        }*/
-
-        for (std::list<Ptr<NistSlTft> >::iterator it = m_slBearersActivatedList.begin ();
-             it != m_slBearersActivatedList.end ();
-             it++)
+        NistEpcTftClassifier::Flow flow = NistEpcTftClassifier::GetFlow (packet, NistEpcTft::UPLINK);
+        bool pending = false;
+        Ptr<NistSlTft> slTft = LookupSidelinkBearer (flow.remoteAddress, &pending);
+        if (slTft)
           {
-            if ((*it)->Matches(ipv4Header.GetDestination ())) {
-              //Found sidelink
-              m_asSapProvider->SendData (packet, (*it)->GetGroupL2Address());
-              return true;
-            }
-          } 
+            //Found sidelink
+            m_asSapProvider->SendData (packet, slTft->GetGroupL2Address());
+            return true;
+          }
       }
     default:
       NS_LOG_WARN (this << " NAS NOT OFF or ACTIVE, or sidelink bearer not found, discarding packet");
@@ -290,6 +267,48 @@ NistEpcUeNas::Send (Ptr<Packet> packet)
 
 }
 
+Ptr<NistSlTft>
+NistEpcUeNas::LookupSidelinkBearer (uint32_t destination, bool* pending)
+{
+  *pending = false;
+  std::unordered_map<uint32_t, Ptr<NistSlTft> >::const_iterator cached = m_slBearerCache.find (destination);
+  if (cached != m_slBearerCache.end ())
+    {
+      return cached->second;
+    }
+
+  Ipv4Address address (destination);
+  for (std::list<Ptr<NistSlTft> >::iterator it = m_slBearersActivatedList.begin ();
+       it != m_slBearersActivatedList.end ();
+       it++)
+    {
+      if ((*it)->Matches (address))
+        {
+          m_slBearerCache[destination] = *it;
+          return *it;
+        }
+    }
+  //check if pending. Not cached, the bearer is activated soon
+  for (std::list<Ptr<NistSlTft> >::iterator it = m_pendingSlBearersList.begin ();
+       it != m_pendingSlBearersList.end ();
+       it++)
+    {
+      if ((*it)->Matches (address))
+        {
+          *pending = true;
+          return 0;
+        }
+    }
+  m_slBearerCache[destination] = 0;
+  return 0;
+}
+
+void
+NistEpcUeNas::InvalidateSidelinkBearerCache (void)
+{
+  m_slBearerCache.clear ();
+}
+
 void 
 NistEpcUeNas::DoNotifyConnectionSuccessful ()
 {
@@ -372,6 +391,7 @@ NistEpcUeNas::ActivateSidelinkBearer (Ptr<NistSlTft> tft)
   //for in coverage case, it will trigger communication with the eNodeb
   //for out of coverage, it will trigger the use of preconfiguration
   m_pendingSlBearersList.push_back (tft);
+  InvalidateSidelinkBearerCache ();
   m_asSapProvider->ActivateSidelinkRadioBearer (tft->GetGroupL2Address(), tft->isTransmit(), tft->isReceive()); 
 }
 
@@ -388,6 +408,7 @@ NistEpcUeNas::DeactivateSidelinkBearer (Ptr<NistSlTft> tft)
         //found the sidelink to remove
         m_asSapProvider->DeactivateSidelinkRadioBearer (tft->GetGroupL2Address());
         m_slBearersActivatedList.erase (it);
+        InvalidateSidelinkBearerCache ();
         break;
       }
     } 
@@ -405,6 +426,7 @@ NistEpcUeNas::DoNotifySidelinkRadioBearerActivated (uint32_t group)
         //Found sidelink
         m_slBearersActivatedList.push_back (*it);
         it = m_pendingSlBearersList.erase (it);
+        InvalidateSidelinkBearerCache ();
       } else {
         it++; 
       }
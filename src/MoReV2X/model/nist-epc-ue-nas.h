@@ -27,6 +27,7 @@
 #include <ns3/nist-epc-tft-classifier.h>
 #include <ns3/nist-sl-tft.h>
 #include <map>
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -36,6 +37,7 @@ class NistEpcHelper;
 class NistEpcUeNas : public Object
 {
   friend class NistMemberLteAsSapUser<NistEpcUeNas>;
+  friend class NrV2XTestAccess; // unit tests, see test/nr-v2x-test-access.h
 public:
 
   /** 
@@ -223,6 +225,19 @@ private:
    */
   void SwitchToState (State s);
 
+  /**
+   * Look up the activated sidelink bearer of a destination, caching the outcome
+   * \param destination the destination address (host byte order)
+   * \param pending set to true if the only matching bearer is still being setup
+   * \return the bearer, or 0 if there is none
+   */
+  Ptr<NistSlTft> LookupSidelinkBearer (uint32_t destination, bool* pending);
+
+  /**
+   * Forget the sidelink bearers looked up so far, when the bearers change
+   */
+  void InvalidateSidelinkBearerCache (void);
+
   /// The current UE NAS state.
   State m_state;
 
@@ -264,6 +279,9 @@ private:
   //Sidelink bearers activated
   std::list<Ptr<NistSlTft> > m_slBearersActivatedList;
 
+  //Activated sidelink bearer of the destinations seen so far (0 if none)
+  std::unordered_map<uint32_t, Ptr<NistSlTft> > m_slBearerCache;
+
 };
 
 
@@ -48,7 +48,7 @@ NistLteHarqPhy::~NistLteHarqPhy ()
 {
   m_miDlHarqProcessesInfoMap.clear ();
   m_miUlHarqProcessesInfoMap.clear ();
-  m_miSlHarqProcessesInfoMap.clear ();
+  m_slHarqProcesses.clear ();
 }
 
 
@@ -279,22 +279,24 @@ NistLteHarqPhy::ResetUlHarqProcessNistStatus (uint16_t rnti, uint8_t id)
 }
 
 
+uint32_t
+NistLteHarqPhy::GetSlHarqProcessKey (uint16_t rnti, uint8_t l1dst)
+{
+  return ((uint32_t) rnti << 8) | l1dst;
+}
+
 double
 NistLteHarqPhy::GetAccumulatedMiSl (uint16_t rnti, uint8_t l1dst)
 {
   NS_LOG_FUNCTION (this << rnti);
 
-  std::map <uint16_t, std::map <uint8_t, HarqProcessInfoList_t> >::iterator it;
-  it = m_miSlHarqProcessesInfoMap.find (rnti);
-  NS_ASSERT_MSG (it!=m_miSlHarqProcessesInfoMap.end (), " Does not find MI for RNTI");
-  std::map <uint8_t, HarqProcessInfoList_t>::iterator it2;
-  it2 = it->second.find (l1dst);
-  NS_ASSERT_MSG (it2!=it->second.end (), " Does not find MI for l1dst ");
-  HarqProcessInfoList_t list = (*it2).second;
+  std::unordered_map <uint32_t, NistSlHarqProcessInfo_t>::const_iterator it;
+  it = m_slHarqProcesses.find (GetSlHarqProcessKey (rnti, l1dst));
+  NS_ASSERT_MSG (it!=m_slHarqProcesses.end (), " Does not find MI for RNTI and l1dst");
   double mi = 0.0;
-  for (uint8_t i = 0; i < list.size (); i++)
+  for (uint8_t i = 0; i < it->second.size (); i++)
     {
-      mi += list.at (i).m_mi;
+      mi += it->second.at (i).m_mi;
     }
   return (mi);
 }
@@ -303,34 +305,22 @@ HarqProcessInfoList_t
 NistLteHarqPhy::GetHarqProcessInfoSl (uint16_t rnti, uint8_t l1dst)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)l1dst);
-  std::map <uint16_t, std::map <uint8_t, HarqProcessInfoList_t> >::iterator it;
-  it = m_miSlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miSlHarqProcessesInfoMap.end ())
-    {
-      // new entry
-      HarqProcessInfoList_t harqInfo;
-      std::map <uint8_t, HarqProcessInfoList_t> map;
-      map.insert (std::pair <uint8_t, HarqProcessInfoList_t> (l1dst, harqInfo));
-      m_miSlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::map <uint8_t, HarqProcessInfoList_t> > (rnti, map));
-      return (harqInfo);
-    }
-  else
+  const NistSlHarqProcessInfo_t& info = GetSlHarqProcessInfo (rnti, l1dst);
+  return HarqProcessInfoList_t (info.m_tx, info.m_tx + info.m_nTx);
+}
+
+const NistSlHarqProcessInfo_t&
+NistLteHarqPhy::GetSlHarqProcessInfo (uint16_t rnti, uint8_t l1dst) const
+{
+  NS_LOG_FUNCTION (this << rnti << (uint16_t)l1dst);
+  static const NistSlHarqProcessInfo_t empty = {0, {}};
+  std::unordered_map <uint32_t, NistSlHarqProcessInfo_t>::const_iterator it;
+  it = m_slHarqProcesses.find (GetSlHarqProcessKey (rnti, l1dst));
+  if (it == m_slHarqProcesses.end ())
     {
-      //entry here, check ls1dst
-      std::map <uint8_t, HarqProcessInfoList_t>::iterator it2;
-      it2 = it->second.find (l1dst);
-      if (it2==it->second.end ())
-        {
-          HarqProcessInfoList_t harqInfo;
-          std::map <uint8_t, HarqProcessInfoList_t> map;
-          it->second.insert (std::pair <uint8_t, HarqProcessInfoList_t> (l1dst, harqInfo));
-          return (harqInfo);
-        }
-      else
-        {
-          return ((*it2).second);
-        }
+      return empty;
     }
+  return it->second;
 }
 
 HarqProcessInfoList_t
@@ -368,108 +358,42 @@ NistLteHarqPhy::GetHarqProcessInfoDisc (uint16_t rnti, uint8_t resPsdch)
 }
 
 void
-NistLteHarqPhy::UpdateSlHarqProcessNistStatus (uint16_t rnti, uint8_t l1dst, double mi, uint16_t infoBytes, uint16_t codeBytes)
+NistLteHarqPhy::AddSlHarqTransmission (uint16_t rnti, uint8_t l1dst, const NistHarqProcessInfoElement_t& el)
 {
-  NS_LOG_FUNCTION (this << rnti << mi);
-  std::map <uint16_t, std::map <uint8_t, HarqProcessInfoList_t> >::iterator it;
-  std::map <uint8_t, HarqProcessInfoList_t>::iterator it2;
-  
-  it = m_miSlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miSlHarqProcessesInfoMap.end ())
-    {
-      // new entry
-      HarqProcessInfoList_t harqInfo;
-      NistHarqProcessInfoElement_t el;
-      el.m_mi = mi;
-      el.m_infoBits = infoBytes * 8;
-      el.m_codeBits = codeBytes * 8;
-      harqInfo.push_back (el);
-      std::map <uint8_t, HarqProcessInfoList_t> map;
-      map.insert (std::pair <uint8_t, HarqProcessInfoList_t> (l1dst, harqInfo));
-      m_miSlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::map <uint8_t, HarqProcessInfoList_t> > (rnti, map));
-    }
-  else
+  // operator[] creates the missing processes with no transmission
+  NistSlHarqProcessInfo_t& info = m_slHarqProcesses[GetSlHarqProcessKey (rnti, l1dst)];
+  if (info.m_nTx == NistSlHarqProcessInfo_t::MAX_TX)
     {
-      it2 = it->second.find (l1dst);
-      if (it2 == it->second.end())
-        {
-          // new entry
-          HarqProcessInfoList_t harqInfo;
-          NistHarqProcessInfoElement_t el;
-          el.m_mi = mi;
-          el.m_infoBits = infoBytes * 8;
-          el.m_codeBits = codeBytes * 8;
-          harqInfo.push_back (el);
-          (*it).second.insert (std::pair <uint8_t, HarqProcessInfoList_t> (l1dst, harqInfo));
-        }
-      else
-        {
-          if ((*it2).second.size () == 3) // MAX HARQ RETX
-            {
-              // HARQ should be disabled -> discard info
-              return;
-            }
-          NistHarqProcessInfoElement_t el;
-          el.m_mi = mi;
-          el.m_infoBits = infoBytes * 8;
-          el.m_codeBits = codeBytes * 8;
-          (*it2).second.push_back (el);
-        }
+      // HARQ should be disabled -> discard info
+      return;
     }
+  info.m_tx[info.m_nTx++] = el;
+}
+
+void
+NistLteHarqPhy::UpdateSlHarqProcessNistStatus (uint16_t rnti, uint8_t l1dst, double mi, uint16_t infoBytes, uint16_t codeBytes)
+{
+  NS_LOG_FUNCTION (this << rnti << mi);
+  NistHarqProcessInfoElement_t el;
+  el.m_mi = mi;
+  el.m_rv = 0;
+  el.m_infoBits = infoBytes * 8;
+  el.m_codeBits = codeBytes * 8;
+  el.m_sinr = 0;
+  AddSlHarqTransmission (rnti, l1dst, el);
 }
 
 void
 NistLteHarqPhy::UpdateSlHarqProcessNistStatus (uint16_t rnti, uint8_t l1dst, double sinr)
 {
   NS_LOG_FUNCTION (this << rnti << sinr);
-  std::map <uint16_t, std::map <uint8_t, HarqProcessInfoList_t> >::iterator it;
-  std::map <uint8_t, HarqProcessInfoList_t>::iterator it2;
-  
-  it = m_miSlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miSlHarqProcessesInfoMap.end ())
-    {
-      // new entry
-      HarqProcessInfoList_t harqInfo;
-      NistHarqProcessInfoElement_t el;
-      el.m_mi = 0;
-      el.m_infoBits = 0;
-      el.m_codeBits = 0;
-      el.m_sinr = sinr;
-      harqInfo.push_back (el);
-      std::map <uint8_t, HarqProcessInfoList_t> map;
-      map.insert (std::pair <uint8_t, HarqProcessInfoList_t> (l1dst, harqInfo));
-      m_miSlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::map <uint8_t, HarqProcessInfoList_t> > (rnti, map));
-    }
-  else
-    {
-      it2 = it->second.find (l1dst);
-      if (it2 == it->second.end())
-        {
-          // new entry
-          HarqProcessInfoList_t harqInfo;
-          NistHarqProcessInfoElement_t el;
-          el.m_mi = 0;
-          el.m_infoBits = 0;
-          el.m_codeBits = 0;
-          el.m_sinr = sinr;
-          harqInfo.push_back (el);
-          (*it).second.insert (std::pair <uint8_t, HarqProcessInfoList_t> (l1dst, harqInfo));
-        }
-      else
-        {
-          if ((*it2).second.size () == 3) // MAX HARQ RETX
-            {
-              // HARQ should be disabled -> discard info
-              return;
-            }
-          NistHarqProcessInfoElement_t el;
-          el.m_mi = 0;
-          el.m_infoBits = 0;
-          el.m_codeBits = 0;
-          el.m_sinr = sinr;
-          (*it2).second.push_back (el);
-        }
-    }
+  NistHarqProcessInfoElement_t el;
+  el.m_mi = 0;
+  el.m_rv = 0;
+  el.m_infoBits = 0;
+  el.m_codeBits = 0;
+  el.m_sinr = sinr;
+  AddSlHarqTransmission (rnti, l1dst, el);
 }
 
 void
@@ -532,31 +456,7 @@ void
 NistLteHarqPhy::ResetSlHarqProcessNistStatus (uint16_t rnti, uint8_t l1dst)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)l1dst);
-  std::map <uint16_t, std::map <uint8_t, HarqProcessInfoList_t> >::iterator it;
-  std::map <uint8_t, HarqProcessInfoList_t>::iterator it2;
-  it = m_miSlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miSlHarqProcessesInfoMap.end ())
-    {
-      // new entry
-      HarqProcessInfoList_t harqInfo;
-      std::map <uint8_t, HarqProcessInfoList_t> map;
-      map.insert (std::pair <uint8_t, HarqProcessInfoList_t> (l1dst, harqInfo));
-      m_miSlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::map <uint8_t, HarqProcessInfoList_t> > (rnti, map));
-    }
-  else
-    {
-      it2 = (*it).second.find (l1dst);
-      if (it2 == (*it).second.end())
-        {
-          HarqProcessInfoList_t harqInfo;
-          std::map <uint8_t, HarqProcessInfoList_t> map;
-          it->second.insert (std::pair <uint8_t, HarqProcessInfoList_t> (l1dst, harqInfo));
-        }
-      else
-        {
-          (*it2).second.clear ();
-        }
-    }
+  m_slHarqProcesses[GetSlHarqProcessKey (rnti, l1dst)].m_nTx = 0;
 }
 
 void
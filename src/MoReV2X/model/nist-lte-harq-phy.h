@@ -30,6 +30,7 @@
 #include <math.h>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <ns3/simple-ref-count.h>
 
 
@@ -48,6 +49,29 @@ struct NistHarqProcessInfoElement_t
 
 typedef std::vector <NistHarqProcessInfoElement_t> HarqProcessInfoList_t;
 
+/**
+ * Info of a sidelink HARQ process, stored in place: at most MAX_TX
+ * transmissions are combined
+ */
+struct NistSlHarqProcessInfo_t
+{
+  static const uint8_t MAX_TX = 3; // MAX HARQ RETX
+
+  uint8_t m_nTx; // transmissions stored
+  NistHarqProcessInfoElement_t m_tx[MAX_TX];
+
+  uint8_t size (void) const
+  {
+    return m_nTx;
+  }
+
+  const NistHarqProcessInfoElement_t& at (uint8_t i) const
+  {
+    NS_ASSERT_MSG (i < m_nTx, "No HARQ transmission " << (uint16_t) i);
+    return m_tx[i];
+  }
+};
+
 /**
  * \ingroup lte
  * \brief The NistLteHarqPhy class implements the HARQ functionalities related to PHY layer
@@ -168,6 +192,15 @@ public:
   * \return the vector of the info related to HARQ proc Id
   */
   HarqProcessInfoList_t GetHarqProcessInfoSl (uint16_t rnti, uint8_t l1dst);
+
+  /**
+  * \brief Return the info of the HARQ process in case of retransmissions
+  * for SL, without copying it
+  * \param rnti the RNTI of the transmitter
+  * \param l1dst The layer 1 destination ID
+  * \return the info of the HARQ process, empty if it does not exist
+  */
+  const NistSlHarqProcessInfo_t& GetSlHarqProcessInfo (uint16_t rnti, uint8_t l1dst) const;
  
   /**
   * \brief Return the info of the HARQ procId in case of retranmissions
@@ -226,7 +259,10 @@ private:
 
   std::vector <std::vector <HarqProcessInfoList_t> > m_miDlHarqProcessesInfoMap;
   std::map <uint16_t, std::vector <HarqProcessInfoList_t> > m_miUlHarqProcessesInfoMap;
-  std::map <uint16_t, std::map <uint8_t , HarqProcessInfoList_t> > m_miSlHarqProcessesInfoMap;
+  static uint32_t GetSlHarqProcessKey (uint16_t rnti, uint8_t l1dst);
+  void AddSlHarqTransmission (uint16_t rnti, uint8_t l1dst, const NistHarqProcessInfoElement_t& el);
+
+  std::unordered_map <uint32_t, NistSlHarqProcessInfo_t> m_slHarqProcesses; // (rnti, l1dst) -> process
   std::map <uint16_t, std::map <uint8_t , HarqProcessInfoList_t> > m_miDiscHarqProcessesInfoMap;  
     
   uint8_t m_discNumRetx;
@@ -28,6 +28,7 @@
 #include "nist-lte-phy.h"
 #include "nist-lte-net-device.h"
 #include <ns3/double.h>
+#include "nr-v2x-console.h"
 
 namespace ns3 {
 
@@ -195,7 +196,7 @@ void
 NistLtePhy::SetMacPdu (Ptr<Packet> p)
 {
   m_packetBurstQueue.at (m_packetBurstQueue.size () - 1)->AddPacket (p);
-  NS_LOG_UNCOND("NistLtePhy::SetMacPdu (Ptr<Packet> p) - added new packet to the burst, packetSize: " << p->GetSize());
+  NR_V2X_CONSOLE (VERBOSE, "NistLtePhy::SetMacPdu (Ptr<Packet> p) - added new packet to the burst, packetSize: " << p->GetSize());
 }
 
 Ptr<PacketBurst>
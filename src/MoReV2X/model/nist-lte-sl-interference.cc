@@ -25,6 +25,9 @@
 
 #include <ns3/simulator.h>
 #include <ns3/log.h>
+#include "nr-v2x-profiler.h"
+
+#include <algorithm>
 
 
 namespace ns3 {
@@ -33,6 +36,7 @@ NS_LOG_COMPONENT_DEFINE ("NistLteSlInterference");
 
 NistLteSlInterference::NistLteSlInterference ()
   : m_receiving (false),
+    m_lazySinr (false),
     m_lastSignalId (0),
     m_lastSignalIdBeforeReset (0)
 {
@@ -52,6 +56,7 @@ NistLteSlInterference::DoDispose ()
   m_sinrChunkProcessorList.clear ();
   m_interfChunkProcessorList.clear ();
   m_rxSignal.clear();
+  m_chunks.clear ();
   m_allSignals = 0;
   m_noise = 0;
   Object::DoDispose ();
@@ -77,6 +82,7 @@ NistLteSlInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
   if (m_receiving == false) {
     NS_LOG_LOGIC ("first signal");//Still check that receiving multiple simultaneous signals, make sure they are synchronized
     m_rxSignal.clear ();
+    m_chunks.clear ();
     m_receiving = true;
   } else {
     NS_LOG_LOGIC ("additional signal (Nb simultaneous Rx = " << m_rxSignal.size() << ")");
@@ -86,6 +92,12 @@ NistLteSlInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
   //In sidelink, each packet must be monitored seperatly
   m_rxSignal.push_back (rxPsd->Copy ());
   m_lastChangeTime = Now ();
+
+  if (m_lazySinr)
+    {
+      // the SINR will be computed by EvaluateSinr, if needed
+      return;
+    }
   
   //trigger the initialization of each chunk processor 
   for (std::list<Ptr<NistLteSlChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
@@ -114,6 +126,10 @@ NistLteSlInterference::EndRx ()
     {
       ConditionallyEvaluateChunk ();
       m_receiving = false;
+      if (m_lazySinr)
+        {
+          return;
+        }
       for (std::list<Ptr<NistLteSlChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
         {
           (*it)->End ();
@@ -178,12 +194,24 @@ void
 NistLteSlInterference::ConditionallyEvaluateChunk ()
 {
   NS_LOG_FUNCTION (this);
+  NR_V2X_PROFILE_SCOPE (EVALUATE_CHUNK);
   if (m_receiving)
     {
       NS_LOG_DEBUG (this << " Receiving");
     }
   NS_LOG_DEBUG (this << " now "  << Now () << " last " << m_lastChangeTime);
-  if (m_receiving && (Now () > m_lastChangeTime))
+  if (m_receiving && (Now () > m_lastChangeTime) && m_lazySinr)
+    {
+      // only store the total power perceived: the SINR of each signal is
+      // evaluated later, and only for the signals that need it
+      NistLteSlInterferenceChunk chunk;
+      chunk.m_allSignals = m_allSignals->Copy ();
+      chunk.m_noise = m_noise;
+      chunk.m_duration = Now () - m_lastChangeTime;
+      m_chunks.push_back (chunk);
+      m_lastChangeTime = Now ();
+    }
+  else if (m_receiving && (Now () > m_lastChangeTime))
     {
       //compute values for each signal being received
       for (uint32_t index = 0 ; index < m_rxSignal.size() ; index++)
@@ -230,6 +258,81 @@ NistLteSlInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> no
   m_lastSignalIdBeforeReset = m_lastSignalId;
 }
 
+void
+NistLteSlInterference::SetLazySinrEvaluation (bool lazy)
+{
+  NS_LOG_FUNCTION (this << lazy);
+  NS_ASSERT_MSG (!m_receiving, "Cannot change the SINR evaluation mode during a reception");
+  m_lazySinr = lazy;
+}
+
+SpectrumValue
+NistLteSlInterference::EvaluateSinr (uint32_t index) const
+{
+  NS_LOG_FUNCTION (this << index);
+  std::vector<double> values;
+  EvaluateSinr (index, values);
+  SpectrumValue sinr (m_rxSignal[index]->GetSpectrumModel ());
+  std::copy (values.begin (), values.end (), sinr.ValuesBegin ());
+  return sinr;
+}
+
+void
+NistLteSlInterference::EvaluateSinr (uint32_t index, std::vector<double>& sinr) const
+{
+  // No logging here: this can run outside of the simulator thread
+  NS_ASSERT_MSG (m_lazySinr, "The SINR is evaluated by the chunk processors");
+  NS_ASSERT_MSG (index < m_rxSignal.size (), "No signal with index " << index);
+  NS_ASSERT_MSG (!m_chunks.empty (), "No chunk was evaluated for the last reception");
+
+  const SpectrumValue& signal = *PeekPointer (m_rxSignal[index]);
+  size_t numBands = signal.ConstValuesEnd () - signal.ConstValuesBegin ();
+  std::vector<double> sum (numBands, 0.0);
+  Time totDuration = MicroSeconds (0);
+  // Same operations (and order) as the SINR chunk processor, restricted to the
+  // RBs where the signal is present: elsewhere the SINR is zero anyway
+  for (std::vector<NistLteSlInterferenceChunk>::const_iterator it = m_chunks.begin (); it != m_chunks.end (); ++it)
+    {
+      const SpectrumValue& allSignals = *PeekPointer (it->m_allSignals);
+      const SpectrumValue& noise = *PeekPointer (it->m_noise);
+      double duration = it->m_duration.GetSeconds ();
+      for (size_t rb = 0; rb < numBands; rb++)
+        {
+          if (signal[rb] != 0)
+            {
+              double interf = (allSignals[rb] - signal[rb]) + noise[rb];
+              sum[rb] += (signal[rb] / interf) * duration;
+            }
+        }
+      totDuration += it->m_duration;
+    }
+
+  sinr.assign (numBands, 0.0);
+  double totSeconds = totDuration.GetSeconds ();
+  for (size_t rb = 0; rb < numBands; rb++)
+    {
+      if (signal[rb] != 0)
+        {
+          sinr[rb] = sum[rb] / totSeconds;
+        }
+    }
+}
+
+void
+NistLteSlInterference::PrepareSinrEvaluation ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_lazySinr, "The SINR is evaluated by the chunk processors");
+  // A chunk stored now is the same the EndRx at the same time would store
+  ConditionallyEvaluateChunk ();
+}
+
+uint32_t
+NistLteSlInterference::GetNSignals (void) const
+{
+  return m_rxSignal.size ();
+}
+
 void
 NistLteSlInterference::AddRsPowerChunkProcessor (Ptr<NistLteSlChunkProcessor> p)
 {
@@ -111,6 +111,48 @@ public:
    */
   void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
 
+  /**
+   * Enable or disable the lazy evaluation of the SINR. When enabled, the
+   * chunk processors are bypassed: only the total received power of each
+   * chunk is stored, and the SINR of a signal is computed by EvaluateSinr
+   * when (and if) the receiver asks for it.
+   *
+   * @param lazy true to defer the SINR evaluation
+   */
+  void SetLazySinrEvaluation (bool lazy);
+
+  /**
+   * Compute the time-averaged SINR of a signal of the last reception.
+   * Only the RBs occupied by the signal are evaluated, the others are left
+   * to zero. Values are identical to the ones returned by the SINR chunk
+   * processor over the same RBs.
+   *
+   * @param index the index of the signal (order of the StartRx calls)
+   * @return the SINR of the signal
+   */
+  SpectrumValue EvaluateSinr (uint32_t index) const;
+
+  /**
+   * Same as EvaluateSinr, but the values are written to a plain vector
+   * (one per RB), so that several signals can be evaluated concurrently:
+   * no reference counted object is created or copied.
+   *
+   * @param index the index of the signal (order of the StartRx calls)
+   * @param sinr the SINR of the signal
+   */
+  void EvaluateSinr (uint32_t index, std::vector<double>& sinr) const;
+
+  /**
+   * Store the chunk ending now, if any, so that EvaluateSinr can be called
+   * before EndRx. Has no effect on the outcome of the reception.
+   */
+  void PrepareSinrEvaluation ();
+
+  /**
+   * @return the number of signals of the current (or last) reception
+   */
+  uint32_t GetNSignals (void) const;
+
 private:
   void ConditionallyEvaluateChunk ();
   void DoAddSignal  (Ptr<const SpectrumValue> spd);
@@ -118,6 +160,22 @@ private:
 
    bool m_receiving;
 
+  /** Total power and noise perceived during a chunk, stored when the SINR
+      evaluation is deferred */
+  struct NistLteSlInterferenceChunk
+  {
+    Ptr<SpectrumValue> m_allSignals; //!< sum of the incoming signals
+    Ptr<const SpectrumValue> m_noise; //!< noise PSD
+    Time m_duration; //!< duration of the chunk
+  };
+
+  bool m_lazySinr;
+
+  std::vector<NistLteSlInterferenceChunk> m_chunks; /**< chunks of the
+                                                     * current (or last)
+                                                     * reception
+                                                     */
+
   std::vector <Ptr<SpectrumValue> > m_rxSignal; /**< stores the power spectral density of
                                   * the signal whose RX is being
                                   * attempted
@@ -42,6 +42,7 @@
 #include <iostream>
 
 #include "ns3/nr-v2x-tag.h"
+#include "ns3/nr-v2x-console.h"
 
 
 namespace ns3 {
@@ -937,7 +938,8 @@ NistLteUeRrc::DoActivateSidelinkRadioBearer (uint32_t group, bool tx, bool rx)
     case IDLE_WAIT_SIB1:
     case IDLE_CAMPED_NORMALLY:
       NS_LOG_INFO ("Considering out of network");
-      std::cout << "IMSI " << m_imsi << " considered out of network" << std::endl;
+      if (NrV2XConsole::IsEnabled (NrV2XConsole::INFO))
+        std::cout << "IMSI " << m_imsi << " considered out of network" << std::endl;
 
       if (m_rnti == 0)
         {
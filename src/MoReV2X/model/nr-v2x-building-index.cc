@@ -0,0 +1,274 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#include "nr-v2x-building-index.h"
+
+#include <ns3/log.h>
+#include <ns3/building-list.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrV2XBuildingIndex");
+
+NrV2XBuildingIndex::NrV2XBuildingIndex ()
+  : m_cellSize (0),
+    m_xMin (0),
+    m_yMin (0),
+    m_nCellsX (0),
+    m_nCellsY (0),
+    m_query (0)
+{
+}
+
+void
+NrV2XBuildingIndex::Build (double cellSize)
+{
+  NS_LOG_FUNCTION (this << cellSize);
+  NS_ASSERT_MSG (cellSize > 0, "The cell size must be positive");
+  m_buildings.clear ();
+  m_boxes.clear ();
+  m_cells.clear ();
+  m_nCellsX = 0;
+  m_nCellsY = 0;
+  double xMax = -std::numeric_limits<double>::infinity ();
+  double yMax = -std::numeric_limits<double>::infinity ();
+  m_xMin = std::numeric_limits<double>::infinity ();
+  m_yMin = std::numeric_limits<double>::infinity ();
+  for (BuildingList::Iterator it = BuildingList::Begin (); it != BuildingList::End (); ++it)
+    {
+      Box box = (*it)->GetBoundaries ();
+      m_buildings.push_back (*it);
+      m_boxes.push_back (box);
+      m_xMin = std::min (m_xMin, box.xMin);
+      m_yMin = std::min (m_yMin, box.yMin);
+      xMax = std::max (xMax, box.xMax);
+      yMax = std::max (yMax, box.yMax);
+    }
+  m_lastQuery.assign (m_buildings.size (), 0);
+  m_query = 0;
+  if (m_buildings.empty ())
+    {
+      return;
+    }
+
+  // Bound the memory of the grid for sparse buildings over a large area
+  double maxCells = 16.0 * m_buildings.size () + 1024;
+  m_cellSize = cellSize;
+  while ((std::floor ((xMax - m_xMin) / m_cellSize) + 1) * (std::floor ((yMax - m_yMin) / m_cellSize) + 1) > maxCells)
+    {
+      m_cellSize *= 2;
+    }
+  m_nCellsX = (uint32_t) std::floor ((xMax - m_xMin) / m_cellSize) + 1;
+  m_nCellsY = (uint32_t) std::floor ((yMax - m_yMin) / m_cellSize) + 1;
+  m_cells.resize (m_nCellsX * m_nCellsY);
+  for (uint32_t i = 0; i < m_boxes.size (); i++)
+    {
+      for (uint32_t y = GetCellY (m_boxes[i].yMin); y <= GetCellY (m_boxes[i].yMax); y++)
+        {
+          for (uint32_t x = GetCellX (m_boxes[i].xMin); x <= GetCellX (m_boxes[i].xMax); x++)
+            {
+              m_cells[y * m_nCellsX + x].push_back (i);
+            }
+        }
+    }
+  NS_LOG_INFO ("Indexed " << m_buildings.size () << " buildings in " << m_nCellsX << "x" << m_nCellsY << " cells of " << m_cellSize << " m");
+}
+
+uint32_t
+NrV2XBuildingIndex::GetNBuildings (void) const
+{
+  return m_buildings.size ();
+}
+
+uint32_t
+NrV2XBuildingIndex::GetCellX (double x) const
+{
+  double cell = std::floor ((x - m_xMin) / m_cellSize);
+  return (uint32_t) std::min (std::max (cell, 0.0), (double) (m_nCellsX - 1));
+}
+
+uint32_t
+NrV2XBuildingIndex::GetCellY (double y) const
+{
+  double cell = std::floor ((y - m_yMin) / m_cellSize);
+  return (uint32_t) std::min (std::max (cell, 0.0), (double) (m_nCellsY - 1));
+}
+
+Ptr<Building>
+NrV2XBuildingIndex::GetBuilding (const Vector& position) const
+{
+  if (m_cells.empty ()
+      || position.x < m_xMin || position.x > m_xMin + m_nCellsX * m_cellSize
+      || position.y < m_yMin || position.y > m_yMin + m_nCellsY * m_cellSize)
+    {
+      return 0;
+    }
+  const std::vector<uint32_t>& cell = m_cells[GetCellY (position.y) * m_nCellsX + GetCellX (position.x)];
+  for (std::vector<uint32_t>::const_iterator it = cell.begin (); it != cell.end (); ++it)
+    {
+      if (m_boxes[*it].IsInside (position))
+        {
+          return m_buildings[*it];
+        }
+    }
+  return 0;
+}
+
+bool
+NrV2XBuildingIndex::Intersects (const Box& box, const Vector& a, const Vector& b)
+{
+  // Slab test of the segment a + t (b - a), t in [0, 1]
+  double tMin = 0.0;
+  double tMax = 1.0;
+  const double origin[3] = {a.x, a.y, a.z};
+  const double direction[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+  const double low[3] = {box.xMin, box.yMin, box.zMin};
+  const double high[3] = {box.xMax, box.yMax, box.zMax};
+  for (uint32_t axis = 0; axis < 3; axis++)
+    {
+      if (direction[axis] == 0)
+        {
+          if (origin[axis] < low[axis] || origin[axis] > high[axis])
+            {
+              return false;
+            }
+          continue;
+        }
+      double t1 = (low[axis] - origin[axis]) / direction[axis];
+      double t2 = (high[axis] - origin[axis]) / direction[axis];
+      if (t1 > t2)
+        {
+          std::swap (t1, t2);
+        }
+      tMin = std::max (tMin, t1);
+      tMax = std::min (tMax, t2);
+      if (tMin > tMax)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+NrV2XBuildingIndex::IsLineOfSight (const Vector& a, const Vector& b) const
+{
+  if (m_cells.empty ())
+    {
+      return true;
+    }
+  // Clip the segment to the grid, in the horizontal plane
+  double dx = b.x - a.x;
+  double dy = b.y - a.y;
+  double t0 = 0.0;
+  double t1 = 1.0;
+  const double p[4] = {-dx, dx, -dy, dy};
+  const double q[4] = {a.x - m_xMin, m_xMin + m_nCellsX * m_cellSize - a.x, a.y - m_yMin, m_yMin + m_nCellsY * m_cellSize - a.y};
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      if (p[i] == 0)
+        {
+          if (q[i] < 0)
+            {
+              return true;
+            }
+          continue;
+        }
+      double t = q[i] / p[i];
+      if (p[i] < 0)
+        {
+          t0 = std::max (t0, t);
+        }
+      else
+        {
+          t1 = std::min (t1, t);
+        }
+      if (t0 > t1)
+        {
+          return true;
+        }
+    }
+
+  // Walk the cells crossed by the segment, from t0 to t1
+  if (++m_query == 0)
+    {
+      std::fill (m_lastQuery.begin (), m_lastQuery.end (), 0);
+      m_query = 1;
+    }
+  uint32_t x = GetCellX (a.x + t0 * dx);
+  uint32_t y = GetCellY (a.y + t0 * dy);
+  uint32_t xEnd = GetCellX (a.x + t1 * dx);
+  uint32_t yEnd = GetCellY (a.y + t1 * dy);
+  int32_t stepX = dx > 0 ? 1 : -1;
+  int32_t stepY = dy > 0 ? 1 : -1;
+  double infinity = std::numeric_limits<double>::infinity ();
+  double tNextX = dx != 0 ? (m_xMin + (x + (dx > 0 ? 1 : 0)) * m_cellSize - a.x) / dx : infinity;
+  double tNextY = dy != 0 ? (m_yMin + (y + (dy > 0 ? 1 : 0)) * m_cellSize - a.y) / dy : infinity;
+  double tDeltaX = dx != 0 ? m_cellSize / std::abs (dx) : infinity;
+  double tDeltaY = dy != 0 ? m_cellSize / std::abs (dy) : infinity;
+  for (uint32_t steps = 0; steps <= m_nCellsX + m_nCellsY; steps++)
+    {
+      const std::vector<uint32_t>& cell = m_cells[y * m_nCellsX + x];
+      for (std::vector<uint32_t>::const_iterator it = cell.begin (); it != cell.end (); ++it)
+        {
+          if (m_lastQuery[*it] == m_query)
+            {
+              continue;
+            }
+          m_lastQuery[*it] = m_query;
+          if (Intersects (m_boxes[*it], a, b))
+            {
+              return false;
+            }
+        }
+      if (x == xEnd && y == yEnd)
+        {
+          break;
+        }
+      if (tNextX < tNextY)
+        {
+          if ((stepX < 0 && x == 0) || (stepX > 0 && x == m_nCellsX - 1))
+            {
+              break;
+            }
+          x += stepX;
+          tNextX += tDeltaX;
+        }
+      else
+        {
+          if ((stepY < 0 && y == 0) || (stepY > 0 && y == m_nCellsY - 1))
+            {
+              break;
+            }
+          y += stepY;
+          tNextY += tDeltaY;
+        }
+    }
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,67 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#include "nr-v2x-console.h"
+
+#include <ns3/simulator.h>
+
+#include <iostream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrV2XConsole");
+
+NrV2XConsole::Verbosity NrV2XConsole::s_verbosity = NrV2XConsole::VERBOSE;
+std::chrono::steady_clock::time_point NrV2XConsole::s_wallClockStart;
+
+void
+NrV2XConsole::SetVerbosity (Verbosity verbosity)
+{
+  NS_LOG_FUNCTION (verbosity);
+  s_verbosity = verbosity;
+}
+
+NrV2XConsole::Verbosity
+NrV2XConsole::GetVerbosity (void)
+{
+  return s_verbosity;
+}
+
+void
+NrV2XConsole::EnableHeartbeat (Time interval)
+{
+  NS_LOG_FUNCTION (interval);
+  NS_ASSERT_MSG (interval > Seconds (0), "The heartbeat interval must be positive");
+  s_wallClockStart = std::chrono::steady_clock::now ();
+  Simulator::ScheduleNow (&NrV2XConsole::Heartbeat, interval);
+}
+
+void
+NrV2XConsole::Heartbeat (Time interval)
+{
+  double wallClock = std::chrono::duration<double> (std::chrono::steady_clock::now () - s_wallClockStart).count ();
+  std::cout << "Simulation time " << Simulator::Now ().GetSeconds () << " s, wall-clock time " << wallClock << " s" << std::endl;
+  Simulator::Schedule (interval, &NrV2XConsole::Heartbeat, interval);
+}
+
+} // namespace ns3
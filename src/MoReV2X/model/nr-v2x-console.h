@@ -0,0 +1,88 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#ifndef NR_V2X_CONSOLE_H
+#define NR_V2X_CONSOLE_H
+
+#include <ns3/nstime.h>
+#include <ns3/log.h>
+
+#include <chrono>
+
+/**
+ * Console message of the given verbosity level, printed as NS_LOG_UNCOND.
+ * Below the level the message is not even formatted.
+ */
+#define NR_V2X_CONSOLE(level, msg) \
+  do \
+    { \
+      if (ns3::NrV2XConsole::IsEnabled (ns3::NrV2XConsole::level)) \
+        { \
+          NS_LOG_UNCOND (msg); \
+        } \
+    } \
+  while (false)
+
+namespace ns3 {
+
+/**
+ * Verbosity of the console output of the scenarios and of the model.
+ * The default VERBOSE keeps every per-packet and per-frame message; QUIET
+ * removes them, and the progress is reported by the heartbeat instead.
+ */
+class NrV2XConsole
+{
+public:
+  enum Verbosity
+  {
+    QUIET = 0, // heartbeat and errors only
+    INFO,      // configuration summaries
+    VERBOSE    // per-packet and per-frame messages
+  };
+
+  static void SetVerbosity (Verbosity verbosity);
+  static Verbosity GetVerbosity (void);
+
+  static bool IsEnabled (Verbosity level)
+  {
+    return level <= s_verbosity;
+  }
+
+  /**
+   * Print the simulation time and the wall-clock time every interval of
+   * simulation time, starting now
+   *
+   * \param interval the heartbeat period
+   */
+  static void EnableHeartbeat (Time interval);
+
+private:
+  static void Heartbeat (Time interval);
+
+  static Verbosity s_verbosity;
+  static std::chrono::steady_clock::time_point s_wallClockStart;
+};
+
+} // namespace ns3
+
+#endif /* NR_V2X_CONSOLE_H */
@@ -0,0 +1,258 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#include "nr-v2x-profiler.h"
+#include "nr-v2x-console.h"
+
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrV2XProfiler");
+
+NS_OBJECT_ENSURE_REGISTERED (NrV2XProfiler);
+
+Ptr<NrV2XProfiler> NrV2XProfiler::s_instance = 0;
+
+NrV2XProfiler::NrV2XProfiler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+NrV2XProfiler::~NrV2XProfiler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+NrV2XProfiler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::NrV2XProfiler")
+    .SetParent<Object> ()
+    .AddConstructor<NrV2XProfiler> ()
+    .AddAttribute ("Resolution",
+                   "Resolution of the per-call duration histograms [us]",
+                   DoubleValue (0.1),
+                   MakeDoubleAccessor (&NrV2XProfiler::m_resolution),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("TimeSeriesInterval",
+                   "Simulated time between two samples of the profiler time series. Zero disables the time series",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&NrV2XProfiler::m_timeSeriesInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("OutputPath",
+                   "Specifiy the output path where to store the results",
+                   StringValue ("results/sidelink/"),
+                   MakeStringAccessor (&NrV2XProfiler::m_outputPath),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+NrV2XProfiler*
+NrV2XProfiler::GetInstance (void)
+{
+  if (s_instance == 0)
+    {
+      s_instance = CreateObject<NrV2XProfiler> ();
+      s_instance->m_thread = std::this_thread::get_id ();
+      s_instance->Start ();
+      Simulator::ScheduleDestroy (&NrV2XProfiler::SaveInstance);
+    }
+  return PeekPointer (s_instance);
+}
+
+void
+NrV2XProfiler::SaveInstance (void)
+{
+  if (s_instance != 0)
+    {
+      s_instance->Save ();
+      s_instance = 0;
+    }
+}
+
+void
+NrV2XProfiler::Start (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t probe = 0; probe < N_PROBES; probe++)
+    {
+      m_probes[probe].calls = 0;
+      m_probes[probe].total = 0.0;
+      m_probes[probe].max = 0.0;
+      m_probes[probe].duration = NrV2XLogHistogram (m_resolution, 5);
+      m_probes[probe].lastCalls = 0;
+      m_probes[probe].lastTotal = 0.0;
+    }
+  for (uint32_t counter = 0; counter < N_COUNTERS; counter++)
+    {
+      m_counters[counter] = 0;
+    }
+
+  if (m_timeSeriesInterval > Seconds (0))
+    {
+      std::ofstream timeSeriesFile;
+      timeSeriesFile.open (m_outputPath + "ProfilerTimeSeries.csv");
+      timeSeriesFile << "time,probe,calls,totalUs" << std::endl;
+      timeSeriesFile.close ();
+      m_timeSeriesEvent = Simulator::Schedule (m_timeSeriesInterval, &NrV2XProfiler::WriteTimeSeries, this);
+    }
+}
+
+const char*
+NrV2XProfiler::ProbeName (Probe probe)
+{
+  switch (probe)
+    {
+    case V2X_SELECT_RESOURCES:
+      return "V2XSelectResources";
+    case MODE2_STEP1:
+      return "Mode2Step1";
+    case RE_EVALUATE_RESOURCES:
+      return "ReEvaluateResources";
+    case PHY_START_RX:
+      return "StartRx";
+    case PHY_END_RX_SL_DATA:
+      return "EndRxV2XSlData";
+    case UPDATE_CHANNEL_MATRIX:
+      return "UpdateChannelMatrix";
+    case CREATE_TX_PSD:
+      return "CreateUlTxPowerSpectralDensity";
+    case EVALUATE_CHUNK:
+      return "ConditionallyEvaluateChunk";
+    case RLC_UM_TRANSMIT_PDCP_PDU:
+      return "RlcUmTransmitPdcpPdu";
+    case RLC_UM_TX_OPPORTUNITY:
+      return "RlcUmNotifyTxOpportunity";
+    case RLC_UM_RECEIVE_PDU:
+      return "RlcUmReceivePdu";
+    default:
+      NS_FATAL_ERROR ("Unknown probe " << probe);
+    }
+  return "";
+}
+
+const char*
+NrV2XProfiler::CounterName (Counter counter)
+{
+  switch (counter)
+    {
+    case RSRP_THRESHOLD_INCREASES:
+      return "RsrpThresholdIncreases";
+    case SINR_EVALUATIONS:
+      return "SinrEvaluations";
+    default:
+      NS_FATAL_ERROR ("Unknown counter " << counter);
+    }
+  return "";
+}
+
+void
+NrV2XProfiler::AddSample (Probe probe, double duration)
+{
+  NS_ASSERT_MSG (std::this_thread::get_id () == m_thread, "Profiler probe " << ProbeName (probe) << " outside of the simulator thread");
+  ProbeStats& stats = m_probes[probe];
+  stats.calls++;
+  stats.total += duration;
+  stats.max = std::max (stats.max, duration);
+  stats.duration.Add (duration);
+}
+
+void
+NrV2XProfiler::Count (Counter counter, uint64_t n)
+{
+  NS_ASSERT_MSG (std::this_thread::get_id () == m_thread, "Profiler counter " << CounterName (counter) << " outside of the simulator thread");
+  m_counters[counter] += n;
+}
+
+void
+NrV2XProfiler::WriteTimeSeries (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::ofstream timeSeriesFile;
+  timeSeriesFile.open (m_outputPath + "ProfilerTimeSeries.csv", std::ios_base::app);
+  double now = Simulator::Now ().GetSeconds ();
+  for (uint32_t probe = 0; probe < N_PROBES; probe++)
+    {
+      ProbeStats& stats = m_probes[probe];
+      timeSeriesFile << now << "," << ProbeName ((Probe) probe) << "," << stats.calls - stats.lastCalls << ","
+                     << stats.total - stats.lastTotal << std::endl;
+      stats.lastCalls = stats.calls;
+      stats.lastTotal = stats.total;
+    }
+  timeSeriesFile.close ();
+  m_timeSeriesEvent = Simulator::Schedule (m_timeSeriesInterval, &NrV2XProfiler::WriteTimeSeries, this);
+}
+
+void
+NrV2XProfiler::Save (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_timeSeriesEvent.Cancel ();
+
+  std::ofstream summaryFile, histogramFile;
+  summaryFile.open (m_outputPath + "ProfilerSummary.csv");
+  histogramFile.open (m_outputPath + "ProfilerHistograms.csv");
+  summaryFile << "probe,calls,totalUs,meanUs,p50Us,p99Us,maxUs" << std::endl;
+  histogramFile << "probe,durationFromUs,durationToUs,count" << std::endl;
+
+  NR_V2X_CONSOLE (INFO, "MoReV2X profiler summary (wall-clock, inclusive of nested probes)");
+  NR_V2X_CONSOLE (INFO, std::setw (32) << std::left << "probe" << std::right << std::setw (12) << "calls" << std::setw (14) << "total [s]"
+                  << std::setw (12) << "mean [us]" << std::setw (12) << "p99 [us]");
+
+  for (uint32_t probe = 0; probe < N_PROBES; probe++)
+    {
+      ProbeStats& stats = m_probes[probe];
+      double mean = stats.calls > 0 ? stats.total / stats.calls : 0.0;
+      summaryFile << ProbeName ((Probe) probe) << "," << stats.calls << "," << stats.total << "," << mean << ","
+                  << stats.duration.GetQuantile (0.5) << "," << stats.duration.GetQuantile (0.99) << "," << stats.max << std::endl;
+      for (uint32_t index = 0; index < stats.duration.GetNBuckets (); index++)
+        {
+          if (stats.duration.GetCount (index) > 0)
+            {
+              histogramFile << ProbeName ((Probe) probe) << "," << stats.duration.GetLowerBound (index) << ","
+                            << stats.duration.GetUpperBound (index) << "," << stats.duration.GetCount (index) << std::endl;
+            }
+        }
+      NR_V2X_CONSOLE (INFO, std::setw (32) << std::left << ProbeName ((Probe) probe) << std::right << std::setw (12) << stats.calls
+                      << std::setw (14) << stats.total * 1e-6 << std::setw (12) << mean << std::setw (12) << stats.duration.GetQuantile (0.99));
+    }
+  for (uint32_t counter = 0; counter < N_COUNTERS; counter++)
+    {
+      summaryFile << CounterName ((Counter) counter) << "," << m_counters[counter] << ",,,,," << std::endl;
+      NR_V2X_CONSOLE (INFO, std::setw (32) << std::left << CounterName ((Counter) counter) << std::right << std::setw (12) << m_counters[counter]);
+    }
+
+  summaryFile.close ();
+  histogramFile.close ();
+}
+
+} // namespace ns3
@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#ifndef NR_V2X_PROFILER_H
+#define NR_V2X_PROFILER_H
+
+#include <ns3/object.h>
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+
+#include "nr-v2x-rx-statistics.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+/**
+ * The hot-path probes are compiled in only when the module is configured
+ * with --enable-morev2x-profiler, which defines NR_V2X_PROFILER. Otherwise
+ * the macros expand to nothing and the simulator is not affected.
+ *
+ * The profiler is not thread-safe: the probes must stay in the simulator
+ * thread, e.g. not in the SINR evaluations of the NrV2XWorkerPool. This is
+ * asserted at every sample.
+ */
+#ifdef NR_V2X_PROFILER
+#define NR_V2X_PROFILE_SCOPE(probe) \
+  ns3::NrV2XProfilerScope nrV2XProfilerScope (ns3::NrV2XProfiler::probe)
+#define NR_V2X_PROFILE_COUNT(counter, n) \
+  ns3::NrV2XProfiler::GetInstance ()->Count (ns3::NrV2XProfiler::counter, n)
+#else
+#define NR_V2X_PROFILE_SCOPE(probe)
+#define NR_V2X_PROFILE_COUNT(counter, n)
+#endif
+
+namespace ns3 {
+
+/**
+ * Wall-clock profiler of the MoReV2X hot paths. Every probe accumulates the
+ * number of calls, the total time and a histogram of the per-call duration.
+ * Nested probes (e.g. Mode2Step1 inside V2XSelectResources) are inclusive.
+ * A summary is saved at Simulator::Destroy in ProfilerSummary.csv, and printed
+ * on the console at the INFO verbosity of NrV2XConsole; if TimeSeriesInterval
+ * is not zero, the per-interval calls and time of every probe are also
+ * appended to ProfilerTimeSeries.csv.
+ */
+class NrV2XProfiler : public Object
+{
+public:
+  enum Probe
+  {
+    V2X_SELECT_RESOURCES = 0,
+    MODE2_STEP1,
+    RE_EVALUATE_RESOURCES,
+    PHY_START_RX,
+    PHY_END_RX_SL_DATA,
+    UPDATE_CHANNEL_MATRIX,
+    CREATE_TX_PSD,
+    EVALUATE_CHUNK,
+    RLC_UM_TRANSMIT_PDCP_PDU,
+    RLC_UM_TX_OPPORTUNITY,
+    RLC_UM_RECEIVE_PDU,
+    N_PROBES
+  };
+
+  enum Counter
+  {
+    RSRP_THRESHOLD_INCREASES = 0,
+    SINR_EVALUATIONS,
+    N_COUNTERS
+  };
+
+  NrV2XProfiler ();
+  virtual ~NrV2XProfiler ();
+
+  static TypeId GetTypeId (void);
+
+  /**
+   * \return the profiler shared by all the probes. It is created at the
+   * first call, and its summary is saved at Simulator::Destroy
+   */
+  static NrV2XProfiler* GetInstance (void);
+
+  /**
+   * \param probe the probe
+   * \param duration the wall-clock duration of the call [us]
+   */
+  void AddSample (Probe probe, double duration);
+
+  void Count (Counter counter, uint64_t n);
+
+  /**
+   * Write the summary in the output path, and print it at the INFO verbosity
+   */
+  void Save (void);
+
+private:
+  static void SaveInstance (void);
+  void Start (void);
+  void WriteTimeSeries (void);
+
+  struct ProbeStats
+  {
+    uint64_t calls;
+    double total; // [us]
+    double max; // [us]
+    NrV2XLogHistogram duration;
+    uint64_t lastCalls; // at the last time series sample
+    double lastTotal;
+  };
+
+  static const char* ProbeName (Probe probe);
+  static const char* CounterName (Counter counter);
+
+  static Ptr<NrV2XProfiler> s_instance;
+
+  ProbeStats m_probes[N_PROBES];
+  uint64_t m_counters[N_COUNTERS];
+
+  double m_resolution;
+  Time m_timeSeriesInterval;
+  std::string m_outputPath;
+  EventId m_timeSeriesEvent;
+  std::thread::id m_thread; // the simulator thread, where the profiler was created
+};
+
+
+/**
+ * Times the enclosing scope and feeds the duration to the profiler
+ */
+class NrV2XProfilerScope
+{
+public:
+  NrV2XProfilerScope (NrV2XProfiler::Probe probe)
+    : m_probe (probe),
+      m_start (std::chrono::steady_clock::now ())
+  {
+  }
+
+  ~NrV2XProfilerScope ()
+  {
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now () - m_start;
+    NrV2XProfiler::GetInstance ()->AddSample (m_probe, elapsed.count ());
+  }
+
+private:
+  NrV2XProfiler::Probe m_probe;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace ns3
+
+#endif /* NR_V2X_PROFILER_H */
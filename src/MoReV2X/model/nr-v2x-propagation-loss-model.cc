@@ -26,14 +26,18 @@
 #include "ns3/building-list.h"
 #include <ns3/nr-v2x-ue-net-device.h>
 #include "ns3/node-container.h"
+#include "ns3/node-list.h"
+#include "ns3/nr-v2x-profiler.h"
 #include <fstream>
 #include <iostream>
+#include <limits>
 
 NS_LOG_COMPONENT_DEFINE ("NrV2XPropagationLossModel");
 
 namespace ns3 {
 
 std::map<uint32_t, std::map<uint32_t , NrV2XPropagationLossModel::ChannelModel> > NrV2XPropagationLossModel::ChannelMatrix;
+std::set<uint32_t> NrV2XPropagationLossModel::s_retiredNodes;
 
 NS_OBJECT_ENSURE_REGISTERED (NrV2XPropagationLossModel);
 
@@ -48,6 +52,26 @@ NrV2XPropagationLossModel::~NrV2XPropagationLossModel ()
 {
 }
 
+void
+NrV2XPropagationLossModel::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_UEsContainer = NodeContainer ();
+  BuildingsPropagationLossModel::DoDispose ();
+}
+
+int64_t
+NrV2XPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  int64_t currentStream = stream;
+  currentStream += BuildingsPropagationLossModel::DoAssignStreams (currentStream);
+  m_randomUniform->SetStream (currentStream++);
+  m_shadowing->SetStream (currentStream++);
+  m_shadowingNLOSv->SetStream (currentStream++);
+  return (currentStream - stream);
+}
+
 TypeId
 NrV2XPropagationLossModel::GetTypeId (void)
 {
@@ -90,6 +114,10 @@ NrV2XPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b)
   uint32_t nodeIdB = b->GetObject<Node>()->GetId();
   double distance = 0.0, pathloss = 0.0;
 
+  // The links of the retired nodes are cut, so that the spectrum channel skips them
+  if ((!s_retiredNodes.empty()) && ((s_retiredNodes.find(nodeIdA) != s_retiredNodes.end()) || (s_retiredNodes.find(nodeIdB) != s_retiredNodes.end())))
+    return std::numeric_limits<double>::infinity();
+
 
 /*  NS_LOG_INFO("Printing channel models matrix");
   //Print matrix
@@ -143,16 +171,22 @@ NrV2XPropagationLossModel::GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityModel
 }
 
 
+double
+NrV2XPropagationLossModel::GetMaxCouplingLoss (double distance, double shadowingMargin) const
+{
+  NS_ASSERT_MSG(distance > 0, "The maximum distance must be positive");
+  // Same pathloss as the channel models
+  return 32.4 + 20 * std::log10(distance) + 20 * std::log10(m_frequency) + shadowingMargin;
+}
+
 
 void 
 NrV2XPropagationLossModel::InitChannelMatrix (NodeContainer VehicleUEs)
 {
   NS_LOG_FUNCTION(this);
-  double shadowingValue, shadowingNLOSv;
-  bool LOS;
-  double Plos;
   // Save the NodeContainer
   m_UEsContainer = VehicleUEs;
+  s_retiredNodes.clear();
   NS_LOG_INFO("Frequency " << m_frequency << " sigma = " << m_sigma << " sigma NLOSv = " << m_sigmaNLOSv << " Decor. distance = " << m_decorrDistance);
   NS_LOG_INFO("Creating channel models matrix...");
 
@@ -197,35 +231,7 @@ NrV2XPropagationLossModel::InitChannelMatrix (NodeContainer VehicleUEs)
         Ptr<MobilityModel> mobRX = RxNode->GetObject<MobilityModel> ();
         double TxRxDistance = mobTX->GetDistanceFrom(mobRX);
 //        NS_LOG_INFO("Tx ID " << txID << ", Rx ID " << rxID << ", Tx-Rx distance " << TxRxDistance << ", " << mobTX->GetPosition().x << ", " << mobRX->GetPosition().x);
-        NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].Distance = TxRxDistance;
-        NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].Pathloss = 32.4 + 20 * std::log10(TxRxDistance) + 20 * std::log10(m_frequency); 
-        shadowingValue = m_shadowing->GetValue (0.0, (m_sigma*m_sigma));
-        NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].Shadowing = shadowingValue;
-        if (TxRxDistance <= 475)
-        { 
-          Plos = std::min(1.0,2.1013e-6*TxRxDistance*TxRxDistance - 0.002*TxRxDistance + 1.0193);  // Probability of being in LOS in the Highway scenario (see 3GPP TR 37.885)
-        }
-        else
-        {
-          Plos = std::max(0.0,0.54 - 0.001*(TxRxDistance-475));
-        }
-//        Plos = 0;         //TODO COMMENT
-        LOS = m_randomUniform->GetValue () > Plos ? false : true;
-        NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].LOS = LOS;
-        if (LOS)
-        {
-          NS_LOG_INFO("LOS link");
-          NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].ShadowingNLOSv = 0;
-        }
-        else
-        {
-          Ptr<NormalRandomVariable> RandomShadowingNLOSv =  CreateObject<NormalRandomVariable> ();
-          shadowingNLOSv = RandomShadowingNLOSv->GetValue (5 + std::max(0.0,(15*std::log10(TxRxDistance))-41), (m_sigmaNLOSv*m_sigmaNLOSv));// Due to the presence of other vehicles
-//          shadowingNLOSv = m_shadowingNLOSv->GetValue (5 + std::max(0.0,(15*std::log10(TxRxDistance))-41), (m_sigmaNLOSv*m_sigmaNLOSv));// Due to the presence of other vehicles
-          shadowingNLOSv = std::max(0.0,shadowingNLOSv);
-          NS_LOG_INFO("NLOSv link. Additional shadowing = " << shadowingNLOSv << " dB");
-          NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].ShadowingNLOSv = shadowingNLOSv;
-        }
+        InitChannelModel(txID, rxID, TxRxDistance);
       }
     }
   }
@@ -248,10 +254,92 @@ NrV2XPropagationLossModel::InitChannelMatrix (NodeContainer VehicleUEs)
   Simulator::Schedule (MilliSeconds (100), &NrV2XPropagationLossModel::UpdateChannelMatrix, this);      
 }
 
+void
+NrV2XPropagationLossModel::InitChannelModel (uint32_t txID, uint32_t rxID, double TxRxDistance)
+{
+  double shadowingValue, shadowingNLOSv;
+  bool LOS;
+  double Plos;
+  NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].Distance = TxRxDistance;
+  NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].Pathloss = 32.4 + 20 * std::log10(TxRxDistance) + 20 * std::log10(m_frequency); 
+  shadowingValue = m_shadowing->GetValue (0.0, (m_sigma*m_sigma));
+  NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].Shadowing = shadowingValue;
+  if (TxRxDistance <= 475)
+  { 
+    Plos = std::min(1.0,2.1013e-6*TxRxDistance*TxRxDistance - 0.002*TxRxDistance + 1.0193);  // Probability of being in LOS in the Highway scenario (see 3GPP TR 37.885)
+  }
+  else
+  {
+    Plos = std::max(0.0,0.54 - 0.001*(TxRxDistance-475));
+  }
+//  Plos = 0;         //TODO COMMENT
+  LOS = m_randomUniform->GetValue () > Plos ? false : true;
+  NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].LOS = LOS;
+  if (LOS)
+  {
+    NS_LOG_INFO("LOS link");
+    NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].ShadowingNLOSv = 0;
+  }
+  else
+  {
+    Ptr<NormalRandomVariable> RandomShadowingNLOSv =  CreateObject<NormalRandomVariable> ();
+    shadowingNLOSv = RandomShadowingNLOSv->GetValue (5 + std::max(0.0,(15*std::log10(TxRxDistance))-41), (m_sigmaNLOSv*m_sigmaNLOSv));// Due to the presence of other vehicles
+//    shadowingNLOSv = m_shadowingNLOSv->GetValue (5 + std::max(0.0,(15*std::log10(TxRxDistance))-41), (m_sigmaNLOSv*m_sigmaNLOSv));// Due to the presence of other vehicles
+    shadowingNLOSv = std::max(0.0,shadowingNLOSv);
+    NS_LOG_INFO("NLOSv link. Additional shadowing = " << shadowingNLOSv << " dB");
+    NrV2XPropagationLossModel::ChannelMatrix[txID][rxID].ShadowingNLOSv = shadowingNLOSv;
+  }
+}
+
+void
+NrV2XPropagationLossModel::RetireNode (uint32_t nodeId)
+{
+  NS_LOG_FUNCTION(this << nodeId);
+  if (!s_retiredNodes.insert(nodeId).second)
+    return;
+  NrV2XPropagationLossModel::ChannelMatrix.erase(nodeId);
+  for (std::map<uint32_t, std::map<uint32_t , ChannelModel> >::iterator II = NrV2XPropagationLossModel::ChannelMatrix.begin(); II != NrV2XPropagationLossModel::ChannelMatrix.end(); ++II)
+    II->second.erase(nodeId);
+}
+
+void
+NrV2XPropagationLossModel::ActivateNode (uint32_t nodeId)
+{
+  NS_LOG_FUNCTION(this << nodeId);
+  if (s_retiredNodes.erase(nodeId) == 0)
+    return;
+  Ptr<MobilityModel> mobNode;
+  for (NodeContainer::Iterator L = m_UEsContainer.Begin(); L != m_UEsContainer.End(); ++L)
+  {
+    if ((*L)->GetId () == nodeId)
+      mobNode = (*L)->GetObject<MobilityModel> ();
+  }
+  NS_ASSERT_MSG(mobNode != 0, "Node " << nodeId << " is not in the channel matrix");
+  // New links, as in InitChannelMatrix: the matrix stores the links with rxID < txID and their symmetric copy
+  for (NodeContainer::Iterator K = m_UEsContainer.Begin(); K != m_UEsContainer.End(); ++K)
+  {
+    uint32_t otherID = (*K)->GetId ();
+    if ((otherID == nodeId) || (s_retiredNodes.find(otherID) != s_retiredNodes.end()))
+      continue;
+    uint32_t txID = std::max(nodeId, otherID);
+    uint32_t rxID = std::min(nodeId, otherID);
+    InitChannelModel(txID, rxID, mobNode->GetDistanceFrom((*K)->GetObject<MobilityModel> ()));
+    NrV2XPropagationLossModel::ChannelMatrix[rxID][txID] = NrV2XPropagationLossModel::ChannelMatrix[txID][rxID];
+  }
+  ChannelModel self;
+  self.Distance = 0.0;
+  self.Pathloss = 0.0;
+  self.Shadowing = 0.0;
+  self.ShadowingNLOSv = 0.0;
+  self.LOS = false;
+  NrV2XPropagationLossModel::ChannelMatrix[nodeId][nodeId] = self;
+}
+
 void 
 NrV2XPropagationLossModel::UpdateChannelMatrix (void)
 {
   NS_LOG_FUNCTION(this);
+  NR_V2X_PROFILE_SCOPE (UPDATE_CHANNEL_MATRIX);
   double shadowingValue, shadowingNLOSv;
   bool LOS;
   double Plos;
@@ -263,13 +351,15 @@ NrV2XPropagationLossModel::UpdateChannelMatrix (void)
     Ptr<Node> TxNode = *L;
     uint32_t txID;
     txID = TxNode->GetId ();
+    if (s_retiredNodes.find(txID) != s_retiredNodes.end())
+      continue;
     Ptr<MobilityModel> mobTX = TxNode->GetObject<MobilityModel> ();
     for (NodeContainer::Iterator K = m_UEsContainer.Begin(); K != m_UEsContainer.End(); ++K)
     {
       Ptr<Node> RxNode = *K;
       uint32_t rxID;     
       rxID = RxNode->GetId ();
-      if (rxID < txID)
+      if ((rxID < txID) && (s_retiredNodes.find(rxID) == s_retiredNodes.end()))
       {      
         Ptr<MobilityModel> mobRX = RxNode->GetObject<MobilityModel> ();
         double TxRxDistance = mobTX->GetDistanceFrom(mobRX);
@@ -330,6 +420,27 @@ NrV2XPropagationLossModel::UpdateChannelMatrix (void)
   Simulator::Schedule (MilliSeconds (100), &NrV2XPropagationLossModel::UpdateChannelMatrix, this);      
 }
 
+const NrV2XPropagationLossModel::ChannelModel*
+NrV2XPropagationLossModel::GetChannelModel (uint32_t txID, uint32_t rxID) const
+{
+  std::map<uint32_t, std::map<uint32_t , ChannelModel> >::const_iterator txIT = NrV2XPropagationLossModel::ChannelMatrix.find(txID);
+  if (txIT == NrV2XPropagationLossModel::ChannelMatrix.end())
+    return 0; // Retired (or unknown) transmitter
+  std::map<uint32_t , ChannelModel>::const_iterator rxIT = txIT->second.find(rxID);
+  if (rxIT == txIT->second.end())
+    return 0; // Retired (or unknown) receiver
+  return &rxIT->second;
+}
+
+double
+NrV2XPropagationLossModel::GetRelativeSpeed (uint32_t txID, uint32_t rxID) const
+{
+  NS_ASSERT_MSG((txID < NodeList::GetNNodes()) && (rxID < NodeList::GetNNodes()), "No node " << std::max(txID, rxID));
+  Ptr<MobilityModel> mobTX = NodeList::GetNode(txID)->GetObject<MobilityModel> ();
+  Ptr<MobilityModel> mobRX = NodeList::GetNode(rxID)->GetObject<MobilityModel> ();
+  return mobTX->GetRelativeSpeed(mobRX)*3.6; //expressed in km/h
+}
+
 bool
 NrV2XPropagationLossModel::GetLineOfSightState (uint32_t txID, uint32_t rxID)
 {
@@ -26,6 +26,7 @@
 #include <ns3/traced-callback.h>
 #include "ns3/node.h"
 #include "ns3/node-container.h"
+#include <set>
 
 namespace ns3 {
 
@@ -86,10 +87,27 @@ public:
   static TypeId GetTypeId (void);
   NrV2XPropagationLossModel ();
   ~NrV2XPropagationLossModel ();
+  virtual void DoDispose ();
   
 
   void InitChannelMatrix (NodeContainer VehicleUEs);
 
+  /**
+   * Release the channel models of a node that left the scenario. Its links
+   * are not updated anymore and their loss is infinite, so that the spectrum
+   * channel does not deliver its transmissions
+   *
+   * \param nodeId the ID of a node passed to InitChannelMatrix
+   */
+  void RetireNode (uint32_t nodeId);
+
+  /**
+   * Create again the channel models of a retired node, as InitChannelMatrix does
+   *
+   * \param nodeId the ID of a node passed to InitChannelMatrix
+   */
+  void ActivateNode (uint32_t nodeId);
+
   bool GetLineOfSightState (uint32_t txID, uint32_t rxID);
 
   /**
@@ -109,6 +127,18 @@ public:
    */
   double GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+  /**
+   * Convert a maximum distance into the maximum coupling loss of the
+   * spectrum channel (MultiModelSpectrumChannel::MaxLossDb). The links
+   * beyond the distance are cut, unless their shadowing (log-normal plus
+   * NLOSv) is below -shadowingMargin
+   *
+   * \param distance the maximum distance (m)
+   * \param shadowingMargin the shadowing margin (dB)
+   * \return the pathloss at the distance plus the margin (dB)
+   */
+  double GetMaxCouplingLoss (double distance, double shadowingMargin) const;
+
 
   struct ChannelModel
   {
@@ -120,8 +150,27 @@ public:
   };
   // Map to store pathloss and shadowing
 
+  /**
+   * \param txID the ID of the transmitter
+   * \param rxID the ID of the receiver
+   * \return the channel model of the link, as of the last channel update, or
+   * 0 if one of the nodes was retired (or was never passed to InitChannelMatrix)
+   */
+  const ChannelModel* GetChannelModel (uint32_t txID, uint32_t rxID) const;
+
+  /**
+   * \param txID the ID of the transmitter
+   * \param rxID the ID of the receiver
+   * \return the relative speed (km/h) of the two nodes, from their mobility
+   * models at the time of the call. Retired nodes included
+   */
+  double GetRelativeSpeed (uint32_t txID, uint32_t rxID) const;
+
   static std::map<uint32_t, std::map<uint32_t , ChannelModel> > ChannelMatrix;
 
+  // Nodes without channel models. Shared, like ChannelMatrix, by the instance of the spectrum channel
+  static std::set<uint32_t> s_retiredNodes;
+
 private:
 
   Ptr<UniformRandomVariable> m_randomUniform = CreateObject<UniformRandomVariable> ();
@@ -130,6 +179,10 @@ private:
 
   void UpdateChannelMatrix (void);
 
+  void InitChannelModel (uint32_t txID, uint32_t rxID, double TxRxDistance);
+
+  virtual int64_t DoAssignStreams (int64_t stream);
+
   NodeContainer m_UEsContainer;
 
   double m_sigma;
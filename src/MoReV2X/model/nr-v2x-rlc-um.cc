@@ -34,6 +34,8 @@
 #include <inttypes.h>
 
 #include "ns3/nr-v2x-tag.h"
+#include "ns3/nr-v2x-profiler.h"
+#include "ns3/nr-v2x-console.h"
 
 namespace ns3 {
 
@@ -98,6 +100,7 @@ void
 NistLteRlcUm::DoTransmitPdcpPdu (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << p->GetSize ());
+  NR_V2X_PROFILE_SCOPE (RLC_UM_TRANSMIT_PDCP_PDU);
 
   if (m_txBufferSize + p->GetSize () <= m_maxTxBufferSize)
     {
@@ -150,6 +153,7 @@ void
 NistLteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId)
 {
   NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << bytes);
+  NR_V2X_PROFILE_SCOPE (RLC_UM_TX_OPPORTUNITY);
 
   if (bytes <= 2)
     {
@@ -453,6 +457,7 @@ void
 NistLteRlcUm::DoReceivePdu (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << p->GetSize ());
+  NR_V2X_PROFILE_SCOPE (RLC_UM_RECEIVE_PDU);
   // Receiver timestamp
   NistRlcTag rlcTag;
   Time delay;
@@ -1258,7 +1263,7 @@ NistLteRlcUm::DoReportBufferNistStatus (void)
  //TODO FIXME NEW for V2X       ~ maybe wrong
   r.alreadyUESelected = false;
 
-  NS_LOG_UNCOND ("Send ReportBufferNistStatus = " << r.txQueueSize << ", " << r.txQueueHolDelay );
+  NR_V2X_CONSOLE (VERBOSE, "Send ReportBufferNistStatus = " << r.txQueueSize << ", " << r.txQueueHolDelay );
  // std::cin.get(); // Pause the program and check the buffer size
   /*if (Simulator::Now ().GetSeconds() == 0.298701)
     {
@@ -0,0 +1,328 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#include "nr-v2x-rx-statistics.h"
+
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/uinteger.h>
+#include <ns3/string.h>
+
+#include <cmath>
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrV2XRxStatistics");
+
+NS_OBJECT_ENSURE_REGISTERED (NrV2XRxStatistics);
+
+NrV2XLogHistogram::NrV2XLogHistogram ()
+  : m_resolution (1.0),
+    m_subBucketBits (5)
+{
+}
+
+NrV2XLogHistogram::NrV2XLogHistogram (double resolution, uint8_t subBucketBits)
+  : m_resolution (resolution),
+    m_subBucketBits (subBucketBits)
+{
+  NS_ASSERT_MSG (resolution > 0, "The histogram resolution must be positive");
+  NS_ASSERT_MSG (subBucketBits < 32, "Too many sub-bucket bits");
+}
+
+uint32_t
+NrV2XLogHistogram::GetIndex (uint64_t units) const
+{
+  uint64_t subBuckets = (uint64_t) 1 << m_subBucketBits;
+  if (units < 2 * subBuckets)
+    {
+      return (uint32_t) units; // linear region
+    }
+  uint8_t msb = 0;
+  while ((units >> (msb + 1)) != 0)
+    {
+      msb++;
+    }
+  uint8_t shift = msb - m_subBucketBits;
+  return (uint32_t) (2 * subBuckets + (shift - 1) * subBuckets + ((units >> shift) - subBuckets));
+}
+
+uint64_t
+NrV2XLogHistogram::GetLowerBoundUnits (uint32_t index) const
+{
+  uint64_t subBuckets = (uint64_t) 1 << m_subBucketBits;
+  if (index < 2 * subBuckets)
+    {
+      return index;
+    }
+  uint64_t shift = (index - 2 * subBuckets) / subBuckets + 1;
+  uint64_t sub = (index - 2 * subBuckets) % subBuckets + subBuckets;
+  return sub << shift;
+}
+
+void
+NrV2XLogHistogram::Add (double value)
+{
+  uint64_t units = (uint64_t) std::floor (std::max (value, 0.0) / m_resolution);
+  uint32_t index = GetIndex (units);
+  if (index >= m_counts.size ())
+    {
+      m_counts.resize (index + 1, 0);
+    }
+  m_counts[index]++;
+}
+
+uint32_t
+NrV2XLogHistogram::GetNBuckets (void) const
+{
+  return m_counts.size ();
+}
+
+uint64_t
+NrV2XLogHistogram::GetCount (uint32_t index) const
+{
+  return m_counts.at (index);
+}
+
+double
+NrV2XLogHistogram::GetLowerBound (uint32_t index) const
+{
+  return GetLowerBoundUnits (index) * m_resolution;
+}
+
+double
+NrV2XLogHistogram::GetUpperBound (uint32_t index) const
+{
+  return GetLowerBoundUnits (index + 1) * m_resolution;
+}
+
+uint64_t
+NrV2XLogHistogram::GetTotalCount (void) const
+{
+  uint64_t total = 0;
+  for (uint32_t index = 0; index < m_counts.size (); index++)
+    {
+      total += m_counts[index];
+    }
+  return total;
+}
+
+double
+NrV2XLogHistogram::GetQuantile (double q) const
+{
+  uint64_t total = GetTotalCount ();
+  if (total == 0)
+    {
+      return 0.0;
+    }
+  uint64_t rank = (uint64_t) std::ceil (q * total);
+  uint64_t cumulated = 0;
+  for (uint32_t index = 0; index < m_counts.size (); index++)
+    {
+      cumulated += m_counts[index];
+      if (cumulated >= rank && m_counts[index] > 0)
+        {
+          return GetUpperBound (index);
+        }
+    }
+  return GetUpperBound (m_counts.size () - 1);
+}
+
+
+Ptr<NrV2XRxStatistics> NrV2XRxStatistics::s_instance = 0;
+
+NrV2XRxStatistics::NrV2XRxStatistics ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+NrV2XRxStatistics::~NrV2XRxStatistics ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+NrV2XRxStatistics::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::NrV2XRxStatistics")
+    .SetParent<Object> ()
+    .AddConstructor<NrV2XRxStatistics> ()
+    .AddAttribute ("DistanceBinWidth",
+                   "Width of the Tx-Rx distance bins of the PDR counters [m]",
+                   DoubleValue (10.0),
+                   MakeDoubleAccessor (&NrV2XRxStatistics::m_distanceBinWidth),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("LatencyResolution",
+                   "Resolution of the latency histogram [s]",
+                   DoubleValue (0.0001),
+                   MakeDoubleAccessor (&NrV2XRxStatistics::m_latencyResolution),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("IpgResolution",
+                   "Resolution of the inter-packet gap histogram [s]",
+                   DoubleValue (0.001),
+                   MakeDoubleAccessor (&NrV2XRxStatistics::m_ipgResolution),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("SubBucketBits",
+                   "Number of buckets per power of two of the histograms, in bits. The relative error is 2^-SubBucketBits",
+                   UintegerValue (5),
+                   MakeUintegerAccessor (&NrV2XRxStatistics::m_subBucketBits),
+                   MakeUintegerChecker<uint8_t> (0, 16))
+    .AddAttribute ("OutputPath",
+                   "Specifiy the output path where to store the results",
+                   StringValue ("results/sidelink/"),
+                   MakeStringAccessor (&NrV2XRxStatistics::m_outputPath),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+Ptr<NrV2XRxStatistics>
+NrV2XRxStatistics::GetInstance (void)
+{
+  if (s_instance == 0)
+    {
+      s_instance = CreateObject<NrV2XRxStatistics> ();
+      Simulator::ScheduleDestroy (&NrV2XRxStatistics::SaveInstance);
+    }
+  return s_instance;
+}
+
+void
+NrV2XRxStatistics::SaveInstance (void)
+{
+  if (s_instance != 0)
+    {
+      s_instance->Save ();
+      s_instance = 0;
+    }
+}
+
+NrV2XRxStatistics::Aggregates&
+NrV2XRxStatistics::GetAggregates (uint8_t trafficType, uint16_t selectionTrigger)
+{
+  StatsKey_t key (trafficType, selectionTrigger);
+  std::map<StatsKey_t, Aggregates>::iterator it = m_aggregates.find (key);
+  if (it == m_aggregates.end ())
+    {
+      Aggregates newAggregates;
+      newAggregates.latency = NrV2XLogHistogram (m_latencyResolution, m_subBucketBits);
+      newAggregates.ipg = NrV2XLogHistogram (m_ipgResolution, m_subBucketBits);
+      it = m_aggregates.insert (std::pair<StatsKey_t, Aggregates> (key, newAggregates)).first;
+    }
+  return it->second;
+}
+
+void
+NrV2XRxStatistics::AddReception (uint32_t txId, uint32_t rxId, uint8_t trafficType, uint16_t selectionTrigger, uint64_t packetId,
+                                 double distance, uint16_t lossType, double latency)
+{
+  NS_LOG_FUNCTION (this << txId << rxId << (uint16_t) trafficType << selectionTrigger << packetId << distance << lossType << latency);
+  Aggregates& aggregates = GetAggregates (trafficType, selectionTrigger);
+
+  uint32_t bin = (uint32_t) std::floor (distance / m_distanceBinWidth);
+  if (bin >= aggregates.pdr.size ())
+    {
+      OutcomeCounters emptyCounters = {0, {0, 0, 0, 0}};
+      aggregates.pdr.resize (bin + 1, emptyCounters);
+    }
+
+  if (lossType == 9)
+    {
+      aggregates.pdr[bin].decoded++;
+      aggregates.latency.Add (latency);
+
+      uint64_t link = ((uint64_t) rxId << 32) | txId;
+      double now = Simulator::Now ().GetSeconds ();
+      std::map<uint64_t, LastDecoded>::iterator lastIt = m_lastDecoded.find (link);
+      if (lastIt == m_lastDecoded.end ())
+        {
+          LastDecoded last = {packetId, now};
+          m_lastDecoded.insert (std::pair<uint64_t, LastDecoded> (link, last));
+        }
+      else if (lastIt->second.packetId != packetId) // a retransmission does not close a gap
+        {
+          aggregates.ipg.Add (now - lastIt->second.time);
+          lastIt->second.packetId = packetId;
+          lastIt->second.time = now;
+        }
+    }
+  else
+    {
+      NS_ASSERT_MSG (lossType < 4, "Unknown loss type " << lossType);
+      aggregates.pdr[bin].lost[lossType]++;
+    }
+}
+
+void
+NrV2XRxStatistics::Save (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::ofstream pdrFile, latencyFile, ipgFile;
+  pdrFile.open (m_outputPath + "RxStatsPDR.csv");
+  latencyFile.open (m_outputPath + "RxStatsLatency.csv");
+  ipgFile.open (m_outputPath + "RxStatsIPG.csv");
+  pdrFile << "trafficType,selectionTrigger,distanceFrom,distanceTo,decoded,lossType0,lossType1,lossType2,lossType3" << std::endl;
+  latencyFile << "trafficType,selectionTrigger,latencyFrom,latencyTo,count" << std::endl;
+  ipgFile << "trafficType,selectionTrigger,ipgFrom,ipgTo,count" << std::endl;
+
+  for (std::map<StatsKey_t, Aggregates>::iterator it = m_aggregates.begin (); it != m_aggregates.end (); it++)
+    {
+      uint16_t trafficType = it->first.first;
+      uint16_t selectionTrigger = it->first.second;
+      for (uint32_t bin = 0; bin < it->second.pdr.size (); bin++)
+        {
+          OutcomeCounters& counters = it->second.pdr[bin];
+          if (counters.decoded + counters.lost[0] + counters.lost[1] + counters.lost[2] + counters.lost[3] == 0)
+            {
+              continue;
+            }
+          pdrFile << trafficType << "," << selectionTrigger << "," << bin * m_distanceBinWidth << "," << (bin + 1) * m_distanceBinWidth << ","
+                  << counters.decoded << "," << counters.lost[0] << "," << counters.lost[1] << "," << counters.lost[2] << "," << counters.lost[3] << std::endl;
+        }
+      for (uint32_t index = 0; index < it->second.latency.GetNBuckets (); index++)
+        {
+          if (it->second.latency.GetCount (index) > 0)
+            {
+              latencyFile << trafficType << "," << selectionTrigger << "," << it->second.latency.GetLowerBound (index) << ","
+                          << it->second.latency.GetUpperBound (index) << "," << it->second.latency.GetCount (index) << std::endl;
+            }
+        }
+      for (uint32_t index = 0; index < it->second.ipg.GetNBuckets (); index++)
+        {
+          if (it->second.ipg.GetCount (index) > 0)
+            {
+              ipgFile << trafficType << "," << selectionTrigger << "," << it->second.ipg.GetLowerBound (index) << ","
+                      << it->second.ipg.GetUpperBound (index) << "," << it->second.ipg.GetCount (index) << std::endl;
+            }
+        }
+    }
+
+  pdrFile.close ();
+  latencyFile.close ();
+  ipgFile.close ();
+}
+
+} // namespace ns3
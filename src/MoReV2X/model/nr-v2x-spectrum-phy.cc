@@ -45,11 +45,16 @@
 #include <ns3/pointer.h>
 #include <ns3/object-vector.h>
 #include <ns3/node-container.h>
+#include <ns3/node-list.h>
 #include <iostream>
 #include <fstream>
 #include <algorithm>
 
 #include "nr-v2x-utils.h"
+#include "nr-v2x-rx-statistics.h"
+#include "nr-v2x-tag.h"
+#include "nr-v2x-profiler.h"
+#include "nr-v2x-worker-pool.h"
 
 namespace ns3 {
 
@@ -180,6 +185,9 @@ operator < (const NistDiscTbId_t& a, const NistDiscTbId_t& b)
   
 NS_OBJECT_ENSURE_REGISTERED (NrV2XSpectrumPhy);
 
+std::map<Time, std::vector<NrV2XSpectrumPhy*> > NrV2XSpectrumPhy::s_endRxBatches;
+NrV2XWorkerPool* NrV2XSpectrumPhy::s_decodePool = 0;
+
 NrV2XSpectrumPhy::NrV2XSpectrumPhy ()
   : m_state (IDLE),
     m_cellId (0),
@@ -198,6 +206,12 @@ NrV2XSpectrumPhy::NrV2XSpectrumPhy ()
   m_interferenceData = CreateObject<NistLteInterference> ();
   m_interferenceCtrl = CreateObject<NistLteInterference> ();
   m_interferenceSl = CreateObject<NistLteSlInterference> ();
+  SetLazySinrEvaluation (true); // default of the LazySinrEvaluation attribute
+  m_decodeWorkers = 1;
+  m_measurementSink = false;
+  m_statisticsXMin = 0;
+  m_statisticsXMax = 3500;
+  m_slSinrPrefetchTime = Seconds (-1);
  
   m_prevPrintTime = 0;
   m_totalReceptions = 0;
@@ -232,6 +246,11 @@ void NrV2XSpectrumPhy::DoDispose ()
   m_interferenceCtrl = 0;
   m_interferenceSl->Dispose ();
   m_interferenceSl = 0;
+  for (std::map<Time, std::vector<NrV2XSpectrumPhy*> >::iterator it = s_endRxBatches.begin (); it != s_endRxBatches.end (); ++it)
+  {
+    it->second.erase (std::remove (it->second.begin (), it->second.end (), this), it->second.end ());
+  }
+  m_slSinrPrefetched.clear ();
   m_ulDataSlCheck = false;
   m_RssiCallback = MakeNullCallback < void, double, std::vector <int>, uint16_t>();  // TODO FIXME New for V2V
 
@@ -350,7 +369,8 @@ NrV2XSpectrumPhy::GetTypeId (void)
     .AddAttribute ("SlotDuration",
 	           "The NR-V2X time slot duration",
 		   DoubleValue (1.0),
-		   MakeDoubleAccessor (&NrV2XSpectrumPhy::m_slotDuration),
+		   MakeDoubleAccessor (&NrV2XSpectrumPhy::SetSlotDuration,
+		                       &NrV2XSpectrumPhy::GetSlotDuration),
 		   MakeDoubleChecker<double> ())
     .AddAttribute ("SubCarrierSpacing",
 	           "The NR-V2X SubCarrier Spacing (SCS)",
@@ -372,6 +392,47 @@ NrV2XSpectrumPhy::GetTypeId (void)
 		   DoubleValue (1.0),
 		   MakeDoubleAccessor (&NrV2XSpectrumPhy::m_savingPeriod),
 		   MakeDoubleChecker<double> ())
+    .AddAttribute ("LossCountersBinWidth",
+                   "Width [m] of the Tx-Rx distance bins used to aggregate the loss counters. If 0, one entry per transmitter is kept",
+		   DoubleValue (0.0),
+		   MakeDoubleAccessor (&NrV2XSpectrumPhy::m_lossCountersBinWidth),
+		   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("MaxBufferedPackets",
+                   "Maximum number of reception records kept in memory before being saved. If 0, they are saved only at every saving period",
+		   UintegerValue (100000),
+		   MakeUintegerAccessor (&NrV2XSpectrumPhy::m_maxBufferedPackets),
+		   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("EnableRxStatistics",
+                   "If true, the outcome of each reception is aggregated online by NrV2XRxStatistics (PDR vs distance, latency and IPG histograms)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NrV2XSpectrumPhy::m_enableRxStatistics),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MeasurementSink",
+                   "If true, the decoded sidelink TBs are only accounted for here (reception records, statistics and traces), and are not delivered to the MAC and the upper layers",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NrV2XSpectrumPhy::m_measurementSink),
+                   MakeBooleanChecker ())
+    .AddAttribute ("StatisticsXMin",
+                   "Receivers with an x coordinate below this value (m) are not accounted for in the reception records and statistics",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&NrV2XSpectrumPhy::m_statisticsXMin),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("StatisticsXMax",
+                   "Receivers with an x coordinate above this value (m) are not accounted for in the reception records and statistics",
+                   DoubleValue (3500),
+                   MakeDoubleAccessor (&NrV2XSpectrumPhy::m_statisticsXMax),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("LazySinrEvaluation",
+                   "If true, the per-RB SINR of a sidelink TB is computed only when the TB reaches the SINR-based error model",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&NrV2XSpectrumPhy::SetLazySinrEvaluation,
+                                        &NrV2XSpectrumPhy::GetLazySinrEvaluation),
+                   MakeBooleanChecker ())
+    .AddAttribute ("DecodeWorkers",
+                   "Number of threads evaluating the SINR of the sidelink receptions ending in the same slot, at all the receivers. Only used with LazySinrEvaluation. The outcome of the receptions does not depend on it",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&NrV2XSpectrumPhy::m_decodeWorkers),
+                   MakeUintegerChecker<uint32_t> (1))
 
   ;
 
@@ -732,6 +793,7 @@ void
 NrV2XSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
 {
   NS_LOG_FUNCTION (this << spectrumRxParams);
+  NR_V2X_PROFILE_SCOPE (PHY_START_RX);
   NS_LOG_LOGIC (this << " ID:" << GetDevice()->GetNode()->GetId() << " state: " << m_state);
     
   Ptr <const SpectrumValue> rxPsd = spectrumRxParams->psd;
@@ -781,10 +843,6 @@ NrV2XSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
       m_interferenceSl->AddSignal (rxPsd, duration); 
       m_interferenceData->AddSignal (rxPsd, duration); //to compute UL/SL interference
 
-      // Initialize the entry if it does not exis
-      if ( (GetDevice()->GetNode()->GetId() != lteV2XSlRxParams->nodeId) && (m_lostPKTs.find(lteV2XSlRxParams->nodeId) == m_lostPKTs.end()) ) //else this entry already exists
-        m_lostPKTs[lteV2XSlRxParams->nodeId] = {0,0,0};    
-   
    //   SetRxSensitivity (-90.4); //expressed in dBm 
       std::vector <int> rbMap; 
       int i = 0;
@@ -855,61 +913,19 @@ NrV2XSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
       else
       {
         NS_LOG_INFO("Cannot receive this packet!");
-        NodeContainer GlobalContainer = NodeContainer::GetGlobal(); //Used to evaluate the transmitter-receiver distance at spectrum layer
 //        if ((posRX.x >= 1500) && (posRX.x <= 3500) && ( lteV2XSlRxParams->nodeId != GetDevice()->GetNode()->GetId()) )
-        if ((posRX.x >= 0) && (posRX.x <= 3500) && ( lteV2XSlRxParams->nodeId != GetDevice()->GetNode()->GetId()) )
+        if ((posRX.x >= m_statisticsXMin) && (posRX.x <= m_statisticsXMax) && ( lteV2XSlRxParams->nodeId != GetDevice()->GetNode()->GetId()) )
         {
-          Ptr<Node> TxNode;
-          for (NodeContainer::Iterator L = GlobalContainer.Begin(); L != GlobalContainer.End(); ++L) 
-          {
-            TxNode = *L;
-            if ( lteV2XSlRxParams->nodeId == TxNode->GetId())
-            {
-              mobTX = TxNode->GetObject<MobilityModel>();
-              break;
-            }
-          }
-          NS_LOG_INFO("Tx-rx distance: " << mobRX->GetDistanceFrom(mobTX) << " m");
-
-          PacketStatus newRx;
-          newRx.rxTime = std::floor(Simulator::Now().GetSeconds()*100)/100;
-          newRx.latency = std::round( (Simulator::Now().GetSeconds() - sci_tmp.m_genTime)*10000 )/10000;
-          newRx.TxDistance = mobRX->GetDistanceFrom(mobTX);
-          newRx.packetID = sci_tmp.m_packetID;
-          newRx.txIndex = sci_tmp.m_TxIndex;
-          newRx.selectionTrigger = sci_tmp.m_selectionTrigger;
-          newRx.announced = sci_tmp.m_announcedTB;
-          newRx.txID = TxNode->GetId();
-          newRx.rxID = GetDevice()->GetNode()->GetId();
-          newRx.decoded = false;
-
           if (totalPowerDbm < m_rxSensitivity)
           { 
             NS_LOG_INFO ("Labelling the packet as: signal level below sensitivity");
-            newRx.lossType = 0;
-            m_RssiCallback (RSSI_dBm, rbMap, TxNode->GetId());
-//            std::cin.get();
+            m_RssiCallback (RSSI_dBm, rbMap, lteV2XSlRxParams->nodeId);
+            RecordLostV2XSlData (lteV2XSlRxParams, 0);
           }
-          else if (!(!m_halfDuplexPhy || m_halfDuplexPhy->GetState () == IDLE || !(m_halfDuplexPhy->m_ulDataSlCheck)))
+          else
           {
             NS_LOG_INFO("Labelling the packet as: half-duplex loss!");
-            newRx.lossType = 1;
-          }
-          m_receivedPackets.push_back(newRx);
-
-          //Save the data
-          if ((m_saveCollisionsUniMore) && (Simulator::Now ().GetSeconds () - m_prevPrintTime > m_savingPeriod))
-          {
-            std::ofstream AlePDR; 
-            AlePDR.open(m_outputPath + "ReceivedLog.txt", std::ios_base::app);
-            for (std::vector<PacketStatus>::iterator iit = m_receivedPackets.begin(); iit != m_receivedPackets.end(); iit++)
-            {
-              AlePDR << iit->rxTime << "," << iit->packetID << "," << iit->TxDistance << "," << iit->txID << "," << iit->rxID << "," << (uint16_t) iit->decoded << "," << iit->lossType << "," << iit->txIndex << "," << iit->selectionTrigger << "," << iit->announced << "," << iit->latency << std::endl;
-            }
-            m_receivedPackets.clear();
-            //std::floor(Simulator::Now().GetSeconds()*100)/100 << "," << sci.m_packetID << "," << mobRX->GetDistanceFrom(mobTX) << "," <<  TxNode->GetId() << "," << GetDevice()->GetNode()->GetId() << ",";
-            AlePDR.close();
-            m_prevPrintTime = Simulator::Now ().GetSeconds ();
+            RecordLostV2XSlData (lteV2XSlRxParams, 1);
           }
 
          /* std::ofstream AlePDR; 
@@ -936,7 +952,7 @@ NrV2XSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
      //     NS_LOG_UNCOND(GetDevice()->GetNode()->GetId() << " receiving message from " <<lteV2XSlRxParams->nodeId);
      //      std::cin.get();
            ++m_totalReceptions;
-           ++m_lostPKTs[lteV2XSlRxParams->nodeId].propagationLosses;
+           ++GetLossCounters (lteV2XSlRxParams->nodeId).propagationLosses;
         }
         else if (!(!m_halfDuplexPhy || m_halfDuplexPhy->GetState () == IDLE || !(m_halfDuplexPhy->m_ulDataSlCheck)))
         {
@@ -982,11 +998,73 @@ NrV2XSpectrumPhy::StartRxSlData (Ptr<NistLteSpectrumSignalParametersSlFrame> par
 }
 
 //TODO FIXME NEW for V2X
+void
+NrV2XSpectrumPhy::RecordLostV2XSlData (Ptr<const NistLteSpectrumSignalParametersV2XSlFrame> params, uint8_t lossType)
+{
+  NS_LOG_FUNCTION (this << params << (uint16_t) lossType);
+  Ptr<SciV2XLteControlMessage> msg = DynamicCast<SciV2XLteControlMessage> (*(params->ctrlMsgList.begin()));
+  NistV2XSciListElement_s sci = msg->GetSci ();
+  Ptr<MobilityModel> mobRX = GetDevice()->GetNode()->GetObject<MobilityModel>();
+  Ptr<MobilityModel> mobTX = NodeList::GetNode (params->nodeId)->GetObject<MobilityModel>();
+  NS_LOG_INFO("Tx-rx distance: " << mobRX->GetDistanceFrom(mobTX) << " m");
+
+  PacketStatus newRx;
+  newRx.rxTime = std::floor(Simulator::Now().GetSeconds()*100)/100;
+  newRx.latency = std::round( (Simulator::Now().GetSeconds() - sci.m_genTime)*10000 )/10000;
+  newRx.TxDistance = mobRX->GetDistanceFrom(mobTX);
+  newRx.packetID = sci.m_packetID;
+  newRx.txIndex = sci.m_TxIndex;
+  newRx.selectionTrigger = sci.m_selectionTrigger;
+  newRx.announced = sci.m_announcedTB;
+  newRx.txID = params->nodeId;
+  newRx.rxID = GetDevice()->GetNode()->GetId();
+  newRx.decoded = false;
+  newRx.lossType = lossType;
+  if (m_enableRxStatistics)
+  {
+    NrV2XTag v2xTag;
+    uint8_t trafficType = 0x00;
+    if (params->packetBurst && params->packetBurst->GetNPackets () > 0 && (*params->packetBurst->Begin ())->FindFirstMatchingByteTag (v2xTag))
+      trafficType = v2xTag.GetTrafficType ();
+    NrV2XRxStatistics::GetInstance ()->AddReception (newRx.txID, newRx.rxID, trafficType, newRx.selectionTrigger, sci.m_packetID,
+                                                     newRx.TxDistance, newRx.lossType, Simulator::Now ().GetSeconds () - sci.m_genTime);
+  }
+  if (m_saveCollisionsUniMore) // The records are never saved otherwise
+  {
+    m_receivedPackets.push_back(newRx);
+    if ((m_maxBufferedPackets > 0) && (m_receivedPackets.size () >= m_maxBufferedPackets))
+      SaveReceivedPackets ();
+  }
+
+  if ((m_saveCollisionsUniMore) && (Simulator::Now ().GetSeconds () - m_prevPrintTime > m_savingPeriod))
+  {
+    SaveReceivedPackets ();
+    m_prevPrintTime = Simulator::Now ().GetSeconds ();
+  }
+}
+
+void
+NrV2XSpectrumPhy::NotifyV2XSlSignalDiscarded (Ptr<const SpectrumSignalParameters> params)
+{
+  NS_LOG_FUNCTION (this << params);
+  Ptr<const NistLteSpectrumSignalParametersV2XSlFrame> v2xParams = DynamicCast<const NistLteSpectrumSignalParametersV2XSlFrame> (params);
+  if ((v2xParams == 0) || (v2xParams->ctrlMsgList.size () == 0) || (v2xParams->nodeId == GetDevice()->GetNode()->GetId()))
+    return;
+  // As a signal delivered below the sensitivity by StartRx
+  ++m_totalReceptions;
+  ++GetLossCounters (v2xParams->nodeId).propagationLosses;
+  Vector posRX = GetDevice()->GetNode()->GetObject<MobilityModel>()->GetPosition();
+  if ((posRX.x >= m_statisticsXMin) && (posRX.x <= m_statisticsXMax))
+  {
+    RecordLostV2XSlData (v2xParams, 0);
+  }
+}
+
 void
 NrV2XSpectrumPhy::StartRxV2XSlData (Ptr<NistLteSpectrumSignalParametersV2XSlFrame> params)
 {
   NS_LOG_FUNCTION (this);
-  SidelinkCommResourcePool::SubframeInfo currentSF = SimulatorTimeToSubframe (Simulator::Now(), m_slotDuration);
+  SidelinkCommResourcePool::SubframeInfo currentSF = SimulatorTimeToSubframe (Simulator::Now(), m_numerologyIndex);
 //SimulatorTimeToSubframe
   NS_LOG_LOGIC(this << " ID:" << GetDevice()->GetNode()->GetId() << " state: " << m_state << " Starting to receive SL V2X Data at SF(" << currentSF.frameNo << "," << currentSF.subframeNo << ")");
 
@@ -1034,7 +1112,7 @@ NrV2XSpectrumPhy::StartRxV2XSlData (Ptr<NistLteSpectrumSignalParametersV2XSlFram
                        m_firstRxStart = Simulator::Now ();
                        m_firstRxDuration = params->duration;
                        NS_LOG_LOGIC (this << " scheduling EndRxSl with delay " << params->duration.GetSeconds () << "s");
-                       m_endRxDataEvent = Simulator::Schedule (params->duration, &NrV2XSpectrumPhy::EndRxV2XSlData, this);
+                       ScheduleEndRxV2XSlData (params->duration);
                     }
                     else
                     {
@@ -1082,7 +1160,7 @@ NrV2XSpectrumPhy::StartRxV2XSlData (Ptr<NistLteSpectrumSignalParametersV2XSlFram
                  m_firstRxStart = Simulator::Now ();
                  m_firstRxDuration = params->duration;
                  NS_LOG_LOGIC(this << " scheduling EndRxSl with delay " << params->duration.GetSeconds () << "s");
-                 m_endRxDataEvent = Simulator::Schedule (params->duration, &NrV2XSpectrumPhy::EndRxV2XSlData, this);  
+                 ScheduleEndRxV2XSlData (params->duration);
              }
              else
              {
@@ -1226,6 +1304,56 @@ NrV2XSpectrumPhy::UpdateSlSinrPerceived (std::vector <SpectrumValue> sinr)
   m_slSinrPerceived = sinr;
 }
 
+void
+NrV2XSpectrumPhy::SetLazySinrEvaluation (bool lazy)
+{
+  NS_LOG_FUNCTION (this << lazy);
+  m_lazySinrEvaluation = lazy;
+  m_interferenceSl->SetLazySinrEvaluation (lazy);
+}
+
+bool
+NrV2XSpectrumPhy::GetLazySinrEvaluation (void) const
+{
+  return m_lazySinrEvaluation;
+}
+
+void
+NrV2XSpectrumPhy::SetSlotDuration (double slotDuration)
+{
+  NS_LOG_FUNCTION (this << slotDuration);
+  m_slotDuration = slotDuration;
+  m_numerologyIndex = GetNumerologyIndex (slotDuration);
+}
+
+double
+NrV2XSpectrumPhy::GetSlotDuration (void) const
+{
+  return m_slotDuration;
+}
+
+const SpectrumValue&
+NrV2XSpectrumPhy::GetSlSinrPerceived (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  if (m_lazySinrEvaluation && !m_slSinrEvaluated.at (index))
+  {
+    NR_V2X_PROFILE_COUNT (SINR_EVALUATIONS, 1);
+    if (m_slSinrPrefetchTime == Simulator::Now () && m_slSinrPrefetched.size () == m_interferenceSl->GetNSignals ())
+    {
+      SpectrumValue sinr (m_rxSpectrumModel);
+      std::copy (m_slSinrPrefetched[index].begin (), m_slSinrPrefetched[index].end (), sinr.ValuesBegin ());
+      m_slSinrPerceived[index] = sinr;
+    }
+    else
+    {
+      m_slSinrPerceived[index] = m_interferenceSl->EvaluateSinr (index);
+    }
+    m_slSinrEvaluated[index] = true;
+  }
+  return m_slSinrPerceived.at (index);
+}
+
 void
 NrV2XSpectrumPhy::UpdateSlSigPerceived (std::vector <SpectrumValue> signal)
 {
@@ -1328,16 +1456,95 @@ NrV2XSpectrumPhy::EndRxSlData ()
 }
 
 
+void
+NrV2XSpectrumPhy::ScheduleEndRxV2XSlData (Time duration)
+{
+  NS_LOG_FUNCTION (this << duration);
+  m_endRxDataEvent = Simulator::Schedule (duration, &NrV2XSpectrumPhy::EndRxV2XSlData, this);
+  if (m_decodeWorkers > 1 && m_lazySinrEvaluation)
+  {
+    s_endRxBatches[Simulator::Now () + duration].push_back (this);
+  }
+}
+
+void
+NrV2XSpectrumPhy::PrefetchSlSinr (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::map<Time, std::vector<NrV2XSpectrumPhy*> >::iterator batch = s_endRxBatches.find (Simulator::Now ());
+  if (batch == s_endRxBatches.end ())
+  {
+    // Already done by the first receiver of this slot
+    return;
+  }
+  std::vector<NrV2XSpectrumPhy*> receivers;
+  receivers.swap (batch->second);
+  s_endRxBatches.erase (s_endRxBatches.begin (), ++batch);
+
+  // Only the SINR is evaluated in parallel: it depends on the received
+  // signals only. The error model draws random numbers and updates the
+  // statistics, so it still runs in each EndRxV2XSlData, in event order.
+  struct SinrTask
+  {
+    const NistLteSlInterference* interference;
+    uint32_t index;
+    std::vector<double>* sinr;
+  };
+  std::vector<SinrTask> tasks;
+  uint32_t workers = 1;
+  for (std::vector<NrV2XSpectrumPhy*>::iterator it = receivers.begin (); it != receivers.end (); ++it)
+  {
+    NrV2XSpectrumPhy* phy = *it;
+    // The reception may have been aborted or rescheduled. The event being
+    // executed is already expired.
+    bool ending = (phy == this) || (phy->m_endRxDataEvent.IsRunning () && phy->m_endRxDataEvent.GetTs () == (uint64_t) Simulator::Now ().GetTimeStep ());
+    if (!ending || phy->m_state != RX_DATA || !phy->m_lazySinrEvaluation || phy->m_rxSpectrumModel == 0)
+    {
+      continue;
+    }
+    phy->m_interferenceSl->PrepareSinrEvaluation ();
+    phy->m_slSinrPrefetched.assign (phy->m_interferenceSl->GetNSignals (), std::vector<double> ());
+    phy->m_slSinrPrefetchTime = Simulator::Now ();
+    for (uint32_t index = 0; index < phy->m_slSinrPrefetched.size (); index++)
+    {
+      SinrTask task = {PeekPointer (phy->m_interferenceSl), index, &phy->m_slSinrPrefetched[index]};
+      tasks.push_back (task);
+    }
+    workers = std::max (workers, phy->m_decodeWorkers);
+  }
+  NS_LOG_DEBUG (this << " evaluating " << tasks.size () << " SINRs of " << receivers.size () << " receivers with " << workers << " workers");
+
+  if (s_decodePool == 0)
+  {
+    // Kept until the end of the simulation: a larger DecodeWorkers set
+    // afterwards does not restart the threads
+    s_decodePool = new NrV2XWorkerPool (workers);
+    Simulator::ScheduleDestroy (&NrV2XSpectrumPhy::ShutdownDecodeWorkers);
+  }
+  s_decodePool->Run (tasks.size (), [&tasks] (uint32_t i)
+  {
+    tasks[i].interference->EvaluateSinr (tasks[i].index, *tasks[i].sinr);
+  });
+}
+
+void
+NrV2XSpectrumPhy::ShutdownDecodeWorkers (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  // The destructor joins the threads
+  delete s_decodePool;
+  s_decodePool = 0;
+}
+
 void
 NrV2XSpectrumPhy::EndRxV2XSlData ()
 {
   NS_LOG_FUNCTION (this);
+  NR_V2X_PROFILE_SCOPE (PHY_END_RX_SL_DATA);
   bool debugSpectrum = false;
-  double Distance;
 //  double MIMOGain = 1;
 //  double correctionFactor = 6; // Please remove it
 //  double correctionFactor = 1; // The correction factor was needed when using the NIST BLER curves. 
-  double RelativeSpeed;
   Vector posTX, posRX;
   Ptr<MobilityModel> mobTX;
 //  std::map<int,Ptr<Node>>::iterator TxNodeIT;
@@ -1346,7 +1553,7 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
   bool LOS = true;
   //bool psschCollision = false;
   // bool pscchCollision = true;
-  SidelinkCommResourcePool::SubframeInfo currentSF = SimulatorTimeToSubframe (Simulator::Now(), m_slotDuration);
+  SidelinkCommResourcePool::SubframeInfo currentSF = SimulatorTimeToSubframe (Simulator::Now(), m_numerologyIndex);
 
   // V2V
   Ptr<NormalRandomVariable> randomNormal =  CreateObject<NormalRandomVariable> ();  // Log-normal random variable for the addition of NLOSv shadowing in the Highway scenario
@@ -1368,9 +1575,19 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
  // std::cin.get();
 
   NS_ASSERT (m_state == RX_DATA);
+  if (m_lazySinrEvaluation && m_decodeWorkers > 1)
+  {
+    PrefetchSlSinr ();
+  }
   // this will trigger CQI calculation and Error Model evaluation
   // as a side effect, the error model should update the error status of all TBs
   m_interferenceSl->EndRx ();
+  if (m_lazySinrEvaluation)
+  {
+    // Nothing is computed yet: the SINR of a TB is evaluated on its first access
+    m_slSinrPerceived.assign (m_rxPacketInfo.size (), SpectrumValue ());
+    m_slSinrEvaluated.assign (m_rxPacketInfo.size (), false);
+  }
   NS_LOG_DEBUG (this << " No. of SL bursts " << m_rxPacketInfo.size ());
   NS_LOG_DEBUG (this << " Expected TBs (communication) " << m_expectedSlTbs.size ());
   NS_LOG_DEBUG (this << " Expected TBs (discovery) " << m_expectedDiscTbs.size ());
@@ -1450,29 +1667,34 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
             {
               NS_LOG_DEBUG("Also UE " << itTb_2->first.m_rnti << " transmitted on subchannel " << i);
               debugSpectrum = true;
-              std::vector<int> overlappedRBs; //Vector of the overlapped RBs
-              for (uint16_t rbId =  i*m_subChSize; rbId < i*m_subChSize + m_subChSize; rbId++)
-              { 
-                if ( (std::find(m_rxPacketInfo[itSinr_2->second].rbBitmap.begin(), m_rxPacketInfo[itSinr_2->second].rbBitmap.end(), rbId) != m_rxPacketInfo[itSinr_2->second].rbBitmap.end()) &&
-                     (std::find(m_rxPacketInfo[itSinr->second].rbBitmap.begin(), m_rxPacketInfo[itSinr->second].rbBitmap.end(), rbId) != m_rxPacketInfo[itSinr->second].rbBitmap.end()) ) 
-                overlappedRBs.push_back(rbId);
-              }
-              first_SINR = GetMeanSinr (m_slSinrPerceived[itSinr->second], overlappedRBs);
-              second_SINR = GetMeanSinr (m_slSinrPerceived[itSinr_2->second], overlappedRBs);
-              NS_LOG_DEBUG("Mean SINR of UE " << itTb->first.m_rnti << " is " << first_SINR << ", equal to " << 10*std::log10(first_SINR) << " dB");
-              NS_LOG_DEBUG("Mean SINR of UE " << itTb_2->first.m_rnti << " is " << second_SINR << ", equal to " << 10*std::log10(second_SINR) << " dB");
-              if (first_SINR < second_SINR) //The first user transmission is corrupted
+              // The outcome of the overlap is only logged: the SINRs are not evaluated otherwise,
+              // so that they are computed only for the TBs that reach the error model
+              if (g_log.IsEnabled (LOG_DEBUG))
               {
-                if (m_rxPacketInfo[itSinr->second].rbBitmap[0] == i*m_subChSize)  //If the SCI starts in the current subchannel
-                {
-                  NS_LOG_DEBUG("UE " << itTb->first.m_rnti << " lost the fight. Labelling as corrupted both the SCI and the TB");
-          //        itTb->second.corrupt = true; //Then the SCI is corrupted
-          //        itTb->second.collidedPssch = true; //Also the TB is corrupted in NR-V2X
+                std::vector<int> overlappedRBs; //Vector of the overlapped RBs
+                for (uint16_t rbId =  i*m_subChSize; rbId < i*m_subChSize + m_subChSize; rbId++)
+                { 
+                  if ( (std::find(m_rxPacketInfo[itSinr_2->second].rbBitmap.begin(), m_rxPacketInfo[itSinr_2->second].rbBitmap.end(), rbId) != m_rxPacketInfo[itSinr_2->second].rbBitmap.end()) &&
+                       (std::find(m_rxPacketInfo[itSinr->second].rbBitmap.begin(), m_rxPacketInfo[itSinr->second].rbBitmap.end(), rbId) != m_rxPacketInfo[itSinr->second].rbBitmap.end()) ) 
+                  overlappedRBs.push_back(rbId);
                 }
-                else
+                first_SINR = GetMeanSinr (GetSlSinrPerceived (itSinr->second), overlappedRBs);
+                second_SINR = GetMeanSinr (GetSlSinrPerceived (itSinr_2->second), overlappedRBs);
+                NS_LOG_DEBUG("Mean SINR of UE " << itTb->first.m_rnti << " is " << first_SINR << ", equal to " << 10*std::log10(first_SINR) << " dB");
+                NS_LOG_DEBUG("Mean SINR of UE " << itTb_2->first.m_rnti << " is " << second_SINR << ", equal to " << 10*std::log10(second_SINR) << " dB");
+                if (first_SINR < second_SINR) //The first user transmission is corrupted
                 {
-                  NS_LOG_DEBUG("UE " << itTb->first.m_rnti << " lost the fight. Labelling as corrupted only the TB");
-          //        itTb->second.collidedPssch = true; //Otherwise, only the TB is corrupted
+                  if (m_rxPacketInfo[itSinr->second].rbBitmap[0] == i*m_subChSize)  //If the SCI starts in the current subchannel
+                  {
+                    NS_LOG_DEBUG("UE " << itTb->first.m_rnti << " lost the fight. Labelling as corrupted both the SCI and the TB");
+            //        itTb->second.corrupt = true; //Then the SCI is corrupted
+            //        itTb->second.collidedPssch = true; //Also the TB is corrupted in NR-V2X
+                  }
+                  else
+                  {
+                    NS_LOG_DEBUG("UE " << itTb->first.m_rnti << " lost the fight. Labelling as corrupted only the TB");
+            //        itTb->second.collidedPssch = true; //Otherwise, only the TB is corrupted
+                  }
                 }
               }
         //      std::cin.get();
@@ -1592,24 +1814,18 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
     NS_LOG_DEBUG("Tx node ID " << itTb->first.m_rnti << " Corrupted? " <<  itTb->second.corrupt << " Collided PSSCH? " << itTb->second.collidedPssch);
     if (itTb->second.corrupt || itTb->second.collidedPssch)
     {
-      HarqProcessInfoList_t harqInfoList;
-      harqInfoList = m_harqPhyModule->GetHarqProcessInfoSl ((*itTb).first.m_rnti, (*itTb).first.m_l1dst);
-      // Search the transmitter ID within the global container
-      for (NodeContainer::Iterator L = GlobalContainer.Begin(); L != GlobalContainer.End(); ++L) 
+      // Distance and LOS state of the link, kept by the channel model. The relative speed is taken from the mobility models
+      double RelativeSpeed = m_channelModels->GetRelativeSpeed((*itTb).first.m_rnti, GetDevice()->GetNode()->GetId()); //expressed in km/h
+      const NrV2XPropagationLossModel::ChannelModel* link = m_channelModels->GetChannelModel((*itTb).first.m_rnti, GetDevice()->GetNode()->GetId());
+      if (link != 0)
       {
-        TxNode = *L;
-        if ( (*itTb).first.m_rnti == TxNode->GetId())
-        {
-          mobTX = TxNode->GetObject<MobilityModel>();
-          posTX = mobTX->GetPosition(); 
-          break;
-        }
+        NS_LOG_DEBUG(this << " TX Node: " << (*itTb).first.m_rnti << ", Tx-Rx Distance = " << link->Distance << ", LOS state " << link->LOS << " Tx-Rx relative speed = " << RelativeSpeed);
+      }
+      else
+      {
+        // The transmitter (or this node) was retired after the start of the reception: as GetLoss does, the link is not updated anymore
+        NS_LOG_DEBUG(this << " TX Node: " << (*itTb).first.m_rnti << " retired during the reception, Tx-Rx relative speed = " << RelativeSpeed);
       }
-
-      Distance = std::sqrt(std::pow(posTX.x-posRX.x,2) + std::pow(posTX.y-posRX.y,2));
-      RelativeSpeed = mobTX->GetRelativeSpeed(mobRX)*3.6; //expressed in km/h
-      bool LOSstate = m_channelModels->GetLineOfSightState(TxNode->GetId(), GetDevice()->GetNode()->GetId());
-      NS_LOG_DEBUG(this << " TX Node: " << TxNode->GetId() << " at (X,Y) = (" << posTX.x << "," << posTX.y << "), Tx-Rx Distance = " << Distance << ", LOS state " << LOSstate << " Tx-Rx relative speed = " << RelativeSpeed);
    //   std::cin.get();
       double SNR;
       for (uint16_t i = 0; i < m_expectedSlTbSNR.size(); i++)
@@ -1637,21 +1853,21 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
             if (tmp_collidedPssch)
             {
                 itTb->second.lossType = 2;
-                ++m_lostPKTs[itTb->first.m_rnti].propagationLosses;
+                ++GetLossCounters (itTb->first.m_rnti).propagationLosses;
                 NS_LOG_INFO("PSSCH Not Recovered!");
             }
             else
             {
                 NS_LOG_INFO("PSSCH Recovered Successfully!");
                 itTb->second.lossType = 3;
-                ++m_lostPKTs[itTb->first.m_rnti].collisionLosses;
+                ++GetLossCounters (itTb->first.m_rnti).collisionLosses;
             }
       }
       else
       {
          NS_LOG_INFO("PSCCH Recovery Failed! Dropping the packet");
          itTb->second.lossType = 2;
-         ++m_lostPKTs[itTb->first.m_rnti].propagationLosses;
+         ++GetLossCounters (itTb->first.m_rnti).propagationLosses;
       }
 
     }  // end if (itTb->second.corrupt || itTb->second.collidedPssch)
@@ -1669,31 +1885,27 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
       if ((m_dataErrorModelEnabled) && (m_rxPacketInfo.size () > 0) && (itSinr != expectedTbToSinrIndex.end())) // avoid to check for errors when there is no actual data transmitted
       {
           // retrieve HARQ info
-          HarqProcessInfoList_t harqInfoList;
+          uint8_t harqNumTx = 0;
           if ((*itTb).second.ndi == 0)
           {
-              harqInfoList = m_harqPhyModule->GetHarqProcessInfoSl ((*itTb).first.m_rnti, (*itTb).first.m_l1dst);
-              NS_LOG_DEBUG (this << " Nb Retx=" << harqInfoList.size());
+              harqNumTx = m_harqPhyModule->GetSlHarqProcessInfo ((*itTb).first.m_rnti, (*itTb).first.m_l1dst).size ();
+              NS_LOG_DEBUG (this << " Nb Retx=" << (uint16_t) harqNumTx);
           }
 
 
           NS_LOG_DEBUG(this << " Time " << Simulator::Now ().GetSeconds () << "\tFrom: " << (*itTb).first.m_rnti << "\tCorrupt: " << (*itTb).second.corrupt);
 
-          for (NodeContainer::Iterator L = GlobalContainer.Begin(); L != GlobalContainer.End(); ++L) 
+          double RelativeSpeed = m_channelModels->GetRelativeSpeed((*itTb).first.m_rnti, GetDevice()->GetNode()->GetId()); //expressed in km/h
+          const NrV2XPropagationLossModel::ChannelModel* link = m_channelModels->GetChannelModel((*itTb).first.m_rnti, GetDevice()->GetNode()->GetId());
+          if (link != 0)
           {
-            TxNode = *L;
-            if ( (*itTb).first.m_rnti == TxNode->GetId())
-            {
-              mobTX = TxNode->GetObject<MobilityModel>();
-              posTX = mobTX->GetPosition(); 
-              break;
-            }
+            NS_LOG_DEBUG(this << " TX Node: " << (*itTb).first.m_rnti << ", Tx-Rx Distance = " << link->Distance << ", LOS state " << link->LOS << " Tx-Rx relative speed = " << RelativeSpeed);
+          }
+          else
+          {
+            // The transmitter (or this node) was retired after the start of the reception: as GetLoss does, the link is not updated anymore
+            NS_LOG_DEBUG(this << " TX Node: " << (*itTb).first.m_rnti << " retired during the reception, Tx-Rx relative speed = " << RelativeSpeed);
           }
-
-	  Distance = std::sqrt(std::pow(posTX.x-posRX.x,2) + std::pow(posTX.y-posRX.y,2));
-          RelativeSpeed = mobTX->GetRelativeSpeed(mobRX)*3.6; //expressed in km/h
-          bool LOSstate = m_channelModels->GetLineOfSightState(TxNode->GetId(), GetDevice()->GetNode()->GetId());
-          NS_LOG_DEBUG(this << " TX Node: " << TxNode->GetId() << " at (X,Y) = (" << posTX.x << "," << posTX.y << "), Tx-Rx Distance = " << Distance << ", LOS state " << LOSstate << " Tx-Rx relative speed = " << RelativeSpeed);
       //    std::cin.get();
           double BLERrandomValue = m_random->GetValue ();
           NS_LOG_DEBUG("BLER random value: " << BLERrandomValue);
@@ -1731,10 +1943,10 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
                    (*itTb).second.collidedPssch = BLERrandomValue > tbStats.tbler ? false : true;  // m_random is uniformly distributed between 0 and 1
                    if ((*itTb).second.collidedPssch)
                    {
-                     ++m_lostPKTs[itTb->first.m_rnti].propagationLosses;
+                     ++GetLossCounters (itTb->first.m_rnti).propagationLosses;
                      itTb->second.lossType = 2;
                      NS_LOG_INFO("PSSCH Not Recovered!");
-                     NS_LOG_INFO("Propagation losses " << m_lostPKTs[itTb->first.m_rnti].propagationLosses);
+                     NS_LOG_INFO("Propagation losses " << GetLossCounters (itTb->first.m_rnti).propagationLosses);
                      //      std::cin.get();
                    }
                    else
@@ -1744,25 +1956,31 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
 		 {
 		   NS_LOG_INFO("PSCCH Recovery Failed! Dropping the packet");
                    (*itTb).second.corrupt = true; 
-                   ++m_lostPKTs[itTb->first.m_rnti].propagationLosses;
+                   ++GetLossCounters (itTb->first.m_rnti).propagationLosses;
                    itTb->second.lossType = 2;
-                   NS_LOG_INFO("Propagation losses " << m_lostPKTs[itTb->first.m_rnti].propagationLosses);
+                   NS_LOG_INFO("Propagation losses " << GetLossCounters (itTb->first.m_rnti).propagationLosses);
                  }
                                     
                  // If it was not corrupted by the propagation (using the original SNR) and if there is some interference to evaluate
-                 double SNR_new = 10*std::log10(GetLowestSinr (m_slSinrPerceived[itSinr->second], itTb->second.rbBitmap) );
-                 if ( (!itTb->second.collidedPssch) && (!itTb->second.corrupt) && ( abs(SNR_new-10*std::log10(SNR)) > 0.001 ) )
+                 // The SINR is looked up only when the SNR-based check succeeded
+                 bool evaluateSinr = (!itTb->second.collidedPssch) && (!itTb->second.corrupt);
+                 if (evaluateSinr)
+                 {
+                   double SNR_new = 10*std::log10(GetLowestSinr (GetSlSinrPerceived (itSinr->second), itTb->second.rbBitmap) );
+                   evaluateSinr = ( abs(SNR_new-10*std::log10(SNR)) > 0.001 );
+                 }
+                 if (evaluateSinr)
                  {
                    NS_LOG_DEBUG("There is some interference to evaluate and the packet is not already corrupted (either SCI or TB)");
 
                    NS_LOG_DEBUG (this << " Not already collided PSSCH. Computing the PSSCH BLER in LOS (with Interference) ");
                    //  tbStats = NrV2XPhyErrorModel::GetV2VPsschBler (itTb->second.mcs, GetMeanSinr (m_slSinrPerceived[itSinr->second], itTb->second.rbBitmap),  harqInfoList, LOS, m_SCS, itTb->second.rbBitmap.size());
 //                     tbStats = NrV2XPhyErrorModel::GetNrV2XPsschBler (itTb->second.mcs, GetMeanSinr (m_slSinrPerceived[itSinr->second], itTb->second.rbBitmap), LOS, m_SCS, RelativeSpeed);
-                   tbStats = NrV2XPhyErrorModel::GetNrV2XPsschBler (itTb->second.mcs, GetLowestSinr (m_slSinrPerceived[itSinr->second], itTb->second.rbBitmap), LOS, m_SCS, RelativeSpeed);
+                   tbStats = NrV2XPhyErrorModel::GetNrV2XPsschBler (itTb->second.mcs, GetLowestSinr (GetSlSinrPerceived (itSinr->second), itTb->second.rbBitmap), LOS, m_SCS, RelativeSpeed);
                    NS_LOG_DEBUG (this << " Computing the PSCCH BLER (1) ");
                    //  tbStatsPSCCH1 = NrV2XPhyErrorModel::GetV2VPscchBler (itTb->second.mcs, GetMeanSinrPSCCH (m_slSinrPerceived[(*itSinr).second], (*itTb).second.rbBitmap, m_subChSize),  harqInfoList, LOS, m_SCS, m_subChSize);
 //                     tbStatsPSCCH1 = NrV2XPhyErrorModel::GetNrV2XPscchBler(itTb->second.mcs, GetMeanSinrPSCCH (m_slSinrPerceived[(*itSinr).second], (*itTb).second.rbBitmap, m_subChSize), LOS, m_SCS);
-                   tbStatsPSCCH1 = NrV2XPhyErrorModel::GetNrV2XPscchBler(itTb->second.mcs, GetLowestSinrPSCCH (m_slSinrPerceived[(*itSinr).second], (*itTb).second.rbBitmap, m_subChSize), LOS, m_SCS);
+                   tbStatsPSCCH1 = NrV2XPhyErrorModel::GetNrV2XPscchBler(itTb->second.mcs, GetLowestSinrPSCCH (GetSlSinrPerceived ((*itSinr).second), (*itTb).second.rbBitmap, m_subChSize), LOS, m_SCS);
                    NS_LOG_DEBUG("TBLER PSSCH = " << tbStats.tbler << " TBLER PSCCH (1) = " << tbStatsPSCCH1.tbler);            
                    //Before looking at the PSSCH I need to check that at least one PSCCH RB has been received successfully!
 //                   if (m_random->GetValue () > tbStatsPSCCH1.tbler ? true : false || m_random->GetValue () > tbStatsPSCCH2.tbler ? true : false) // If one out of 2 PSCCH RBs is correct
@@ -1775,10 +1993,10 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
                      (*itTb).second.collidedPssch = BLERrandomValue > tbStats.tbler ? false : true;  // m_random is uniformly distributed between 0 and 1
                      if ((*itTb).second.collidedPssch)
                      {
-                       ++m_lostPKTs[itTb->first.m_rnti].collisionLosses;
+                       ++GetLossCounters (itTb->first.m_rnti).collisionLosses;
                        itTb->second.lossType = 3;
                        NS_LOG_INFO("PSSCH Not Recovered!");
-                       NS_LOG_INFO("Collision losses " << m_lostPKTs[itTb->first.m_rnti].collisionLosses);
+                       NS_LOG_INFO("Collision losses " << GetLossCounters (itTb->first.m_rnti).collisionLosses);
                      }
                      else
                        NS_LOG_INFO("PSSCH Recovered Successfully!");
@@ -1788,8 +2006,8 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
                      NS_LOG_INFO("PSCCH Recovery Failed! Dropping the packet");
                      (*itTb).second.corrupt = true; 
                      itTb->second.lossType = 3;
-                     ++m_lostPKTs[itTb->first.m_rnti].collisionLosses;
-                     NS_LOG_INFO("Collision losses " << m_lostPKTs[itTb->first.m_rnti].collisionLosses);
+                     ++GetLossCounters (itTb->first.m_rnti).collisionLosses;
+                     NS_LOG_INFO("Collision losses " << GetLossCounters (itTb->first.m_rnti).collisionLosses);
                    }                                     
                  } // end if ( (!itTb->second.collidedPssch) && (!itTb->second.corrupt) && ((uint16_t)SNR_new*10000 != (uint16_t)SNR*10000) ) //rounded at the 4th decimal place
                  else
@@ -1807,7 +2025,7 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
                  NS_LOG_DEBUG (this << " Computing the PSCCH BLER (1) ");
           //         tbStatsPSCCH1 = NrV2XPhyErrorModel::GetV2VPscchBler (itTb->second.mcs, GetMeanSinrPSCCH (m_slSinrPerceived[(*itSinr).second], (*itTb).second.rbBitmap, m_subChSize),  harqInfoList, LOS, m_SCS, m_subChSize);
 //                   tbStatsPSCCH1 =  NrV2XPhyErrorModel::GetNrV2XPscchBler(itTb->second.mcs, GetMeanSinrPSCCH (m_slSinrPerceived[(*itSinr).second], (*itTb).second.rbBitmap, m_subChSize), LOS, m_SCS);
-                 tbStatsPSCCH1 =  NrV2XPhyErrorModel::GetNrV2XPscchBler(itTb->second.mcs, GetLowestSinrPSCCH (m_slSinrPerceived[(*itSinr).second], (*itTb).second.rbBitmap, m_subChSize), LOS, m_SCS);
+                 tbStatsPSCCH1 =  NrV2XPhyErrorModel::GetNrV2XPscchBler(itTb->second.mcs, GetLowestSinrPSCCH (GetSlSinrPerceived ((*itSinr).second), (*itTb).second.rbBitmap, m_subChSize), LOS, m_SCS);
                  NS_LOG_DEBUG("TBLER PSCCH (1) = " << tbStatsPSCCH1.tbler);
                  //Before looking at the PSSCH I need to check that at least one PSCCH RB has been received successfully!
 //		 if (m_random->GetValue () > tbStatsPSCCH1.tbler ? true : false || m_random->GetValue () > tbStatsPSCCH2.tbler ? true : false) // If one out of 2 PSCCH RBs is correct
@@ -1846,9 +2064,9 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
           params.m_ndi = (*itTb).second.ndi;
      //     params.m_correctness = (uint8_t)!(*itTb).second.corrupt;
           params.m_correctness = (uint8_t)!(*itTb).second.collidedPssch;
-          params.m_sinrPerRb = GetMeanSinr (m_slSinrPerceived[(*itSinr).second], (*itTb).second.rbBitmap); // Average only on the RBs used for data
+          params.m_sinrPerRb = GetMeanSinr (GetSlSinrPerceived ((*itSinr).second), (*itTb).second.rbBitmap); // Average only on the RBs used for data
 
-          params.m_rv = harqInfoList.size ();
+          params.m_rv = harqNumTx;
           m_slPhyReception (params);     
 //          NS_LOG_DEBUG("Fired traces on SL reception PHY stats");     
 
@@ -1898,7 +2116,7 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
                 }
 
 //                if ((posRX.x >= 1500) && (posRX.x <= 3500))
-                if ((posRX.x >= 0) && (posRX.x <= 3500))
+                if ((posRX.x >= m_statisticsXMin) && (posRX.x <= m_statisticsXMax))
                 {              
                   PacketStatus newRx;
                   newRx.rxTime = std::floor(Simulator::Now().GetSeconds()*100)/100;
@@ -1928,7 +2146,21 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
                     newRx.decoded = false;
                     newRx.lossType = itTb->second.lossType;
                   }
-                  m_receivedPackets.push_back(newRx);
+                  if (m_enableRxStatistics)
+                  {
+                    NrV2XTag v2xTag;
+                    uint8_t trafficType = 0x00;
+                    if ((*j)->FindFirstMatchingByteTag (v2xTag))
+                      trafficType = v2xTag.GetTrafficType ();
+                    NrV2XRxStatistics::GetInstance ()->AddReception (newRx.txID, newRx.rxID, trafficType, newRx.selectionTrigger, sci.m_packetID,
+                                                                     newRx.TxDistance, newRx.lossType, Simulator::Now ().GetSeconds () - sci.m_genTime);
+                  }
+                  if (m_saveCollisionsUniMore) // The records are never saved otherwise
+                  {
+                    m_receivedPackets.push_back(newRx);
+                    if ((m_maxBufferedPackets > 0) && (m_receivedPackets.size () >= m_maxBufferedPackets))
+                      SaveReceivedPackets ();
+                  }
                 /*  std::ofstream AlePDR; 
                   AlePDR.open(m_outputPath + "ReceivedLog.txt", std::ios_base::app);
                   AlePDR << std::floor(Simulator::Now().GetSeconds()*100)/100 << "," << sci.m_packetID << "," << mobRX->GetDistanceFrom(mobTX) << "," <<  TxNode->GetId() << "," << GetDevice()->GetNode()->GetId() << ",";
@@ -1954,11 +2186,17 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
                   if (!(*itTb).second.collidedPssch)
                   {  
                     m_phyRxEndOkTrace (*j);
-                    if (!m_ltePhyRxDataEndOkCallback.IsNull ())
+                    if (m_measurementSink)
+                    {
+                      // The reception is already recorded: the upper layers would only discard the packet
+                      NS_LOG_DEBUG("TB from " << tbId.m_rnti << " received successfully, not delivered");
+                      ++GetLossCounters (itTb->first.m_rnti).totalOK;
+                    }
+                    else if (!m_ltePhyRxDataEndOkCallback.IsNull ())
                     { 
                       m_ltePhyRxDataEndOkCallback (*j);
                       NS_LOG_DEBUG("TB from " << tbId.m_rnti << " received successfully");
-                      ++m_lostPKTs[itTb->first.m_rnti].totalOK;
+                      ++GetLossCounters (itTb->first.m_rnti).totalOK;
                     }
                   }
                   else
@@ -2049,26 +2287,18 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
  
   //print the collisions counters file
   uint32_t pkt_SUM = 0;
-  for (std::map<uint32_t,CountersLosses>::iterator ITT = m_lostPKTs.begin(); ITT != m_lostPKTs.end(); ITT++)
+  for (std::vector<CountersLosses>::iterator ITT = m_lostPKTs.begin(); ITT != m_lostPKTs.end(); ITT++)
   {
-    pkt_SUM += ITT->second.totalOK;
-    pkt_SUM += ITT->second.collisionLosses;
-    pkt_SUM += ITT->second.propagationLosses;
+    pkt_SUM += ITT->totalOK;
+    pkt_SUM += ITT->collisionLosses;
+    pkt_SUM += ITT->propagationLosses;
   }
   NS_ASSERT_MSG(m_totalReceptions == pkt_SUM,"The counters sum does not match the number of total receptions!");
 
   if ((m_saveCollisionsUniMore) && (Simulator::Now ().GetSeconds () - m_prevPrintTime > m_savingPeriod))
   {
 
-    std::ofstream AlePDR; 
-    AlePDR.open(m_outputPath + "ReceivedLog.txt", std::ios_base::app);
-    for (std::vector<PacketStatus>::iterator iit = m_receivedPackets.begin(); iit != m_receivedPackets.end(); iit++)
-    {
-      AlePDR << iit->rxTime << "," << iit->packetID << "," << iit->TxDistance << "," << iit->txID << "," << iit->rxID << "," << (uint16_t) iit->decoded << "," << iit->lossType << "," << iit->txIndex << "," << iit->selectionTrigger << "," << iit->announced << "," << iit->latency << std::endl;
-    }
-    m_receivedPackets.clear();
-     //std::floor(Simulator::Now().GetSeconds()*100)/100 << "," << sci.m_packetID << "," << mobRX->GetDistanceFrom(mobTX) << "," <<  TxNode->GetId() << "," << GetDevice()->GetNode()->GetId() << ",";
-    AlePDR.close();
+    SaveReceivedPackets ();
 
     m_prevPrintTime = Simulator::Now ().GetSeconds ();
 /*    std::ofstream collisionCounters; 
@@ -2092,11 +2322,11 @@ NrV2XSpectrumPhy::EndRxV2XSlData ()
 
     // Reset the counters. This is mandatory for non-stationary UEs
     m_totalReceptions = 0;
-    for (std::map<uint32_t,CountersLosses>::iterator ITT = m_lostPKTs.begin(); ITT != m_lostPKTs.end(); ITT++)
+    for (std::vector<CountersLosses>::iterator ITT = m_lostPKTs.begin(); ITT != m_lostPKTs.end(); ITT++)
     {
-      ITT->second.totalOK = 0;
-      ITT->second.collisionLosses = 0;
-      ITT->second.propagationLosses = 0;
+      ITT->totalOK = 0;
+      ITT->collisionLosses = 0;
+      ITT->propagationLosses = 0;
     }
 
 //     std::cin.get();
@@ -2244,6 +2474,38 @@ NrV2XSpectrumPhy::SetTxModeGain (uint8_t txMode, double gain)
   }
 }
 
+NrV2XSpectrumPhy::CountersLosses&
+NrV2XSpectrumPhy::GetLossCounters (uint32_t txId)
+{
+  uint32_t index = txId;
+  if (m_lossCountersBinWidth > 0)
+  {
+    Ptr<MobilityModel> mobTX = NodeList::GetNode (txId)->GetObject<MobilityModel> ();
+    Ptr<MobilityModel> mobRX = GetDevice ()->GetNode ()->GetObject<MobilityModel> ();
+    index = (uint32_t) std::floor (mobRX->GetDistanceFrom (mobTX) / m_lossCountersBinWidth);
+  }
+  if (index >= m_lostPKTs.size ())
+  {
+    CountersLosses emptyCounters = {0,0,0};
+    m_lostPKTs.resize (index + 1, emptyCounters);
+  }
+  return m_lostPKTs[index];
+}
+
+void
+NrV2XSpectrumPhy::SaveReceivedPackets (void)
+{
+  NS_LOG_FUNCTION (this << m_receivedPackets.size ());
+  std::ofstream AlePDR; 
+  AlePDR.open(m_outputPath + "ReceivedLog.txt", std::ios_base::app);
+  for (std::vector<PacketStatus>::iterator iit = m_receivedPackets.begin(); iit != m_receivedPackets.end(); iit++)
+  {
+    AlePDR << iit->rxTime << "," << iit->packetID << "," << iit->TxDistance << "," << iit->txID << "," << iit->rxID << "," << (uint16_t) iit->decoded << "," << iit->lossType << "," << iit->txIndex << "," << iit->selectionTrigger << "," << iit->announced << "," << iit->latency << std::endl;
+  }
+  m_receivedPackets.clear();
+  AlePDR.close();
+}
+
 int64_t
 NrV2XSpectrumPhy::AssignStreams (int64_t stream)
 {
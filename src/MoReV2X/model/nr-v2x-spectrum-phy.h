@@ -148,6 +148,7 @@ typedef std::map<NistDiscTbId_t, NistDisctbInfo_t> expectedDiscTbs_t;
 class NistLteNetDevice;
 class AntennaModel;
 class NistLteControlMessage;
+class NrV2XWorkerPool;
 struct NistLteSpectrumSignalParametersDataFrame;
 struct NistLteSpectrumSignalParametersDlCtrlFrame;
 struct NistLteSpectrumSignalParametersUlSrsFrame;
@@ -302,6 +303,19 @@ public:
 
   void StartRxV2XSlData (Ptr<NistLteSpectrumSignalParametersV2XSlFrame> params);
 
+  /**
+   * Account for a V2X SL signal the spectrum channel did not deliver to this
+   * PHY because of its maximum coupling loss. The packet is recorded as lost
+   * below the sensitivity, as StartRx does, so the PDR also counts the links
+   * beyond the cutoff. Unlike StartRx, the RSSI callback is not invoked: the
+   * channel does not compute the received PSD of the discarded signals, and
+   * they are left out of the S-RSSI and of the CBR. NistLteHelper connects
+   * this to the SignalDiscarded trace of the channel
+   *
+   * \param params the parameters of the discarded signal
+   */
+  void NotifyV2XSlSignalDiscarded (Ptr<const SpectrumSignalParameters> params);
+
   void SetHarqPhyModule (Ptr<NistLteHarqPhy> harq);
 
   /**
@@ -632,6 +646,30 @@ bool StartTxV2XSlDataFrame (Ptr<PacketBurst> pb, std::list<Ptr<NistLteControlMes
   * \param sinr vector of interference perceived per each RB per sidelink packet
   */
   void UpdateSlIntPerceived (std::vector <SpectrumValue> interference);
+
+  /**
+  * Enable or disable the lazy SINR evaluation of the sidelink receptions
+  *
+  * \param lazy true to compute the SINR of a TB only when it is needed
+  */
+  void SetLazySinrEvaluation (bool lazy);
+
+  /**
+  * \return true if the SINR of the sidelink receptions is lazily evaluated
+  */
+  bool GetLazySinrEvaluation (void) const;
+
+  /**
+  * Set the slot duration, and the numerology index used by the slot timing
+  *
+  * \param slotDuration the slot duration (ms)
+  */
+  void SetSlotDuration (double slotDuration);
+
+  /**
+  * \return the slot duration (ms)
+  */
+  double GetSlotDuration (void) const;
   
   /** 
   * 
@@ -664,6 +702,7 @@ bool StartTxV2XSlDataFrame (Ptr<PacketBurst> pb, std::list<Ptr<NistLteControlMes
   void SetNistLtePhyRxDataStartCallback (NistLtePhyRxDataStartCallback c);
 
   friend class NrV2XUePhy;
+  friend class NrV2XTestAccess; // unit tests and benchmarks, see test/nr-v2x-test-access.h
   
  /**
   * Assign a fixed random variable stream number to the random variables
@@ -683,6 +722,13 @@ bool StartTxV2XSlDataFrame (Ptr<PacketBurst> pb, std::list<Ptr<NistLteControlMes
      
   void SetDiscNumRetx (uint8_t retx);
 
+  /**
+   * Join the threads evaluating the SINR (DecodeWorkers > 1). Called by
+   * Simulator::Destroy, and to be called before fork (): the threads are
+   * not inherited by the child. The pool is created again when needed.
+   */
+  static void ShutdownDecodeWorkers (void);
+
 private:
   void ChangeState (State newState);
   void EndTx ();
@@ -693,11 +739,14 @@ private:
 
  //TODO FIXME NEW for V2X
   void EndRxV2XSlData ();
+  void ScheduleEndRxV2XSlData (Time duration);
+  void PrefetchSlSinr (void); // evaluates the SINR of all the receptions ending now, in parallel
   
   void SetTxModeGain (uint8_t txMode, double gain);
   double GetLowestSinr (const SpectrumValue& sinr, const std::vector<int>& map);
   double GetLowestSinrPSCCH (const SpectrumValue& sinr, std::vector<int>& map, uint16_t LenPSCCH);
   double GetMeanSinr (const SpectrumValue& sinr, const std::vector<int>& map);
+  const SpectrumValue& GetSlSinrPerceived (uint32_t index); // SINR of the index-th sidelink signal, evaluated on demand if lazy
   double GetMeanSinrPSCCH (const SpectrumValue& sinr, std::vector<int>& map, uint16_t LenPSSCH); 
   int UnimoreCompareSinrPSSCH (const SpectrumValue& first_sinr, const std::vector<int>& first_map,const SpectrumValue& second_sinr, const std::vector<int>& second_map); //Added for the PSCCH and works only with adjacent allocation
   
@@ -712,6 +761,7 @@ private:
   uint16_t m_BW_RBs;
   uint16_t m_subChSize;
   double m_slotDuration;
+  uint16_t m_numerologyIndex; // derived from m_slotDuration
   uint16_t m_SCS;
 
   double m_prevPrintTime;
@@ -745,7 +795,28 @@ private:
     uint32_t totalOK;
   };
   
-  std::map<uint32_t,CountersLosses> m_lostPKTs;
+  std::vector<CountersLosses> m_lostPKTs; // indexed by Tx node ID, or by Tx-Rx distance bin if m_lossCountersBinWidth > 0
+  double m_lossCountersBinWidth; // width of the distance bins of the loss counters [m], 0 to keep one entry per transmitter
+  uint32_t m_maxBufferedPackets; // flush m_receivedPackets to file when it reaches this size (0 = only at every saving period)
+
+  /**
+  * \param txId the node ID of the transmitter
+  * \return the loss counters associated with the transmitter
+  */
+  CountersLosses& GetLossCounters (uint32_t txId);
+
+  /**
+  * Append the buffered reception records to ReceivedLog.txt and clear them
+  */
+  void SaveReceivedPackets (void);
+
+  /**
+  * Record a V2X SL signal this PHY could not receive in the reception records
+  * and statistics
+  * \param params the parameters of the signal
+  * \param lossType 0 if below the sensitivity, 1 if lost because of the half duplex
+  */
+  void RecordLostV2XSlData (Ptr<const NistLteSpectrumSignalParametersV2XSlFrame> params, uint8_t lossType);
 
   uint32_t m_totalReceptions;
 
@@ -792,6 +863,10 @@ private:
   UnimoreReportRssiCallback m_RssiCallback;
 
   bool m_saveCollisionsUniMore; // Save the collision losses and propagation losses output file
+  bool m_enableRxStatistics; // Aggregate the reception outcomes online (see NrV2XRxStatistics)
+  bool m_measurementSink; // Do not deliver the decoded sidelink TBs to the MAC
+  double m_statisticsXMin; // Region of the receivers accounted for in the statistics (m)
+  double m_statisticsXMax;
   
   NistLtePhyRxDataStartCallback m_ltePhyRxDataStartCallback;
 
@@ -809,6 +884,13 @@ private:
   std::set<uint8_t> m_l1GroupIds; // identifiers for D2D layer 1 filtering
   expectedSlTbs_t m_expectedSlTbs;  
   std::vector<SpectrumValue> m_slSinrPerceived; //SINR for each D2D packet received
+  std::vector<bool> m_slSinrEvaluated; //Whether the SINR of each D2D packet was already computed (lazy evaluation)
+  bool m_lazySinrEvaluation; // when true the SINR is computed only for the TBs that need it
+  uint32_t m_decodeWorkers; // threads evaluating the SINR of the receptions ending in the same slot
+  std::vector<std::vector<double> > m_slSinrPrefetched; // SINR of each D2D packet, evaluated by PrefetchSlSinr
+  Time m_slSinrPrefetchTime; // time at which m_slSinrPrefetched was evaluated
+  static std::map<Time, std::vector<NrV2XSpectrumPhy*> > s_endRxBatches; // receivers by end of reception, when m_decodeWorkers > 1
+  static NrV2XWorkerPool* s_decodePool; // threads of PrefetchSlSinr, owned by the simulation
   std::vector<SpectrumValue> m_slSignalPerceived; //Signal for each D2D packet received
   std::vector<SpectrumValue> m_slInterferencePerceived; //Interference for each D2D packet received
   //std::map<Ptr<NistLteControlMessage>, std::vector <int> > m_rxControlMessageRbMap;
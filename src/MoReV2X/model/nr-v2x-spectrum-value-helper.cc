@@ -30,6 +30,7 @@
 #include <fstream>
 
 #include "nr-v2x-spectrum-value-helper.h"
+#include "nr-v2x-profiler.h"
 
 // just needed to log a std::vector<int> properly...
 namespace std {
@@ -265,6 +266,7 @@ Ptr<SpectrumValue>
 NrV2XSpectrumValueHelper::CreateUlTxPowerSpectralDensity (uint16_t earfcn, uint16_t txBandwidthConfiguration, double powerTx, std::vector <int> activeRbs, double slotDuration, uint16_t SCS, uint16_t mcsIndex, bool IBE)
 {
   NS_LOG_FUNCTION (txBandwidthConfiguration << powerTx << activeRbs << SCS << mcsIndex);
+  NR_V2X_PROFILE_SCOPE (CREATE_TX_PSD);
 
   bool InBandEmissions = IBE;
   if (InBandEmissions)
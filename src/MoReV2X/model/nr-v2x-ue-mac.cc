@@ -24,6 +24,7 @@
 
 
 #include <ns3/log.h>
+#include <ns3/abort.h>
 #include <ns3/pointer.h>
 #include <ns3/packet.h>
 #include <ns3/packet-burst.h>
@@ -42,6 +43,9 @@
 #include <bitset>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <iostream>
 #include <fstream>
@@ -49,6 +53,8 @@
 #include "nr-v2x-utils.h"
 
 #include <ns3/node-container.h>
+#include "nr-v2x-profiler.h"
+#include "nr-v2x-console.h"
 
 namespace ns3 {
 
@@ -422,7 +428,8 @@ NrV2XUeMac::GetTypeId (void)
 		.AddAttribute ("SlotDuration",
 					"The NR-V2X time slot duration",
 					DoubleValue (1.0),
-					MakeDoubleAccessor (&NrV2XUeMac::m_slotDuration),
+					MakeDoubleAccessor (&NrV2XUeMac::SetSlotDuration,
+					                    &NrV2XUeMac::GetSlotDuration),
 					MakeDoubleChecker<double> ())
 		.AddAttribute ("NumerologyIndex",
 					"The NR-V2X numerology index",
@@ -464,6 +471,11 @@ NrV2XUeMac::GetTypeId (void)
                                         DoubleValue (1.0),
                                         MakeDoubleAccessor (&NrV2XUeMac::m_savingPeriod),
                                         MakeDoubleChecker<double> ())
+                .AddAttribute ("RecordSelectionInputs",
+                                        "Append the inputs and the outcome of every Mode 2 selection to SelectionInputs.txt, to replay them offline with ReplaySelection",
+                                        BooleanValue (false),
+                                        MakeBooleanAccessor (&NrV2XUeMac::m_recordSelectionInputs),
+                                        MakeBooleanChecker ())
 ;																									;
 	return tid;
 }
@@ -495,6 +507,7 @@ NrV2XUeMac::NrV2XUeMac ()
    m_keepProbability (0.0),
    m_sizeThreshold (0.2),
    m_sensingWindow (1100),
+   m_recordSelectionInputs (false),
    m_oneShotGrant (false)
 {
    NS_LOG_FUNCTION (this);
@@ -525,6 +538,12 @@ NrV2XUeMac::NrV2XUeMac ()
 
    m_prevListUpdate.frameNo = 0;
    m_prevListUpdate.subframeNo = 0;
+   m_reEvaluationState.valid = false;
+   m_reEvaluationState.rebuilds = 0;
+   m_reEvaluationState.startSlot = 0;
+   m_reEvaluationState.endSlot = 0;
+   m_reEvaluationState.N_CSR_per_SF = 0;
+   m_reEvaluationState.finalStep = 0;
    m_miUlHarqProcessesPacket.resize (HARQ_PERIOD);
    for (uint8_t i = 0; i < m_miUlHarqProcessesPacket.size (); i++)
    {
@@ -560,6 +579,8 @@ NrV2XUeMac::DoDispose ()
 {
 	NS_LOG_FUNCTION (this);
 	m_miUlHarqProcessesPacket.clear ();
+	m_PsschRsrpMap.clear ();
+	m_mobility = 0;
 	delete m_macSapProvider;
 	delete m_cmacSapProvider;
 	delete m_uePhySapUser;
@@ -1132,8 +1153,78 @@ NrV2XUeMac::CopySubchannelsMap (std::map < uint16_t, std::vector < std::pair <do
   m_subchannelsMap = inputMap;
 
   NS_ASSERT_MSG(m_subchannelsMap.size() > 0, "Geo-based subchannels map is empty!");
+
+  // Index the geo-cells with a uniform grid, whose step is the narrowest geo-cell
+  m_geoCells.clear ();
+  m_geoCellGrid.clear ();
+  double minStart = std::numeric_limits<double>::max (), maxEnd = -std::numeric_limits<double>::max ();
+  m_geoGridStep = std::numeric_limits<double>::max ();
+  for (std::map < uint16_t, std::vector < std::pair <double, double>>>::iterator mapIT = m_subchannelsMap.begin(); mapIT != m_subchannelsMap.end(); mapIT++)
+  {
+    for (std::vector < std::pair <double, double>>::iterator GeoCellsIT = mapIT->second.begin(); GeoCellsIT != mapIT->second.end(); GeoCellsIT++)
+    {
+      if (GeoCellsIT->second <= GeoCellsIT->first)
+        continue; // empty geo-cell, it never contains a UE
+      NS_ASSERT_MSG (std::isfinite (GeoCellsIT->first) && std::isfinite (GeoCellsIT->second), "Geo-cells must have finite bounds");
+      GeoCell cell;
+      cell.start = GeoCellsIT->first;
+      cell.end = GeoCellsIT->second;
+      cell.subchannel = mapIT->first;
+      m_geoCells.push_back (cell);
+      minStart = std::min (minStart, cell.start);
+      maxEnd = std::max (maxEnd, cell.end);
+      m_geoGridStep = std::min (m_geoGridStep, cell.end - cell.start);
+    }
+  }
+  if (m_geoCells.empty ())
+    return;
+
+  const double maxBuckets = 1e6;
+  m_geoGridOrigin = minStart;
+  m_geoGridStep = std::max (m_geoGridStep, (maxEnd - minStart) / maxBuckets);
+  m_geoCellGrid.resize ((uint32_t) std::ceil ((maxEnd - minStart) / m_geoGridStep));
+  for (uint32_t cellIndex = 0; cellIndex < m_geoCells.size (); cellIndex++)
+  {
+    uint32_t first = (uint32_t) std::floor ((m_geoCells[cellIndex].start - m_geoGridOrigin) / m_geoGridStep);
+    uint32_t last = (uint32_t) std::floor ((m_geoCells[cellIndex].end - m_geoGridOrigin) / m_geoGridStep);
+    for (uint32_t bucket = first; bucket <= last && bucket < m_geoCellGrid.size (); bucket++)
+      m_geoCellGrid[bucket].push_back (cellIndex);
+  }
+}
+
+
+bool
+NrV2XUeMac::GetGeoCellSubchannel (double x, uint16_t *subchannel) const
+{
+  if (m_geoCellGrid.empty () || x < m_geoGridOrigin)
+    return false;
+  uint32_t bucket = (uint32_t) std::min (std::floor ((x - m_geoGridOrigin) / m_geoGridStep), (double) m_geoCellGrid.size () - 1);
+  bool found = false;
+  for (std::vector<uint32_t>::const_iterator cellIt = m_geoCellGrid[bucket].begin (); cellIt != m_geoCellGrid[bucket].end (); cellIt++)
+  {
+    if ((x >= m_geoCells[*cellIt].start) && (x < m_geoCells[*cellIt].end))
+    {
+      *subchannel = m_geoCells[*cellIt].subchannel;
+      found = true;
+    }
+  }
+  return found;
+}
+
+
+void
+NrV2XUeMac::SetSlotDuration (double slotDuration)
+{
+  NS_LOG_FUNCTION (this << slotDuration);
+  m_slotDuration = slotDuration;
+  m_slotNumerologyIndex = GetNumerologyIndex (slotDuration);
 }
 
+double
+NrV2XUeMac::GetSlotDuration (void) const
+{
+  return m_slotDuration;
+}
 
 void
 NrV2XUeMac::PushNewRRIValue (uint16_t RRI)
@@ -1242,6 +1333,7 @@ NrV2XUeMac::V2XSidelinkGrant
 NrV2XUeMac::V2XSelectResources (uint32_t frameNo, uint32_t subframeNo, double pdb, double p_rsvp, uint8_t v2xMessageType, uint8_t v2xTrafficType, uint16_t ReselectionCounter, uint16_t PacketSize, uint16_t ReservationSize, reselectionTrigger V2Xtrigger)
 {        
    NS_LOG_FUNCTION(this);
+   NR_V2X_PROFILE_SCOPE (V2X_SELECT_RESOURCES);
          
    V2XSidelinkGrant V2XGrant;
 
@@ -1308,7 +1400,7 @@ NrV2XUeMac::V2XSelectResources (uint32_t frameNo, uint32_t subframeNo, double pd
    currentSF.subframeNo = subframeNo;
 
    NS_LOG_INFO("Resource Reselection Requested Now: SF(" <<  currentSF.frameNo << "," << currentSF.subframeNo <<  "), Time: " << Simulator::Now ().GetSeconds () << "s, estimated SF(" 
-   << SimulatorTimeToSubframe (Simulator::Now (), m_slotDuration).frameNo << "," << SimulatorTimeToSubframe (Simulator::Now (), m_slotDuration).subframeNo << ")");
+   << SimulatorTimeToSubframe (Simulator::Now (), m_slotNumerologyIndex).frameNo << "," << SimulatorTimeToSubframe (Simulator::Now (), m_slotNumerologyIndex).subframeNo << ")");
 
    uint16_t nsubCHsize = m_nsubCHsize; // [RB]
    //uint16_t startRBSubchannel = 0;
@@ -1375,6 +1467,10 @@ NrV2XUeMac::V2XSelectResources (uint32_t frameNo, uint32_t subframeNo, double pd
 //   if (m_rnti == m_debugNode)
 //     std::cin.get();
 
+   SelectionInputs recordedInputs;
+   if (m_recordSelectionInputs)
+     recordedInputs = CaptureSelectionInputs (currentSF, V2XGrant, pdb, NSubCh, L_SubCh);
+
    if (!m_randomSelection)
    {    
      L1 = Mode2Step1 (Sa, currentSF, V2XGrant, T_2, NSubCh, L_SubCh, &iterationsCounter, &psschThresh, &nCSRpastTx, false);
@@ -1390,6 +1486,17 @@ NrV2XUeMac::V2XSelectResources (uint32_t frameNo, uint32_t subframeNo, double pd
 
    NS_LOG_INFO("Initial list size = " << nCSRinitial << ". After removing past Tx = " << nCSRpastTx << ". After removing reservations = " << nCSRfinal);
 
+   if (m_recordSelectionInputs)
+   {
+     SelectionOutcome outcome;
+     outcome.iterations = iterationsCounter;
+     outcome.rsrpThreshold = psschThresh;
+     outcome.nCSRinitial = nCSRinitial;
+     outcome.nCSRpastTx = nCSRpastTx;
+     outcome.nCSRfinal = nCSRfinal;
+     SaveSelectionInputs (recordedInputs, outcome);
+   }
+
    if (m_List2Enabled)
    {
      NS_ASSERT_MSG(false, "List L2 is temporarily not available");
@@ -1449,31 +1556,24 @@ NrV2XUeMac::V2XSelectResources (uint32_t frameNo, uint32_t subframeNo, double pd
      if ((m_dynamicScheduling) && (m_FreqReuse))
      {
        NS_LOG_DEBUG("Frequency-reuse scheduling is enabled");
-       NodeContainer GlobalContainer = NodeContainer::GetGlobal();
-       Ptr<Node> Node;
-       Vector posNode;
-       Ptr<MobilityModel> mobNode;
-       for (NodeContainer::Iterator L = GlobalContainer.Begin(); L != GlobalContainer.End(); ++L) 
+       if (m_mobility == 0)
        {
-         Node = *L;
-         if (Node->GetId() == m_rnti)
+         NodeContainer GlobalContainer = NodeContainer::GetGlobal();
+         for (NodeContainer::Iterator L = GlobalContainer.Begin(); L != GlobalContainer.End(); ++L) 
          {
-           mobNode = Node->GetObject<MobilityModel>();
-           break;
+           if ((*L)->GetId() == m_rnti)
+           {
+             m_mobility = (*L)->GetObject<MobilityModel>();
+             break;
+           }
          }
-       }  
-       posNode = mobNode->GetPosition();
+       }
+       Vector posNode = m_mobility->GetPosition();
        NS_LOG_DEBUG("Node " << m_rnti << " at X = " << posNode.x << " meters");
 
-       for (std::map < uint16_t, std::vector < std::pair <double, double>>>::iterator mapIT = m_subchannelsMap.begin(); mapIT != m_subchannelsMap.end(); mapIT++)
-       {
-         std::vector < std::pair <double, double>> GeoCellsVector = mapIT->second;
-         for(std::vector < std::pair <double, double>>::iterator GeoCellsIT = GeoCellsVector.begin(); GeoCellsIT != GeoCellsVector.end(); GeoCellsIT++)
-         {
-           if ((posNode.x >= GeoCellsIT->first) && (posNode.x < GeoCellsIT->second))
-             firstSelectedCSR = mapIT->first;
-         }
-       }
+       uint16_t geoCellCSR;
+       if (GetGeoCellSubchannel (posNode.x, &geoCellCSR))
+         firstSelectedCSR = geoCellCSR;
        
        firstSelectedSF.frameNo = frameNo;
        firstSelectedSF.subframeNo = subframeNo + 1;
@@ -1720,6 +1820,165 @@ NrV2XUeMac::V2XSelectResources (uint32_t frameNo, uint32_t subframeNo, double pd
 }
 
 
+NrV2XUeMac::SelectionInputs
+NrV2XUeMac::CaptureSelectionInputs (SidelinkCommResourcePool::SubframeInfo currentSF, const V2XSidelinkGrant& V2XGrant, double pdb, uint16_t NSubCh, uint16_t L_SubCh) const
+{
+   SelectionInputs inputs;
+   inputs.nodeId = m_rnti;
+   inputs.time = Simulator::Now ().GetSeconds ();
+   inputs.currentSF = currentSF;
+   inputs.pdb = pdb;
+   inputs.rri = V2XGrant.m_RRI;
+   inputs.cresel = V2XGrant.m_Cresel;
+   inputs.nSubCh = NSubCh;
+   inputs.lSubCh = L_SubCh;
+   inputs.slotDuration = m_slotDuration;
+   inputs.numerologyIndex = m_numerologyIndex;
+   inputs.rsrpThreshold = m_rsrpThreshold;
+   inputs.sizeThreshold = m_sizeThreshold;
+   inputs.rriList = m_RRIvalues;
+   for (std::list<std::pair<Time,SidelinkCommResourcePool::SubframeInfo> >::const_iterator pastTxIt = m_pastTxUnimore.begin (); pastTxIt != m_pastTxUnimore.end (); pastTxIt++)
+     inputs.pastTx.push_back (pastTxIt->second);
+   inputs.sensed = m_sensedReservedCSRMap;
+   return inputs;
+}
+
+
+void
+NrV2XUeMac::SaveSelectionInputs (const SelectionInputs& inputs, const SelectionOutcome& outcome)
+{
+   std::ofstream inputsFile;
+   inputsFile.open (m_outputPath + "SelectionInputs.txt", std::ios_base::app);
+   WriteSelectionInputs (inputsFile, inputs, outcome);
+   inputsFile.close ();
+}
+
+
+void
+NrV2XUeMac::WriteSelectionInputs (std::ostream& os, const SelectionInputs& inputs, const SelectionOutcome& outcome)
+{
+   // The RSRP values are compared with the threshold, they must be read back exactly
+   std::streamsize precision = os.precision (std::numeric_limits<double>::max_digits10);
+
+   os << "selection " << inputs.nodeId << " " << inputs.time << " " << inputs.currentSF.frameNo << " " << inputs.currentSF.subframeNo << " " << inputs.pdb << " "
+      << inputs.rri << " " << inputs.cresel << " " << inputs.nSubCh << " " << inputs.lSubCh << " " << inputs.slotDuration << " " << inputs.numerologyIndex << " "
+      << inputs.rsrpThreshold << " " << inputs.sizeThreshold << "\n";
+
+   os << "rri " << inputs.rriList.size ();
+   for (std::vector<uint16_t>::const_iterator rriIt = inputs.rriList.begin (); rriIt != inputs.rriList.end (); rriIt++)
+     os << " " << *rriIt;
+   os << "\n";
+
+   os << "pasttx " << inputs.pastTx.size ();
+   for (std::list<SidelinkCommResourcePool::SubframeInfo>::const_iterator pastTxIt = inputs.pastTx.begin (); pastTxIt != inputs.pastTx.end (); pastTxIt++)
+     os << " " << pastTxIt->frameNo << " " << pastTxIt->subframeNo;
+   os << "\n";
+
+   uint32_t nSensed = 0;
+   std::map < uint16_t, std::map < SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR> > >::const_iterator sensedIt;
+   std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR> >::const_iterator sensedSFIt;
+   for (sensedIt = inputs.sensed.begin (); sensedIt != inputs.sensed.end (); sensedIt++)
+     for (sensedSFIt = sensedIt->second.begin (); sensedSFIt != sensedIt->second.end (); sensedSFIt++)
+       nSensed += sensedSFIt->second.size ();
+   os << "sensed " << nSensed << "\n";
+   // csr frame subframe rbStart rbLen rsrp reservedFrame reservedSubframe cresel nodeId rri isReTx isSameTB
+   for (sensedIt = inputs.sensed.begin (); sensedIt != inputs.sensed.end (); sensedIt++)
+     for (sensedSFIt = sensedIt->second.begin (); sensedSFIt != sensedIt->second.end (); sensedSFIt++)
+       for (std::vector<ReservedCSR>::const_iterator resIt = sensedSFIt->second.begin (); resIt != sensedSFIt->second.end (); resIt++)
+         os << sensedIt->first << " " << sensedSFIt->first.frameNo << " " << sensedSFIt->first.subframeNo << " " << resIt->rbStart << " " << resIt->rbLen << " "
+            << resIt->psschRsrpDb << " " << resIt->reservedSF.frameNo << " " << resIt->reservedSF.subframeNo << " " << resIt->CreselRx << " " << resIt->nodeId << " "
+            << resIt->RRI << " " << resIt->isReTx << " " << resIt->isSameTB << "\n";
+
+   os << "outcome " << outcome.iterations << " " << outcome.rsrpThreshold << " " << outcome.nCSRinitial << " " << outcome.nCSRpastTx << " " << outcome.nCSRfinal << std::endl;
+
+   os.precision (precision);
+}
+
+
+bool
+NrV2XUeMac::ReadSelectionInputs (std::istream& is, SelectionInputs *inputs, SelectionOutcome *outcome)
+{
+   std::string keyword;
+   if (!(is >> keyword))
+     return false;
+   NS_ABORT_MSG_UNLESS (keyword == "selection", "Malformed selection inputs: expected \"selection\", found \"" << keyword << "\"");
+   is >> inputs->nodeId >> inputs->time >> inputs->currentSF.frameNo >> inputs->currentSF.subframeNo >> inputs->pdb >> inputs->rri >> inputs->cresel
+      >> inputs->nSubCh >> inputs->lSubCh >> inputs->slotDuration >> inputs->numerologyIndex >> inputs->rsrpThreshold >> inputs->sizeThreshold;
+
+   uint32_t n;
+   is >> keyword >> n;
+   NS_ABORT_MSG_UNLESS (is && keyword == "rri", "Malformed selection inputs of node " << inputs->nodeId << " at " << inputs->time << " s");
+   inputs->rriList.resize (n);
+   for (uint32_t i = 0; i < n; i++)
+     is >> inputs->rriList[i];
+
+   is >> keyword >> n;
+   NS_ABORT_MSG_UNLESS (is && keyword == "pasttx", "Malformed selection inputs of node " << inputs->nodeId << " at " << inputs->time << " s");
+   inputs->pastTx.clear ();
+   for (uint32_t i = 0; i < n; i++)
+   {
+     SidelinkCommResourcePool::SubframeInfo pastTxSF;
+     is >> pastTxSF.frameNo >> pastTxSF.subframeNo;
+     inputs->pastTx.push_back (pastTxSF);
+   }
+
+   is >> keyword >> n;
+   NS_ABORT_MSG_UNLESS (is && keyword == "sensed", "Malformed selection inputs of node " << inputs->nodeId << " at " << inputs->time << " s");
+   inputs->sensed.clear ();
+   for (uint32_t i = 0; i < n; i++)
+   {
+     uint16_t csr;
+     SidelinkCommResourcePool::SubframeInfo receivedSF;
+     ReservedCSR reservation;
+     is >> csr >> receivedSF.frameNo >> receivedSF.subframeNo >> reservation.rbStart >> reservation.rbLen >> reservation.psschRsrpDb
+        >> reservation.reservedSF.frameNo >> reservation.reservedSF.subframeNo >> reservation.CreselRx >> reservation.nodeId >> reservation.RRI
+        >> reservation.isReTx >> reservation.isSameTB;
+     reservation.reservationTime = Seconds (0); // not used by the selection
+     inputs->sensed[csr][receivedSF].push_back (reservation);
+   }
+
+   is >> keyword >> outcome->iterations >> outcome->rsrpThreshold >> outcome->nCSRinitial >> outcome->nCSRpastTx >> outcome->nCSRfinal;
+   NS_ABORT_MSG_UNLESS (is && keyword == "outcome", "Malformed selection inputs of node " << inputs->nodeId << " at " << inputs->time << " s");
+   return true;
+}
+
+
+NrV2XUeMac::SelectionOutcome
+NrV2XUeMac::ReplaySelection (const SelectionInputs& inputs)
+{
+   NS_LOG_FUNCTION(this);
+
+   m_rnti = m_debugNode + 1; // never save the debug files of the selection
+   SetSlotDuration (inputs.slotDuration);
+   m_numerologyIndex = inputs.numerologyIndex;
+   m_sizeThreshold = inputs.sizeThreshold;
+   m_RRIvalues = inputs.rriList;
+   m_sensedReservedCSRMap = inputs.sensed;
+   m_reEvaluationState.valid = false;
+   m_pastTxUnimore.clear ();
+   for (std::list<SidelinkCommResourcePool::SubframeInfo>::const_iterator pastTxIt = inputs.pastTx.begin (); pastTxIt != inputs.pastTx.end (); pastTxIt++)
+     m_pastTxUnimore.push_back (std::make_pair (Seconds (0), *pastTxIt));
+
+   V2XSidelinkGrant V2XGrant;
+   V2XGrant.m_RRI = inputs.rri;
+   V2XGrant.m_Cresel = inputs.cresel;
+
+   // As in V2XSelectResources
+   double T_2 = inputs.pdb - m_slotDuration;
+   uint32_t T_2_slots = T_2/m_slotDuration;
+
+   SelectionOutcome outcome;
+   outcome.iterations = 0;
+   outcome.rsrpThreshold = inputs.rsrpThreshold;
+   std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa, L1;
+   Sa = SelectionWindow (inputs.currentSF, T_2_slots, inputs.nSubCh - inputs.lSubCh + 1);
+   outcome.nCSRinitial = ComputeResidualCSRs (Sa);
+   L1 = Mode2Step1 (Sa, inputs.currentSF, V2XGrant, T_2, inputs.nSubCh, inputs.lSubCh, &outcome.iterations, &outcome.rsrpThreshold, &outcome.nCSRpastTx, false);
+   outcome.nCSRfinal = ComputeResidualCSRs (L1);
+   return outcome;
+}
+
+
 std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo>>
 NrV2XUeMac::SelectionWindow (SidelinkCommResourcePool::SubframeInfo currentSF, uint32_t T_2_slots, uint16_t N_CSR_per_SF)
 {
@@ -1757,6 +2016,7 @@ NrV2XUeMac::Mode2Step1 (std::map<uint16_t,std::list<SidelinkCommResourcePool::Su
 V2XSidelinkGrant V2XGrant, double T_2, uint16_t NSubCh,  uint16_t L_SubCh, uint32_t *iterationsCounter, double *psschThresh, uint32_t *nCSRpartial, bool OnlyReTxions)
 {
    NS_LOG_FUNCTION(this);
+   NR_V2X_PROFILE_SCOPE (MODE2_STEP1);
    std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa_pastTx, L1;
 
    Sa_pastTx = Sa; 
@@ -2121,6 +2381,7 @@ V2XSidelinkGrant V2XGrant, double T_2, uint16_t NSubCh,  uint16_t L_SubCh, uint3
      nCSRresidual = ComputeResidualCSRs (L1);
      *psschThresh += 3;
      *iterationsCounter += 1;
+     NR_V2X_PROFILE_COUNT (RSRP_THRESHOLD_INCREASES, 1);
 
    } //end while
         
@@ -2143,6 +2404,418 @@ V2XSidelinkGrant V2XGrant, double T_2, uint16_t NSubCh,  uint16_t L_SubCh, uint3
 }
 
 
+void
+NrV2XUeMac::ReEvaluationStep1 (SidelinkCommResourcePool::SubframeInfo currentSF, uint32_t T_2_slots, uint16_t N_CSR_per_SF,
+V2XSidelinkGrant V2XGrant, double T_2, uint16_t NSubCh,  uint16_t L_SubCh, uint32_t *iterationsCounter, double *psschThresh, uint32_t *nCSRpartial, bool OnlyReTxions)
+{
+   NS_LOG_FUNCTION(this);
+   NR_V2X_PROFILE_SCOPE (MODE2_STEP1);
+   ReEvaluationState& state = m_reEvaluationState;
+
+   // Remove old frames used for transmission
+   m_prevListUpdate.frameNo = currentSF.frameNo+1;
+   m_prevListUpdate.subframeNo = currentSF.subframeNo+1;
+   UpdatePastTxInfo(currentSF.frameNo+1, currentSF.subframeNo+1);
+
+   // Selection window, as built by SelectionWindow
+  // uint32_t T_1_slots = GetTproc1 (m_numerologyIndex);
+   uint32_t T_1_slots = 2;
+   if (T_2_slots < T_1_slots || N_CSR_per_SF == 0)
+   {
+     NS_FATAL_ERROR("Selection window is empty");
+   }
+   uint32_t currentSlot = currentSF.frameNo*10 + currentSF.subframeNo;
+   uint32_t startSlot = (currentSlot + T_1_slots) % 10240;
+   uint32_t endSlot = (currentSlot + T_2_slots) % 10240;
+   uint32_t windowSlots = T_2_slots - T_1_slots + 1;
+   uint16_t RRI_slots = V2XGrant.m_RRI/m_slotDuration;
+
+   // The window of a later re-evaluation of the same packet ends in the same slot, with a smaller T_2: its candidates are a
+   // subset of the previous ones, and the reservations and past transmissions are the only inputs that changed in the meantime
+   uint32_t shift = (startSlot + 10240 - state.startSlot) % 10240;
+   if (state.valid && endSlot == state.endSlot && shift < (state.endSlot + 10240 - state.startSlot) % 10240 + 1 && T_2 <= state.T_2
+       && *psschThresh == state.initialThresh && NSubCh == state.NSubCh && L_SubCh == state.L_SubCh && N_CSR_per_SF == state.N_CSR_per_SF
+       && RRI_slots == state.RRI_slots && V2XGrant.m_Cresel == state.Cresel && OnlyReTxions == state.onlyReTxions)
+   {
+     NS_LOG_DEBUG("Re-evaluation window shifted by " << shift << " slots");
+     for (uint32_t i = 0; i < shift; i++)
+     {
+       for (uint16_t CSRindex = 0; CSRindex < N_CSR_per_SF; CSRindex++)
+       {
+         std::unordered_map<uint32_t, ReEvaluationCandidate>::iterator candidateIt = state.candidates.find (CSRindex*10240 + (state.startSlot + i) % 10240);
+         ReEvaluationCount (candidateIt->second, false);
+         state.candidates.erase (candidateIt);
+       }
+     }
+   }
+   else
+   {
+     NS_LOG_DEBUG("Building the re-evaluation window");
+     state.valid = true;
+     state.rebuilds++;
+     state.endSlot = endSlot;
+     state.initialThresh = *psschThresh;
+     state.NSubCh = NSubCh;
+     state.L_SubCh = L_SubCh;
+     state.N_CSR_per_SF = N_CSR_per_SF;
+     state.RRI_slots = RRI_slots;
+     state.Cresel = V2XGrant.m_Cresel;
+     state.onlyReTxions = OnlyReTxions;
+     state.candidates.clear ();
+     state.thresholds.assign (1, *psschThresh);
+     state.stepCount.clear ();
+     state.nCandidates = 0;
+     state.reservedSlots.clear ();
+     state.appliedQ.clear ();
+     state.pending.clear ();
+     state.periodic.clear ();
+     state.pastTxSlots.clear ();
+     ReEvaluationCandidate candidate;
+     candidate.exclusionRsrp = -std::numeric_limits<double>::infinity ();
+     candidate.pastTxHits = 0;
+     candidate.thresholdStep = 0;
+     for (uint16_t CSRindex = 0; CSRindex < N_CSR_per_SF; CSRindex++)
+     {
+       for (uint32_t i = 0; i < windowSlots; i++)
+       {
+         std::pair<std::unordered_map<uint32_t, ReEvaluationCandidate>::iterator, bool> candidateIt = state.candidates.insert (std::make_pair (CSRindex*10240 + (startSlot + i) % 10240, candidate));
+         ReEvaluationCount (candidateIt.first->second, true);
+       }
+     }
+     std::map < uint16_t, std::map < SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR> > >::iterator sensedIt;
+     for (sensedIt = m_sensedReservedCSRMap.begin (); sensedIt != m_sensedReservedCSRMap.end (); sensedIt++)
+     {
+       std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR> >::iterator sensedSFIt;
+       for (sensedSFIt = sensedIt->second.begin(); sensedSFIt != sensedIt->second.end(); sensedSFIt++)
+       {
+         for (uint32_t index = 0; index < sensedSFIt->second.size (); index++)
+         {
+           ReEvaluationReservation reservation = {sensedIt->first, sensedSFIt->first, index};
+           state.pending.push_back (reservation);
+         }
+       }
+     }
+   }
+   state.startSlot = startSlot;
+   state.T_2 = T_2;
+
+   // Slots of my past transmissions, as in Mode2Step1: only the difference with the previous re-evaluation is applied
+   std::unordered_set<uint32_t> rm_pastTx_slots;
+   std::list<std::pair<Time,SidelinkCommResourcePool::SubframeInfo>>::iterator pastTxIt;
+   for(std::vector<uint16_t>::iterator RRIit = m_RRIvalues.begin(); RRIit != m_RRIvalues.end(); RRIit++)
+   {
+     uint16_t RRI_to_slot = *RRIit/m_slotDuration;
+     for (pastTxIt = m_pastTxUnimore.begin (); pastTxIt != m_pastTxUnimore.end (); pastTxIt++)
+     {
+       uint16_t Q = 1;
+       if ((SubtractFrames( currentSF.frameNo, pastTxIt->second.frameNo, currentSF.subframeNo, pastTxIt->second.subframeNo) <= *RRIit) && (*RRIit < (T_2 + 1)) )
+         Q = std::ceil( (float) T_2/ *RRIit );
+       for(uint16_t q = 1; q <= Q; q++)
+       {
+         uint32_t subframeNo = (pastTxIt->second.subframeNo + q*RRI_to_slot)%10;
+         uint32_t frameNo = (pastTxIt->second.frameNo  + (pastTxIt->second.subframeNo + q*RRI_to_slot) / 10) % 1024;
+         rm_pastTx_slots.insert (frameNo*10 + subframeNo);
+       }
+     }
+   }
+   for (std::unordered_set<uint32_t>::iterator slotIt = state.pastTxSlots.begin (); slotIt != state.pastTxSlots.end (); slotIt++)
+   {
+     if (rm_pastTx_slots.find (*slotIt) == rm_pastTx_slots.end ())
+       ReEvaluationPastTx (*slotIt, false);
+   }
+   for (std::unordered_set<uint32_t>::iterator slotIt = rm_pastTx_slots.begin (); slotIt != rm_pastTx_slots.end (); slotIt++)
+   {
+     if (state.pastTxSlots.find (*slotIt) == state.pastTxSlots.end ())
+       ReEvaluationPastTx (*slotIt, true);
+   }
+   state.pastTxSlots.swap (rm_pastTx_slots);
+
+   NS_ASSERT_MSG(state.nCandidates > 0, "List of candidate resources is empty after removing past transmissions");
+   uint32_t nCSRtot = state.nCandidates;
+   uint32_t nCSRresidual = 0;
+   *nCSRpartial = nCSRtot;
+
+   if (m_rnti == m_debugNode)
+   {
+     std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > L1 = ReEvaluationL1 (false);
+     std::ofstream L1fileAlert;
+     L1fileAlert.open (m_outputPath + "L1fileAlert.txt", std::ios_base::app);
+     L1fileAlert << "-----Initial L1 (after past Tx) ------ At time " << Simulator::Now().GetSeconds() << ", UE " << m_rnti << " at SF(" << currentSF.frameNo << "," << currentSF.subframeNo << ") Residual resources " << nCSRtot << " ----------" << std::endl;
+     for(std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> >::iterator L1it = L1.begin(); L1it != L1.end(); L1it++)
+     {
+       for(std::list<SidelinkCommResourcePool::SubframeInfo>::iterator FrameIT = L1it->second.begin(); FrameIT != L1it->second.end(); FrameIT++)
+         L1fileAlert << "CSR index " << L1it->first << " Frame " << FrameIT->frameNo << " subframe " << FrameIT->subframeNo << std::endl;
+     }
+     L1fileAlert.close ();
+   }
+
+   double L1targetSize = m_sizeThreshold;
+   state.finalStep = std::numeric_limits<uint32_t>::max ();
+   if (nCSRresidual < L1targetSize * nCSRtot)
+   {
+     // Removes the reservations outside of the sensing window from the state as well
+     UpdateSensedCSR(currentSF.frameNo+1, currentSF.subframeNo+1);
+
+     // The reservations repeated within the window (Q > 1) lose their last repetitions as the window shrinks
+     for (std::list<ReEvaluationReservation>::iterator resIt = state.periodic.begin (); resIt != state.periodic.end (); )
+     {
+       std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<uint16_t> >::iterator appliedIt = state.appliedQ[resIt->CSRindex].find (resIt->receivedSF);
+       if (appliedIt == state.appliedQ[resIt->CSRindex].end ())
+       {
+         resIt = state.periodic.erase (resIt);
+         continue;
+       }
+       uint32_t sensedAge = SubtractFrames(currentSF.frameNo, resIt->receivedSF.frameNo, currentSF.subframeNo, resIt->receivedSF.subframeNo);
+       uint16_t Q = ReEvaluationQ (m_sensedReservedCSRMap[resIt->CSRindex][resIt->receivedSF][resIt->index], sensedAge);
+       if (Q < appliedIt->second[resIt->index])
+         ReEvaluationApply (*resIt, Q);
+       if (Q > 1)
+         resIt++;
+       else
+         resIt = state.periodic.erase (resIt);
+     }
+
+     // New reservations, and the ones received within Tproc0 by the previous re-evaluations
+     uint16_t Tproc0 = GetTproc0 (m_numerologyIndex);
+     for (std::list<ReEvaluationReservation>::iterator resIt = state.pending.begin (); resIt != state.pending.end (); )
+     {
+       std::map <uint16_t, std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR> > >::iterator sensedIt = m_sensedReservedCSRMap.find (resIt->CSRindex);
+       std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR> >::iterator sensedSFIt;
+       if (sensedIt == m_sensedReservedCSRMap.end () || (sensedSFIt = sensedIt->second.find (resIt->receivedSF)) == sensedIt->second.end ())
+       {
+         resIt = state.pending.erase (resIt);
+         continue;
+       }
+       uint32_t sensedAge = SubtractFrames(currentSF.frameNo, resIt->receivedSF.frameNo, currentSF.subframeNo, resIt->receivedSF.subframeNo);
+       if (sensedAge <= Tproc0)
+       {
+         resIt++;
+         continue;
+       }
+       ReservedCSR& reservation = sensedSFIt->second[resIt->index];
+       if (!OnlyReTxions || (reservation.isReTx && reservation.isSameTB))
+       {
+         uint16_t Q = ReEvaluationQ (reservation, sensedAge);
+         ReEvaluationApply (*resIt, Q);
+         if (Q > 1)
+           state.periodic.push_back (*resIt);
+       }
+       resIt = state.pending.erase (resIt);
+     }
+
+     // Candidates per threshold step: each RSRP threshold increase only adds the next step to L1
+     uint32_t step = 0;
+     while (nCSRresidual < L1targetSize * nCSRtot)
+     {
+       if (m_rnti == m_debugNode)
+         NrV2XUeMac::UnimorePrintSensedCSR(m_sensedReservedCSRMap, currentSF, true);
+
+       if (step < state.stepCount.size ())
+         nCSRresidual += state.stepCount[step];
+       state.finalStep = step++;
+       *psschThresh += 3;
+       *iterationsCounter += 1;
+       NR_V2X_PROFILE_COUNT (RSRP_THRESHOLD_INCREASES, 1);
+     }
+   }
+
+   if (m_rnti == m_debugNode)
+   {
+     std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > L1 = ReEvaluationL1 (true);
+     std::ofstream L1fileAlert;
+     L1fileAlert.open (m_outputPath + "L1fileAlert.txt", std::ios_base::app);
+     L1fileAlert << "-----Final L1------ At time " << Simulator::Now().GetSeconds() << ", UE " << m_rnti << " at SF(" << currentSF.frameNo << "," << currentSF.subframeNo << ") Residual resources " << nCSRresidual << " ----------" << std::endl;
+     for(std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> >::iterator L1it = L1.begin(); L1it != L1.end(); L1it++)
+     {
+       for(std::list<SidelinkCommResourcePool::SubframeInfo>::iterator FrameIT = L1it->second.begin(); FrameIT != L1it->second.end(); FrameIT++)
+         L1fileAlert << "CSR index " << L1it->first << " Frame " << FrameIT->frameNo << " subframe " << FrameIT->subframeNo << std::endl;
+     }
+     L1fileAlert.close ();
+   }
+
+}
+
+
+bool
+NrV2XUeMac::IsReEvaluationCandidate (uint16_t CSRindex, SidelinkCommResourcePool::SubframeInfo candidateSF)
+{
+   std::unordered_map<uint32_t, ReEvaluationCandidate>::iterator candidateIt = m_reEvaluationState.candidates.find (CSRindex*10240 + candidateSF.frameNo*10 + candidateSF.subframeNo);
+   if (candidateIt == m_reEvaluationState.candidates.end ())
+     return false;
+   return candidateIt->second.pastTxHits == 0 && candidateIt->second.thresholdStep <= m_reEvaluationState.finalStep;
+}
+
+
+std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo>>
+NrV2XUeMac::ReEvaluationL1 (bool final)
+{
+   std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > L1;
+   uint32_t windowSlots = (m_reEvaluationState.endSlot + 10240 - m_reEvaluationState.startSlot) % 10240 + 1;
+   for (uint16_t CSRindex = 0; CSRindex < m_reEvaluationState.N_CSR_per_SF; CSRindex++)
+   {
+     std::list<SidelinkCommResourcePool::SubframeInfo>& SFlist = L1[CSRindex];
+     for (uint32_t i = 0; i < windowSlots; i++)
+     {
+       uint32_t slot = (m_reEvaluationState.startSlot + i) % 10240;
+       ReEvaluationCandidate& candidate = m_reEvaluationState.candidates[CSRindex*10240 + slot];
+       if (candidate.pastTxHits == 0 && (!final || candidate.thresholdStep <= m_reEvaluationState.finalStep))
+       {
+         SidelinkCommResourcePool::SubframeInfo candidateSF;
+         candidateSF.frameNo = slot / 10;
+         candidateSF.subframeNo = slot % 10;
+         SFlist.push_back (candidateSF);
+       }
+     }
+   }
+   return L1;
+}
+
+
+uint32_t
+NrV2XUeMac::ReEvaluationThresholdStep (double rsrp)
+{
+   std::vector<double>& thresholds = m_reEvaluationState.thresholds;
+   for (uint32_t step = 0; ; step++)
+   {
+     if (step == thresholds.size ())
+       thresholds.push_back (thresholds.back () + 3);
+     if (rsrp < thresholds[step])
+       return step;
+   }
+}
+
+
+void
+NrV2XUeMac::ReEvaluationCount (ReEvaluationCandidate &candidate, bool add)
+{
+   if (candidate.pastTxHits > 0)
+     return;
+   if (m_reEvaluationState.stepCount.size () <= candidate.thresholdStep)
+     m_reEvaluationState.stepCount.resize (candidate.thresholdStep + 1, 0);
+   if (add)
+   {
+     m_reEvaluationState.stepCount[candidate.thresholdStep]++;
+     m_reEvaluationState.nCandidates++;
+   }
+   else
+   {
+     m_reEvaluationState.stepCount[candidate.thresholdStep]--;
+     m_reEvaluationState.nCandidates--;
+   }
+}
+
+
+void
+NrV2XUeMac::ReEvaluationPastTx (uint32_t slot, bool add)
+{
+   // Candidates whose future transmissions (reselection counter + RRI) fall in the slot
+   ReEvaluationState& state = m_reEvaluationState;
+   for (uint16_t CSRindex = 0; CSRindex < state.N_CSR_per_SF; CSRindex++)
+   {
+     for (uint32_t Cresel = 0; Cresel < state.Cresel; Cresel++)
+     {
+       uint32_t candidateSlot = (slot + 10240 - (Cresel*state.RRI_slots) % 10240) % 10240;
+       std::unordered_map<uint32_t, ReEvaluationCandidate>::iterator candidateIt = state.candidates.find (CSRindex*10240 + candidateSlot);
+       if (candidateIt == state.candidates.end ())
+         continue;
+       ReEvaluationCount (candidateIt->second, false);
+       if (add)
+         candidateIt->second.pastTxHits++;
+       else
+         candidateIt->second.pastTxHits--;
+       ReEvaluationCount (candidateIt->second, true);
+     }
+   }
+}
+
+
+void
+NrV2XUeMac::ReEvaluationReserve (uint16_t CSRindex, uint32_t slot, double rsrp, bool add)
+{
+   ReEvaluationState& state = m_reEvaluationState;
+   std::unordered_map<uint32_t, std::multiset<double> >& slots = state.reservedSlots[CSRindex];
+   if (add)
+     slots[slot].insert (rsrp);
+   else
+   {
+     std::unordered_map<uint32_t, std::multiset<double> >::iterator slotIt = slots.find (slot);
+     slotIt->second.erase (slotIt->second.find (rsrp));
+     if (slotIt->second.empty ())
+       slots.erase (slotIt);
+   }
+
+   // Candidates spanning the subchannel whose future transmissions (reselection counter + RRI) fall in the slot
+   int firstCSR = std::max (0, (int) CSRindex - state.L_SubCh + 1);
+   int lastCSR = std::min ((int) CSRindex, state.N_CSR_per_SF - 1);
+   for (int candidateCSR = firstCSR; candidateCSR <= lastCSR; candidateCSR++)
+   {
+     for (uint32_t Cresel = 0; Cresel < state.Cresel; Cresel++)
+     {
+       uint32_t candidateSlot = (slot + 10240 - (Cresel*state.RRI_slots) % 10240) % 10240;
+       std::unordered_map<uint32_t, ReEvaluationCandidate>::iterator candidateIt = state.candidates.find (candidateCSR*10240 + candidateSlot);
+       if (candidateIt == state.candidates.end ())
+         continue;
+       double exclusionRsrp = candidateIt->second.exclusionRsrp;
+       if (add)
+         exclusionRsrp = std::max (exclusionRsrp, rsrp);
+       else if (rsrp >= exclusionRsrp)
+       {
+         // The removed reservation may have been the highest one: look at all of them again
+         exclusionRsrp = -std::numeric_limits<double>::infinity ();
+         for (uint32_t futureTx = 0; futureTx < state.Cresel; futureTx++)
+         {
+           uint32_t futureSlot = (candidateSlot + futureTx*state.RRI_slots) % 10240;
+           for (uint16_t subCH_index = candidateCSR; subCH_index < candidateCSR + state.L_SubCh && subCH_index < state.NSubCh; subCH_index++)
+           {
+             std::map<uint16_t, std::unordered_map<uint32_t, std::multiset<double> > >::iterator subChIt = state.reservedSlots.find (subCH_index);
+             if (subChIt == state.reservedSlots.end ())
+               continue;
+             std::unordered_map<uint32_t, std::multiset<double> >::iterator rsrpIt = subChIt->second.find (futureSlot);
+             if (rsrpIt != subChIt->second.end ())
+               exclusionRsrp = std::max (exclusionRsrp, *rsrpIt->second.rbegin ());
+           }
+         }
+       }
+       if (exclusionRsrp != candidateIt->second.exclusionRsrp)
+       {
+         ReEvaluationCount (candidateIt->second, false);
+         candidateIt->second.exclusionRsrp = exclusionRsrp;
+         candidateIt->second.thresholdStep = ReEvaluationThresholdStep (exclusionRsrp);
+         ReEvaluationCount (candidateIt->second, true);
+       }
+     }
+   }
+}
+
+
+void
+NrV2XUeMac::ReEvaluationApply (const ReEvaluationReservation &reservation, uint16_t Q)
+{
+   // Reserved slots q = 1..Q after the reception, as in Mode2Step1
+   std::vector<uint16_t>& applied = m_reEvaluationState.appliedQ[reservation.CSRindex][reservation.receivedSF];
+   if (applied.size () <= reservation.index)
+     applied.resize (reservation.index + 1, 0);
+   const ReservedCSR& reservedCSR = m_sensedReservedCSRMap[reservation.CSRindex][reservation.receivedSF][reservation.index];
+   uint16_t RRI_to_slot = reservedCSR.RRI/m_slotDuration;
+   uint32_t receivedSlot = reservation.receivedSF.frameNo*10 + reservation.receivedSF.subframeNo;
+   for (uint16_t q = Q + 1; q <= applied[reservation.index]; q++)
+     ReEvaluationReserve (reservation.CSRindex, (receivedSlot + q*RRI_to_slot) % 10240, reservedCSR.psschRsrpDb, false);
+   for (uint16_t q = applied[reservation.index] + 1; q <= Q; q++)
+     ReEvaluationReserve (reservation.CSRindex, (receivedSlot + q*RRI_to_slot) % 10240, reservedCSR.psschRsrpDb, true);
+   applied[reservation.index] = Q;
+}
+
+
+uint16_t
+NrV2XUeMac::ReEvaluationQ (const ReservedCSR &reservation, uint32_t sensedAge)
+{
+   uint16_t Q = 1;
+   if ((sensedAge <= (reservation.RRI /m_slotDuration)) && (reservation.RRI  < m_reEvaluationState.T_2) && !(reservation.isReTx))
+     Q = std::ceil( (float) m_reEvaluationState.T_2/ reservation.RRI );
+   return Q;
+}
+
+
 void
 NrV2XUeMac::UnimorePrintCSR (std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Map)
 {
@@ -2203,7 +2876,7 @@ void
 NrV2XUeMac::UpdatePastTxInfo (uint16_t current_frameNo, uint16_t current_subframeNo)
 {
    NS_LOG_FUNCTION(this);
-   uint16_t sensingWindow_slots = m_sensingWindow/m_slotDuration;
+   uint16_t sensingWindow_slots = m_sensingWindow << m_slotNumerologyIndex;
    current_frameNo--;
    current_subframeNo--;
 
@@ -2230,7 +2903,7 @@ void
 NrV2XUeMac::UpdateSensedCSR (uint16_t current_frameNo, uint16_t current_subframeNo)
 {
    NS_LOG_FUNCTION(this);
-   uint16_t sensingWindow_slots = m_sensingWindow/m_slotDuration;
+   uint16_t sensingWindow_slots = m_sensingWindow << m_slotNumerologyIndex;
    current_frameNo--;
    current_subframeNo--;
 
@@ -2244,6 +2917,21 @@ NrV2XUeMac::UpdateSensedCSR (uint16_t current_frameNo, uint16_t current_subframe
        if (SubtractFrames( current_frameNo, sensedSFIt->first.frameNo, current_subframeNo, sensedSFIt->first.subframeNo) > sensingWindow_slots)
        {
 //         NS_LOG_DEBUG("CSR index " << sensedIt->first << " SF(" << sensedSFIt->first.frameNo << "," << sensedSFIt->first.subframeNo << ") -> Erasing (outside of S)" );
+         // Remove its reserved slots from the re-evaluation state as well
+         if (m_reEvaluationState.valid)
+         {
+           std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<uint16_t> >& appliedSF = m_reEvaluationState.appliedQ[sensedIt->first];
+           std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<uint16_t> >::iterator appliedIt = appliedSF.find (sensedSFIt->first);
+           if (appliedIt != appliedSF.end ())
+           {
+             for (uint32_t index = 0; index < appliedIt->second.size (); index++)
+             {
+               ReEvaluationReservation reservation = {sensedIt->first, sensedSFIt->first, index};
+               ReEvaluationApply (reservation, 0);
+             }
+             appliedSF.erase (appliedIt);
+           }
+         }
          sensedSFIt = sensedIt->second.erase(sensedSFIt);  
        }
        else
@@ -2322,7 +3010,7 @@ NrV2XUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
 
 //   NS_LOG_INFO (this << " Adjusted Frame no. " << frameNo << " subframe no. " << subframeNo);
    SidelinkCommResourcePool::SubframeInfo currentSF, estSF;
-   estSF = SimulatorTimeToSubframe(Simulator::Now (), m_slotDuration);
+   estSF = SimulatorTimeToSubframe (Simulator::Now (), m_slotNumerologyIndex);
    currentSF.frameNo = frameNo;
    currentSF.subframeNo = subframeNo;
 
@@ -2414,7 +3102,7 @@ NrV2XUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
                grantsIT->second.m_ReEvaluationFrame = updatedSF.frameNo;
                grantsIT->second.m_ReEvaluationSubframe = updatedSF.subframeNo;
 
-               NS_LOG_UNCOND("Now: SF(" << frameNo << "," << subframeNo << "). Grant index " << grantsIT->first << ": just updated reservation without data to Tx: SF(" << grantsIT->second.m_nextReservedFrame << "," << grantsIT->second.m_nextReservedSubframe << ")");
+               NR_V2X_CONSOLE (VERBOSE, "Now: SF(" << frameNo << "," << subframeNo << "). Grant index " << grantsIT->first << ": just updated reservation without data to Tx: SF(" << grantsIT->second.m_nextReservedFrame << "," << grantsIT->second.m_nextReservedSubframe << ")");
                NS_LOG_INFO("Now: SF(" << frameNo << "," << subframeNo << "). Grant index " << grantsIT->first << ": just updated re-evaluation without data to Tx: SF(" << grantsIT->second.m_ReEvaluationFrame << "," << grantsIT->second.m_ReEvaluationSubframe << ")"); 
 
                if (grantsIT->first == 1)
@@ -2458,7 +3146,7 @@ NrV2XUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
              V2XSidelinkGrant processedV2Xgrant;
              NS_LOG_DEBUG("TxQueue: " << (*itBsr).second.txQueueSize);
              SidelinkCommResourcePool::SubframeInfo SFpkt;
-             SFpkt = SimulatorTimeToSubframe(Seconds(itBsr->second.V2XGenTime), m_slotDuration);
+             SFpkt = SimulatorTimeToSubframe (Seconds(itBsr->second.V2XGenTime), m_slotNumerologyIndex);
              NS_LOG_DEBUG("Packet generated at: " << itBsr->second.V2XGenTime << " = SF(" << SFpkt.frameNo << "," << SFpkt.subframeNo << "), with PDB = " << itBsr->second.V2XPdb << " ms. No valid grant, creating a new one");
 
 //             if (m_rnti == m_debugNode)
@@ -2479,7 +3167,7 @@ NrV2XUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
              poolIt->second.m_V2X_grant_fresh = true;            
                  
          //    poolIt->second.m_currentV2XGrant.m_tbSize = m_amc->GetUlTbSizeFromMcs ((int) poolIt->second.m_currentV2XGrant.m_mcs, (int) poolIt->second.m_currentV2XGrant.m_rbLenPssch) / 8;
-             NS_LOG_UNCOND("UE MAC: just made UE selection. Now: F:" << frameNo << ", SF:" << subframeNo);
+             NR_V2X_CONSOLE (VERBOSE, "UE MAC: just made UE selection. Now: F:" << frameNo << ", SF:" << subframeNo);
            } //end if (!poolIt->second.m_V2X_grant_received || ((*itBsr).second.V2XMessageType == 0x01 && (*itBsr).second.isNewV2X))
          } //END OF if (!(*itBsr).second.alreadyUESelected && !(itBsr == m_slBsrReceived.end () || (*itBsr).second.txQueueSize == 0))
        } //END OF if (poolIt->second.m_pool->GetSchedulingType() == SidelinkCommResourcePool::UE_SELECTED)
@@ -2489,7 +3177,7 @@ NrV2XUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
        {
          NS_LOG_INFO("Grant selection " << poolIt->second.m_currentV2XGrant.m_TxIndex << " out of " << poolIt->second.m_currentV2XGrant.m_grantTransmissions.size());
          SidelinkCommResourcePool::SubframeInfo SFpkt;
-         SFpkt = SimulatorTimeToSubframe(Seconds(itBsr->second.V2XGenTime), m_slotDuration);
+         SFpkt = SimulatorTimeToSubframe (Seconds(itBsr->second.V2XGenTime), m_slotNumerologyIndex);
 
          NS_LOG_DEBUG("Packet generated at: " << itBsr->second.V2XGenTime << " = SF(" << SFpkt.frameNo << "," << SFpkt.subframeNo << "), next reservation at SF(" << poolIt->second.m_currentV2XGrant.m_grantTransmissions[1].m_nextReservedFrame << "," << poolIt->second.m_currentV2XGrant.m_grantTransmissions[1].m_nextReservedSubframe << ")");
 
@@ -2794,7 +3482,7 @@ NrV2XUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
              //Re-evaluation should not be updated since it is performed only on selected resources
            }
 
-           NS_LOG_UNCOND("Just updated reservation SF(" << poolIt->second.m_currentV2XGrant.m_grantTransmissions[poolIt->second.m_currentV2XGrant.m_TxIndex].m_nextReservedFrame << "," 
+           NR_V2X_CONSOLE (VERBOSE, "Just updated reservation SF(" << poolIt->second.m_currentV2XGrant.m_grantTransmissions[poolIt->second.m_currentV2XGrant.m_TxIndex].m_nextReservedFrame << "," 
            << poolIt->second.m_currentV2XGrant.m_grantTransmissions[poolIt->second.m_currentV2XGrant.m_TxIndex].m_nextReservedSubframe << ")");
 
 	   for (std::list<SidelinkCommResourcePool::V2XSidelinkTransmissionInfo>::iterator txIt = poolIt->second.m_v2xTx.begin (); txIt != poolIt->second.m_v2xTx.end (); txIt++) 
@@ -2807,7 +3495,7 @@ NrV2XUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
            {  
              if (m_evalKeepProb->GetValue() > (1-m_keepProbability))
              {
-               NS_LOG_UNCOND("Keep the same resources");
+               NR_V2X_CONSOLE (VERBOSE, "Keep the same resources");
                std::cin.get();
                poolIt->second.m_currentV2XGrant.m_Cresel = GetCresel(poolIt->second.m_currentV2XGrant.m_RRI);
              }
@@ -2831,7 +3519,7 @@ NrV2XUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
      
        if (allocIter != poolIt->second.m_v2xTx.end() && allocIter->subframe.frameNo == frameNo && allocIter->subframe.subframeNo  == subframeNo)
        {
-         NS_LOG_UNCOND("Now: " << Simulator::Now().GetSeconds()*1000 << " ms: Ok, now I should transmit data, Frame no. " << frameNo << ", Subframe no. " << subframeNo);
+         NR_V2X_CONSOLE (VERBOSE, "Now: " << Simulator::Now().GetSeconds()*1000 << " ms: Ok, now I should transmit data, Frame no. " << frameNo << ", Subframe no. " << subframeNo);
 	 NistV2XSciListElement_s sci1;
 	 sci1.m_rnti = m_rnti;
          sci1.m_genTime = itBsr->second.V2XGenTime;
@@ -3012,7 +3700,7 @@ NrV2XUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
                    { 
                      if (m_evalKeepProb->GetValue() > (1-m_keepProbability))
                      {
-                       NS_LOG_UNCOND("Keep the same resources");
+                       NR_V2X_CONSOLE (VERBOSE, "Keep the same resources");
                        std::cin.get();
                        poolIt->second.m_currentV2XGrant.m_Cresel = GetCresel(poolIt->second.m_currentV2XGrant.m_RRI);
                      }
@@ -3203,10 +3891,14 @@ NrV2XUeMac::DoReportPsschRsrp (Time time, uint16_t rbStart, uint16_t rbLen, doub
 
   PsschRsrp rsrpStruct;
   rsrpStruct.rbStart = rbStart;
-  rsrpStruct.rbStart = rbLen;
+  rsrpStruct.rbLen = rbLen;
   rsrpStruct.psschRsrpDb = rsrpDb;
 
   m_PsschRsrpMap.insert (std::pair<Time,PsschRsrp> (time, rsrpStruct)); 
+
+  // Age out the measurements older than the sensing window, as UpdateSensedCSR does for the sensed CSRs
+  Time horizon = time - MilliSeconds (m_sensingWindow);
+  m_PsschRsrpMap.erase (m_PsschRsrpMap.begin (), m_PsschRsrpMap.lower_bound (horizon));
   
   NS_LOG_INFO("NrV2XUeMac::DoReportPsschRsrp at time: " << time.GetSeconds () << " s, rbStart PSSCH: " << (int)rbStart << ", rbLen PSSCH: " << rbLen << ", PSSCH-RSRP: " << rsrpDb << "dB, List length: " << m_PsschRsrpMap.size ());   
 
@@ -3267,14 +3959,21 @@ NrV2XUeMac::DoReportPsschRsrpReservation (Time time, uint16_t rbStart, uint16_t
       {
         //CSR index already exists
         std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR> >::iterator frameInfoIt = mapIt->second.find(receivedSubframe);
+        uint32_t index = 0;
         if (frameInfoIt != mapIt->second.end())
         {
           NS_LOG_INFO("This SF already exists. Push back the new reservation");
           frameInfoIt->second.push_back(newSensedReservedCSR);
+          index = frameInfoIt->second.size () - 1;
        //   std::cin.get();
         }
         else
           (*mapIt).second.insert (std::pair<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR> > (receivedSubframe, {newSensedReservedCSR}));
+        if (m_reEvaluationState.valid)
+        {
+          ReEvaluationReservation reservation = {(uint16_t) *CSRindexIT, receivedSubframe, index};
+          m_reEvaluationState.pending.push_back (reservation);
+        }
       }
       else 
       {
@@ -3282,6 +3981,11 @@ NrV2XUeMac::DoReportPsschRsrpReservation (Time time, uint16_t rbStart, uint16_t
         std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR>> value;
         value.insert (std::pair<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR>> (receivedSubframe, {newSensedReservedCSR}));
         m_sensedReservedCSRMap.insert (std::pair<uint16_t,std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR>> > (*CSRindexIT,value));    
+        if (m_reEvaluationState.valid)
+        {
+          ReEvaluationReservation reservation = {(uint16_t) *CSRindexIT, receivedSubframe, 0};
+          m_reEvaluationState.pending.push_back (reservation);
+        }
       }
     }
  } // end if (!m_randomselection)
@@ -3327,6 +4031,7 @@ void
 NrV2XUeMac::ReEvaluateResources (SidelinkCommResourcePool::SubframeInfo currentSF, std::map <uint32_t, PoolInfo>::iterator IT, NistLteMacSapProvider::NistReportBufferNistStatusParameters pktParams)
 {
    NS_LOG_FUNCTION(this);
+   NR_V2X_PROFILE_SCOPE (RE_EVALUATE_RESOURCES);
    V2XSidelinkGrant currentV2Xgrant = IT->second.m_currentV2XGrant;
 
    currentSF.frameNo--;
@@ -3362,7 +4067,7 @@ NrV2XUeMac::ReEvaluateResources (SidelinkCommResourcePool::SubframeInfo currentS
    << "). Last Re-evaluation at SF(" << currentV2Xgrant.m_grantTransmissions[currentV2Xgrant.m_TxIndex].m_ReEvaluationFrame << "," << currentV2Xgrant.m_grantTransmissions[currentV2Xgrant.m_TxIndex].m_ReEvaluationSubframe << ")");
   
    SidelinkCommResourcePool::SubframeInfo genTimeSF;
-   genTimeSF = SimulatorTimeToSubframe(Seconds(pktParams.V2XGenTime), m_slotDuration);
+   genTimeSF = SimulatorTimeToSubframe (Seconds(pktParams.V2XGenTime), m_slotNumerologyIndex);
    double ElapsedTime;
    ElapsedTime = SubtractFrames(currentSF.frameNo+1, genTimeSF.frameNo, currentSF.subframeNo+1, genTimeSF.subframeNo)*m_slotDuration; //Expressed in ms
    double newPDB = pktParams.V2XPdb - ElapsedTime;
@@ -3372,14 +4077,10 @@ NrV2XUeMac::ReEvaluateResources (SidelinkCommResourcePool::SubframeInfo currentS
    uint16_t L_SubCh = (uint32_t) currentV2Xgrant.m_grantTransmissions[currentV2Xgrant.m_TxIndex].m_rbLenPssch/m_nsubCHsize;
    uint16_t NSubCh = std::floor(m_BW_RBs / m_nsubCHsize);
    
-   std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa, L1, Sa_noPastTx;
+   uint16_t N_CSR_per_SF = NSubCh - L_SubCh + 1;
  
 //   Sa = SelectionWindow (currentSF, (newPDB-1)/m_slotDuration, NSubCh - L_SubCh + 1);
-   Sa = SelectionWindow (currentSF, (uint32_t)((newPDB-m_slotDuration)/m_slotDuration +1), NSubCh - L_SubCh + 1);
-   if (ComputeResidualCSRs(Sa) == 0)
-   {
-     NS_FATAL_ERROR("Selection window is empty");
-   }
+   uint32_t T_2_slots = (uint32_t)((newPDB-m_slotDuration)/m_slotDuration +1);
    // Print the list of CSRs (Sa)
   /* NS_LOG_DEBUG("Printing the initial list Sa of candidate resources");
      UnimorePrintCSR(Sa);*/
@@ -3410,7 +4111,7 @@ NrV2XUeMac::ReEvaluateResources (SidelinkCommResourcePool::SubframeInfo currentS
            NS_LOG_DEBUG("Re-evaluation not triggered");
          else
          {
-           NS_LOG_UNCOND("UE " << m_rnti << " triggered a re-evaluation for CSR " << L1it->first << " at SF(" << checkSF.frameNo << "," << checkSF.subframeNo << ")");
+           NR_V2X_CONSOLE (VERBOSE, "UE " << m_rnti << " triggered a re-evaluation for CSR " << L1it->first << " at SF(" << checkSF.frameNo << "," << checkSF.subframeNo << ")");
            SelWindowError = true;     
            GrantsToChange.push_back(*ItIt);   
 //           std::cin.get();
@@ -3425,7 +4126,7 @@ NrV2XUeMac::ReEvaluateResources (SidelinkCommResourcePool::SubframeInfo currentS
    if (true)
    {   
      NS_LOG_INFO("Checking the entire selection window without past transmissions and without reservations");
-     L1 = Mode2Step1 (Sa, currentSF, currentV2Xgrant, newPDB, NSubCh, L_SubCh, &iterationsCounter, &psschThresh, &nCSR, m_UMHvariant);
+     ReEvaluationStep1 (currentSF, T_2_slots, N_CSR_per_SF, currentV2Xgrant, newPDB, NSubCh, L_SubCh, &iterationsCounter, &psschThresh, &nCSR, m_UMHvariant);
      for (std::vector <uint16_t>::iterator ItIt = GrantsToCheck.begin(); ItIt != GrantsToCheck.end(); ItIt++)
      {
        uint16_t CSRindex = ((uint32_t) currentV2Xgrant.m_grantTransmissions[*ItIt].m_rbStartPssch) / m_nsubCHsize;
@@ -3433,22 +4134,16 @@ NrV2XUeMac::ReEvaluateResources (SidelinkCommResourcePool::SubframeInfo currentS
        checkSF.frameNo = currentV2Xgrant.m_grantTransmissions[*ItIt].m_nextReservedFrame - 1;
        checkSF.subframeNo = currentV2Xgrant.m_grantTransmissions[*ItIt].m_nextReservedSubframe - 1;
        NS_LOG_INFO("Checking grant index " << *ItIt << ": CSR index = " << CSRindex << " at SF(" << checkSF.frameNo << "," << checkSF.subframeNo << ")"); 
-     // Print the list of CSRs (L1)
-       for(std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> >::iterator L1it = L1.begin(); L1it != L1.end(); L1it++)
+       if (CSRindex < N_CSR_per_SF)
        {
-     //  NS_LOG_DEBUG("CSR index " << L1it->first);
-         if (L1it->first == CSRindex)
+         if (IsReEvaluationCandidate (CSRindex, checkSF))
+           NS_LOG_DEBUG("Re-evaluation not triggered");
+         else
          {
-           std::list<SidelinkCommResourcePool::SubframeInfo>::iterator collisionIT = std::find(L1it->second.begin(), L1it->second.end(), checkSF);
-           if (collisionIT != L1it->second.end())
-             NS_LOG_DEBUG("Re-evaluation not triggered");
-           else
-           {
-             NS_LOG_UNCOND("UE " << m_rnti << " triggered a re-evaluation for CSR " << L1it->first << " at SF(" << checkSF.frameNo << "," << checkSF.subframeNo << ")");
-             GrantsToChange.push_back(*ItIt);
-       //      std::cin.get();
-       //      IT->second.m_currentV2XGrant = V2XSelectResources (currentSF.frameNo+1, currentSF.subframeNo+1, newPDB+m_slotDuration, pktParams.V2XPrsvp, pktParams.V2XMessageType, pktParams.V2XTrafficType, currentV2Xgrant.m_Cresel, pktParams.V2XPacketSize, pktParams.V2XReservationSize, ReEVALUATION); 
-           }
+           NR_V2X_CONSOLE (VERBOSE, "UE " << m_rnti << " triggered a re-evaluation for CSR " << CSRindex << " at SF(" << checkSF.frameNo << "," << checkSF.subframeNo << ")");
+           GrantsToChange.push_back(*ItIt);
+     //      std::cin.get();
+     //      IT->second.m_currentV2XGrant = V2XSelectResources (currentSF.frameNo+1, currentSF.subframeNo+1, newPDB+m_slotDuration, pktParams.V2XPrsvp, pktParams.V2XMessageType, pktParams.V2XTrafficType, currentV2Xgrant.m_Cresel, pktParams.V2XPacketSize, pktParams.V2XReservationSize, ReEVALUATION); 
          }
        }
      }
@@ -3590,7 +4285,7 @@ NrV2XUeMac::V2XChangeResources (V2XSidelinkGrant OriginalGrant, std::vector<uint
    currentSF.subframeNo = subframeNo;
 
    NS_LOG_INFO("Re-Evaluation Requested Now: SF(" <<  currentSF.frameNo << "," << currentSF.subframeNo <<  "), Time: " << Simulator::Now ().GetSeconds () << "s, estimated SF(" 
-   << SimulatorTimeToSubframe (Simulator::Now (), m_slotDuration).frameNo << "," << SimulatorTimeToSubframe (Simulator::Now (), m_slotDuration).subframeNo << ")");
+   << SimulatorTimeToSubframe (Simulator::Now (), m_slotNumerologyIndex).frameNo << "," << SimulatorTimeToSubframe (Simulator::Now (), m_slotNumerologyIndex).subframeNo << ")");
 
    /*for(std::vector <uint16_t>::iterator ItIt = GrantsToChangeIndex.begin(); ItIt != GrantsToChangeIndex.end(); ItIt++)
    {
@@ -3651,12 +4346,27 @@ NrV2XUeMac::V2XChangeResources (V2XSidelinkGrant OriginalGrant, std::vector<uint
 //   if (m_rnti == m_debugNode)
 //     std::cin.get();
 
+   SelectionInputs recordedInputs;
+   if (m_recordSelectionInputs)
+     recordedInputs = CaptureSelectionInputs (currentSF, V2XGrant, pdb, NSubCh, L_SubCh);
+
    L1 = Mode2Step1 (Sa, currentSF, V2XGrant, T_2, NSubCh, L_SubCh, &iterationsCounter, &psschThresh, &nCSRpastTx, false);
 
    nCSRfinal = ComputeResidualCSRs (L1);
 
    NS_LOG_INFO("Initial list size = " << nCSRinitial << ". After removing past Tx = " << nCSRpastTx << ". After removing reservations = " << nCSRfinal);
 
+   if (m_recordSelectionInputs)
+   {
+     SelectionOutcome outcome;
+     outcome.iterations = iterationsCounter;
+     outcome.rsrpThreshold = psschThresh;
+     outcome.nCSRinitial = nCSRinitial;
+     outcome.nCSRpastTx = nCSRpastTx;
+     outcome.nCSRfinal = nCSRfinal;
+     SaveSelectionInputs (recordedInputs, outcome);
+   }
+
    std::vector<CandidateCSRl2> L2EquivalentVector;
    CandidateCSRl2 FinalL2tmpItem;
    for(std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> >::iterator L1it = L1.begin(); L1it != L1.end(); L1it++)
@@ -3969,6 +4679,18 @@ NrV2XUeMac::GetDiscTxPool ()
   return m_discTxPools.m_pool; 
 }
 
+int64_t
+NrV2XUeMac::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_raPreambleUniformVariable->SetStream (stream);
+  m_ueSelectedUniformVariable->SetStream (stream + 1);
+  m_p1UniformVariable->SetStream (stream + 2);
+  m_resUniformVariable->SetStream (stream + 3);
+  m_evalKeepProb->SetStream (stream + 4);
+  return 5;
+}
+
 
 
 } // namespace ns3
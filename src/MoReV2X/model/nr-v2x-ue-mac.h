@@ -38,6 +38,11 @@
 #include <ns3/nstime.h>
 #include <ns3/event-id.h>
 #include <vector>
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <iostream>
 #include <ns3/packet.h>
 #include <ns3/packet-burst.h>
 #include "ns3/traced-value.h"
@@ -48,12 +53,14 @@
 namespace ns3 {
 
 class UniformRandomVariable;
+class MobilityModel;
 
 class NrV2XUeMac :   public Object
 {
   friend class NistUeMemberLteUeCmacSapProvider;
   friend class NistUeMemberLteMacSapProvider;
   friend class NistUeMemberLteUePhySapUser;
+  friend class NrV2XTestAccess; // unit tests and benchmarks, see test/nr-v2x-test-access.h
 
 public:
   static TypeId GetTypeId (void);
@@ -134,6 +141,15 @@ public:
    */
   Ptr<SidelinkTxDiscResourcePool> GetDiscTxPool ();
 
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model. Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
 
   /**
    *  TracedCallback signature for SL UL scheduling events.
@@ -158,6 +174,12 @@ public:
   */
   void PushNewRRIValue (uint16_t RRI);
 
+  /*
+    Slot duration (ms). It also sets the numerology index used by the slot timing
+  */
+  void SetSlotDuration (double slotDuration);
+  double GetSlotDuration (void) const;
+
 
   /*
     Map of geo-based subchannel indexes. Needed for the frequency-reuse dynamic scheme
@@ -302,6 +324,7 @@ private:
   uint16_t m_L_SubCh;
   uint16_t m_BW_RBs;
   double m_slotDuration;
+  uint16_t m_slotNumerologyIndex; // derived from m_slotDuration, the slots per ms are 1 << m_slotNumerologyIndex
   uint16_t m_numerologyIndex;
 
   bool m_randomSelection; 
@@ -524,6 +547,29 @@ private:
   bool m_FreqReuse;
   bool m_AdaptiveScheduling;
 
+  /*
+    Uniform grid over the x coordinate indexing the geo-cells of m_subchannelsMap, built by CopySubchannelsMap.
+    Every bucket lists the geo-cells overlapping it, in the iteration order of m_subchannelsMap
+  */
+  struct GeoCell
+  {
+    double start;
+    double end;
+    uint16_t subchannel;
+  };
+  std::vector<GeoCell> m_geoCells;
+  std::vector<std::vector<uint32_t> > m_geoCellGrid;
+  double m_geoGridOrigin;
+  double m_geoGridStep;
+
+  /*
+    Look up the geo-cell containing x. If several geo-cells contain it, the last one of m_subchannelsMap wins
+    \return false if x is not inside any geo-cell
+  */
+  bool GetGeoCellSubchannel (double x, uint16_t *subchannel) const;
+
+  Ptr<MobilityModel> m_mobility; // mobility model of the node with id m_rnti, looked up at the first use
+
   double m_keepProbability;
   Ptr<UniformRandomVariable> m_evalKeepProb;
 
@@ -533,6 +579,7 @@ private:
 
   std::string m_outputPath;
   double m_savingPeriod;
+  bool m_recordSelectionInputs; // Append the inputs of every Mode 2 selection to SelectionInputs.txt
 
   bool m_oneShotGrant;
 //  uint16_t SubtractFrames (uint16_t frameAhead, uint16_t frame, uint16_t subframeAhead, uint16_t subframe);
@@ -606,7 +653,7 @@ private:
     double psschRsrpDb;
   };
 
-  std::map <Time,PsschRsrp> m_PsschRsrpMap;
+  std::map <Time,PsschRsrp> m_PsschRsrpMap; // PSSCH-RSRP reports within the sensing window
   std::list <std::pair<Time,SidelinkCommResourcePool::SubframeInfo>> m_pastTxUnimore;
 
   bool m_validReservation;
@@ -644,6 +691,64 @@ private:
 
   /*Map to store the past transmission information*/
   std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > m_pastTxMap;
+
+  /**
+  * Candidate of the re-evaluation window
+  */
+  struct ReEvaluationCandidate
+  {
+    double exclusionRsrp; // highest RSRP of the reservations excluding the candidate
+    uint32_t pastTxHits; // future transmissions of the candidate colliding with my past transmissions
+    uint32_t thresholdStep; // RSRP threshold increases needed to keep the candidate in L1
+  };
+
+  /**
+  * Sensed reservation, identified by its position in m_sensedReservedCSRMap
+  */
+  struct ReEvaluationReservation
+  {
+    uint16_t CSRindex;
+    SidelinkCommResourcePool::SubframeInfo receivedSF;
+    uint32_t index;
+  };
+
+  /**
+  * Exclusion state of the last re-evaluation window. Slots are identified by frameNo*10+subframeNo
+  */
+  struct ReEvaluationState
+  {
+    bool valid;
+    uint32_t rebuilds; // times the state was built from scratch
+    uint32_t startSlot;
+    uint32_t endSlot;
+    double T_2;
+    double initialThresh;
+    uint16_t NSubCh;
+    uint16_t L_SubCh;
+    uint16_t N_CSR_per_SF;
+    uint16_t RRI_slots;
+    uint32_t Cresel;
+    bool onlyReTxions;
+    std::unordered_map<uint32_t, ReEvaluationCandidate> candidates; // CSR index*10240 + slot
+    std::vector<double> thresholds; // RSRP threshold after each increase
+    std::vector<uint32_t> stepCount; // candidates without past tx collisions per threshold step
+    uint32_t nCandidates; // candidates without past tx collisions
+    uint32_t finalStep; // threshold step of the last L1
+    std::map<uint16_t, std::unordered_map<uint32_t, std::multiset<double> > > reservedSlots; // RSRP of the reservations per CSR index and slot
+    std::map<uint16_t, std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<uint16_t> > > appliedQ; // slots applied for each sensed reservation
+    std::list<ReEvaluationReservation> pending; // reservations not applied yet (new or within Tproc0)
+    std::list<ReEvaluationReservation> periodic; // reservations applied with Q > 1, whose Q decreases as the window shrinks
+    std::unordered_set<uint32_t> pastTxSlots;
+  };
+
+  ReEvaluationState m_reEvaluationState;
+
+  uint32_t ReEvaluationThresholdStep (double rsrp);
+  void ReEvaluationCount (ReEvaluationCandidate &candidate, bool add);
+  void ReEvaluationPastTx (uint32_t slot, bool add);
+  void ReEvaluationReserve (uint16_t CSRindex, uint32_t slot, double rsrp, bool add);
+  void ReEvaluationApply (const ReEvaluationReservation &reservation, uint16_t Q);
+  uint16_t ReEvaluationQ (const ReservedCSR &reservation, uint32_t sensedAge);
  
   struct CandidateCSR
   {
@@ -688,11 +793,84 @@ private:
 
   std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo>> Mode2Step1 (std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa, SidelinkCommResourcePool::SubframeInfo currentSF, V2XSidelinkGrant V2XGrant, double T_2, uint16_t NSubCh,  uint16_t L_SubCh, uint32_t *iterationsCounter, double *psschThresh, uint32_t *nCSRpartial, bool OnlyReTxions);
 
+  /**
+  * Step 1 of the re-evaluation over the selection window [T_1, T_2_slots]: same candidates, RSRP threshold
+  * and counters as Mode2Step1 over the window built by SelectionWindow, with the same side effects. The
+  * candidates of the window are kept in m_reEvaluationState, so the later re-evaluations of the same window
+  * only apply the reservations and the past transmissions changed in the meantime
+  */
+  void ReEvaluationStep1 (SidelinkCommResourcePool::SubframeInfo currentSF, uint32_t T_2_slots, uint16_t N_CSR_per_SF, V2XSidelinkGrant V2XGrant, double T_2, uint16_t NSubCh,  uint16_t L_SubCh, uint32_t *iterationsCounter, double *psschThresh, uint32_t *nCSRpartial, bool OnlyReTxions);
+
+  /**
+  * True if the candidate is in the list L1 of the last ReEvaluationStep1
+  */
+  bool IsReEvaluationCandidate (uint16_t CSRindex, SidelinkCommResourcePool::SubframeInfo candidateSF);
+
+  /**
+  * List L1 of the last ReEvaluationStep1 (final = true) or the candidates left by the past transmissions (final = false)
+  */
+  std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo>> ReEvaluationL1 (bool final);
+
   /**
   * Method to store Tx events for scheduling assistance in LTE-V2V UE_SELECTED Mode 4 
   */
   void DoStoreTxInfo (SidelinkCommResourcePool::SubframeInfo subframe, uint16_t rbStart, uint16_t rbLen);
 
+public:
+
+  /**
+  * Inputs of a Mode 2 selection, as they are when V2XSelectResources invokes Mode2Step1
+  */
+  struct SelectionInputs
+  {
+    uint32_t nodeId;
+    double time; // (s)
+    SidelinkCommResourcePool::SubframeInfo currentSF; // 0-based, as passed to Mode2Step1
+    double pdb; // (ms)
+    uint16_t rri; // (ms)
+    uint16_t cresel;
+    uint16_t nSubCh;
+    uint16_t lSubCh;
+    double slotDuration; // (ms)
+    uint16_t numerologyIndex;
+    double rsrpThreshold; // initial RSRP threshold (dBm)
+    double sizeThreshold; // minimum fraction of the candidates left in L1
+    std::vector<uint16_t> rriList;
+    std::list<SidelinkCommResourcePool::SubframeInfo> pastTx;
+    std::map <uint16_t, std::map<SidelinkCommResourcePool::SubframeInfo, std::vector<ReservedCSR> > > sensed;
+  };
+
+  struct SelectionOutcome
+  {
+    uint32_t iterations; // RSRP threshold increases
+    double rsrpThreshold; // final RSRP threshold (dBm), as left by Mode2Step1
+    uint32_t nCSRinitial;
+    uint32_t nCSRpastTx;
+    uint32_t nCSRfinal;
+  };
+
+  /**
+  * Write a selection in the SelectionInputs.txt format: one "selection" line followed by the "rri",
+  * "pasttx", "sensed" (and one line per sensed reservation) and "outcome" lines
+  */
+  static void WriteSelectionInputs (std::ostream& os, const SelectionInputs& inputs, const SelectionOutcome& outcome);
+
+  /**
+  * \return false at the end of the stream
+  */
+  static bool ReadSelectionInputs (std::istream& is, SelectionInputs *inputs, SelectionOutcome *outcome);
+
+  /**
+  * Run SelectionWindow and Mode2Step1 on the given inputs, without PHY and without running the simulator.
+  * The sensing state of this MAC and its slot configuration are replaced by the recorded ones
+  */
+  SelectionOutcome ReplaySelection (const SelectionInputs& inputs);
+
+private:
+
+  SelectionInputs CaptureSelectionInputs (SidelinkCommResourcePool::SubframeInfo currentSF, const V2XSidelinkGrant& V2XGrant, double pdb, uint16_t NSubCh, uint16_t L_SubCh) const;
+  void SaveSelectionInputs (const SelectionInputs& inputs, const SelectionOutcome& outcome);
+
 };
 
 } // namespace ns3
@@ -46,8 +46,10 @@
 #include <iostream>
 #include <algorithm>
 #include <ns3/node-container.h>
+#include <ns3/node-list.h>
 
 #include "nr-v2x-utils.h"
+#include "nr-v2x-console.h"
 
 namespace ns3 {
 
@@ -222,6 +224,8 @@ NrV2XUePhy::NrV2XUePhy (Ptr<NrV2XSpectrumPhy> dlPhy, Ptr<NrV2XSpectrumPhy> ulPhy
   //added for V2X
   m_CBRCheckingPeriod = 0.5;
   m_CBRCheckingInterval = 0.0;
+  m_cbrXMin = 1500;
+  m_cbrXMax = 3500;
 
   DoReset ();
 }
@@ -379,7 +383,8 @@ NrV2XUePhy::GetTypeId (void)
     .AddAttribute ("SlotDuration",
 		   "The NR-V2X time slot duration",
 		   DoubleValue (1.0),
-		   MakeDoubleAccessor (&NrV2XUePhy::m_slotDuration),
+		   MakeDoubleAccessor (&NrV2XUePhy::SetSlotDuration,
+		                       &NrV2XUePhy::GetSlotDuration),
 		   MakeDoubleChecker<double> ())
     .AddAttribute ("SubchannelSize",
 	           "The Subchannel size (in RBs)",
@@ -421,6 +426,16 @@ NrV2XUePhy::GetTypeId (void)
 		   DoubleValue (1.0),
 		   MakeDoubleAccessor (&NrV2XUePhy::m_savingPeriod),
 		   MakeDoubleChecker<double> ())
+    .AddAttribute ("CbrXMin",
+                   "UEs with an x coordinate below this value (m) do not evaluate the CBR",
+                   DoubleValue (1500),
+                   MakeDoubleAccessor (&NrV2XUePhy::m_cbrXMin),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("CbrXMax",
+                   "UEs with an x coordinate above this value (m) do not evaluate the CBR",
+                   DoubleValue (3500),
+                   MakeDoubleAccessor (&NrV2XUePhy::m_cbrXMax),
+                   MakeDoubleChecker<double> ())
 
 
 
@@ -493,6 +508,20 @@ NrV2XUePhy::GetTxPower () const
   return m_txPower;
 }
 
+void
+NrV2XUePhy::SetSlotDuration (double slotDuration)
+{
+  NS_LOG_FUNCTION (this << slotDuration);
+  m_slotDuration = slotDuration;
+  m_numerologyIndex = GetNumerologyIndex (slotDuration);
+}
+
+double
+NrV2XUePhy::GetSlotDuration () const
+{
+  return m_slotDuration;
+}
+
 Ptr<NistLteUePowerControl>
 NrV2XUePhy::GetUplinkPowerControl () const
 {
@@ -530,6 +559,14 @@ Ptr<NrV2XSpectrumPhy> NrV2XUePhy::GetSlSpectrumPhy () const
   return m_sidelinkSpectrumPhy;
 }
 
+int64_t
+NrV2XUePhy::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_nextScanRdm->SetStream (stream);
+  return 1;
+}
+
   
 void
 NrV2XUePhy::DoSendMacPdu (Ptr<Packet> p)
@@ -731,7 +768,7 @@ NrV2XUePhy::UnimoreReceivedRssi (double rssi, std::vector <int> rbMap, uint16_t
   uint16_t NSubCh = std::floor(m_BW_RBs / m_nsubCHsize); 
 
   SidelinkCommResourcePool::SubframeInfo SF;
-  SF = SimulatorTimeToSubframe(Simulator::Now(), m_slotDuration);
+  SF = SimulatorTimeToSubframe(Simulator::Now(), m_numerologyIndex);
 //  SF.frameNo--;
 //  SF.subframeNo--;
 
@@ -809,7 +846,7 @@ NrV2XUePhy::UnimoreReceivedRssi (double rssi, std::vector <int> rbMap, uint16_t
     std::map<SidelinkCommResourcePool::SubframeInfo, RSSImeas>::iterator subframeIt;
     for (subframeIt = RSSIit->second.begin(); subframeIt != RSSIit->second.end(); /*no increment*/)
     {
-      if (SubtractFrames( SF.frameNo, subframeIt->first.frameNo, SF.subframeNo, subframeIt->first.subframeNo) > 100/m_slotDuration)
+      if (SubtractFrames( SF.frameNo, subframeIt->first.frameNo, SF.subframeNo, subframeIt->first.subframeNo) > (100u << m_numerologyIndex))
       {
      //   std::cout << "CSR index " << RSSIit->first << " SF(" << std::to_string(subframeIt->first.frameNo) << "," << std::to_string(subframeIt->first.subframeNo) << ") with IDs: ";
      //   for (std::vector<uint16_t>::iterator vectIT = subframeIt->second.m_IDs.begin(); vectIT != subframeIt->second.m_IDs.end(); vectIT++)
@@ -848,26 +885,15 @@ NrV2XUePhy::UnimoreReceivedRssi (double rssi, std::vector <int> rbMap, uint16_t
   {
     NS_LOG_INFO("UE " << m_rnti << " evaluating CBR now " << Simulator::Now ().GetSeconds ());
     m_CBRCheckingInterval = Simulator::Now ().GetSeconds ();
-    NodeContainer GlobalContainer = NodeContainer::GetGlobal(); 
-    for (NodeContainer::Iterator L = GlobalContainer.Begin(); L != GlobalContainer.End(); ++L) 
+    // The node IDs index the node list: no need to scan it
+    Vector posRX = NodeList::GetNode (m_rnti)->GetObject<MobilityModel> ()->GetPosition ();
+    if (posRX.x >= m_cbrXMin && posRX.x <= m_cbrXMax)
     {
-      Ptr<Node> RxNode;
-      Ptr<MobilityModel> mobRX;
-      Vector posRX;
-      RxNode = *L;
-      if (RxNode->GetId() == m_rnti)
-      {
-        mobRX = RxNode->GetObject<MobilityModel>();
-        posRX = mobRX->GetPosition();
-        if (posRX.x >= 1500 && posRX.x <= 3500)
-        {
-          NrV2XUePhy::UnimoreEvaluateCBR(SF.frameNo, SF.subframeNo);
-        }
-        else
-        {
-          NS_LOG_INFO("Rx UE outside of the central section");
-        }
-      }
+      NrV2XUePhy::UnimoreEvaluateCBR(SF.frameNo, SF.subframeNo);
+    }
+    else
+    {
+      NS_LOG_INFO("Rx UE outside of the CBR region");
     }
   }
 
@@ -896,7 +922,7 @@ NrV2XUePhy::UnimoreEvaluateCBR (uint16_t frameNo, uint16_t subframeNo)
  
   uint16_t N_subCh = std::floor(m_BW_RBs / m_nsubCHsize); // Consider the subchannels according to 3GPP 38.215
  // uint16_t N_totalRBs = m_BW_RBs;
-  uint16_t CBR_window_slots = 100/m_slotDuration;
+  uint16_t CBR_window_slots = 100 << m_numerologyIndex;
   uint16_t N_Resources = CBR_window_slots*N_subCh, counter = 0;
 
 //  double RSSIthresh = -88.0; // in dBm
@@ -1545,7 +1571,7 @@ NrV2XUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
   ++subframeNo;
   if (subframeNo > 10)
   {
-    if (m_rnti == 1)
+    if (m_rnti == 1 && NrV2XConsole::IsEnabled (NrV2XConsole::VERBOSE))
     {
       std::cout << Simulator::Now ().GetSeconds () << std::endl;
      /* simTick.open (m_outputPath + "simTick.csv");
@@ -117,6 +117,16 @@ public:
    */
   double GetTxPower () const;
 
+  /**
+   * \param slotDuration the slot duration in ms, which sets the numerology index used by the slot timing
+   */
+  void SetSlotDuration (double slotDuration);
+
+  /**
+   * \return the slot duration in ms
+   */
+  double GetSlotDuration () const;
+
   /**
    * \return ptr to UE Uplink Power Control entity
    */
@@ -157,6 +167,15 @@ public:
    * \return a pointer to the NrV2XSpectrumPhy instance relative to the sidelink reception
    */
   Ptr<NrV2XSpectrumPhy> GetSlSpectrumPhy () const;
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model (the sidelink scanning timer).
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
   
   /**
    * \brief Create the PSD for the TX
@@ -585,6 +604,7 @@ private:
  uint16_t m_nsubCHsize;
  uint16_t m_BW_RBs;
  double m_slotDuration;
+ uint16_t m_numerologyIndex; // derived from m_slotDuration
  uint16_t m_SCS;
  double m_rxSensitivity;
  double m_RSSIthresh;
@@ -711,6 +731,8 @@ private:
 
   double m_CBRCheckingInterval;
   double m_CBRCheckingPeriod;
+  double m_cbrXMin; // Region of the UEs evaluating the CBR (m)
+  double m_cbrXMax;
 
   struct CBRInfo
   {
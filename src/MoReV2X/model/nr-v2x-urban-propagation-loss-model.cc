@@ -0,0 +1,279 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#include "nr-v2x-urban-propagation-loss-model.h"
+
+#include <ns3/log.h>
+#include <ns3/double.h>
+#include <ns3/boolean.h>
+#include <ns3/simulator.h>
+#include <ns3/node.h>
+#include <ns3/mobility-model.h>
+#include <ns3/mobility-building-info.h>
+#include <ns3/building-list.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrV2XUrbanPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (NrV2XUrbanPropagationLossModel);
+
+TypeId
+NrV2XUrbanPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::NrV2XUrbanPropagationLossModel")
+    .SetParent<BuildingsPropagationLossModel> ()
+    .AddConstructor<NrV2XUrbanPropagationLossModel> ()
+    .AddAttribute ("Frequency",
+                   "The propagation frequency [in GHz]",
+                   DoubleValue (5.9),
+                   MakeDoubleAccessor (&NrV2XUrbanPropagationLossModel::m_frequency),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("SigmaLOS",
+                   "The log-normal shadowing standard deviation of the LOS links [in dB]",
+                   DoubleValue (3.0),
+                   MakeDoubleAccessor (&NrV2XUrbanPropagationLossModel::m_sigmaLos),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("SigmaNLOS",
+                   "The log-normal shadowing standard deviation of the links obstructed by buildings [in dB]",
+                   DoubleValue (4.0),
+                   MakeDoubleAccessor (&NrV2XUrbanPropagationLossModel::m_sigmaNlos),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("SigmaNLOSv",
+                   "The standard deviation of the additional loss of the links blocked by vehicles [in dB]",
+                   DoubleValue (4.0),
+                   MakeDoubleAccessor (&NrV2XUrbanPropagationLossModel::m_sigmaNlosv),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("DecorrDistance",
+                   "The shadowing decorrelation distance [in m]",
+                   DoubleValue (10.0),
+                   MakeDoubleAccessor (&NrV2XUrbanPropagationLossModel::m_decorrDistance),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("CoherenceTime",
+                   "The time a link keeps its pathloss, LOS state and shadowing",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&NrV2XUrbanPropagationLossModel::m_coherenceTime),
+                   MakeTimeChecker ())
+    .AddAttribute ("LinkTimeout",
+                   "The time after which a link not evaluated is dropped",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&NrV2XUrbanPropagationLossModel::m_linkTimeout),
+                   MakeTimeChecker ())
+    .AddAttribute ("NakagamiFading",
+                   "Add a Nakagami-m fast fading, drawn at every evaluation",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NrV2XUrbanPropagationLossModel::m_nakagami),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BuildingCellSize",
+                   "The side of the cells of the grid indexing the buildings [in m]",
+                   DoubleValue (50.0),
+                   MakeDoubleAccessor (&NrV2XUrbanPropagationLossModel::m_cellSize),
+                   MakeDoubleChecker<double> (1.0))
+  ;
+  return tid;
+}
+
+NrV2XUrbanPropagationLossModel::NrV2XUrbanPropagationLossModel ()
+  : m_nextExpiry (Seconds (0)),
+    m_randomUniform (CreateObject<UniformRandomVariable> ()),
+    m_shadowing (CreateObject<NormalRandomVariable> ()),
+    m_shadowingNLOSv (CreateObject<NormalRandomVariable> ()),
+    m_fading (CreateObject<GammaRandomVariable> ())
+{
+  NS_LOG_FUNCTION (this);
+}
+
+NrV2XUrbanPropagationLossModel::~NrV2XUrbanPropagationLossModel ()
+{
+}
+
+int64_t
+NrV2XUrbanPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  int64_t currentStream = stream;
+  currentStream += BuildingsPropagationLossModel::DoAssignStreams (currentStream);
+  m_randomUniform->SetStream (currentStream++);
+  m_shadowing->SetStream (currentStream++);
+  m_shadowingNLOSv->SetStream (currentStream++);
+  m_fading->SetStream (currentStream++);
+  return (currentStream - stream);
+}
+
+void
+NrV2XUrbanPropagationLossModel::UpdateBuildingIndex (void) const
+{
+  if (m_buildingIndex.GetNBuildings () != BuildingList::GetNBuildings ())
+    {
+      m_buildingIndex.Build (m_cellSize);
+    }
+}
+
+double
+NrV2XUrbanPropagationLossModel::IndoorLoss (Ptr<MobilityModel> mobility) const
+{
+  Vector position = mobility->GetPosition ();
+  Ptr<Building> building = m_buildingIndex.GetBuilding (position);
+  Ptr<MobilityBuildingInfo> buildingInfo = mobility->GetObject<MobilityBuildingInfo> ();
+  if (buildingInfo == 0)
+    {
+      return 0.0;
+    }
+  if (building == 0)
+    {
+      buildingInfo->SetOutdoor ();
+      return 0.0;
+    }
+  buildingInfo->SetIndoor (building, building->GetFloor (position), building->GetRoomX (position), building->GetRoomY (position));
+  return ExternalWallLoss (buildingInfo);
+}
+
+bool
+NrV2XUrbanPropagationLossModel::IsLineOfSight (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  UpdateBuildingIndex ();
+  return m_buildingIndex.IsLineOfSight (a->GetPosition (), b->GetPosition ());
+}
+
+const NrV2XUrbanPropagationLossModel::ChannelModel&
+NrV2XUrbanPropagationLossModel::GetChannelModel (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  Time now = Simulator::Now ();
+  if (now >= m_nextExpiry)
+    {
+      ExpireChannelModels ();
+    }
+  uint64_t nodeIdA = a->GetObject<Node> ()->GetId ();
+  uint64_t nodeIdB = b->GetObject<Node> ()->GetId ();
+  uint64_t key = (std::min (nodeIdA, nodeIdB) << 32) | std::max (nodeIdA, nodeIdB);
+  std::unordered_map<uint64_t, ChannelModel>::iterator it = m_channelModels.find (key);
+  if (it == m_channelModels.end ())
+    {
+      ChannelModel& link = m_channelModels[key];
+      UpdateChannelModel (link, a, b, true);
+      return link;
+    }
+  if (now - it->second.LastUpdate >= m_coherenceTime)
+    {
+      UpdateChannelModel (it->second, a, b, false);
+    }
+  return it->second;
+}
+
+uint32_t
+NrV2XUrbanPropagationLossModel::GetNChannelModels (void) const
+{
+  return m_channelModels.size ();
+}
+
+void
+NrV2XUrbanPropagationLossModel::ExpireChannelModels (void) const
+{
+  Time now = Simulator::Now ();
+  for (std::unordered_map<uint64_t, ChannelModel>::iterator it = m_channelModels.begin (); it != m_channelModels.end (); )
+    {
+      // A link in use is updated at least every CoherenceTime
+      if (now - it->second.LastUpdate > m_linkTimeout + m_coherenceTime)
+        {
+          it = m_channelModels.erase (it);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+  m_nextExpiry = now + m_linkTimeout;
+}
+
+void
+NrV2XUrbanPropagationLossModel::UpdateChannelModel (ChannelModel& link, Ptr<MobilityModel> a, Ptr<MobilityModel> b, bool first) const
+{
+  NS_LOG_FUNCTION (this);
+  UpdateBuildingIndex ();
+  double distance = a->GetDistanceFrom (b);
+  link.Blocked = !m_buildingIndex.IsLineOfSight (a->GetPosition (), b->GetPosition ());
+  if (link.Blocked)
+    {
+      link.Pathloss = 36.85 + 30 * std::log10 (distance) + 18.9 * std::log10 (m_frequency);
+    }
+  else
+    {
+      link.Pathloss = 38.77 + 16.7 * std::log10 (distance) + 18.2 * std::log10 (m_frequency);
+    }
+  link.Pathloss += IndoorLoss (a) + IndoorLoss (b);
+
+  double sigma = link.Blocked ? m_sigmaNlos : m_sigmaLos;
+  double shadowingValue = m_shadowing->GetValue (0.0, sigma * sigma);
+  if (!first)
+    {
+      double updateDistance = std::abs (distance - link.Distance);
+      shadowingValue = std::exp (-updateDistance / m_decorrDistance) * link.Shadowing + std::sqrt (1 - std::exp (-2 * updateDistance / m_decorrDistance)) * shadowingValue;
+    }
+  link.Shadowing = shadowingValue;
+  link.Distance = distance;
+
+  // Probability of being in LOS in the Urban scenario (see 3GPP TR 37.885)
+  double Plos = std::min (1.0, 1.05 * std::exp (-0.0114 * distance));
+  link.LOS = !link.Blocked && (m_randomUniform->GetValue () <= Plos);
+  link.ShadowingNLOSv = 0.0;
+  if (!link.Blocked && !link.LOS)
+    {
+      // Due to the presence of other vehicles
+      link.ShadowingNLOSv = std::max (0.0, m_shadowingNLOSv->GetValue (5 + std::max (0.0, 15 * std::log10 (distance) - 41), m_sigmaNlosv * m_sigmaNlosv));
+    }
+  link.LastUpdate = Simulator::Now ();
+  NS_LOG_INFO ("Distance " << distance << " m, blocked " << link.Blocked << ", LOS " << link.LOS << ", pathloss " << link.Pathloss
+               << " dB, shadowing " << link.Shadowing << " dB, shadowing NLOSv " << link.ShadowingNLOSv << " dB");
+}
+
+double
+NrV2XUrbanPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  return GetChannelModel (a, b).Pathloss;
+}
+
+double
+NrV2XUrbanPropagationLossModel::GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  const ChannelModel& link = GetChannelModel (a, b);
+  return link.Shadowing + link.ShadowingNLOSv;
+}
+
+double
+NrV2XUrbanPropagationLossModel::DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  const ChannelModel& link = GetChannelModel (a, b);
+  double rxPowerDbm = txPowerDbm - link.Pathloss - link.Shadowing - link.ShadowingNLOSv;
+  if (m_nakagami)
+    {
+      // Shape of the V2V fading (Schumacher 2017), more severe behind buildings
+      double m = link.Blocked ? 0.5 : 2.7 * std::exp (-0.01 * (link.Distance - 1)) + 1.0;
+      rxPowerDbm += 10 * std::log10 (m_fading->GetValue (m, 1 / m));
+    }
+  return rxPowerDbm;
+}
+
+} // namespace ns3
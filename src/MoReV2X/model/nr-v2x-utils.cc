@@ -34,6 +34,7 @@
 #include "nist-lte-common.h"
 #include <map>
 #include <ns3/random-variable-stream.h>
+#include "nr-v2x-console.h"
 
 
 namespace ns3 {
@@ -69,21 +70,31 @@ SubtractFrames (uint16_t frameAhead, uint16_t frame, uint16_t subframeAhead, uin
 }
 
 
+uint16_t
+GetNumerologyIndex (double slotDuration)
+{
+   for (uint16_t numerologyIndex = 0; numerologyIndex <= 3; numerologyIndex++)
+   {
+     if (slotDuration == 1.0 / (1 << numerologyIndex))
+       return numerologyIndex;
+   }
+   NS_FATAL_ERROR ("Slot duration " << slotDuration << " ms does not match any numerology");
+   return 0;
+}
+
+
 SidelinkCommResourcePool::SubframeInfo
-SimulatorTimeToSubframe (Time time, double slotDuration)
+SimulatorTimeToSubframe (Time time, uint16_t numerologyIndex)
 {
-//   uint64_t milliseconds = time.GetSeconds () * 1000 + 15;
-//   uint64_t milliseconds = time.GetMilliSeconds () + 15/slotDuration;
-   uint64_t milliseconds;
-   uint64_t microseconds = time.GetMicroSeconds () + 11000*slotDuration + UL_PUSCH_TTIS_DELAY*slotDuration*1000;
-//   NS_LOG_DEBUG("MilliSeconds: " << milliseconds << " MicroSeconds: " << microseconds);
-   milliseconds = microseconds / (1000*slotDuration);
+   NS_ASSERT_MSG (numerologyIndex <= 3, "Numerology index must be between 0 and 3");
+   // The slot lasts 1000 >> numerologyIndex us: the offsets of 11 + UL_PUSCH_TTIS_DELAY slots
+   // and the division by the slot duration are exact in integer arithmetic
+   uint64_t microseconds = time.GetMicroSeconds () + ((11000 + UL_PUSCH_TTIS_DELAY*1000) >> numerologyIndex);
+   uint64_t slots = (microseconds << numerologyIndex) / 1000;
 
    SidelinkCommResourcePool::SubframeInfo SF;
-   SF.subframeNo = (uint32_t) (milliseconds % 10);
-   SF.frameNo = (uint32_t) ((milliseconds / 10) % 1024);
-//   SF.subframeNo = (uint32_t) (microseconds % 10);
-//   SF.frameNo = (uint32_t) ((microseconds / 10) % 1024);
+   SF.subframeNo = (uint32_t) (slots % 10);
+   SF.frameNo = (uint32_t) ((slots / 10) % 1024);
    if (SF.subframeNo == 0)
    {
      SF.subframeNo = 10;
@@ -98,6 +109,13 @@ SimulatorTimeToSubframe (Time time, double slotDuration)
 }
 
 
+SidelinkCommResourcePool::SubframeInfo
+SimulatorTimeToSubframe (Time time, double slotDuration)
+{
+   return SimulatorTimeToSubframe (time, GetNumerologyIndex (slotDuration));
+}
+
+
 uint32_t EvaluateSlotsDifference(SidelinkCommResourcePool::SubframeInfo SF1, SidelinkCommResourcePool::SubframeInfo SF2, uint32_t maxDifference)
 {
    uint32_t SlotsDiff;
@@ -131,48 +149,18 @@ ComputeResidualCSRs (std::map<uint16_t,std::list<SidelinkCommResourcePool::Subfr
 uint16_t
 GetTproc0 (uint16_t numerologyIndex)
 {
-   uint16_t T_proc_0; //Defined in slots
-   switch (numerologyIndex)
-   {
-     case 0:
-       T_proc_0 = 1;
-       break;
-     case 1:
-       T_proc_0 = 1;
-       break;
-     case 2:
-       T_proc_0 = 2;
-       break;
-     case 3:
-       T_proc_0 = 4;
-       break;
-   }
-
-   return T_proc_0;
+   static const uint16_t T_proc_0[4] = {1, 1, 2, 4}; //Defined in slots
+   NS_ASSERT_MSG (numerologyIndex <= 3, "Numerology index must be between 0 and 3");
+   return T_proc_0[numerologyIndex];
 }
 
 
 uint16_t
 GetTproc1 (uint16_t numerologyIndex)
 {
-   uint16_t T_proc_1; //Defined in slots
-   switch (numerologyIndex)
-   {
-     case 0:
-       T_proc_1 = 3;
-       break;
-     case 1:
-       T_proc_1 = 5;
-       break;
-     case 2:
-       T_proc_1 = 9;
-       break;
-     case 3:
-       T_proc_1 = 17;
-       break;
-   }
-
-   return T_proc_1;
+   static const uint16_t T_proc_1[4] = {3, 5, 9, 17}; //Defined in slots
+   NS_ASSERT_MSG (numerologyIndex <= 3, "Numerology index must be between 0 and 3");
+   return T_proc_1[numerologyIndex];
 }
 
 
@@ -290,9 +278,9 @@ GetRefSensitivity (uint16_t SCS, uint32_t BW)
    //Print the table
    for (std::map <uint16_t, std::map<uint16_t, double> >::iterator IT = RefSens.begin(); IT != RefSens.end(); IT++)
    {
-    NS_LOG_UNCOND("BW = " << IT->first << " MHz");
+    NR_V2X_CONSOLE (INFO, "BW = " << IT->first << " MHz");
     for (std::map<uint16_t, double>::iterator innerIT = IT->second.begin(); innerIT != IT->second.end(); innerIT++)
-      NS_LOG_UNCOND("SCS = " << innerIT->first << " kHz. Sensitivity = " << innerIT->second);
+      NR_V2X_CONSOLE (INFO, "SCS = " << innerIT->first << " kHz. Sensitivity = " << innerIT->second);
    }
 
    return RefSens[BW][SCS];
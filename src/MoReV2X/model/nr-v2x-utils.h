@@ -31,6 +31,16 @@ uint32_t SubtractFrames (uint16_t frameAhead, uint16_t frame, uint16_t subframeA
 
 SidelinkCommResourcePool::SubframeInfo SimulatorTimeToSubframe (Time time, double slotDuration);
 
+/**
+* Same as above, with the slot duration given as 2^-numerologyIndex ms
+*/
+SidelinkCommResourcePool::SubframeInfo SimulatorTimeToSubframe (Time time, uint16_t numerologyIndex);
+
+/**
+* Method to get the numerology index of a slot duration of 1, 0.5, 0.25 or 0.125 ms
+*/
+uint16_t GetNumerologyIndex (double slotDuration);
+
 uint32_t EvaluateSlotsDifference(SidelinkCommResourcePool::SubframeInfo SF1, SidelinkCommResourcePool::SubframeInfo SF2, uint32_t maxDifference);
 
 /**
@@ -0,0 +1,151 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#include "nr-v2x-worker-pool.h"
+
+#include <ns3/assert.h>
+
+namespace ns3 {
+
+NrV2XWorkerPool::NrV2XWorkerPool (uint32_t workers)
+  : m_task (0),
+    m_iterations (0),
+    m_next (0),
+    m_pending (0),
+    m_generation (0),
+    m_stop (false)
+{
+  NS_ASSERT_MSG (workers > 0, "At least one worker is needed");
+  for (uint32_t i = 1; i < workers; i++)
+    {
+      m_threads.push_back (std::thread (&NrV2XWorkerPool::Work, this));
+    }
+}
+
+NrV2XWorkerPool::~NrV2XWorkerPool ()
+{
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_stop = true;
+  }
+  m_start.notify_all ();
+  for (std::vector<std::thread>::iterator it = m_threads.begin (); it != m_threads.end (); ++it)
+    {
+      it->join ();
+    }
+}
+
+uint32_t
+NrV2XWorkerPool::GetWorkers (void) const
+{
+  return m_threads.size () + 1;
+}
+
+void
+NrV2XWorkerPool::Run (uint32_t n, const std::function<void (uint32_t)>& task)
+{
+  if (n == 0)
+    {
+      return;
+    }
+  if (m_threads.empty () || n == 1)
+    {
+      for (uint32_t i = 0; i < n; i++)
+        {
+          task (i);
+        }
+      return;
+    }
+
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_task = &task;
+    m_iterations = n;
+    m_next = 0;
+    m_pending = n;
+    m_generation++;
+  }
+  m_start.notify_all ();
+
+  RunIterations ();
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (m_pending > 0)
+    {
+      m_done.wait (lock);
+    }
+  m_task = 0;
+}
+
+void
+NrV2XWorkerPool::Work (void)
+{
+  uint64_t generation = 0;
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_mutex);
+        while (!m_stop && m_generation == generation)
+          {
+            m_start.wait (lock);
+          }
+        if (m_stop)
+          {
+            return;
+          }
+        generation = m_generation;
+      }
+      RunIterations ();
+    }
+}
+
+void
+NrV2XWorkerPool::RunIterations (void)
+{
+  while (true)
+    {
+      uint32_t i;
+      const std::function<void (uint32_t)>* task;
+      {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        if (m_next >= m_iterations)
+          {
+            return;
+          }
+        i = m_next++;
+        task = m_task;
+      }
+      (*task) (i);
+      bool last;
+      {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        last = (--m_pending == 0);
+      }
+      if (last)
+        {
+          m_done.notify_one ();
+        }
+    }
+}
+
+} // namespace ns3
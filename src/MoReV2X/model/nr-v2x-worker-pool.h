@@ -0,0 +1,83 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#ifndef NR_V2X_WORKER_POOL_H
+#define NR_V2X_WORKER_POOL_H
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Fixed set of threads running the iterations of a parallel loop.
+ *
+ * The tasks must not touch the simulator, the logging or any reference
+ * counted object: only plain data owned by the caller, and each iteration
+ * its own output. The calling thread runs iterations too, and Run returns
+ * when all of them are done.
+ */
+class NrV2XWorkerPool
+{
+public:
+  /**
+   * \param workers the number of threads, the calling one included
+   */
+  NrV2XWorkerPool (uint32_t workers);
+  ~NrV2XWorkerPool ();
+
+  uint32_t GetWorkers (void) const;
+
+  /**
+   * Run task (i) for every i in [0, n)
+   */
+  void Run (uint32_t n, const std::function<void (uint32_t)>& task);
+
+private:
+  NrV2XWorkerPool (const NrV2XWorkerPool&);
+  NrV2XWorkerPool& operator= (const NrV2XWorkerPool&);
+
+  void Work (void);
+  void RunIterations (void);
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_start;
+  std::condition_variable m_done;
+
+  const std::function<void (uint32_t)>* m_task;
+  uint32_t m_iterations;
+  uint32_t m_next; // next iteration to run
+  uint32_t m_pending; // iterations not completed yet
+  uint64_t m_generation; // incremented at every Run
+  bool m_stop;
+};
+
+} // namespace ns3
+
+#endif /* NR_V2X_WORKER_POOL_H */
@@ -26,6 +26,7 @@
 #include "ns3/assert.h"
 
 #define  INF 10000
+#define  MAX_RASTER_CELLS 16000000
 
 namespace ns3 {
 
@@ -34,24 +35,52 @@ PosEnabler::PosEnabler() // Create the object
   m_enabled = true;
 }
 
-void
+int
 PosEnabler::initPolygon(Point *polygon, int n, std::string polyType)
 {
-  if (polyType == "TX")
-  {
-    m_polygonTX = polygon;
-    m_TXsize = n;
-  }
-  else if (polyType == "RX")
-  {
-    m_polygonRX = polygon;
-    m_RXsize = n;    
-  }
-  else 
+  NS_ASSERT_MSG((polyType == "TX") || (polyType == "RX"), "Invalid polygon type");
+  int handle = registerPolygon(polygon, n);
+  m_polygonNames[polyType] = handle;
+  return handle;
+}
+
+int
+PosEnabler::registerPolygon(Point *polygon, int n)
+{
+  Polygon poly;
+  poly.vertices.assign(polygon, polygon + std::max(n, 0));
+  poly.minX = poly.maxX = poly.minY = poly.maxY = 0;
+  poly.rasterized = false;
+  if (n >= 3)
   {
-    NS_ASSERT_MSG(false, "Invalid polygon type");
+    poly.minX = poly.maxX = polygon[0].x;
+    poly.minY = poly.maxY = polygon[0].y;
+    for (int i = 1; i < n; i++)
+    {
+      poly.minX = std::min(poly.minX, polygon[i].x);
+      poly.maxX = std::max(poly.maxX, polygon[i].x);
+      poly.minY = std::min(poly.minY, polygon[i].y);
+      poly.maxY = std::max(poly.maxY, polygon[i].y);
+    }
+    // The points on the right of the bounding box are outside only if the ray does not reach the polygon
+    uint64_t cells = (uint64_t) (poly.maxX - poly.minX + 2) * (poly.maxY - poly.minY + 1);
+    if ((poly.maxX < INF) && (cells <= MAX_RASTER_CELLS))
+    {
+      poly.rasterized = true;
+      poly.raster.resize(cells);
+      poly.rowReady.resize(poly.maxY - poly.minY + 1, false);
+    }
   }
-  
+  m_polygons.push_back(poly);
+  return m_polygons.size() - 1;
+}
+
+int
+PosEnabler::getPolygonHandle(std::string polyType)
+{
+  std::map<std::string, int>::iterator it = m_polygonNames.find(polyType);
+  NS_ASSERT_MSG(it != m_polygonNames.end(), "Invalid polygon type");
+  return it->second;
 }
 
 void
@@ -127,28 +156,11 @@ PosEnabler::doIntersect(Point p1, Point q1, Point p2, Point q2)
 } 
 
 
-// Returns true if the point p lies inside the polygon[] with n vertices 
-bool
-PosEnabler::isInsidePoly(std::string polyType, Point p) 
+// Ray-casting test of the point p against the polygon[] with n vertices
+PosEnabler::RayCast
+PosEnabler::rayCast(const std::vector<Point>& polygon, Point p) 
 { 
-  Point *polygon;
-  int n;
-  if (polyType == "TX")
-  {
-    polygon = m_polygonTX;
-    n = m_TXsize;
-  }
-  else if (polyType == "RX")
-  {
-    polygon = m_polygonRX;
-    n = m_RXsize    ;
-  }
-  else 
-  {
-    NS_ASSERT_MSG(false, "Invalid polygon type");
-  }
-  // There must be at least 3 vertices in polygon[] 
-  if (n < 3)  return false; 
+  int n = polygon.size();
   // Create a point for line segment from p to infinite 
   Point extreme = {INF, p.y}; 
   // Count intersections of the above line with sides of polygon 
@@ -164,17 +176,67 @@ PosEnabler::isInsidePoly(std::string polyType, Point p)
       // then check if it lies on segment. If it lies, return true, 
       // otherwise false 
       if (orientation(polygon[i], p, polygon[next]) == 0) 
-        return onSegment(polygon[i], p, polygon[next]); 
+        return onSegment(polygon[i], p, polygon[next]) ? ON_EDGE : COLLINEAR_OUTSIDE; 
       count++; 
     } 
     i = next; 
   } while (i != 0); 
   
-  // Return true if count is odd, false otherwise 
-  if (m_enabled)
-    return count&1;  // Same as (count%2 == 1) 
-  else
-    return true;
+  return (count&1) ? INSIDE : OUTSIDE;  // Same as (count%2 == 1) 
+} 
+
+
+PosEnabler::RayCast
+PosEnabler::classify(Polygon& polygon, Point p)
+{
+  // Bounding-box rejection: the ray does not cross any side
+  if ((p.y < polygon.minY) || (p.y > polygon.maxY) || ((p.x > polygon.maxX) && (polygon.maxX < INF)))
+    return OUTSIDE;
+  if (!polygon.rasterized)
+    return rayCast(polygon.vertices, p);
+
+  int width = polygon.maxX - polygon.minX + 2;
+  int row = p.y - polygon.minY;
+  if (!polygon.rowReady[row])
+  {
+    for (int column = 0; column < width; column++)
+    {
+      Point q = {polygon.minX + column - 1, p.y};
+      polygon.raster[row * width + column] = rayCast(polygon.vertices, q);
+    }
+    polygon.rowReady[row] = true;
+  }
+  int column = (p.x < polygon.minX) ? 0 : p.x - polygon.minX + 1;
+  return (RayCast) polygon.raster[row * width + column];
+}
+
+
+bool
+PosEnabler::isInsidePoly(std::string polyType, Point p) 
+{ 
+  return isInsidePoly(getPolygonHandle(polyType), p);
+}
+
+
+// Returns true if the point p lies inside the polygon with the given handle
+bool
+PosEnabler::isInsidePoly(int polygon, Point p) 
+{ 
+  NS_ASSERT_MSG((polygon >= 0) && (polygon < (int) m_polygons.size()), "Invalid polygon handle");
+  // There must be at least 3 vertices in polygon[] 
+  if (m_polygons[polygon].vertices.size() < 3)  return false; 
+
+  switch (classify(m_polygons[polygon], p))
+  {
+    case ON_EDGE:
+      return true;
+    case COLLINEAR_OUTSIDE:
+      return false;
+    case INSIDE:
+      return true;
+    default:
+      return !m_enabled;
+  }
 } 
 
 
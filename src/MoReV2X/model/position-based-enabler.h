@@ -26,6 +26,9 @@
 
 #include "ns3/vector.h"
 #include <vector>
+#include <map>
+#include <string>
+#include <stdint.h>
 
 
 namespace ns3 {
@@ -47,7 +50,11 @@ class PosEnabler
 {
   public:
     PosEnabler ();   
-    void initPolygon(Point polygon[], int n, std::string polyType);
+    // Register the polygon under the name polyType ("TX" or "RX") and return its handle
+    int initPolygon(Point polygon[], int n, std::string polyType);
+    // Register a polygon and return the handle to be used with isInsidePoly
+    int registerPolygon(Point polygon[], int n);
+    int getPolygonHandle(std::string polyType);
     void initBBs(std::vector<BoundingBox> BBs);
 
     void EnableChecker(void);
@@ -58,13 +65,40 @@ class PosEnabler
     int orientation(Point p, Point q, Point r);
     bool doIntersect(Point p1, Point q1, Point p2, Point q2);
     bool isInsidePoly(std::string polyType, Point p);
+    bool isInsidePoly(int polygon, Point p);
 
     //Bounding boxes
     bool isEnabled(Vector pos); 
 
   private: 
-    Point *m_polygonTX, *m_polygonRX;
-    int m_TXsize, m_RXsize;
+    // Outcome of the ray-casting test, before applying m_enabled
+    enum RayCast
+    {
+      OUTSIDE = 0,          // even number of crossings
+      INSIDE = 1,           // odd number of crossings
+      ON_EDGE = 2,          // collinear with a crossed side and on it
+      COLLINEAR_OUTSIDE = 3 // collinear with a crossed side but not on it
+    };
+
+    /*
+      Registered polygon. Inside the bounding box the ray-casting outcome of every integer point is cached
+      in a raster, filled one row at a time. The first column of each row holds the outcome of the points
+      on the left of the bounding box, which is the same for all of them
+    */
+    struct Polygon
+    {
+      std::vector<Point> vertices;
+      int minX, maxX, minY, maxY;
+      bool rasterized;
+      std::vector<uint8_t> raster;
+      std::vector<bool> rowReady;
+    };
+
+    RayCast rayCast(const std::vector<Point>& polygon, Point p);
+    RayCast classify(Polygon& polygon, Point p);
+
+    std::vector<Polygon> m_polygons;
+    std::map<std::string, int> m_polygonNames;
     std::vector<BoundingBox> m_BBs; 
     bool m_enabled;
 
@@ -0,0 +1,1959 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+/*
+ * Microbenchmarks of the MoReV2X hot paths. The workloads are synthetic and
+ * seed-controlled, so that two runs of the same build perform exactly the
+ * same operations. Every measurement is appended as a CSV row
+ * (workload,parameters,operations,seconds,opsPerSecond) to the file given by
+ * the MoReV2XBenchmarkOutput global value. If MoReV2XBenchmarkBaseline points
+ * to a file produced by a previous run, a test case fails when its throughput
+ * drops below (1 - MoReV2XBenchmarkTolerance) times the baseline one.
+ * The results of the same paths are checked by the nr-v2x unit suite.
+ *
+ * Example:
+ *   NS_GLOBAL_VALUE="MoReV2XBenchmarkBaseline=base.csv;MoReV2XBenchmarkTolerance=0.2" \
+ *     ./test.py --suite=nr-v2x-benchmark
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/global-value.h>
+#include <ns3/string.h>
+#include <ns3/double.h>
+#include <ns3/uinteger.h>
+#include <ns3/boolean.h>
+#include <ns3/rng-seed-manager.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/node-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/spectrum-value.h>
+
+#include <ns3/nr-v2x-ue-mac.h>
+#include <ns3/nr-v2x-spectrum-phy.h>
+#include <ns3/nr-v2x-propagation-loss-model.h>
+#include <ns3/nr-v2x-spectrum-value-helper.h>
+#include <ns3/nr-v2x-phy-error-model.h>
+#include <ns3/nr-v2x-utils.h>
+#include <ns3/nist-lte-common.h>
+#include <ns3/position-based-enabler.h>
+#include <ns3/nr-v2x-trace-mobility-helper.h>
+#include <ns3/nist-lte-sl-interference.h>
+#include <ns3/nr-v2x-worker-pool.h>
+#include <ns3/lte-node-state.h>
+#include <ns3/nist-lte-harq-phy.h>
+#include <ns3/building.h>
+#include <ns3/building-list.h>
+#include <ns3/nr-v2x-building-index.h>
+#include <ns3/nr-v2x-urban-propagation-loss-model.h>
+#include <ns3/nist-epc-tft-classifier.h>
+#include <ns3/packet.h>
+#include <ns3/ipv4-header.h>
+#include <ns3/udp-header.h>
+#include <ns3/udp-l4-protocol.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/spectrum-signal-parameters.h>
+
+#include "nr-v2x-counting-spectrum-phy.h"
+#include "nr-v2x-test-access.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <cstdio>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrV2XBenchmarkTest");
+
+static GlobalValue g_benchmarkOutput ("MoReV2XBenchmarkOutput",
+                                      "CSV file where the MoReV2X benchmark results are appended",
+                                      StringValue ("morev2x-benchmark.csv"),
+                                      MakeStringChecker ());
+
+static GlobalValue g_benchmarkBaseline ("MoReV2XBenchmarkBaseline",
+                                        "CSV file of a previous MoReV2X benchmark run. Empty disables the regression check",
+                                        StringValue (""),
+                                        MakeStringChecker ());
+
+static GlobalValue g_benchmarkTolerance ("MoReV2XBenchmarkTolerance",
+                                         "Tolerated relative throughput drop with respect to the baseline",
+                                         DoubleValue (0.25),
+                                         MakeDoubleChecker<double> (0.0, 1.0));
+
+static GlobalValue g_benchmarkSeed ("MoReV2XBenchmarkSeed",
+                                    "Seed of the synthetic MoReV2X benchmark workloads",
+                                    UintegerValue (1),
+                                    MakeUintegerChecker<uint32_t> (1));
+
+static GlobalValue g_benchmarkNodes ("MoReV2XBenchmarkNodes",
+                                     "Comma-separated numbers of nodes of the channel matrix benchmark (e.g. 100,500,1000,5000)",
+                                     StringValue ("100,500,1000"),
+                                     MakeStringChecker ());
+
+
+/**
+ * Base class of the benchmarks: seeds the workload, reports the measurements
+ * and checks them against the baseline
+ */
+class NrV2XBenchmarkTestCase : public TestCase
+{
+public:
+  NrV2XBenchmarkTestCase (std::string name);
+  virtual ~NrV2XBenchmarkTestCase ();
+
+protected:
+  typedef std::chrono::steady_clock Clock_t;
+
+  /**
+   * Seed the ns-3 RNG for the given workload, so that every configuration
+   * of every run draws the same values
+   */
+  void SeedWorkload (uint32_t run);
+
+  /**
+   * \param workload the name of the workload
+   * \param parameters the configuration of the workload
+   * \param operations the number of operations performed
+   * \param start the time of the first operation
+   */
+  void Report (std::string workload, std::string parameters, uint64_t operations, Clock_t::time_point start);
+
+private:
+  std::map<std::string, double> LoadBaseline (std::string fileName);
+};
+
+NrV2XBenchmarkTestCase::NrV2XBenchmarkTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+NrV2XBenchmarkTestCase::~NrV2XBenchmarkTestCase ()
+{
+}
+
+void
+NrV2XBenchmarkTestCase::SeedWorkload (uint32_t run)
+{
+  UintegerValue seed;
+  g_benchmarkSeed.GetValue (seed);
+  RngSeedManager::SetSeed (seed.Get ());
+  RngSeedManager::SetRun (run);
+}
+
+std::map<std::string, double>
+NrV2XBenchmarkTestCase::LoadBaseline (std::string fileName)
+{
+  std::map<std::string, double> baseline;
+  std::ifstream baselineFile (fileName.c_str ());
+  if (!baselineFile.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open the benchmark baseline " << fileName);
+    }
+  std::string line;
+  while (std::getline (baselineFile, line))
+    {
+      // workload,parameters,operations,seconds,opsPerSecond
+      std::vector<std::string> fields;
+      std::stringstream lineStream (line);
+      std::string field;
+      while (std::getline (lineStream, field, ','))
+        {
+          fields.push_back (field);
+        }
+      if (fields.size () == 5 && fields[0] != "workload")
+        {
+          baseline[fields[0] + "," + fields[1]] = std::atof (fields[4].c_str ()); // the last run of a configuration wins
+        }
+    }
+  return baseline;
+}
+
+void
+NrV2XBenchmarkTestCase::Report (std::string workload, std::string parameters, uint64_t operations, Clock_t::time_point start)
+{
+  std::chrono::duration<double> elapsed = Clock_t::now () - start;
+  double opsPerSecond = operations / std::max (elapsed.count (), 1e-9);
+  NS_LOG_INFO (workload << " [" << parameters << "]: " << operations << " operations in " << elapsed.count () << " s, "
+                        << opsPerSecond << " ops/s");
+
+  StringValue output;
+  g_benchmarkOutput.GetValue (output);
+  if (output.Get () != "")
+    {
+      std::ifstream existing (output.Get ().c_str ());
+      bool writeHeader = !existing.good ();
+      existing.close ();
+      std::ofstream outputFile (output.Get ().c_str (), std::ios_base::app);
+      if (writeHeader)
+        {
+          outputFile << "workload,parameters,operations,seconds,opsPerSecond" << std::endl;
+        }
+      outputFile << workload << "," << parameters << "," << operations << "," << elapsed.count () << "," << opsPerSecond << std::endl;
+      outputFile.close ();
+    }
+
+  StringValue baselineName;
+  g_benchmarkBaseline.GetValue (baselineName);
+  if (baselineName.Get () != "")
+    {
+      DoubleValue tolerance;
+      g_benchmarkTolerance.GetValue (tolerance);
+      std::map<std::string, double> baseline = LoadBaseline (baselineName.Get ());
+      std::map<std::string, double>::iterator it = baseline.find (workload + "," + parameters);
+      if (it != baseline.end ())
+        {
+          NS_TEST_EXPECT_MSG_GT_OR_EQ (opsPerSecond, (1 - tolerance.Get ()) * it->second,
+                                       workload << " [" << parameters << "] throughput dropped beyond the tolerance");
+        }
+    }
+}
+
+
+/**
+ * Mode 2 resource selection: Mode2Step1 and ReEvaluationStep1 over a
+ * selection window built by SelectionWindow, with a synthetic sensing
+ * database
+ */
+class NrV2XMode2SelectionBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XMode2SelectionBenchmark (double pdb, std::vector<uint16_t> rriList, uint16_t nSubCh, uint16_t lSubCh, double density);
+  virtual ~NrV2XMode2SelectionBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  double m_pdb;
+  std::vector<uint16_t> m_rriList;
+  uint16_t m_nSubCh;
+  uint16_t m_lSubCh;
+  double m_density;
+};
+
+NrV2XMode2SelectionBenchmark::NrV2XMode2SelectionBenchmark (double pdb, std::vector<uint16_t> rriList, uint16_t nSubCh, uint16_t lSubCh, double density)
+  : NrV2XBenchmarkTestCase ("Mode 2 selection benchmark"),
+    m_pdb (pdb),
+    m_rriList (rriList),
+    m_nSubCh (nSubCh),
+    m_lSubCh (lSubCh),
+    m_density (density)
+{
+}
+
+NrV2XMode2SelectionBenchmark::~NrV2XMode2SelectionBenchmark ()
+{
+}
+
+void
+NrV2XMode2SelectionBenchmark::DoRun (void)
+{
+  SeedWorkload (1);
+  const uint16_t subchannelSize = 10;
+  const uint32_t iterations = 50;
+
+  Ptr<NrV2XUeMac> mac = NrV2XTestAccess::CreateMode2Mac (subchannelSize, m_rriList);
+
+  // Current slot SF(600,5): sense the reservations of the previous second
+  SidelinkCommResourcePool::SubframeInfo currentSF;
+  currentSF.frameNo = 600;
+  currentSF.subframeNo = 5;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  NrV2XTestAccess::FillSensingDatabase (mac, currentSF, uniform, m_rriList, subchannelSize, m_nSubCh, m_lSubCh, m_density, false);
+
+  NrV2XTestAccess::V2XSidelinkGrant grant;
+  grant.m_RRI = 100;
+  grant.m_Cresel = 10;
+  double T_2 = m_pdb - 1.0;
+
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      uint32_t iterationsCounter = 0, nCSR = 0;
+      double psschThresh = -110;
+      std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa, L1;
+      Sa = NrV2XTestAccess::SelectionWindow (mac, currentSF, T_2, m_nSubCh - m_lSubCh + 1);
+      L1 = NrV2XTestAccess::Mode2Step1 (mac, Sa, currentSF, grant, T_2, m_nSubCh, m_lSubCh, &iterationsCounter, &psschThresh, &nCSR, false);
+    }
+  std::ostringstream rriString;
+  for (std::vector<uint16_t>::iterator it = m_rriList.begin (); it != m_rriList.end (); it++)
+    {
+      rriString << (it == m_rriList.begin () ? "" : "/") << *it;
+    }
+  std::ostringstream parameters;
+  parameters << "pdb=" << m_pdb << " rri=" << rriString.str () << " nSubCh=" << m_nSubCh << " lSubCh=" << m_lSubCh << " density=" << m_density;
+  Report ("Mode2Selection", parameters.str (), iterations, start);
+
+  // Re-evaluations of the same window one slot apart, as with ReEvaluation in all slots: the full
+  // Mode2Step1 of each of them against ReEvaluationStep1, which builds the window state once
+  uint32_t nSteps = std::min (10.0, T_2 - 3);
+  start = Clock_t::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      uint32_t iterationsCounter = 0, nCSR = 0;
+      double psschThresh = -110;
+      SidelinkCommResourcePool::SubframeInfo reEvalSF;
+      reEvalSF.frameNo = (currentSF.frameNo * 10 + currentSF.subframeNo + i % nSteps) / 10;
+      reEvalSF.subframeNo = (currentSF.frameNo * 10 + currentSF.subframeNo + i % nSteps) % 10;
+      std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa, L1;
+      Sa = NrV2XTestAccess::SelectionWindow (mac, reEvalSF, T_2 - i % nSteps, m_nSubCh - m_lSubCh + 1);
+      L1 = NrV2XTestAccess::Mode2Step1 (mac, Sa, reEvalSF, grant, T_2 - i % nSteps, m_nSubCh, m_lSubCh, &iterationsCounter, &psschThresh, &nCSR, false);
+    }
+  Report ("Mode2ReEvaluationFull", parameters.str (), iterations, start);
+
+  start = Clock_t::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      uint32_t iterationsCounter = 0, nCSR = 0;
+      double psschThresh = -110;
+      SidelinkCommResourcePool::SubframeInfo reEvalSF;
+      reEvalSF.frameNo = (currentSF.frameNo * 10 + currentSF.subframeNo + i % nSteps) / 10;
+      reEvalSF.subframeNo = (currentSF.frameNo * 10 + currentSF.subframeNo + i % nSteps) % 10;
+      NrV2XTestAccess::ReEvaluationStep1 (mac, reEvalSF, T_2 - i % nSteps, m_nSubCh - m_lSubCh + 1, grant, T_2 - i % nSteps, m_nSubCh, m_lSubCh, &iterationsCounter, &psschThresh, &nCSR, false);
+    }
+  Report ("Mode2ReEvaluation", parameters.str (), iterations, start);
+
+  mac->Dispose ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Frequency-reuse geo-cell lookup: GetGeoCellSubchannel on a highway
+ * partitioned with GetGeoCellSize
+ */
+class NrV2XGeoCellLookupBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XGeoCellLookupBenchmark (uint16_t nRbs, double reuseDistance);
+  virtual ~NrV2XGeoCellLookupBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_nRbs;
+  double m_reuseDistance;
+};
+
+NrV2XGeoCellLookupBenchmark::NrV2XGeoCellLookupBenchmark (uint16_t nRbs, double reuseDistance)
+  : NrV2XBenchmarkTestCase ("Geo-cell lookup benchmark"),
+    m_nRbs (nRbs),
+    m_reuseDistance (reuseDistance)
+{
+}
+
+NrV2XGeoCellLookupBenchmark::~NrV2XGeoCellLookupBenchmark ()
+{
+}
+
+void
+NrV2XGeoCellLookupBenchmark::DoRun (void)
+{
+  SeedWorkload (6);
+  const uint16_t subchannelSize = 10;
+  const double highwayLength = 5000;
+  const uint32_t iterations = 200000;
+
+  uint32_t nGeoCells;
+  double geoCellSize = GetGeoCellSize (subchannelSize, m_nRbs, m_reuseDistance, &nGeoCells);
+  std::map < uint16_t, std::vector < std::pair <double, double>>> subchannelsMap;
+  for (double clusterStart = 0; clusterStart < highwayLength; clusterStart += m_reuseDistance)
+    {
+      for (uint16_t subCh = 0; subCh < nGeoCells; subCh++)
+        {
+          subchannelsMap[subCh].push_back (std::make_pair (clusterStart + subCh * geoCellSize, clusterStart + (subCh + 1) * geoCellSize));
+        }
+    }
+  Ptr<NrV2XUeMac> mac = CreateObject<NrV2XUeMac> ();
+  mac->CopySubchannelsMap (subchannelsMap);
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  std::vector<double> positions;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      positions.push_back (uniform->GetValue (-100, highwayLength + 100));
+    }
+
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      uint16_t csr;
+      NrV2XTestAccess::GetGeoCellSubchannel (mac, positions[i % positions.size ()], &csr);
+    }
+  std::ostringstream parameters;
+  parameters << "nRbs=" << m_nRbs << " reuseDistance=" << m_reuseDistance;
+  Report ("GeoCellLookup", parameters.str (), iterations, start);
+  mac->Dispose ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Position checker: PosEnabler::isInsidePoly on the HIGHWAY TX polygon and
+ * on a concave polygon with horizontal sides, on random points, vertices
+ * and points of the sides
+ */
+class NrV2XPolygonCheckBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XPolygonCheckBenchmark (bool enabled);
+  virtual ~NrV2XPolygonCheckBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  bool m_enabled;
+};
+
+NrV2XPolygonCheckBenchmark::NrV2XPolygonCheckBenchmark (bool enabled)
+  : NrV2XBenchmarkTestCase ("Polygon check benchmark"),
+    m_enabled (enabled)
+{
+}
+
+NrV2XPolygonCheckBenchmark::~NrV2XPolygonCheckBenchmark ()
+{
+}
+
+void
+NrV2XPolygonCheckBenchmark::DoRun (void)
+{
+  SeedWorkload (7);
+  const uint32_t iterations = 1000000;
+
+  Point highway[] = {{975, 1870}, {1540, 1626}, {1965, 2121}, {2556, 3253}, {1798,3597}, {966,2492}};
+  Point concave[] = {{0, 0}, {400, 0}, {400, 300}, {250, 300}, {250, 100}, {150, 100}, {150, 300}, {0, 300}};
+  std::vector<std::vector<Point> > polygons;
+  polygons.push_back (std::vector<Point> (highway, highway + 6));
+  polygons.push_back (std::vector<Point> (concave, concave + 8));
+
+  PosEnabler checker;
+  if (!m_enabled)
+    {
+      checker.DisableChecker ();
+    }
+  std::vector<int> handles;
+  for (uint32_t i = 0; i < polygons.size (); i++)
+    {
+      handles.push_back (checker.registerPolygon (&polygons[i][0], polygons[i].size ()));
+    }
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  std::vector<std::pair<int, Point> > queries;
+  for (uint32_t i = 0; i < polygons.size (); i++)
+    {
+      int minX = polygons[i][0].x, maxX = minX, minY = polygons[i][0].y, maxY = minY;
+      for (uint32_t v = 0; v < polygons[i].size (); v++)
+        {
+          minX = std::min (minX, polygons[i][v].x);
+          maxX = std::max (maxX, polygons[i][v].x);
+          minY = std::min (minY, polygons[i][v].y);
+          maxY = std::max (maxY, polygons[i][v].y);
+          // Vertices and points along the sides
+          Point next = polygons[i][(v + 1) % polygons[i].size ()];
+          for (int step = 0; step <= 10; step++)
+            {
+              Point p = {polygons[i][v].x + (next.x - polygons[i][v].x) * step / 10,
+                         polygons[i][v].y + (next.y - polygons[i][v].y) * step / 10};
+              queries.push_back (std::make_pair (i, p));
+            }
+        }
+      for (uint32_t q = 0; q < 2000; q++)
+        {
+          Point p = {(int) std::floor (uniform->GetValue (minX - 50, maxX + 51)), (int) std::floor (uniform->GetValue (minY - 50, maxY + 51))};
+          queries.push_back (std::make_pair (i, p));
+        }
+    }
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      std::pair<int, Point>& query = queries[i % queries.size ()];
+      checker.isInsidePoly (handles[query.first], query.second);
+    }
+  std::ostringstream parameters;
+  parameters << "enabled=" << m_enabled;
+  Report ("PolygonCheck", parameters.str (), iterations, start);
+  Simulator::Destroy ();
+}
+
+
+/**
+ * PSSCH overlap resolution: UnimoreCompareSinrPSSCH on random pairs of
+ * subchannel allocations
+ */
+class NrV2XPsschOverlapBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XPsschOverlapBenchmark (uint16_t nRbs, uint16_t subchannelSize);
+  virtual ~NrV2XPsschOverlapBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_nRbs;
+  uint16_t m_subchannelSize;
+};
+
+NrV2XPsschOverlapBenchmark::NrV2XPsschOverlapBenchmark (uint16_t nRbs, uint16_t subchannelSize)
+  : NrV2XBenchmarkTestCase ("PSSCH overlap resolution benchmark"),
+    m_nRbs (nRbs),
+    m_subchannelSize (subchannelSize)
+{
+}
+
+NrV2XPsschOverlapBenchmark::~NrV2XPsschOverlapBenchmark ()
+{
+}
+
+void
+NrV2XPsschOverlapBenchmark::DoRun (void)
+{
+  SeedWorkload (2);
+  const uint32_t pairs = 200;
+  const uint32_t iterations = 100000;
+
+  Ptr<NrV2XSpectrumPhy> phy = CreateObject<NrV2XSpectrumPhy> ();
+  Ptr<SpectrumModel> model = NrV2XSpectrumValueHelper::GetSpectrumModel (18100, m_nRbs);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uint16_t nSubCh = m_nRbs / m_subchannelSize;
+
+  std::vector<SpectrumValue> sinrs;
+  std::vector<std::vector<int> > maps;
+  for (uint32_t i = 0; i < 2 * pairs; i++)
+    {
+      SpectrumValue sinr (model);
+      for (uint16_t rb = 0; rb < m_nRbs; rb++)
+        {
+          sinr[rb] = std::pow (10.0, uniform->GetValue (-10, 30) / 10);
+        }
+      sinrs.push_back (sinr);
+      uint16_t length = uniform->GetInteger (1, nSubCh);
+      uint16_t first = uniform->GetInteger (0, nSubCh - length);
+      std::vector<int> map;
+      for (int rb = first * m_subchannelSize; rb < (first + length) * m_subchannelSize; rb++)
+        {
+          map.push_back (rb);
+        }
+      maps.push_back (map);
+    }
+
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      uint32_t pair = i % pairs;
+      NrV2XTestAccess::UnimoreCompareSinrPSSCH (phy, sinrs[2 * pair], maps[2 * pair], sinrs[2 * pair + 1], maps[2 * pair + 1]);
+    }
+  std::ostringstream parameters;
+  parameters << "nRbs=" << m_nRbs << " subchannelSize=" << m_subchannelSize;
+  Report ("PsschOverlap", parameters.str (), iterations, start);
+  phy->Dispose ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * PSSCH-RSRP history: DoReportPsschRsrp over a long run, where the history
+ * is trimmed to the sensing window
+ */
+class NrV2XPsschRsrpHistoryBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XPsschRsrpHistoryBenchmark (double simTime, double reportsPerMs);
+  virtual ~NrV2XPsschRsrpHistoryBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  double m_simTime; // (s)
+  double m_reportsPerMs;
+};
+
+NrV2XPsschRsrpHistoryBenchmark::NrV2XPsschRsrpHistoryBenchmark (double simTime, double reportsPerMs)
+  : NrV2XBenchmarkTestCase ("PSSCH-RSRP history benchmark"),
+    m_simTime (simTime),
+    m_reportsPerMs (reportsPerMs)
+{
+}
+
+NrV2XPsschRsrpHistoryBenchmark::~NrV2XPsschRsrpHistoryBenchmark ()
+{
+}
+
+void
+NrV2XPsschRsrpHistoryBenchmark::DoRun (void)
+{
+  SeedWorkload (8);
+  const uint64_t iterations = m_simTime * 1000 * m_reportsPerMs;
+  const int64_t step = 1000000 / m_reportsPerMs; // (ns)
+
+  Ptr<NrV2XUeMac> mac = CreateObject<NrV2XUeMac> ();
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint64_t i = 0; i < iterations; i++)
+    {
+      NrV2XTestAccess::DoReportPsschRsrp (mac, NanoSeconds (i * step), uniform->GetInteger (0, 40), 10, uniform->GetValue (-110, -60));
+    }
+  std::ostringstream parameters;
+  parameters << "simTime=" << m_simTime << " reportsPerMs=" << m_reportsPerMs;
+  Report ("PsschRsrpHistory", parameters.str (), iterations, start);
+
+  mac->Dispose ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Channel matrix: InitChannelMatrix and one UpdateChannelMatrix for N
+ * vehicles dropped on a 2 km highway
+ */
+class NrV2XChannelMatrixBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XChannelMatrixBenchmark (uint32_t nNodes);
+  virtual ~NrV2XChannelMatrixBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nNodes;
+};
+
+NrV2XChannelMatrixBenchmark::NrV2XChannelMatrixBenchmark (uint32_t nNodes)
+  : NrV2XBenchmarkTestCase ("Channel matrix benchmark"),
+    m_nNodes (nNodes)
+{
+}
+
+NrV2XChannelMatrixBenchmark::~NrV2XChannelMatrixBenchmark ()
+{
+}
+
+void
+NrV2XChannelMatrixBenchmark::DoRun (void)
+{
+  SeedWorkload (3);
+  NodeContainer nodes;
+  nodes.Create (m_nNodes);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (uniform->GetValue (0, 2000), uniform->GetValue (0, 6 * 4), 1.5));
+      (*it)->AggregateObject (mobility);
+    }
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Ptr<NrV2XPropagationLossModel> lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+
+  std::ostringstream parameters;
+  parameters << "nodes=" << m_nNodes;
+  Clock_t::time_point start = Clock_t::now ();
+  lossModel->InitChannelMatrix (nodes);
+  Report ("ChannelMatrixInit", parameters.str (), (uint64_t) m_nNodes * (m_nNodes - 1) / 2, start);
+
+  // The first update is scheduled 100 ms after the initialization
+  Simulator::Stop (MilliSeconds (150));
+  start = Clock_t::now ();
+  Simulator::Run ();
+  Report ("ChannelMatrixUpdate", parameters.str (), (uint64_t) m_nNodes * (m_nNodes - 1) / 2, start);
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Mobility trace ingestion: NrV2XTraceMobilityHelper on a synthetic SUMO
+ * FCD trace where vehicle v drives east at 20 m/s along y = v. The vehicles
+ * enter and leave a pool of V-UEs, optionally with their channel models
+ * activated and retired accordingly
+ */
+class NrV2XTraceMobilityBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XTraceMobilityBenchmark (uint32_t nVehicles, uint32_t poolSize, bool channelModels);
+  virtual ~NrV2XTraceMobilityBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  void Enter (uint32_t nodeId);
+  void Leave (uint32_t nodeId);
+
+  uint32_t m_nVehicles;
+  uint32_t m_poolSize;
+  bool m_channelModels;
+  uint32_t m_steps;
+  uint32_t m_lifetime;
+  Ptr<NrV2XPropagationLossModel> m_lossModel;
+};
+
+NrV2XTraceMobilityBenchmark::NrV2XTraceMobilityBenchmark (uint32_t nVehicles, uint32_t poolSize, bool channelModels)
+  : NrV2XBenchmarkTestCase ("Mobility trace benchmark"),
+    m_nVehicles (nVehicles),
+    m_poolSize (poolSize),
+    m_channelModels (channelModels),
+    m_steps (60),
+    m_lifetime (30)
+{
+}
+
+NrV2XTraceMobilityBenchmark::~NrV2XTraceMobilityBenchmark ()
+{
+}
+
+void
+NrV2XTraceMobilityBenchmark::Enter (uint32_t nodeId)
+{
+  if (m_channelModels)
+    {
+      m_lossModel->ActivateNode (nodeId);
+    }
+}
+
+void
+NrV2XTraceMobilityBenchmark::Leave (uint32_t nodeId)
+{
+  if (m_channelModels)
+    {
+      m_lossModel->RetireNode (nodeId);
+    }
+}
+
+void
+NrV2XTraceMobilityBenchmark::DoRun (void)
+{
+  // Vehicle v is in the trace from step v * (steps - lifetime) / nVehicles, for lifetime steps of 1 s
+  const std::string fcdName = "morev2x-benchmark-fcd.xml";
+  std::ofstream fcd (fcdName.c_str ());
+  fcd << "<fcd-export>" << std::endl;
+  uint64_t records = 0;
+  for (uint32_t step = 0; step < m_steps; step++)
+    {
+      fcd << "    <timestep time=\"" << step << ".00\">" << std::endl;
+      for (uint32_t vehicle = 0; vehicle < m_nVehicles; vehicle++)
+        {
+          uint32_t enterStep = (vehicle * (m_steps - m_lifetime)) / m_nVehicles;
+          if ((step >= enterStep) && (step < enterStep + m_lifetime))
+            {
+              fcd << "        <vehicle id=\"veh" << vehicle << "\" x=\"" << 20.0 * (step - enterStep) << "\" y=\"" << vehicle
+                  << "\" angle=\"90.00\" type=\"car\" speed=\"20.00\" pos=\"0.00\" lane=\"e_0\" slope=\"0.00\"/>" << std::endl;
+              records++;
+            }
+        }
+      fcd << "    </timestep>" << std::endl;
+    }
+  fcd << "    <timestep time=\"" << m_steps << ".00\"/>" << std::endl;
+  fcd << "</fcd-export>" << std::endl;
+  fcd.close ();
+
+  NodeContainer pool;
+  pool.Create (m_poolSize);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (pool);
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  m_lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  m_lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+
+  Ptr<NrV2XTraceMobilityHelper> trace = CreateObject<NrV2XTraceMobilityHelper> ();
+  trace->SetAttribute ("LookAhead", TimeValue (Seconds (2)));
+  trace->SetEnterCallback (MakeCallback (&NrV2XTraceMobilityBenchmark::Enter, this));
+  trace->SetLeaveCallback (MakeCallback (&NrV2XTraceMobilityBenchmark::Leave, this));
+  trace->Install (fcdName, pool);
+  if (m_channelModels)
+    {
+      m_lossModel->InitChannelMatrix (pool);
+      for (NodeContainer::Iterator it = pool.Begin (); it != pool.End (); ++it)
+        {
+          m_lossModel->RetireNode ((*it)->GetId ());
+        }
+    }
+
+  Simulator::Stop (Seconds (m_steps + 1));
+  Clock_t::time_point start = Clock_t::now ();
+  Simulator::Run ();
+  std::ostringstream parameters;
+  parameters << "vehicles=" << m_nVehicles << " pool=" << m_poolSize << " channelModels=" << m_channelModels;
+  Report ("TraceMobility", parameters.str (), records, start);
+
+  trace->Dispose ();
+  std::remove (fcdName.c_str ());
+  m_lossModel = 0;
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Tx PSD construction, with and without in-band emissions
+ */
+class NrV2XTxPsdBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XTxPsdBenchmark (uint16_t nRbs, bool ibe);
+  virtual ~NrV2XTxPsdBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_nRbs;
+  bool m_ibe;
+};
+
+NrV2XTxPsdBenchmark::NrV2XTxPsdBenchmark (uint16_t nRbs, bool ibe)
+  : NrV2XBenchmarkTestCase ("Tx PSD benchmark"),
+    m_nRbs (nRbs),
+    m_ibe (ibe)
+{
+}
+
+NrV2XTxPsdBenchmark::~NrV2XTxPsdBenchmark ()
+{
+}
+
+void
+NrV2XTxPsdBenchmark::DoRun (void)
+{
+  SeedWorkload (4);
+  const uint32_t iterations = 2000;
+  const uint16_t subchannelSize = 10;
+  uint16_t nSubCh = m_nRbs / subchannelSize;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+
+  std::vector<std::vector<int> > allocations;
+  std::vector<uint16_t> mcs;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      uint16_t length = uniform->GetInteger (1, nSubCh);
+      uint16_t first = uniform->GetInteger (0, nSubCh - length);
+      std::vector<int> activeRbs;
+      for (int rb = first * subchannelSize; rb < (first + length) * subchannelSize; rb++)
+        {
+          activeRbs.push_back (rb);
+        }
+      allocations.push_back (activeRbs);
+      mcs.push_back (uniform->GetInteger (0, 27));
+    }
+
+  NrV2XSpectrumValueHelper psdHelper;
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      psdHelper.CreateUlTxPowerSpectralDensity (18100, m_nRbs, 23.0, allocations[i % allocations.size ()], 1.0, 15, mcs[i % mcs.size ()], m_ibe);
+    }
+  std::ostringstream parameters;
+  parameters << "nRbs=" << m_nRbs << " ibe=" << m_ibe;
+  Report ("TxPsd", parameters.str (), iterations, start);
+}
+
+
+/**
+ * PSSCH and PSCCH BLER lookup
+ */
+class NrV2XBlerLookupBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XBlerLookupBenchmark (uint16_t scs);
+  virtual ~NrV2XBlerLookupBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_scs;
+};
+
+NrV2XBlerLookupBenchmark::NrV2XBlerLookupBenchmark (uint16_t scs)
+  : NrV2XBenchmarkTestCase ("BLER lookup benchmark"),
+    m_scs (scs)
+{
+}
+
+NrV2XBlerLookupBenchmark::~NrV2XBlerLookupBenchmark ()
+{
+}
+
+void
+NrV2XBlerLookupBenchmark::DoRun (void)
+{
+  SeedWorkload (5);
+  const uint32_t samples = 1000;
+  const uint32_t iterations = 200000;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+
+  std::vector<double> sinr, speed;
+  std::vector<bool> los;
+  for (uint32_t i = 0; i < samples; i++)
+    {
+      sinr.push_back (std::pow (10.0, uniform->GetValue (-15, 25) / 10));
+      speed.push_back (uniform->GetValue (0, 280));
+      los.push_back (uniform->GetValue () < 0.5);
+    }
+
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      uint32_t sample = i % samples;
+      NrV2XPhyErrorModel::GetNrV2XPsschBler (4, sinr[sample], los[sample], m_scs, speed[sample]);
+      NrV2XPhyErrorModel::GetNrV2XPscchBler (4, sinr[sample], los[sample], m_scs);
+    }
+  std::ostringstream parameters;
+  parameters << "scs=" << m_scs;
+  Report ("BlerLookup", parameters.str (), 2 * iterations, start);
+}
+
+
+/**
+ * Slot timing: SimulatorTimeToSubframe for the numerology index, on slot
+ * boundaries and random instants
+ */
+class NrV2XSlotTimingBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XSlotTimingBenchmark (uint16_t numerologyIndex);
+  virtual ~NrV2XSlotTimingBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_numerologyIndex;
+};
+
+NrV2XSlotTimingBenchmark::NrV2XSlotTimingBenchmark (uint16_t numerologyIndex)
+  : NrV2XBenchmarkTestCase ("Slot timing benchmark"),
+    m_numerologyIndex (numerologyIndex)
+{
+}
+
+NrV2XSlotTimingBenchmark::~NrV2XSlotTimingBenchmark ()
+{
+}
+
+void
+NrV2XSlotTimingBenchmark::DoRun (void)
+{
+  SeedWorkload (9);
+  const uint32_t samples = 10000;
+  const uint32_t iterations = 200000;
+  double slotDuration = 1.0 / (1 << m_numerologyIndex);
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  std::vector<Time> times;
+  for (uint32_t i = 0; i < samples; i++)
+    {
+      // Slot boundaries and random instants up to 1000 s
+      Time t = i % 2 ? NanoSeconds (std::floor (uniform->GetValue (0, 1e12))) : MicroSeconds ((uint64_t) (1000 * slotDuration) * uniform->GetInteger (0, 1e6));
+      times.push_back (t);
+    }
+
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      SimulatorTimeToSubframe (times[i % samples], m_numerologyIndex);
+    }
+  std::ostringstream parameters;
+  parameters << "numerology=" << m_numerologyIndex;
+  Report ("SlotTiming", parameters.str (), iterations, start);
+}
+
+
+/**
+ * SINR of the receptions ending in the same slot: the lazy evaluation of
+ * every signal at every receiver, sequential and on a worker pool
+ */
+class NrV2XParallelSinrBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XParallelSinrBenchmark (uint32_t nReceivers, uint32_t nSignals, uint32_t nWorkers);
+  virtual ~NrV2XParallelSinrBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  void StartReceptions (Time duration);
+  void EndReceptions (void);
+
+  uint32_t m_nReceivers;
+  uint32_t m_nSignals;
+  uint32_t m_nWorkers;
+  std::vector<Ptr<NistLteSlInterference> > m_interference;
+};
+
+NrV2XParallelSinrBenchmark::NrV2XParallelSinrBenchmark (uint32_t nReceivers, uint32_t nSignals, uint32_t nWorkers)
+  : NrV2XBenchmarkTestCase ("Parallel SINR benchmark"),
+    m_nReceivers (nReceivers),
+    m_nSignals (nSignals),
+    m_nWorkers (nWorkers)
+{
+}
+
+NrV2XParallelSinrBenchmark::~NrV2XParallelSinrBenchmark ()
+{
+}
+
+void
+NrV2XParallelSinrBenchmark::StartReceptions (Time duration)
+{
+  const uint16_t nRbs = 50;
+  const uint16_t subchannelSize = 10;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  NrV2XSpectrumValueHelper psdHelper;
+  Ptr<SpectrumValue> noise = psdHelper.CreateNoisePowerSpectralDensity (18100, nRbs, 9.0);
+  for (uint32_t r = 0; r < m_nReceivers; r++)
+    {
+      Ptr<NistLteSlInterference> interference = CreateObject<NistLteSlInterference> ();
+      interference->SetNoisePowerSpectralDensity (noise);
+      interference->SetLazySinrEvaluation (true);
+      for (uint32_t i = 0; i < m_nSignals; i++)
+        {
+          uint16_t length = uniform->GetInteger (1, nRbs / subchannelSize);
+          uint16_t first = uniform->GetInteger (0, nRbs / subchannelSize - length);
+          std::vector<int> activeRbs;
+          for (int rb = first * subchannelSize; rb < (first + length) * subchannelSize; rb++)
+            {
+              activeRbs.push_back (rb);
+            }
+          Ptr<SpectrumValue> psd = psdHelper.CreateTxPowerSpectralDensity (18100, nRbs, uniform->GetValue (-100, -60), activeRbs);
+          interference->StartRx (psd);
+          interference->AddSignal (psd, duration);
+        }
+      // Interferers ending before the receptions, so that there are several chunks
+      for (uint32_t i = 0; i < m_nSignals; i++)
+        {
+          std::vector<int> activeRbs;
+          for (int rb = 0; rb < nRbs; rb++)
+            {
+              activeRbs.push_back (rb);
+            }
+          Ptr<SpectrumValue> psd = psdHelper.CreateTxPowerSpectralDensity (18100, nRbs, uniform->GetValue (-110, -70), activeRbs);
+          interference->AddSignal (psd, MicroSeconds (uniform->GetInteger (1, duration.GetMicroSeconds () - 1)));
+        }
+      m_interference.push_back (interference);
+    }
+}
+
+void
+NrV2XParallelSinrBenchmark::EndReceptions (void)
+{
+  const uint32_t rounds = 5;
+  for (uint32_t r = 0; r < m_nReceivers; r++)
+    {
+      m_interference[r]->PrepareSinrEvaluation ();
+    }
+
+  std::vector<SpectrumValue> sequential;
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t round = 0; round < rounds; round++)
+    {
+      sequential.clear ();
+      for (uint32_t r = 0; r < m_nReceivers; r++)
+        {
+          for (uint32_t i = 0; i < m_nSignals; i++)
+            {
+              sequential.push_back (m_interference[r]->EvaluateSinr (i));
+            }
+        }
+    }
+  std::ostringstream parameters;
+  parameters << "receivers=" << m_nReceivers << " signals=" << m_nSignals << " workers=1";
+  Report ("ParallelSinr", parameters.str (), rounds * sequential.size (), start);
+
+  NrV2XWorkerPool pool (m_nWorkers);
+  std::vector<std::vector<double> > parallel (m_nReceivers * m_nSignals);
+  const std::vector<Ptr<NistLteSlInterference> >& interference = m_interference;
+  uint32_t nSignals = m_nSignals;
+  start = Clock_t::now ();
+  for (uint32_t round = 0; round < rounds; round++)
+    {
+      pool.Run (parallel.size (), [&interference, &parallel, nSignals] (uint32_t i)
+      {
+        interference[i / nSignals]->EvaluateSinr (i % nSignals, parallel[i]);
+      });
+    }
+  parameters.str ("");
+  parameters << "receivers=" << m_nReceivers << " signals=" << m_nSignals << " workers=" << m_nWorkers;
+  Report ("ParallelSinr", parameters.str (), rounds * parallel.size (), start);
+
+  for (uint32_t r = 0; r < m_nReceivers; r++)
+    {
+      m_interference[r]->EndRx ();
+    }
+}
+
+void
+NrV2XParallelSinrBenchmark::DoRun (void)
+{
+  SeedWorkload (10);
+  Time duration = MicroSeconds (500);
+  Simulator::ScheduleNow (&NrV2XParallelSinrBenchmark::StartReceptions, this, duration);
+  Simulator::Schedule (duration, &NrV2XParallelSinrBenchmark::EndReceptions, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_interference.clear ();
+}
+
+
+/**
+ * Duplicate detection of LTENodeState: every neighbour broadcasts at a fixed
+ * rate, and every packet is received twice (blind retransmission)
+ */
+class NrV2XDuplicateDetectionBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XDuplicateDetectionBenchmark (uint32_t nSources, double simTime);
+  virtual ~NrV2XDuplicateDetectionBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  void Receive (uint32_t source, uint32_t packetId);
+
+  uint32_t m_nSources;
+  double m_simTime; // (s)
+  Ptr<LTENodeState> m_nodeState;
+  uint64_t m_receptions;
+};
+
+NrV2XDuplicateDetectionBenchmark::NrV2XDuplicateDetectionBenchmark (uint32_t nSources, double simTime)
+  : NrV2XBenchmarkTestCase ("Duplicate detection benchmark"),
+    m_nSources (nSources),
+    m_simTime (simTime)
+{
+}
+
+NrV2XDuplicateDetectionBenchmark::~NrV2XDuplicateDetectionBenchmark ()
+{
+}
+
+void
+NrV2XDuplicateDetectionBenchmark::Receive (uint32_t source, uint32_t packetId)
+{
+  for (uint32_t copy = 0; copy < 2; copy++)
+    {
+      m_receptions++;
+      if (!m_nodeState->HasReceivedPacket (source, packetId))
+        {
+          m_nodeState->AddNewReceivedPacket (source, packetId);
+        }
+    }
+}
+
+void
+NrV2XDuplicateDetectionBenchmark::DoRun (void)
+{
+  SeedWorkload (11);
+  const double period = 0.1; // 10 Hz
+  m_nodeState = CreateObject<LTENodeState> ();
+  m_receptions = 0;
+
+  // Packet IDs are shared by all the sources, as the IDs of the tags
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uint32_t packetId = 0;
+  for (uint32_t source = 0; source < m_nSources; source++)
+    {
+      double offset = uniform->GetValue (0, period);
+      for (double t = offset; t < m_simTime; t += period)
+        {
+          Simulator::Schedule (Seconds (t), &NrV2XDuplicateDetectionBenchmark::Receive, this, source, packetId++);
+        }
+    }
+
+  Clock_t::time_point start = Clock_t::now ();
+  Simulator::Run ();
+  std::ostringstream parameters;
+  parameters << "sources=" << m_nSources << " simTime=" << m_simTime;
+  Report ("DuplicateDetection", parameters.str (), m_receptions, start);
+
+  Simulator::Destroy ();
+  m_nodeState = 0;
+}
+
+
+/**
+ * Sidelink HARQ state of NistLteHarqPhy: new data, retransmissions and
+ * lookups of random (transmitter, destination) processes, as done by
+ * EndRxV2XSlData
+ */
+class NrV2XSlHarqStateBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XSlHarqStateBenchmark (uint32_t nTransmitters, uint32_t operations);
+  virtual ~NrV2XSlHarqStateBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nTransmitters;
+  uint32_t m_operations;
+};
+
+NrV2XSlHarqStateBenchmark::NrV2XSlHarqStateBenchmark (uint32_t nTransmitters, uint32_t operations)
+  : NrV2XBenchmarkTestCase ("Sidelink HARQ state benchmark"),
+    m_nTransmitters (nTransmitters),
+    m_operations (operations)
+{
+}
+
+NrV2XSlHarqStateBenchmark::~NrV2XSlHarqStateBenchmark ()
+{
+}
+
+void
+NrV2XSlHarqStateBenchmark::DoRun (void)
+{
+  SeedWorkload (12);
+  enum Operation
+  {
+    NEW_DATA,
+    RETX,
+    LOOKUP
+  };
+  struct Step
+  {
+    Operation operation;
+    uint16_t rnti;
+    uint8_t l1dst;
+    double value;
+  };
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  std::vector<Step> steps;
+  for (uint32_t i = 0; i < m_operations; i++)
+    {
+      double u = uniform->GetValue ();
+      Step step = {u < 0.2 ? NEW_DATA : (u < 0.5 ? RETX : LOOKUP),
+                   (uint16_t) uniform->GetInteger (1, m_nTransmitters),
+                   (uint8_t) uniform->GetInteger (0, 3),
+                   uniform->GetValue (0, 100)};
+      steps.push_back (step);
+    }
+
+  Ptr<NistLteHarqPhy> harq = Create<NistLteHarqPhy> ();
+  Clock_t::time_point start = Clock_t::now ();
+  for (std::vector<Step>::const_iterator it = steps.begin (); it != steps.end (); ++it)
+    {
+      switch (it->operation)
+        {
+        case NEW_DATA:
+          harq->ResetSlHarqProcessNistStatus (it->rnti, it->l1dst);
+          break;
+        case RETX:
+          harq->UpdateSlHarqProcessNistStatus (it->rnti, it->l1dst, it->value);
+          break;
+        case LOOKUP:
+          harq->GetSlHarqProcessInfo (it->rnti, it->l1dst);
+          break;
+        }
+    }
+  std::ostringstream parameters;
+  parameters << "transmitters=" << m_nTransmitters;
+  Report ("SlHarqState", parameters.str (), m_operations, start);
+
+}
+
+
+/**
+ * Per-link state of the channel model, as read by EndRxV2XSlData: the
+ * vehicles change their velocity at random times, and the links are
+ * looked up after the channel updates
+ */
+class NrV2XLinkStateBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XLinkStateBenchmark (uint32_t nNodes, uint32_t lookups);
+  virtual ~NrV2XLinkStateBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  void ChangeCourse (Ptr<ConstantVelocityMobilityModel> mobility, Vector velocity);
+
+  uint32_t m_nNodes;
+  uint32_t m_lookups;
+  NodeContainer m_nodes;
+  Ptr<NrV2XPropagationLossModel> m_lossModel;
+};
+
+NrV2XLinkStateBenchmark::NrV2XLinkStateBenchmark (uint32_t nNodes, uint32_t lookups)
+  : NrV2XBenchmarkTestCase ("Link state benchmark"),
+    m_nNodes (nNodes),
+    m_lookups (lookups)
+{
+}
+
+NrV2XLinkStateBenchmark::~NrV2XLinkStateBenchmark ()
+{
+}
+
+void
+NrV2XLinkStateBenchmark::ChangeCourse (Ptr<ConstantVelocityMobilityModel> mobility, Vector velocity)
+{
+  mobility->SetVelocity (velocity);
+}
+
+void
+NrV2XLinkStateBenchmark::DoRun (void)
+{
+  SeedWorkload (13);
+  m_nodes.Create (m_nNodes);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  for (NodeContainer::Iterator it = m_nodes.Begin (); it != m_nodes.End (); ++it)
+    {
+      Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel> ();
+      mobility->SetPosition (Vector (uniform->GetValue (0, 2000), uniform->GetValue (0, 6 * 4), 1.5));
+      mobility->SetVelocity (Vector (uniform->GetValue (-40, 40), 0, 0));
+      (*it)->AggregateObject (mobility);
+    }
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  m_lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  m_lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+  m_lossModel->InitChannelMatrix (m_nodes);
+
+  // Course changes between the channel updates
+  for (NodeContainer::Iterator it = m_nodes.Begin (); it != m_nodes.End (); ++it)
+    {
+      Simulator::Schedule (MilliSeconds (uniform->GetInteger (1, 249)), &NrV2XLinkStateBenchmark::ChangeCourse, this,
+                           (*it)->GetObject<ConstantVelocityMobilityModel> (), Vector (uniform->GetValue (-40, 40), uniform->GetValue (-1, 1), 0));
+    }
+  Simulator::Stop (MilliSeconds (250));
+  Simulator::Run ();
+
+  std::vector<std::pair<uint32_t, uint32_t> > links;
+  links.reserve (m_lookups);
+  for (uint32_t i = 0; i < m_lookups; i++)
+    {
+      uint32_t tx = uniform->GetInteger (0, m_nNodes - 1);
+      uint32_t rx = (tx + uniform->GetInteger (1, m_nNodes - 1)) % m_nNodes;
+      links.push_back (std::make_pair (m_nodes.Get (tx)->GetId (), m_nodes.Get (rx)->GetId ()));
+    }
+  std::ostringstream parameters;
+  parameters << "nodes=" << m_nNodes;
+  Clock_t::time_point start = Clock_t::now ();
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator it = links.begin (); it != links.end (); ++it)
+    {
+      m_lossModel->GetChannelModel (it->first, it->second);
+      m_lossModel->GetRelativeSpeed (it->first, it->second);
+    }
+  Report ("LinkStateLookup", parameters.str (), m_lookups, start);
+
+  m_lossModel->Dispose ();
+  m_lossModel = 0;
+  m_nodes = NodeContainer ();
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Building queries of the urban loss model: point-in-building and
+ * segment-crosses-building on a Manhattan grid of N x N blocks of 80 m
+ * separated by 20 m wide streets, through NrV2XBuildingIndex and by a scan
+ * of BuildingList
+ */
+class NrV2XBuildingIndexBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XBuildingIndexBenchmark (uint32_t nBlocks, uint32_t queries);
+  virtual ~NrV2XBuildingIndexBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nBlocks;
+  uint32_t m_queries;
+};
+
+NrV2XBuildingIndexBenchmark::NrV2XBuildingIndexBenchmark (uint32_t nBlocks, uint32_t queries)
+  : NrV2XBenchmarkTestCase ("Building index benchmark"),
+    m_nBlocks (nBlocks),
+    m_queries (queries)
+{
+}
+
+NrV2XBuildingIndexBenchmark::~NrV2XBuildingIndexBenchmark ()
+{
+}
+
+void
+NrV2XBuildingIndexBenchmark::DoRun (void)
+{
+  SeedWorkload (14);
+  for (uint32_t x = 0; x < m_nBlocks; x++)
+    {
+      for (uint32_t y = 0; y < m_nBlocks; y++)
+        {
+          Ptr<Building> building = CreateObject<Building> ();
+          building->SetBoundaries (Box (x * 100.0, x * 100.0 + 80, y * 100.0, y * 100.0 + 80, 0, 20));
+        }
+    }
+  double side = m_nBlocks * 100.0;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  std::vector<std::pair<Vector, Vector> > segments;
+  for (uint32_t i = 0; i < m_queries; i++)
+    {
+      Vector a (uniform->GetValue (-50, side + 50), uniform->GetValue (-50, side + 50), 1.5);
+      Vector b (a.x + uniform->GetValue (-300, 300), a.y + uniform->GetValue (-300, 300), 1.5);
+      segments.push_back (std::make_pair (a, b));
+    }
+  std::ostringstream parameters;
+  parameters << "buildings=" << BuildingList::GetNBuildings ();
+
+  std::vector<uint32_t> scanInside;
+  std::vector<bool> scanLos;
+  Clock_t::time_point start = Clock_t::now ();
+  for (std::vector<std::pair<Vector, Vector> >::const_iterator it = segments.begin (); it != segments.end (); ++it)
+    {
+      uint32_t inside = std::numeric_limits<uint32_t>::max ();
+      bool los = true;
+      for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+        {
+          if ((*bit)->IsInside (it->first))
+            {
+              inside = (*bit)->GetId ();
+            }
+          if (los && NrV2XBuildingIndex::Intersects ((*bit)->GetBoundaries (), it->first, it->second))
+            {
+              los = false;
+            }
+        }
+      scanInside.push_back (inside);
+      scanLos.push_back (los);
+    }
+  Report ("BuildingQueryScan", parameters.str (), m_queries, start);
+
+  NrV2XBuildingIndex index;
+  start = Clock_t::now ();
+  index.Build (50);
+  Report ("BuildingIndexBuild", parameters.str (), BuildingList::GetNBuildings (), start);
+  std::vector<uint32_t> indexInside;
+  std::vector<bool> indexLos;
+  start = Clock_t::now ();
+  for (std::vector<std::pair<Vector, Vector> >::const_iterator it = segments.begin (); it != segments.end (); ++it)
+    {
+      Ptr<Building> building = index.GetBuilding (it->first);
+      indexInside.push_back (building != 0 ? building->GetId () : std::numeric_limits<uint32_t>::max ());
+      indexLos.push_back (index.IsLineOfSight (it->first, it->second));
+    }
+  Report ("BuildingQueryIndexed", parameters.str (), m_queries, start);
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Link state of the urban loss model: N vehicles driving along the streets
+ * of a Manhattan grid, where every vehicle transmits to all the others every
+ * 100 ms, as the spectrum channel evaluates the links. After 1 s only half of
+ * the vehicles keep transmitting, and the links of the others expire
+ */
+class NrV2XUrbanLinkStateBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XUrbanLinkStateBenchmark (uint32_t nVehicles, bool nakagami);
+  virtual ~NrV2XUrbanLinkStateBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  void Transmit (uint32_t nActive);
+
+  uint32_t m_nVehicles;
+  bool m_nakagami;
+  NodeContainer m_nodes;
+  Ptr<NrV2XUrbanPropagationLossModel> m_lossModel;
+  uint64_t m_evaluations;
+};
+
+NrV2XUrbanLinkStateBenchmark::NrV2XUrbanLinkStateBenchmark (uint32_t nVehicles, bool nakagami)
+  : NrV2XBenchmarkTestCase ("Urban link state benchmark"),
+    m_nVehicles (nVehicles),
+    m_nakagami (nakagami),
+    m_evaluations (0)
+{
+}
+
+NrV2XUrbanLinkStateBenchmark::~NrV2XUrbanLinkStateBenchmark ()
+{
+}
+
+void
+NrV2XUrbanLinkStateBenchmark::Transmit (uint32_t nActive)
+{
+  for (uint32_t tx = 0; tx < nActive; tx++)
+    {
+      Ptr<MobilityModel> txMobility = m_nodes.Get (tx)->GetObject<MobilityModel> ();
+      for (uint32_t rx = 0; rx < nActive; rx++)
+        {
+          if (rx == tx)
+            {
+              continue;
+            }
+          m_lossModel->CalcRxPower (23, txMobility, m_nodes.Get (rx)->GetObject<MobilityModel> ());
+          m_evaluations++;
+        }
+    }
+}
+
+void
+NrV2XUrbanLinkStateBenchmark::DoRun (void)
+{
+  SeedWorkload (15);
+  for (uint32_t x = 0; x < 10; x++)
+    {
+      for (uint32_t y = 0; y < 10; y++)
+        {
+          Ptr<Building> building = CreateObject<Building> ();
+          building->SetBoundaries (Box (x * 100.0, x * 100.0 + 80, y * 100.0, y * 100.0 + 80, 0, 20));
+        }
+    }
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  m_nodes.Create (m_nVehicles);
+  for (NodeContainer::Iterator it = m_nodes.Begin (); it != m_nodes.End (); ++it)
+    {
+      // Along the vertical streets, between the columns of blocks
+      Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel> ();
+      mobility->SetPosition (Vector (uniform->GetInteger (0, 9) * 100.0 + 90, uniform->GetValue (0, 1000), 1.5));
+      mobility->SetVelocity (Vector (0, uniform->GetValue () < 0.5 ? -14 : 14, 0));
+      (*it)->AggregateObject (mobility);
+    }
+  m_lossModel = CreateObject<NrV2XUrbanPropagationLossModel> ();
+  m_lossModel->SetAttribute ("NakagamiFading", BooleanValue (m_nakagami));
+
+  for (uint32_t ms = 0; ms < 3500; ms += 100)
+    {
+      Simulator::Schedule (MilliSeconds (ms), &NrV2XUrbanLinkStateBenchmark::Transmit, this, ms < 1000 ? m_nVehicles : m_nVehicles / 2);
+    }
+  std::ostringstream parameters;
+  parameters << "vehicles=" << m_nVehicles << ",nakagami=" << m_nakagami;
+  Clock_t::time_point start = Clock_t::now ();
+  Simulator::Stop (MilliSeconds (3500));
+  Simulator::Run ();
+  Report ("UrbanLinkState", parameters.str (), m_evaluations, start);
+
+  m_lossModel = 0;
+  m_nodes = NodeContainer ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Offline Mode 2 selection replay: the inputs captured as V2XSelectResources
+ * records them are written, read back and replayed by a MAC without sensing
+ * history
+ */
+class NrV2XSelectionReplayBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XSelectionReplayBenchmark (double pdb, uint32_t nSelections);
+  virtual ~NrV2XSelectionReplayBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  double m_pdb;
+  uint32_t m_nSelections;
+};
+
+NrV2XSelectionReplayBenchmark::NrV2XSelectionReplayBenchmark (double pdb, uint32_t nSelections)
+  : NrV2XBenchmarkTestCase ("Selection replay benchmark"),
+    m_pdb (pdb),
+    m_nSelections (nSelections)
+{
+}
+
+NrV2XSelectionReplayBenchmark::~NrV2XSelectionReplayBenchmark ()
+{
+}
+
+void
+NrV2XSelectionReplayBenchmark::DoRun (void)
+{
+  SeedWorkload (16);
+  const uint16_t subchannelSize = 10;
+  const uint16_t nSubCh = 5;
+  const uint16_t lSubCh = 1;
+  const uint32_t repetitions = 5;
+  std::vector<uint16_t> rriList = {20, 50, 100, 200, 500, 1000};
+
+  Ptr<NrV2XUeMac> mac = NrV2XTestAccess::CreateMode2Mac (subchannelSize, rriList);
+
+  // Current slot SF(600,5): sense the reservations of the previous second, and a few past transmissions
+  SidelinkCommResourcePool::SubframeInfo currentSF;
+  currentSF.frameNo = 600;
+  currentSF.subframeNo = 5;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  NrV2XTestAccess::FillSensingDatabase (mac, currentSF, uniform, rriList, subchannelSize, nSubCh, lSubCh, 0.3, true);
+  NrV2XTestAccess::AddPastTransmissions (mac, currentSF);
+
+  // Record the selections as V2XSelectResources does
+  std::stringstream recording;
+  for (uint32_t i = 0; i < m_nSelections; i++)
+    {
+      NrV2XTestAccess::V2XSidelinkGrant grant;
+      grant.m_RRI = std::max<uint16_t> (rriList[i % rriList.size ()], 100);
+      grant.m_Cresel = uniform->GetInteger (5, 15);
+      double T_2 = m_pdb - 1.0;
+      NrV2XUeMac::SelectionInputs inputs = NrV2XTestAccess::CaptureSelectionInputs (mac, currentSF, grant, m_pdb, nSubCh, lSubCh);
+      NrV2XUeMac::SelectionOutcome outcome;
+      outcome.iterations = 0;
+      outcome.rsrpThreshold = -128;
+      std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa, L1;
+      Sa = NrV2XTestAccess::SelectionWindow (mac, currentSF, T_2, nSubCh - lSubCh + 1);
+      outcome.nCSRinitial = ComputeResidualCSRs (Sa);
+      L1 = NrV2XTestAccess::Mode2Step1 (mac, Sa, currentSF, grant, T_2, nSubCh, lSubCh, &outcome.iterations, &outcome.rsrpThreshold, &outcome.nCSRpastTx, false);
+      outcome.nCSRfinal = ComputeResidualCSRs (L1);
+      NrV2XUeMac::WriteSelectionInputs (recording, inputs, outcome);
+    }
+  mac->Dispose ();
+
+  std::vector<NrV2XUeMac::SelectionInputs> selections;
+  NrV2XUeMac::SelectionInputs inputs;
+  NrV2XUeMac::SelectionOutcome outcome;
+  while (NrV2XUeMac::ReadSelectionInputs (recording, &inputs, &outcome))
+    {
+      selections.push_back (inputs);
+    }
+
+  Ptr<NrV2XUeMac> replay = CreateObject<NrV2XUeMac> ();
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t r = 0; r < repetitions; r++)
+    {
+      for (uint32_t i = 0; i < selections.size (); i++)
+        {
+          replay->ReplaySelection (selections[i]);
+        }
+    }
+  std::ostringstream parameters;
+  parameters << "pdb=" << m_pdb << " selections=" << m_nSelections;
+  Report ("SelectionReplay", parameters.str (), repetitions * selections.size (), start);
+  replay->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Uplink classification of UDP packets among a default bearer and bearers
+ * for ranges of remote ports and a DSCP: a scan of the TFTs with the
+ * deserialized headers, as the classifier used to, and the flows cached by
+ * NistEpcTftClassifier
+ */
+class NrV2XTftClassifierBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XTftClassifierBenchmark (uint32_t nFlows, uint32_t nPackets);
+  virtual ~NrV2XTftClassifierBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nFlows;
+  uint32_t m_nPackets;
+};
+
+NrV2XTftClassifierBenchmark::NrV2XTftClassifierBenchmark (uint32_t nFlows, uint32_t nPackets)
+  : NrV2XBenchmarkTestCase ("TFT classifier benchmark"),
+    m_nFlows (nFlows),
+    m_nPackets (nPackets)
+{
+}
+
+NrV2XTftClassifierBenchmark::~NrV2XTftClassifierBenchmark ()
+{
+}
+
+void
+NrV2XTftClassifierBenchmark::DoRun (void)
+{
+  SeedWorkload (17);
+  const uint32_t nTfts = 6;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+
+  // The default bearer, then bearers for ranges of remote ports and a DSCP
+  std::map<uint32_t, Ptr<NistEpcTft> > tfts;
+  tfts[1] = NistEpcTft::Default ();
+  for (uint32_t id = 2; id <= nTfts; id++)
+    {
+      Ptr<NistEpcTft> tft = Create<NistEpcTft> ();
+      NistEpcTft::NistPacketFilter filter;
+      filter.direction = (id % 2) ? NistEpcTft::BIDIRECTIONAL : NistEpcTft::UPLINK;
+      filter.remotePortStart = 5000 + id * 100;
+      filter.remotePortEnd = 5000 + id * 100 + 49;
+      if (id == nTfts)
+        {
+          filter.typeOfService = 0xb8;
+          filter.typeOfServiceMask = 0xfc;
+        }
+      tft->Add (filter);
+      tfts[id] = tft;
+    }
+  NistEpcTftClassifier classifier;
+  for (std::map<uint32_t, Ptr<NistEpcTft> >::iterator it = tfts.begin (); it != tfts.end (); it++)
+    {
+      classifier.Add (it->second, it->first);
+    }
+
+  std::vector<Ptr<Packet> > flows;
+  for (uint32_t i = 0; i < m_nFlows; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (uniform->GetInteger (50, 300));
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (uniform->GetInteger (49152, 65535));
+      udpHeader.SetDestinationPort (uniform->GetInteger (5000, 5000 + (nTfts + 1) * 100));
+      p->AddHeader (udpHeader);
+      Ipv4Header ipv4Header;
+      ipv4Header.SetSource (Ipv4Address ("7.0.0.2"));
+      ipv4Header.SetDestination (Ipv4Address (0x0a000000 + uniform->GetInteger (1, 1000)));
+      ipv4Header.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+      ipv4Header.SetTos (uniform->GetValue () < 0.5 ? 0xb8 : 0);
+      ipv4Header.SetPayloadSize (p->GetSize ());
+      p->AddHeader (ipv4Header);
+      flows.push_back (p);
+    }
+  std::vector<uint32_t> sequence;
+  for (uint32_t i = 0; i < m_nPackets; i++)
+    {
+      sequence.push_back (uniform->GetInteger (0, m_nFlows - 1));
+    }
+
+  // Deserialize the headers of every packet and scan the TFTs, as the classifier used to
+  Clock_t::time_point start = Clock_t::now ();
+  for (uint32_t i = 0; i < m_nPackets; i++)
+    {
+      Ptr<Packet> pCopy = flows[sequence[i]]->Copy ();
+      Ipv4Header ipv4Header;
+      pCopy->RemoveHeader (ipv4Header);
+      UdpHeader udpHeader;
+      pCopy->RemoveHeader (udpHeader);
+      for (std::map<uint32_t, Ptr<NistEpcTft> >::reverse_iterator it = tfts.rbegin (); it != tfts.rend (); it++)
+        {
+          if (it->second->Matches (NistEpcTft::UPLINK, ipv4Header.GetDestination (), ipv4Header.GetSource (),
+                                   udpHeader.GetDestinationPort (), udpHeader.GetSourcePort (), ipv4Header.GetTos ()))
+            {
+              break;
+            }
+        }
+    }
+  std::ostringstream parameters;
+  parameters << "flows=" << m_nFlows << " tfts=" << nTfts;
+  Report ("TftClassifyParsed", parameters.str (), m_nPackets, start);
+
+  start = Clock_t::now ();
+  for (uint32_t i = 0; i < m_nPackets; i++)
+    {
+      classifier.Classify (flows[sequence[i]], NistEpcTft::UPLINK);
+    }
+  Report ("TftClassifyCached", parameters.str (), m_nPackets, start);
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Maximum coupling loss of the spectrum channel: N vehicles on a 5 km
+ * highway transmit once, through a channel delivering every signal and
+ * through one cut at the coupling loss of a maximum distance plus a
+ * shadowing margin
+ */
+class NrV2XCouplingLossCutoffBenchmark : public NrV2XBenchmarkTestCase
+{
+public:
+  NrV2XCouplingLossCutoffBenchmark (uint32_t nNodes, double maxDistance);
+  virtual ~NrV2XCouplingLossCutoffBenchmark ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nNodes;
+  double m_maxDistance;
+};
+
+NrV2XCouplingLossCutoffBenchmark::NrV2XCouplingLossCutoffBenchmark (uint32_t nNodes, double maxDistance)
+  : NrV2XBenchmarkTestCase ("Coupling loss cutoff benchmark"),
+    m_nNodes (nNodes),
+    m_maxDistance (maxDistance)
+{
+}
+
+NrV2XCouplingLossCutoffBenchmark::~NrV2XCouplingLossCutoffBenchmark ()
+{
+}
+
+void
+NrV2XCouplingLossCutoffBenchmark::DoRun (void)
+{
+  SeedWorkload (18);
+  NodeContainer nodes;
+  nodes.Create (m_nNodes);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (uniform->GetValue (0, 5000), uniform->GetInteger (1, 6) * 4.0, 1.5));
+      (*it)->AggregateObject (mobility);
+    }
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Ptr<NrV2XPropagationLossModel> lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+  lossModel->InitChannelMatrix (nodes);
+  double maxCouplingLoss = lossModel->GetMaxCouplingLoss (m_maxDistance, 10);
+
+  // 23 dBm over 50 RBs, for 1 ms
+  std::vector<double> centerFrequencies;
+  for (uint32_t rb = 0; rb < 50; rb++)
+    {
+      centerFrequencies.push_back (5.9e9 + rb * 180e3);
+    }
+  Ptr<SpectrumModel> spectrumModel = Create<SpectrumModel> (centerFrequencies);
+  Ptr<SpectrumValue> psd = Create<SpectrumValue> (spectrumModel);
+  (*psd) = 0.2 / (50 * 180e3);
+
+  Ptr<MultiModelSpectrumChannel> fullChannel = CreateObject<MultiModelSpectrumChannel> ();
+  Ptr<MultiModelSpectrumChannel> cutChannel = CreateObject<MultiModelSpectrumChannel> ();
+  cutChannel->SetAttribute ("MaxLossDb", DoubleValue (maxCouplingLoss));
+  Ptr<MultiModelSpectrumChannel> channels[2] = {fullChannel, cutChannel};
+  std::vector<Ptr<NrV2XCountingSpectrumPhy> > phys[2];
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      channels[c]->AddPropagationLossModel (lossModel);
+      for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+        {
+          Ptr<NrV2XCountingSpectrumPhy> phy = Create<NrV2XCountingSpectrumPhy> ((*it)->GetObject<MobilityModel> (), spectrumModel);
+          channels[c]->AddRx (phy);
+          phys[c].push_back (phy);
+        }
+    }
+
+  std::ostringstream parameters;
+  parameters << "nodes=" << m_nNodes << " maxDistance=" << m_maxDistance;
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      Clock_t::time_point start = Clock_t::now ();
+      for (uint32_t i = 0; i < m_nNodes; i++)
+        {
+          Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+          params->psd = psd;
+          params->duration = MilliSeconds (1);
+          params->txPhy = phys[c][i];
+          channels[c]->StartTx (params);
+        }
+      // Before the first update of the channel matrix
+      Simulator::Stop (MilliSeconds (1));
+      Simulator::Run ();
+      Report (c == 0 ? "SignalDeliveryFull" : "SignalDeliveryCutoff", parameters.str (), m_nNodes, start);
+    }
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Simulator::Destroy ();
+}
+
+class NrV2XBenchmarkTestSuite : public TestSuite
+{
+public:
+  NrV2XBenchmarkTestSuite ();
+};
+
+NrV2XBenchmarkTestSuite::NrV2XBenchmarkTestSuite ()
+  : TestSuite ("nr-v2x-benchmark", PERFORMANCE)
+{
+  std::vector<uint16_t> shortRriList = {100};
+  std::vector<uint16_t> fullRriList = {20, 50, 100, 200, 300, 400, 500, 600, 700, 800, 900, 1000};
+  double pdbs[] = {20, 100};
+  for (uint32_t p = 0; p < 2; p++)
+    {
+      AddTestCase (new NrV2XMode2SelectionBenchmark (pdbs[p], shortRriList, 5, 1, 0.2), TestCase::QUICK);
+      AddTestCase (new NrV2XMode2SelectionBenchmark (pdbs[p], shortRriList, 5, 1, 0.6), TestCase::QUICK);
+      AddTestCase (new NrV2XMode2SelectionBenchmark (pdbs[p], fullRriList, 5, 1, 0.2), TestCase::QUICK);
+      AddTestCase (new NrV2XMode2SelectionBenchmark (pdbs[p], shortRriList, 10, 2, 0.2), TestCase::QUICK);
+      AddTestCase (new NrV2XMode2SelectionBenchmark (pdbs[p], fullRriList, 10, 1, 0.6), TestCase::EXTENSIVE);
+    }
+
+  AddTestCase (new NrV2XGeoCellLookupBenchmark (50, 500), TestCase::QUICK);
+  AddTestCase (new NrV2XGeoCellLookupBenchmark (100, 1000), TestCase::QUICK);
+
+  AddTestCase (new NrV2XPolygonCheckBenchmark (true), TestCase::QUICK);
+  AddTestCase (new NrV2XPolygonCheckBenchmark (false), TestCase::QUICK);
+
+  AddTestCase (new NrV2XPsschOverlapBenchmark (50, 10), TestCase::QUICK);
+  AddTestCase (new NrV2XPsschOverlapBenchmark (100, 10), TestCase::QUICK);
+
+  AddTestCase (new NrV2XPsschRsrpHistoryBenchmark (60, 2), TestCase::QUICK);
+
+  for (uint16_t numerology = 0; numerology <= 3; numerology++)
+    {
+      AddTestCase (new NrV2XSlotTimingBenchmark (numerology), TestCase::QUICK);
+    }
+
+  StringValue nodes;
+  g_benchmarkNodes.GetValue (nodes);
+  std::stringstream nodesStream (nodes.Get ());
+  std::string nNodes;
+  while (std::getline (nodesStream, nNodes, ','))
+    {
+      uint32_t n = std::atoi (nNodes.c_str ());
+      AddTestCase (new NrV2XChannelMatrixBenchmark (n), n > 1000 ? TestCase::TAKES_FOREVER : TestCase::QUICK);
+    }
+
+  AddTestCase (new NrV2XTraceMobilityBenchmark (2000, 2000, false), TestCase::QUICK);
+  AddTestCase (new NrV2XTraceMobilityBenchmark (200, 50, true), TestCase::QUICK);
+
+  AddTestCase (new NrV2XTxPsdBenchmark (50, false), TestCase::QUICK);
+  AddTestCase (new NrV2XTxPsdBenchmark (50, true), TestCase::QUICK);
+  AddTestCase (new NrV2XTxPsdBenchmark (100, true), TestCase::QUICK);
+
+  AddTestCase (new NrV2XBlerLookupBenchmark (15), TestCase::QUICK);
+  AddTestCase (new NrV2XBlerLookupBenchmark (30), TestCase::QUICK);
+
+  AddTestCase (new NrV2XParallelSinrBenchmark (100, 8, 2), TestCase::QUICK);
+  AddTestCase (new NrV2XParallelSinrBenchmark (100, 8, 4), TestCase::QUICK);
+
+  AddTestCase (new NrV2XDuplicateDetectionBenchmark (100, 60), TestCase::QUICK);
+  AddTestCase (new NrV2XDuplicateDetectionBenchmark (300, 20), TestCase::QUICK);
+
+  AddTestCase (new NrV2XSlHarqStateBenchmark (100, 200000), TestCase::QUICK);
+  AddTestCase (new NrV2XSlHarqStateBenchmark (1000, 200000), TestCase::QUICK);
+
+  AddTestCase (new NrV2XLinkStateBenchmark (50, 200000), TestCase::QUICK);
+  AddTestCase (new NrV2XLinkStateBenchmark (200, 200000), TestCase::QUICK);
+
+  AddTestCase (new NrV2XBuildingIndexBenchmark (10, 20000), TestCase::QUICK);
+  AddTestCase (new NrV2XBuildingIndexBenchmark (40, 5000), TestCase::QUICK);
+
+  AddTestCase (new NrV2XUrbanLinkStateBenchmark (100, false), TestCase::QUICK);
+  AddTestCase (new NrV2XUrbanLinkStateBenchmark (100, true), TestCase::QUICK);
+
+  AddTestCase (new NrV2XSelectionReplayBenchmark (20, 20), TestCase::QUICK);
+  AddTestCase (new NrV2XSelectionReplayBenchmark (100, 20), TestCase::QUICK);
+
+  AddTestCase (new NrV2XTftClassifierBenchmark (10, 200000), TestCase::QUICK);
+  AddTestCase (new NrV2XTftClassifierBenchmark (1000, 200000), TestCase::QUICK);
+
+  AddTestCase (new NrV2XCouplingLossCutoffBenchmark (300, 1000), TestCase::QUICK);
+  AddTestCase (new NrV2XCouplingLossCutoffBenchmark (300, 2000), TestCase::QUICK);
+}
+
+static NrV2XBenchmarkTestSuite g_nrV2XBenchmarkTestSuite;
+
+} // namespace ns3
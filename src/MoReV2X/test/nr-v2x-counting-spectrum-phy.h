@@ -0,0 +1,90 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#ifndef NR_V2X_COUNTING_SPECTRUM_PHY_H
+#define NR_V2X_COUNTING_SPECTRUM_PHY_H
+
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/mobility-model.h>
+#include <ns3/antenna-model.h>
+
+namespace ns3 {
+
+/**
+ * Receiver of the coupling loss tests: counts the signals the spectrum
+ * channel delivers and their energy
+ */
+class NrV2XCountingSpectrumPhy : public SpectrumPhy
+{
+public:
+  NrV2XCountingSpectrumPhy (Ptr<MobilityModel> mobility, Ptr<const SpectrumModel> model)
+    : m_mobility (mobility),
+      m_model (model),
+      m_received (0),
+      m_energy (0)
+  {
+  }
+
+  virtual void SetDevice (Ptr<NetDevice> d)
+  {
+  }
+  virtual Ptr<NetDevice> GetDevice ()
+  {
+    return 0;
+  }
+  virtual void SetMobility (Ptr<MobilityModel> m)
+  {
+    m_mobility = m;
+  }
+  virtual Ptr<MobilityModel> GetMobility ()
+  {
+    return m_mobility;
+  }
+  virtual void SetChannel (Ptr<SpectrumChannel> c)
+  {
+  }
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const
+  {
+    return m_model;
+  }
+  virtual Ptr<AntennaModel> GetRxAntenna ()
+  {
+    return 0;
+  }
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params)
+  {
+    m_received++;
+    m_energy += Integral (*params->psd) * params->duration.GetSeconds ();
+  }
+
+  Ptr<MobilityModel> m_mobility;
+  Ptr<const SpectrumModel> m_model;
+  uint64_t m_received;
+  double m_energy; // (J)
+};
+
+} // namespace ns3
+
+#endif /* NR_V2X_COUNTING_SPECTRUM_PHY_H */
@@ -0,0 +1,205 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+#ifndef NR_V2X_TEST_ACCESS_H
+#define NR_V2X_TEST_ACCESS_H
+
+#include <ns3/nr-v2x-ue-mac.h>
+#include <ns3/nr-v2x-spectrum-phy.h>
+#include <ns3/nist-epc-ue-nas.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/double.h>
+#include <ns3/uinteger.h>
+#include <ns3/nstime.h>
+
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * The only friend of the models in the nr-v2x and nr-v2x-benchmark suites:
+ * forwards to the internals the tests check, and builds the Mode 2 fixture
+ * the unit tests and the benchmarks share
+ */
+class NrV2XTestAccess
+{
+public:
+  typedef NrV2XUeMac::V2XSidelinkGrant V2XSidelinkGrant;
+  typedef std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > CandidateMap;
+
+  /**
+   * Mode 2 MAC with 1 ms slots, the given subchannel size and RRIs, and
+   * an RNTI other than the debug node's, so that nothing is written on disk
+   */
+  static Ptr<NrV2XUeMac> CreateMode2Mac (uint16_t subchannelSize, const std::vector<uint16_t>& rriList)
+  {
+    Ptr<NrV2XUeMac> mac = CreateObject<NrV2XUeMac> ();
+    mac->SetAttribute ("SlotDuration", DoubleValue (1.0));
+    mac->SetAttribute ("NumerologyIndex", UintegerValue (0));
+    mac->SetAttribute ("SubchannelSize", UintegerValue (subchannelSize));
+    mac->m_rnti = 1;
+    for (std::vector<uint16_t>::const_iterator it = rriList.begin (); it != rriList.end (); it++)
+      {
+        mac->PushNewRRIValue (*it);
+      }
+    return mac;
+  }
+
+  /**
+   * Senses the reservations of the second before currentSF: each L_SubCh
+   * subchannels of each slot are reserved with probability density, with
+   * random RRI, RSRP and Cresel. With randomFlags the reservations are also
+   * randomly marked as retransmissions and same-TB
+   * \return the number of reservations
+   */
+  static uint32_t FillSensingDatabase (Ptr<NrV2XUeMac> mac, SidelinkCommResourcePool::SubframeInfo currentSF, Ptr<UniformRandomVariable> uniform,
+                                       const std::vector<uint16_t>& rriList, uint16_t subchannelSize, uint16_t nSubCh, uint16_t lSubCh,
+                                       double density, bool randomFlags)
+  {
+    uint32_t nReservations = 0;
+    for (uint32_t slot = 1000; slot > 10; slot--)
+      {
+        uint32_t absoluteSlot = (currentSF.frameNo - 1) * 10 + (currentSF.subframeNo - 1) - slot;
+        SidelinkCommResourcePool::SubframeInfo receivedSF, reservedSF;
+        receivedSF.frameNo = absoluteSlot / 10 + 1;
+        receivedSF.subframeNo = absoluteSlot % 10 + 1;
+        for (uint16_t subCh = 0; subCh + lSubCh <= nSubCh; subCh += lSubCh)
+          {
+            if (uniform->GetValue () < density)
+              {
+                uint16_t rri = rriList[uniform->GetInteger (0, rriList.size () - 1)];
+                reservedSF.frameNo = (absoluteSlot + rri) / 10 + 1;
+                reservedSF.subframeNo = (absoluteSlot + rri) % 10 + 1;
+                mac->DoReportPsschRsrpReservation (Seconds (0), subCh * subchannelSize, lSubCh * subchannelSize, uniform->GetValue (-120, -70),
+                                                   receivedSF, reservedSF, uniform->GetInteger (5, 15), uniform->GetInteger (1, 200), rri,
+                                                   randomFlags && uniform->GetValue () < 0.2, randomFlags && uniform->GetValue () < 0.5);
+                nReservations++;
+              }
+          }
+      }
+    return nReservations;
+  }
+
+  /**
+   * Transmissions of the UE every 20 slots during the 100 slots before currentSF
+   */
+  static void AddPastTransmissions (Ptr<NrV2XUeMac> mac, SidelinkCommResourcePool::SubframeInfo currentSF)
+  {
+    for (uint32_t slot = 100; slot > 0; slot -= 20)
+      {
+        SidelinkCommResourcePool::SubframeInfo txSF;
+        txSF.frameNo = (currentSF.frameNo * 10 + currentSF.subframeNo - slot) / 10;
+        txSF.subframeNo = (currentSF.frameNo * 10 + currentSF.subframeNo - slot) % 10;
+        mac->m_pastTxUnimore.push_back (std::make_pair (Seconds (0), txSF));
+      }
+  }
+
+  // NrV2XUeMac
+
+  static std::list<std::pair<Time,SidelinkCommResourcePool::SubframeInfo> >& PastTransmissions (Ptr<NrV2XUeMac> mac)
+  {
+    return mac->m_pastTxUnimore;
+  }
+  static std::map<Time,NrV2XUeMac::PsschRsrp>& PsschRsrpMap (Ptr<NrV2XUeMac> mac)
+  {
+    return mac->m_PsschRsrpMap;
+  }
+  static uint16_t SensingWindow (Ptr<NrV2XUeMac> mac)
+  {
+    return mac->m_sensingWindow;
+  }
+  static uint32_t ReEvaluationRebuilds (Ptr<NrV2XUeMac> mac)
+  {
+    return mac->m_reEvaluationState.rebuilds;
+  }
+  static void DoReportPsschRsrp (Ptr<NrV2XUeMac> mac, Time time, uint16_t rbStart, uint16_t rbLen, double rsrpDb)
+  {
+    mac->DoReportPsschRsrp (time, rbStart, rbLen, rsrpDb);
+  }
+  static void DoReportPsschRsrpReservation (Ptr<NrV2XUeMac> mac, Time time, uint16_t rbStart, uint16_t rbLen, double rsrpDb,
+                                            SidelinkCommResourcePool::SubframeInfo receivedSubframe, SidelinkCommResourcePool::SubframeInfo reservedSubframe,
+                                            uint32_t CreselRx, uint32_t nodeId, double RRI, bool isReTx, bool isSameTB)
+  {
+    mac->DoReportPsschRsrpReservation (time, rbStart, rbLen, rsrpDb, receivedSubframe, reservedSubframe, CreselRx, nodeId, RRI, isReTx, isSameTB);
+  }
+  static CandidateMap SelectionWindow (Ptr<NrV2XUeMac> mac, SidelinkCommResourcePool::SubframeInfo currentSF, uint32_t T_2_slots, uint16_t N_CSR_per_SF)
+  {
+    return mac->SelectionWindow (currentSF, T_2_slots, N_CSR_per_SF);
+  }
+  static CandidateMap Mode2Step1 (Ptr<NrV2XUeMac> mac, CandidateMap Sa, SidelinkCommResourcePool::SubframeInfo currentSF, V2XSidelinkGrant V2XGrant,
+                                  double T_2, uint16_t NSubCh, uint16_t L_SubCh, uint32_t *iterationsCounter, double *psschThresh,
+                                  uint32_t *nCSRpartial, bool OnlyReTxions)
+  {
+    return mac->Mode2Step1 (Sa, currentSF, V2XGrant, T_2, NSubCh, L_SubCh, iterationsCounter, psschThresh, nCSRpartial, OnlyReTxions);
+  }
+  static void ReEvaluationStep1 (Ptr<NrV2XUeMac> mac, SidelinkCommResourcePool::SubframeInfo currentSF, uint32_t T_2_slots, uint16_t N_CSR_per_SF,
+                                 V2XSidelinkGrant V2XGrant, double T_2, uint16_t NSubCh, uint16_t L_SubCh, uint32_t *iterationsCounter,
+                                 double *psschThresh, uint32_t *nCSRpartial, bool OnlyReTxions)
+  {
+    mac->ReEvaluationStep1 (currentSF, T_2_slots, N_CSR_per_SF, V2XGrant, T_2, NSubCh, L_SubCh, iterationsCounter, psschThresh, nCSRpartial, OnlyReTxions);
+  }
+  static CandidateMap ReEvaluationL1 (Ptr<NrV2XUeMac> mac, bool final)
+  {
+    return mac->ReEvaluationL1 (final);
+  }
+  static bool IsReEvaluationCandidate (Ptr<NrV2XUeMac> mac, uint16_t CSRindex, SidelinkCommResourcePool::SubframeInfo candidateSF)
+  {
+    return mac->IsReEvaluationCandidate (CSRindex, candidateSF);
+  }
+  static NrV2XUeMac::SelectionInputs CaptureSelectionInputs (Ptr<NrV2XUeMac> mac, SidelinkCommResourcePool::SubframeInfo currentSF,
+                                                             const V2XSidelinkGrant& V2XGrant, double pdb, uint16_t NSubCh, uint16_t L_SubCh)
+  {
+    return mac->CaptureSelectionInputs (currentSF, V2XGrant, pdb, NSubCh, L_SubCh);
+  }
+  static bool GetGeoCellSubchannel (Ptr<NrV2XUeMac> mac, double x, uint16_t *subchannel)
+  {
+    return mac->GetGeoCellSubchannel (x, subchannel);
+  }
+
+  // NrV2XSpectrumPhy
+
+  static int UnimoreCompareSinrPSSCH (Ptr<NrV2XSpectrumPhy> phy, const SpectrumValue& first_sinr, const std::vector<int>& first_map,
+                                      const SpectrumValue& second_sinr, const std::vector<int>& second_map)
+  {
+    return phy->UnimoreCompareSinrPSSCH (first_sinr, first_map, second_sinr, second_map);
+  }
+
+  // NistEpcUeNas
+
+  static std::unordered_map<uint32_t, Ptr<NistSlTft> >& SlBearerCache (Ptr<NistEpcUeNas> nas)
+  {
+    return nas->m_slBearerCache;
+  }
+  static Ptr<NistSlTft> LookupSidelinkBearer (Ptr<NistEpcUeNas> nas, uint32_t destination, bool* pending)
+  {
+    return nas->LookupSidelinkBearer (destination, pending);
+  }
+};
+
+} // namespace ns3
+
+#endif /* NR_V2X_TEST_ACCESS_H */
@@ -0,0 +1,2674 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * 2018 Dipartimento di Ingegneria 'Enzo Ferrari' (DIEF),
+ *      Universita' degli Studi di Modena e Reggio Emilia (UniMoRe)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luca Lusvarghi <luca.lusvarghi5@unimore.it>
+ * University of Modena and Reggio Emilia
+ *
+ */
+
+/*
+ * Unit tests of the MoReV2X models. The optimized paths are checked against
+ * a reference implementation or against the expected behavior on small
+ * seed-controlled workloads. The timing of the same paths is measured by the
+ * nr-v2x-benchmark performance suite.
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/uinteger.h>
+#include <ns3/boolean.h>
+#include <ns3/string.h>
+#include <ns3/rng-seed-manager.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/node-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/spectrum-value.h>
+
+#include <ns3/nr-v2x-ue-mac.h>
+#include <ns3/nr-v2x-spectrum-phy.h>
+#include <ns3/nr-v2x-propagation-loss-model.h>
+#include <ns3/nr-v2x-spectrum-value-helper.h>
+#include <ns3/nr-v2x-phy-error-model.h>
+#include <ns3/nr-v2x-utils.h>
+#include <ns3/nist-lte-common.h>
+#include <ns3/position-based-enabler.h>
+#include <ns3/nr-v2x-trace-mobility-helper.h>
+#include <ns3/nist-lte-sl-interference.h>
+#include <ns3/nist-lte-sl-chunk-processor.h>
+#include <ns3/nr-v2x-worker-pool.h>
+#include <ns3/lte-node-state.h>
+#include <ns3/nist-lte-harq-phy.h>
+#include <ns3/building.h>
+#include <ns3/building-list.h>
+#include <ns3/nr-v2x-building-index.h>
+#include <ns3/nr-v2x-urban-propagation-loss-model.h>
+#include <ns3/nist-epc-tft-classifier.h>
+#include <ns3/nist-epc-ue-nas.h>
+#include <ns3/nist-lte-as-sap.h>
+#include <ns3/nist-sl-tft.h>
+#include <ns3/packet.h>
+#include <ns3/ipv4-header.h>
+#include <ns3/udp-header.h>
+#include <ns3/udp-l4-protocol.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/antenna-model.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/simple-net-device.h>
+#include <ns3/packet-burst.h>
+#include <ns3/pointer.h>
+#include <ns3/nist-lte-spectrum-signal-parameters.h>
+#include <ns3/nist-lte-control-messages.h>
+#include <ns3/nist-lte-radio-bearer-tag.h>
+
+#include "nr-v2x-counting-spectrum-phy.h"
+#include "nr-v2x-test-access.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <cstdio>
+#include <cstdlib>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrV2XTest");
+
+/**
+ * Mode 2 resource selection: ReEvaluationStep1 must keep exactly the
+ * candidates of the full Mode2Step1 over a selection window built by
+ * SelectionWindow, with a synthetic sensing database, with and without past
+ * transmissions
+ */
+class NrV2XMode2ReEvaluationTestCase : public TestCase
+{
+public:
+  NrV2XMode2ReEvaluationTestCase (double pdb, std::vector<uint16_t> rriList, uint16_t nSubCh, uint16_t lSubCh, double density);
+  virtual ~NrV2XMode2ReEvaluationTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  double m_pdb;
+  std::vector<uint16_t> m_rriList;
+  uint16_t m_nSubCh;
+  uint16_t m_lSubCh;
+  double m_density;
+};
+
+NrV2XMode2ReEvaluationTestCase::NrV2XMode2ReEvaluationTestCase (double pdb, std::vector<uint16_t> rriList, uint16_t nSubCh, uint16_t lSubCh, double density)
+  : TestCase ("Mode 2 re-evaluation"),
+    m_pdb (pdb),
+    m_rriList (rriList),
+    m_nSubCh (nSubCh),
+    m_lSubCh (lSubCh),
+    m_density (density)
+{
+}
+
+NrV2XMode2ReEvaluationTestCase::~NrV2XMode2ReEvaluationTestCase ()
+{
+}
+
+void
+NrV2XMode2ReEvaluationTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  const uint16_t subchannelSize = 10;
+
+  Ptr<NrV2XUeMac> mac = NrV2XTestAccess::CreateMode2Mac (subchannelSize, m_rriList);
+
+  // Current slot SF(600,5): sense the reservations of the previous second
+  SidelinkCommResourcePool::SubframeInfo currentSF;
+  currentSF.frameNo = 600;
+  currentSF.subframeNo = 5;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uint32_t nReservations = NrV2XTestAccess::FillSensingDatabase (mac, currentSF, uniform, m_rriList, subchannelSize, m_nSubCh, m_lSubCh, m_density, false);
+  NS_TEST_ASSERT_MSG_GT (nReservations, 0, "The sensing database is empty");
+
+  NrV2XTestAccess::V2XSidelinkGrant grant;
+  grant.m_RRI = 100;
+  grant.m_Cresel = 10;
+  double T_2 = m_pdb - 1.0;
+  for (uint32_t pastTx = 0; pastTx < 2; pastTx++)
+    {
+      if (pastTx == 1)
+        {
+          NrV2XTestAccess::AddPastTransmissions (mac, currentSF);
+        }
+      for (uint32_t onlyReTx = 0; onlyReTx < 2; onlyReTx++)
+        {
+          uint32_t fullIterations = 0, fullCSR = 0, reEvalIterations = 0, reEvalCSR = 0;
+          double fullThresh = -110, reEvalThresh = -110;
+          std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa, fullL1, reEvalL1;
+          Sa = NrV2XTestAccess::SelectionWindow (mac, currentSF, T_2, m_nSubCh - m_lSubCh + 1);
+          fullL1 = NrV2XTestAccess::Mode2Step1 (mac, Sa, currentSF, grant, T_2, m_nSubCh, m_lSubCh, &fullIterations, &fullThresh, &fullCSR, onlyReTx);
+          NrV2XTestAccess::ReEvaluationStep1 (mac, currentSF, T_2, m_nSubCh - m_lSubCh + 1, grant, T_2, m_nSubCh, m_lSubCh, &reEvalIterations, &reEvalThresh, &reEvalCSR, onlyReTx);
+          reEvalL1 = NrV2XTestAccess::ReEvaluationL1 (mac, true);
+          NS_TEST_ASSERT_MSG_GT (ComputeResidualCSRs (fullL1), 0, "The selection left no candidate resource");
+          NS_TEST_ASSERT_MSG_EQ ((fullL1 == reEvalL1), true, "The re-evaluation selected different candidates");
+          NS_TEST_ASSERT_MSG_EQ (reEvalIterations, fullIterations, "Different number of RSRP threshold increases");
+          NS_TEST_ASSERT_MSG_EQ (reEvalThresh, fullThresh, "Different final RSRP threshold");
+          NS_TEST_ASSERT_MSG_EQ (reEvalCSR, fullCSR, "Different number of candidates after the past transmissions");
+        }
+    }
+
+  // Later re-evaluations of a window, one slot apart: the new reservations (some within Tproc0), the
+  // new past transmissions, the reservations leaving the sensing window and the shrinking T_2 are applied to
+  // the state of the previous re-evaluation
+  uint32_t currentSlot = currentSF.frameNo * 10 + currentSF.subframeNo;
+  for (uint32_t slot = 1090; slot < 1110; slot++)
+    {
+      uint32_t receivedSlot = currentSlot - slot;
+      SidelinkCommResourcePool::SubframeInfo receivedSF, reservedSF;
+      receivedSF.frameNo = receivedSlot / 10 + 1;
+      receivedSF.subframeNo = receivedSlot % 10 + 1;
+      reservedSF.frameNo = (receivedSlot + 100) / 10 + 1;
+      reservedSF.subframeNo = (receivedSlot + 100) % 10 + 1;
+      NrV2XTestAccess::DoReportPsschRsrpReservation (mac, Seconds (0), 0, m_lSubCh * subchannelSize, -75, receivedSF, reservedSF, 10, 1, 100, false, false);
+    }
+  uint32_t nSteps = std::min (30.0, T_2 - 3);
+  for (uint32_t onlyReTx = 0; onlyReTx < 2; onlyReTx++)
+    {
+      uint32_t rebuilds = NrV2XTestAccess::ReEvaluationRebuilds (mac);
+      for (uint32_t step = 0; step < nSteps; step++)
+        {
+          uint32_t reEvalSlot = currentSlot + onlyReTx * nSteps + step;
+          SidelinkCommResourcePool::SubframeInfo reEvalSF;
+          reEvalSF.frameNo = reEvalSlot / 10;
+          reEvalSF.subframeNo = reEvalSlot % 10;
+          double reEvalT_2 = T_2 - step;
+          if (step > 0)
+            {
+              for (uint32_t age = 0; age < 2; age++)
+                {
+                  uint32_t receivedSlot = reEvalSlot - age;
+                  SidelinkCommResourcePool::SubframeInfo receivedSF, reservedSF;
+                  receivedSF.frameNo = receivedSlot / 10 + 1;
+                  receivedSF.subframeNo = receivedSlot % 10 + 1;
+                  for (uint16_t subCh = 0; subCh + m_lSubCh <= m_nSubCh; subCh += m_lSubCh)
+                    {
+                      if (uniform->GetValue () < m_density)
+                        {
+                          uint16_t rri = m_rriList[uniform->GetInteger (0, m_rriList.size () - 1)];
+                          reservedSF.frameNo = (receivedSlot + rri) / 10 + 1;
+                          reservedSF.subframeNo = (receivedSlot + rri) % 10 + 1;
+                          NrV2XTestAccess::DoReportPsschRsrpReservation (mac, Seconds (0), subCh * subchannelSize, m_lSubCh * subchannelSize, uniform->GetValue (-120, -70),
+                                                                         receivedSF, reservedSF, uniform->GetInteger (5, 15), uniform->GetInteger (1, 200), rri,
+                                                                         uniform->GetValue () < 0.5, uniform->GetValue () < 0.5);
+                        }
+                    }
+                }
+              // A strong reservation repeated within the window, whose repetitions leave it as the sensing age grows and T_2 shrinks
+              SidelinkCommResourcePool::SubframeInfo receivedSF, reservedSF;
+              receivedSF.frameNo = (reEvalSlot - 1) / 10 + 1;
+              receivedSF.subframeNo = (reEvalSlot - 1) % 10 + 1;
+              reservedSF.frameNo = (reEvalSlot + 9) / 10 + 1;
+              reservedSF.subframeNo = (reEvalSlot + 9) % 10 + 1;
+              NrV2XTestAccess::DoReportPsschRsrpReservation (mac, Seconds (0), ((step * m_lSubCh) % (m_nSubCh - m_lSubCh + 1)) * subchannelSize, m_lSubCh * subchannelSize, -60,
+                                                             receivedSF, reservedSF, 10, 2, 10, false, false);
+              if (step % 3 == 1)
+                {
+                  SidelinkCommResourcePool::SubframeInfo txSF;
+                  txSF.frameNo = (reEvalSlot - 1) / 10;
+                  txSF.subframeNo = (reEvalSlot - 1) % 10;
+                  NrV2XTestAccess::PastTransmissions (mac).push_back (std::make_pair (Seconds (0), txSF));
+                }
+            }
+          uint32_t fullIterations = 0, fullCSR = 0, reEvalIterations = 0, reEvalCSR = 0;
+          double fullThresh = -110, reEvalThresh = -110;
+          std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa, fullL1, reEvalL1;
+          Sa = NrV2XTestAccess::SelectionWindow (mac, reEvalSF, reEvalT_2, m_nSubCh - m_lSubCh + 1);
+          fullL1 = NrV2XTestAccess::Mode2Step1 (mac, Sa, reEvalSF, grant, reEvalT_2, m_nSubCh, m_lSubCh, &fullIterations, &fullThresh, &fullCSR, onlyReTx);
+          NrV2XTestAccess::ReEvaluationStep1 (mac, reEvalSF, reEvalT_2, m_nSubCh - m_lSubCh + 1, grant, reEvalT_2, m_nSubCh, m_lSubCh, &reEvalIterations, &reEvalThresh, &reEvalCSR, onlyReTx);
+          reEvalL1 = NrV2XTestAccess::ReEvaluationL1 (mac, true);
+          NS_TEST_ASSERT_MSG_EQ ((fullL1 == reEvalL1), true, "The re-evaluation at step " << step << " selected different candidates");
+          NS_TEST_ASSERT_MSG_EQ (reEvalIterations, fullIterations, "Different number of RSRP threshold increases at step " << step);
+          NS_TEST_ASSERT_MSG_EQ (reEvalThresh, fullThresh, "Different final RSRP threshold at step " << step);
+          NS_TEST_ASSERT_MSG_EQ (reEvalCSR, fullCSR, "Different number of candidates after the past transmissions at step " << step);
+          for (std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> >::iterator SaIt = Sa.begin (); SaIt != Sa.end (); SaIt++)
+            {
+              for (std::list<SidelinkCommResourcePool::SubframeInfo>::iterator FrameIt = SaIt->second.begin (); FrameIt != SaIt->second.end (); FrameIt++)
+                {
+                  bool inFullL1 = std::find (fullL1[SaIt->first].begin (), fullL1[SaIt->first].end (), *FrameIt) != fullL1[SaIt->first].end ();
+                  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::IsReEvaluationCandidate (mac, SaIt->first, *FrameIt), inFullL1, "Wrong candidate lookup at step " << step);
+                }
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::ReEvaluationRebuilds (mac), rebuilds + 1, "The later re-evaluations of the window were not incremental");
+    }
+  mac->Dispose ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Frequency-reuse geo-cell lookup: GetGeoCellSubchannel on a highway
+ * partitioned with GetGeoCellSize, checked against a scan of the map
+ */
+class NrV2XGeoCellLookupTestCase : public TestCase
+{
+public:
+  NrV2XGeoCellLookupTestCase (uint16_t nRbs, double reuseDistance);
+  virtual ~NrV2XGeoCellLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_nRbs;
+  double m_reuseDistance;
+};
+
+NrV2XGeoCellLookupTestCase::NrV2XGeoCellLookupTestCase (uint16_t nRbs, double reuseDistance)
+  : TestCase ("Geo-cell lookup"),
+    m_nRbs (nRbs),
+    m_reuseDistance (reuseDistance)
+{
+}
+
+NrV2XGeoCellLookupTestCase::~NrV2XGeoCellLookupTestCase ()
+{
+}
+
+void
+NrV2XGeoCellLookupTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (6);
+  const uint16_t subchannelSize = 10;
+  const double highwayLength = 5000;
+
+  uint32_t nGeoCells;
+  double geoCellSize = GetGeoCellSize (subchannelSize, m_nRbs, m_reuseDistance, &nGeoCells);
+  std::map < uint16_t, std::vector < std::pair <double, double>>> subchannelsMap;
+  for (double clusterStart = 0; clusterStart < highwayLength; clusterStart += m_reuseDistance)
+    {
+      for (uint16_t subCh = 0; subCh < nGeoCells; subCh++)
+        {
+          subchannelsMap[subCh].push_back (std::make_pair (clusterStart + subCh * geoCellSize, clusterStart + (subCh + 1) * geoCellSize));
+        }
+    }
+  Ptr<NrV2XUeMac> mac = CreateObject<NrV2XUeMac> ();
+  mac->CopySubchannelsMap (subchannelsMap);
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      double position = uniform->GetValue (-100, highwayLength + 100);
+      bool scanFound = false;
+      uint16_t scanCSR = 0, gridCSR = 0;
+      for (std::map < uint16_t, std::vector < std::pair <double, double>>>::iterator mapIT = subchannelsMap.begin (); mapIT != subchannelsMap.end (); mapIT++)
+        {
+          for (std::vector < std::pair <double, double>>::iterator cellIt = mapIT->second.begin (); cellIt != mapIT->second.end (); cellIt++)
+            {
+              if ((position >= cellIt->first) && (position < cellIt->second))
+                {
+                  scanCSR = mapIT->first;
+                  scanFound = true;
+                }
+            }
+        }
+      bool gridFound = NrV2XTestAccess::GetGeoCellSubchannel (mac, position, &gridCSR);
+      NS_TEST_ASSERT_MSG_EQ (gridFound, scanFound, "The geo-cell grid and the scan of the map disagree at " << position);
+      if (gridFound)
+        {
+          NS_TEST_ASSERT_MSG_EQ (gridCSR, scanCSR, "Unexpected geo-cell of " << position);
+          found++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_GT (found, 0, "No position falls inside a geo-cell");
+  mac->Dispose ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Position checker: PosEnabler::isInsidePoly on the HIGHWAY TX polygon and
+ * on a concave polygon with horizontal sides, checked against the plain
+ * ray-casting test on random points, vertices and points of the sides
+ */
+class NrV2XPolygonCheckTestCase : public TestCase
+{
+public:
+  NrV2XPolygonCheckTestCase (bool enabled);
+  virtual ~NrV2XPolygonCheckTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  bool RayCast (PosEnabler& checker, const std::vector<Point>& polygon, Point p);
+
+  bool m_enabled;
+};
+
+NrV2XPolygonCheckTestCase::NrV2XPolygonCheckTestCase (bool enabled)
+  : TestCase ("Polygon check"),
+    m_enabled (enabled)
+{
+}
+
+NrV2XPolygonCheckTestCase::~NrV2XPolygonCheckTestCase ()
+{
+}
+
+bool
+NrV2XPolygonCheckTestCase::RayCast (PosEnabler& checker, const std::vector<Point>& polygon, Point p)
+{
+  int n = polygon.size ();
+  Point extreme = {10000, p.y};
+  int count = 0, i = 0;
+  do
+    {
+      int next = (i + 1) % n;
+      if (checker.doIntersect (polygon[i], polygon[next], p, extreme))
+        {
+          if (checker.orientation (polygon[i], p, polygon[next]) == 0)
+            {
+              return checker.onSegment (polygon[i], p, polygon[next]);
+            }
+          count++;
+        }
+      i = next;
+    }
+  while (i != 0);
+  return m_enabled ? (count & 1) : true;
+}
+
+void
+NrV2XPolygonCheckTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (7);
+
+  Point highway[] = {{975, 1870}, {1540, 1626}, {1965, 2121}, {2556, 3253}, {1798,3597}, {966,2492}};
+  Point concave[] = {{0, 0}, {400, 0}, {400, 300}, {250, 300}, {250, 100}, {150, 100}, {150, 300}, {0, 300}};
+  std::vector<std::vector<Point> > polygons;
+  polygons.push_back (std::vector<Point> (highway, highway + 6));
+  polygons.push_back (std::vector<Point> (concave, concave + 8));
+
+  PosEnabler checker;
+  if (!m_enabled)
+    {
+      checker.DisableChecker ();
+    }
+  std::vector<int> handles;
+  for (uint32_t i = 0; i < polygons.size (); i++)
+    {
+      handles.push_back (checker.registerPolygon (&polygons[i][0], polygons[i].size ()));
+    }
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  std::vector<std::pair<int, Point> > queries;
+  for (uint32_t i = 0; i < polygons.size (); i++)
+    {
+      int minX = polygons[i][0].x, maxX = minX, minY = polygons[i][0].y, maxY = minY;
+      for (uint32_t v = 0; v < polygons[i].size (); v++)
+        {
+          minX = std::min (minX, polygons[i][v].x);
+          maxX = std::max (maxX, polygons[i][v].x);
+          minY = std::min (minY, polygons[i][v].y);
+          maxY = std::max (maxY, polygons[i][v].y);
+          // Vertices and points along the sides
+          Point next = polygons[i][(v + 1) % polygons[i].size ()];
+          for (int step = 0; step <= 10; step++)
+            {
+              Point p = {polygons[i][v].x + (next.x - polygons[i][v].x) * step / 10,
+                         polygons[i][v].y + (next.y - polygons[i][v].y) * step / 10};
+              queries.push_back (std::make_pair (i, p));
+            }
+        }
+      for (uint32_t q = 0; q < 2000; q++)
+        {
+          Point p = {(int) std::floor (uniform->GetValue (minX - 50, maxX + 51)), (int) std::floor (uniform->GetValue (minY - 50, maxY + 51))};
+          queries.push_back (std::make_pair (i, p));
+        }
+    }
+  uint32_t inside = 0;
+  for (std::vector<std::pair<int, Point> >::iterator it = queries.begin (); it != queries.end (); it++)
+    {
+      bool rasterized = checker.isInsidePoly (handles[it->first], it->second);
+      NS_TEST_ASSERT_MSG_EQ (rasterized, RayCast (checker, polygons[it->first], it->second),
+                             "The rasterized and the plain ray-casting test disagree at (" << it->second.x << "," << it->second.y << ")");
+      inside += rasterized;
+    }
+  NS_TEST_ASSERT_MSG_GT (inside, 0, "No point falls inside the polygons");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * PSSCH overlap resolution: UnimoreCompareSinrPSSCH on random pairs of
+ * subchannel allocations, checked against the mean SINR of the overlapping
+ * RBs
+ */
+class NrV2XPsschOverlapTestCase : public TestCase
+{
+public:
+  NrV2XPsschOverlapTestCase (uint16_t nRbs, uint16_t subchannelSize);
+  virtual ~NrV2XPsschOverlapTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_nRbs;
+  uint16_t m_subchannelSize;
+};
+
+NrV2XPsschOverlapTestCase::NrV2XPsschOverlapTestCase (uint16_t nRbs, uint16_t subchannelSize)
+  : TestCase ("PSSCH overlap resolution"),
+    m_nRbs (nRbs),
+    m_subchannelSize (subchannelSize)
+{
+}
+
+NrV2XPsschOverlapTestCase::~NrV2XPsschOverlapTestCase ()
+{
+}
+
+void
+NrV2XPsschOverlapTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (2);
+  const uint32_t pairs = 200;
+
+  Ptr<NrV2XSpectrumPhy> phy = CreateObject<NrV2XSpectrumPhy> ();
+  Ptr<SpectrumModel> model = NrV2XSpectrumValueHelper::GetSpectrumModel (18100, m_nRbs);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uint16_t nSubCh = m_nRbs / m_subchannelSize;
+
+  uint32_t outcomes[3] = {0, 0, 0};
+  for (uint32_t i = 0; i < pairs; i++)
+    {
+      SpectrumValue sinr[2] = {SpectrumValue (model), SpectrumValue (model)};
+      std::vector<int> map[2];
+      for (uint32_t j = 0; j < 2; j++)
+        {
+          for (uint16_t rb = 0; rb < m_nRbs; rb++)
+            {
+              sinr[j][rb] = std::pow (10.0, uniform->GetValue (-10, 30) / 10);
+            }
+          uint16_t length = uniform->GetInteger (1, nSubCh);
+          uint16_t first = uniform->GetInteger (0, nSubCh - length);
+          for (int rb = first * m_subchannelSize; rb < (first + length) * m_subchannelSize; rb++)
+            {
+              map[j].push_back (rb);
+            }
+        }
+      double mean[2] = {0, 0};
+      uint32_t overlapped = 0;
+      for (std::vector<int>::iterator it = map[0].begin (); it != map[0].end (); it++)
+        {
+          if (std::find (map[1].begin (), map[1].end (), *it) != map[1].end ())
+            {
+              mean[0] += sinr[0][*it];
+              mean[1] += sinr[1][*it];
+              overlapped++;
+            }
+        }
+      int expected = overlapped == 0 ? 0 : (mean[0] / overlapped > mean[1] / overlapped ? 1 : 2);
+      int outcome = NrV2XTestAccess::UnimoreCompareSinrPSSCH (phy, sinr[0], map[0], sinr[1], map[1]);
+      NS_TEST_ASSERT_MSG_EQ (outcome, expected, "Unexpected comparison outcome of pair " << i);
+      outcomes[outcome]++;
+    }
+  NS_TEST_ASSERT_MSG_GT (outcomes[0], 0, "No pair without overlap");
+  NS_TEST_ASSERT_MSG_GT (outcomes[1] + outcomes[2], 0, "No overlapping pair");
+  phy->Dispose ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * PSSCH-RSRP history: DoReportPsschRsrp over a long run, checking that the
+ * history stays within the sensing window
+ */
+class NrV2XPsschRsrpHistoryTestCase : public TestCase
+{
+public:
+  NrV2XPsschRsrpHistoryTestCase (double simTime, double reportsPerMs);
+  virtual ~NrV2XPsschRsrpHistoryTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  double m_simTime; // (s)
+  double m_reportsPerMs;
+};
+
+NrV2XPsschRsrpHistoryTestCase::NrV2XPsschRsrpHistoryTestCase (double simTime, double reportsPerMs)
+  : TestCase ("PSSCH-RSRP history"),
+    m_simTime (simTime),
+    m_reportsPerMs (reportsPerMs)
+{
+}
+
+NrV2XPsschRsrpHistoryTestCase::~NrV2XPsschRsrpHistoryTestCase ()
+{
+}
+
+void
+NrV2XPsschRsrpHistoryTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (8);
+  const uint64_t reports = m_simTime * 1000 * m_reportsPerMs;
+  const int64_t step = 1000000 / m_reportsPerMs; // (ns)
+
+  Ptr<NrV2XUeMac> mac = CreateObject<NrV2XUeMac> ();
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  size_t maxSize = 0;
+  for (uint64_t i = 0; i < reports; i++)
+    {
+      NrV2XTestAccess::DoReportPsschRsrp (mac, NanoSeconds (i * step), uniform->GetInteger (0, 40), 10, uniform->GetValue (-110, -60));
+      maxSize = std::max (maxSize, NrV2XTestAccess::PsschRsrpMap (mac).size ());
+    }
+
+  Time last = NanoSeconds ((reports - 1) * step);
+  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::PsschRsrpMap (mac).rbegin ()->first, last, "Latest report missing");
+  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::PsschRsrpMap (mac).rbegin ()->second.rbLen, 10, "Unexpected rbLen");
+  NS_TEST_ASSERT_MSG_EQ ((NrV2XTestAccess::PsschRsrpMap (mac).begin ()->first >= last - MilliSeconds (NrV2XTestAccess::SensingWindow (mac))), true, "Report older than the sensing window");
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (maxSize, (size_t) (NrV2XTestAccess::SensingWindow (mac) * m_reportsPerMs) + 1, "History not bounded by the sensing window");
+  mac->Dispose ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Channel matrix: InitChannelMatrix and one UpdateChannelMatrix for N
+ * vehicles dropped on a 2 km highway keep a row per vehicle
+ */
+class NrV2XChannelMatrixTestCase : public TestCase
+{
+public:
+  NrV2XChannelMatrixTestCase (uint32_t nNodes);
+  virtual ~NrV2XChannelMatrixTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nNodes;
+};
+
+NrV2XChannelMatrixTestCase::NrV2XChannelMatrixTestCase (uint32_t nNodes)
+  : TestCase ("Channel matrix"),
+    m_nNodes (nNodes)
+{
+}
+
+NrV2XChannelMatrixTestCase::~NrV2XChannelMatrixTestCase ()
+{
+}
+
+void
+NrV2XChannelMatrixTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (3);
+  NodeContainer nodes;
+  nodes.Create (m_nNodes);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (uniform->GetValue (0, 2000), uniform->GetValue (0, 6 * 4), 1.5));
+      (*it)->AggregateObject (mobility);
+    }
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Ptr<NrV2XPropagationLossModel> lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+  lossModel->InitChannelMatrix (nodes);
+  NS_TEST_ASSERT_MSG_EQ (NrV2XPropagationLossModel::ChannelMatrix.size (), m_nNodes, "Unexpected channel matrix size");
+
+  // The first update is scheduled 100 ms after the initialization
+  Simulator::Stop (MilliSeconds (150));
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (NrV2XPropagationLossModel::ChannelMatrix.size (), m_nNodes, "Unexpected channel matrix size after the update");
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Mobility trace ingestion: NrV2XTraceMobilityHelper on a synthetic SUMO
+ * FCD trace where vehicle v drives east at 20 m/s along y = v. The vehicles
+ * enter and leave a pool of V-UEs, optionally with their channel models
+ * activated and retired accordingly. Also checks a setdest of an ns-2 trace
+ */
+class NrV2XTraceMobilityTestCase : public TestCase
+{
+public:
+  NrV2XTraceMobilityTestCase (uint32_t nVehicles, uint32_t poolSize, bool channelModels);
+  virtual ~NrV2XTraceMobilityTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void Enter (uint32_t nodeId);
+  void Leave (uint32_t nodeId);
+  void CheckPositions (NodeContainer pool, double time);
+
+  uint32_t m_nVehicles;
+  uint32_t m_poolSize;
+  bool m_channelModels;
+  uint32_t m_steps;
+  uint32_t m_lifetime;
+  Ptr<NrV2XPropagationLossModel> m_lossModel;
+  std::set<uint32_t> m_active;
+  uint32_t m_enters;
+  uint32_t m_leaves;
+  uint32_t m_maxActive;
+  uint32_t m_wrongPositions;
+  uint32_t m_wrongMatrixSize;
+};
+
+NrV2XTraceMobilityTestCase::NrV2XTraceMobilityTestCase (uint32_t nVehicles, uint32_t poolSize, bool channelModels)
+  : TestCase ("Mobility trace"),
+    m_nVehicles (nVehicles),
+    m_poolSize (poolSize),
+    m_channelModels (channelModels),
+    m_steps (60),
+    m_lifetime (30)
+{
+}
+
+NrV2XTraceMobilityTestCase::~NrV2XTraceMobilityTestCase ()
+{
+}
+
+void
+NrV2XTraceMobilityTestCase::Enter (uint32_t nodeId)
+{
+  if (m_channelModels)
+    {
+      m_lossModel->ActivateNode (nodeId);
+    }
+  m_active.insert (nodeId);
+  m_enters++;
+  m_maxActive = std::max (m_maxActive, (uint32_t) m_active.size ());
+}
+
+void
+NrV2XTraceMobilityTestCase::Leave (uint32_t nodeId)
+{
+  if (m_channelModels)
+    {
+      m_lossModel->RetireNode (nodeId);
+    }
+  m_active.erase (nodeId);
+  m_leaves++;
+}
+
+void
+NrV2XTraceMobilityTestCase::CheckPositions (NodeContainer pool, double time)
+{
+  for (std::set<uint32_t>::iterator it = m_active.begin (); it != m_active.end (); it++)
+    {
+      for (NodeContainer::Iterator node = pool.Begin (); node != pool.End (); ++node)
+        {
+          if ((*node)->GetId () != *it)
+            {
+              continue;
+            }
+          Vector position = (*node)->GetObject<MobilityModel> ()->GetPosition ();
+          uint32_t vehicle = (uint32_t) std::floor (position.y + 0.5);
+          double enterTime = (vehicle * (m_steps - m_lifetime)) / m_nVehicles;
+          if (std::fabs (position.x - 20 * (time - enterTime)) > 1e-6)
+            {
+              m_wrongPositions++;
+            }
+        }
+    }
+  if (m_channelModels && (NrV2XPropagationLossModel::ChannelMatrix.size () != m_active.size ()))
+    {
+      m_wrongMatrixSize++;
+    }
+}
+
+void
+NrV2XTraceMobilityTestCase::DoRun (void)
+{
+  m_enters = 0;
+  m_leaves = 0;
+  m_maxActive = 0;
+  m_wrongPositions = 0;
+  m_wrongMatrixSize = 0;
+  m_active.clear ();
+
+  // Vehicle v is in the trace from step v * (steps - lifetime) / nVehicles, for lifetime steps of 1 s
+  const std::string fcdName = "morev2x-test-fcd.xml";
+  std::ofstream fcd (fcdName.c_str ());
+  fcd << "<fcd-export>" << std::endl;
+  for (uint32_t step = 0; step < m_steps; step++)
+    {
+      fcd << "    <timestep time=\"" << step << ".00\">" << std::endl;
+      for (uint32_t vehicle = 0; vehicle < m_nVehicles; vehicle++)
+        {
+          uint32_t enterStep = (vehicle * (m_steps - m_lifetime)) / m_nVehicles;
+          if ((step >= enterStep) && (step < enterStep + m_lifetime))
+            {
+              fcd << "        <vehicle id=\"veh" << vehicle << "\" x=\"" << 20.0 * (step - enterStep) << "\" y=\"" << vehicle
+                  << "\" angle=\"90.00\" type=\"car\" speed=\"20.00\" pos=\"0.00\" lane=\"e_0\" slope=\"0.00\"/>" << std::endl;
+            }
+        }
+      fcd << "    </timestep>" << std::endl;
+    }
+  fcd << "    <timestep time=\"" << m_steps << ".00\"/>" << std::endl;
+  fcd << "</fcd-export>" << std::endl;
+  fcd.close ();
+
+  NodeContainer pool;
+  pool.Create (m_poolSize);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (pool);
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  m_lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  m_lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+
+  Ptr<NrV2XTraceMobilityHelper> trace = CreateObject<NrV2XTraceMobilityHelper> ();
+  trace->SetAttribute ("LookAhead", TimeValue (Seconds (2)));
+  trace->SetEnterCallback (MakeCallback (&NrV2XTraceMobilityTestCase::Enter, this));
+  trace->SetLeaveCallback (MakeCallback (&NrV2XTraceMobilityTestCase::Leave, this));
+  trace->Install (fcdName, pool);
+  if (m_channelModels)
+    {
+      m_lossModel->InitChannelMatrix (pool);
+      for (NodeContainer::Iterator it = pool.Begin (); it != pool.End (); ++it)
+        {
+          m_lossModel->RetireNode ((*it)->GetId ());
+        }
+    }
+  for (uint32_t step = 0; step < m_steps; step += 7)
+    {
+      Simulator::Schedule (Seconds (step + 0.5), &NrV2XTraceMobilityTestCase::CheckPositions, this, pool, step + 0.5);
+    }
+
+  Simulator::Stop (Seconds (m_steps + 1));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_enters + trace->GetDroppedVehicles (), m_nVehicles, "Every vehicle must enter or be dropped");
+  NS_TEST_EXPECT_MSG_EQ (m_leaves, m_enters, "Every vehicle must leave at the end of the trace");
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (m_maxActive, m_poolSize, "More vehicles than V-UEs");
+  NS_TEST_EXPECT_MSG_EQ (m_wrongPositions, 0, "The V-UEs do not follow the trace");
+  NS_TEST_EXPECT_MSG_EQ (m_wrongMatrixSize, 0, "The channel matrix does not follow the vehicles in the scenario");
+  NS_TEST_EXPECT_MSG_EQ (NrV2XPropagationLossModel::ChannelMatrix.size (), 0, "The channel models of the retired V-UEs were not released");
+  if (m_poolSize >= m_nVehicles)
+    {
+      NS_TEST_EXPECT_MSG_EQ (trace->GetDroppedVehicles (), 0, "No vehicle should be dropped");
+    }
+  trace->Dispose ();
+  std::remove (fcdName.c_str ());
+  m_lossModel = 0;
+  Simulator::Destroy ();
+
+  // ns-2 trace: one vehicle moving 100 m east at 10 m/s from t = 1 s
+  const std::string ns2Name = "morev2x-test-ns2.tcl";
+  std::ofstream ns2 (ns2Name.c_str ());
+  ns2 << "$node_(0) set X_ 0.0" << std::endl << "$node_(0) set Y_ 5.0" << std::endl << "$node_(0) set Z_ 0.0" << std::endl;
+  ns2 << "$ns_ at 1.0 \"$node_(0) setdest 100.0 5.0 10.0\"" << std::endl;
+  ns2.close ();
+  NodeContainer ns2Pool;
+  ns2Pool.Create (1);
+  mobility.Install (ns2Pool);
+  trace = CreateObject<NrV2XTraceMobilityHelper> ();
+  trace->Install (ns2Name, ns2Pool);
+  Simulator::Stop (Seconds (6));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (ns2Pool.Get (0)->GetObject<MobilityModel> ()->GetPosition ().x, 50.0, 1e-6, "Wrong position during the setdest");
+  Simulator::Stop (Seconds (20));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (ns2Pool.Get (0)->GetObject<MobilityModel> ()->GetPosition ().x, 100.0, 1e-6, "The setdest did not stop at the destination");
+  trace->Dispose ();
+  std::remove (ns2Name.c_str ());
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Tx PSD construction, with and without in-band emissions: the power is
+ * transmitted in the allocated RBs, and leaks out of them only with the
+ * in-band emissions
+ */
+class NrV2XTxPsdTestCase : public TestCase
+{
+public:
+  NrV2XTxPsdTestCase (uint16_t nRbs, bool ibe);
+  virtual ~NrV2XTxPsdTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_nRbs;
+  bool m_ibe;
+};
+
+NrV2XTxPsdTestCase::NrV2XTxPsdTestCase (uint16_t nRbs, bool ibe)
+  : TestCase ("Tx PSD"),
+    m_nRbs (nRbs),
+    m_ibe (ibe)
+{
+}
+
+NrV2XTxPsdTestCase::~NrV2XTxPsdTestCase ()
+{
+}
+
+void
+NrV2XTxPsdTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (4);
+  const uint16_t subchannelSize = 10;
+  uint16_t nSubCh = m_nRbs / subchannelSize;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+
+  NrV2XSpectrumValueHelper psdHelper;
+  uint32_t leakingPsds = 0;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      uint16_t length = uniform->GetInteger (1, nSubCh - 1);
+      uint16_t first = uniform->GetInteger (0, nSubCh - length);
+      std::vector<int> activeRbs;
+      for (int rb = first * subchannelSize; rb < (first + length) * subchannelSize; rb++)
+        {
+          activeRbs.push_back (rb);
+        }
+      Ptr<SpectrumValue> psd = psdHelper.CreateUlTxPowerSpectralDensity (18100, m_nRbs, 23.0, activeRbs, 1.0, 15,
+                                                                         uniform->GetInteger (0, 27), m_ibe);
+      double inside = 0, outside = 0;
+      for (uint16_t rb = 0; rb < m_nRbs; rb++)
+        {
+          NS_TEST_ASSERT_MSG_GT_OR_EQ ((*psd)[rb], 0, "Negative PSD in RB " << rb);
+          if (std::find (activeRbs.begin (), activeRbs.end (), rb) != activeRbs.end ())
+            {
+              inside += (*psd)[rb];
+            }
+          else
+            {
+              outside += (*psd)[rb];
+            }
+        }
+      NS_TEST_ASSERT_MSG_GT (inside, 0, "No power in the allocated RBs");
+      if (!m_ibe)
+        {
+          NS_TEST_ASSERT_MSG_EQ (outside, 0, "Power out of the allocated RBs without in-band emissions");
+        }
+      leakingPsds += outside > 0;
+    }
+  if (m_ibe)
+    {
+      NS_TEST_ASSERT_MSG_GT (leakingPsds, 0, "No in-band emission");
+    }
+}
+
+
+/**
+ * PSSCH and PSCCH BLER lookup: the BLER is a probability, and does not
+ * increase with the SINR
+ */
+class NrV2XBlerLookupTestCase : public TestCase
+{
+public:
+  NrV2XBlerLookupTestCase (uint16_t scs);
+  virtual ~NrV2XBlerLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_scs;
+};
+
+NrV2XBlerLookupTestCase::NrV2XBlerLookupTestCase (uint16_t scs)
+  : TestCase ("BLER lookup"),
+    m_scs (scs)
+{
+}
+
+NrV2XBlerLookupTestCase::~NrV2XBlerLookupTestCase ()
+{
+}
+
+void
+NrV2XBlerLookupTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (5);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      double sinrDb = uniform->GetValue (-15, 25);
+      double speed = uniform->GetValue (0, 280);
+      bool los = uniform->GetValue () < 0.5;
+      double pssch = NrV2XPhyErrorModel::GetNrV2XPsschBler (4, std::pow (10.0, sinrDb / 10), los, m_scs, speed).tbler;
+      double pscch = NrV2XPhyErrorModel::GetNrV2XPscchBler (4, std::pow (10.0, sinrDb / 10), los, m_scs).tbler;
+      NS_TEST_ASSERT_MSG_EQ ((pssch >= 0 && pssch <= 1), true, "PSSCH BLER " << pssch << " at " << sinrDb << " dB");
+      NS_TEST_ASSERT_MSG_EQ ((pscch >= 0 && pscch <= 1), true, "PSCCH BLER " << pscch << " at " << sinrDb << " dB");
+      double betterPssch = NrV2XPhyErrorModel::GetNrV2XPsschBler (4, std::pow (10.0, (sinrDb + 3) / 10), los, m_scs, speed).tbler;
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (betterPssch, pssch, "The PSSCH BLER increases with the SINR at " << sinrDb << " dB");
+    }
+}
+
+
+/**
+ * Slot timing: SimulatorTimeToSubframe for the numerology index, checked
+ * against the floating point conversion with the slot duration
+ */
+class NrV2XSlotTimingTestCase : public TestCase
+{
+public:
+  NrV2XSlotTimingTestCase (uint16_t numerologyIndex);
+  virtual ~NrV2XSlotTimingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_numerologyIndex;
+};
+
+NrV2XSlotTimingTestCase::NrV2XSlotTimingTestCase (uint16_t numerologyIndex)
+  : TestCase ("Slot timing"),
+    m_numerologyIndex (numerologyIndex)
+{
+}
+
+NrV2XSlotTimingTestCase::~NrV2XSlotTimingTestCase ()
+{
+}
+
+void
+NrV2XSlotTimingTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (9);
+  double slotDuration = 1.0 / (1 << m_numerologyIndex);
+  NS_TEST_ASSERT_MSG_EQ (GetNumerologyIndex (slotDuration), m_numerologyIndex, "Unexpected numerology index");
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      // Slot boundaries and random instants up to 1000 s
+      Time t = i % 2 ? NanoSeconds (std::floor (uniform->GetValue (0, 1e12))) : MicroSeconds ((uint64_t) (1000 * slotDuration) * uniform->GetInteger (0, 1e6));
+
+      // Previous floating point conversion
+      uint64_t microseconds = t.GetMicroSeconds () + 11000*slotDuration + UL_PUSCH_TTIS_DELAY*slotDuration*1000;
+      uint64_t slots = microseconds / (1000*slotDuration);
+      uint32_t subframeNo = slots % 10;
+      uint32_t frameNo = (slots / 10) % 1024;
+      if (subframeNo == 0)
+        {
+          subframeNo = 10;
+          frameNo = frameNo == 0 ? 1023 : frameNo - 1;
+        }
+      if (frameNo == 0)
+        {
+          frameNo = 1024;
+        }
+      SidelinkCommResourcePool::SubframeInfo sf = SimulatorTimeToSubframe (t, m_numerologyIndex);
+      NS_TEST_ASSERT_MSG_EQ (sf.frameNo, frameNo, "Unexpected frame at " << t);
+      NS_TEST_ASSERT_MSG_EQ (sf.subframeNo, subframeNo, "Unexpected subframe at " << t);
+    }
+}
+
+
+/**
+ * SINR of the receptions ending in the same slot: the lazy evaluation of
+ * every signal at every receiver, sequential and on a worker pool. The two
+ * must give the same values, bit by bit
+ */
+class NrV2XParallelSinrTestCase : public TestCase
+{
+public:
+  NrV2XParallelSinrTestCase (uint32_t nReceivers, uint32_t nSignals, uint32_t nWorkers);
+  virtual ~NrV2XParallelSinrTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void StartReceptions (Time duration);
+  void EndReceptions (void);
+
+  uint32_t m_nReceivers;
+  uint32_t m_nSignals;
+  uint32_t m_nWorkers;
+  std::vector<Ptr<NistLteSlInterference> > m_interference;
+};
+
+NrV2XParallelSinrTestCase::NrV2XParallelSinrTestCase (uint32_t nReceivers, uint32_t nSignals, uint32_t nWorkers)
+  : TestCase ("Parallel SINR"),
+    m_nReceivers (nReceivers),
+    m_nSignals (nSignals),
+    m_nWorkers (nWorkers)
+{
+}
+
+NrV2XParallelSinrTestCase::~NrV2XParallelSinrTestCase ()
+{
+}
+
+void
+NrV2XParallelSinrTestCase::StartReceptions (Time duration)
+{
+  const uint16_t nRbs = 50;
+  const uint16_t subchannelSize = 10;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  NrV2XSpectrumValueHelper psdHelper;
+  Ptr<SpectrumValue> noise = psdHelper.CreateNoisePowerSpectralDensity (18100, nRbs, 9.0);
+  for (uint32_t r = 0; r < m_nReceivers; r++)
+    {
+      Ptr<NistLteSlInterference> interference = CreateObject<NistLteSlInterference> ();
+      interference->SetNoisePowerSpectralDensity (noise);
+      interference->SetLazySinrEvaluation (true);
+      for (uint32_t i = 0; i < m_nSignals; i++)
+        {
+          uint16_t length = uniform->GetInteger (1, nRbs / subchannelSize);
+          uint16_t first = uniform->GetInteger (0, nRbs / subchannelSize - length);
+          std::vector<int> activeRbs;
+          for (int rb = first * subchannelSize; rb < (first + length) * subchannelSize; rb++)
+            {
+              activeRbs.push_back (rb);
+            }
+          Ptr<SpectrumValue> psd = psdHelper.CreateTxPowerSpectralDensity (18100, nRbs, uniform->GetValue (-100, -60), activeRbs);
+          interference->StartRx (psd);
+          interference->AddSignal (psd, duration);
+        }
+      // Interferers ending before the receptions, so that there are several chunks
+      for (uint32_t i = 0; i < m_nSignals; i++)
+        {
+          std::vector<int> activeRbs;
+          for (int rb = 0; rb < nRbs; rb++)
+            {
+              activeRbs.push_back (rb);
+            }
+          Ptr<SpectrumValue> psd = psdHelper.CreateTxPowerSpectralDensity (18100, nRbs, uniform->GetValue (-110, -70), activeRbs);
+          interference->AddSignal (psd, MicroSeconds (uniform->GetInteger (1, duration.GetMicroSeconds () - 1)));
+        }
+      m_interference.push_back (interference);
+    }
+}
+
+void
+NrV2XParallelSinrTestCase::EndReceptions (void)
+{
+  for (uint32_t r = 0; r < m_nReceivers; r++)
+    {
+      m_interference[r]->PrepareSinrEvaluation ();
+    }
+
+  std::vector<SpectrumValue> sequential;
+  for (uint32_t r = 0; r < m_nReceivers; r++)
+    {
+      for (uint32_t i = 0; i < m_nSignals; i++)
+        {
+          sequential.push_back (m_interference[r]->EvaluateSinr (i));
+        }
+    }
+
+  NrV2XWorkerPool pool (m_nWorkers);
+  std::vector<std::vector<double> > parallel (m_nReceivers * m_nSignals);
+  const std::vector<Ptr<NistLteSlInterference> >& interference = m_interference;
+  uint32_t nSignals = m_nSignals;
+  pool.Run (parallel.size (), [&interference, &parallel, nSignals] (uint32_t i)
+  {
+    interference[i / nSignals]->EvaluateSinr (i % nSignals, parallel[i]);
+  });
+
+  for (uint32_t i = 0; i < parallel.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (std::equal (parallel[i].begin (), parallel[i].end (), sequential[i].ConstValuesBegin ()), true,
+                             "Different SINR of signal " << i % m_nSignals << " at receiver " << i / m_nSignals);
+    }
+  for (uint32_t r = 0; r < m_nReceivers; r++)
+    {
+      m_interference[r]->EndRx ();
+    }
+}
+
+void
+NrV2XParallelSinrTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (10);
+  Time duration = MicroSeconds (500);
+  Simulator::ScheduleNow (&NrV2XParallelSinrTestCase::StartReceptions, this, duration);
+  Simulator::Schedule (duration, &NrV2XParallelSinrTestCase::EndReceptions, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_interference.clear ();
+}
+
+
+/**
+ * Lazy SINR evaluation against the chunk processors: two interference
+ * models receive the same overlapping signals, with interferers starting
+ * and ending during the receptions. The SINR evaluated on demand must be
+ * the one reported by the SINR chunk processor, RB by RB
+ */
+class NrV2XLazySinrTestCase : public TestCase
+{
+public:
+  NrV2XLazySinrTestCase (uint32_t nSignals, uint32_t nInterferers);
+  virtual ~NrV2XLazySinrTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void StartReceptions (Time duration);
+  void AddInterferer (Ptr<SpectrumValue> psd, Time duration);
+  void EndReceptions (void);
+  void ReportSinr (std::vector<SpectrumValue> sinr);
+
+  uint32_t m_nSignals;
+  uint32_t m_nInterferers;
+  Ptr<NistLteSlInterference> m_lazy;
+  Ptr<NistLteSlInterference> m_chunks;
+  std::vector<SpectrumValue> m_reportedSinr;
+};
+
+NrV2XLazySinrTestCase::NrV2XLazySinrTestCase (uint32_t nSignals, uint32_t nInterferers)
+  : TestCase ("Lazy SINR"),
+    m_nSignals (nSignals),
+    m_nInterferers (nInterferers)
+{
+}
+
+NrV2XLazySinrTestCase::~NrV2XLazySinrTestCase ()
+{
+}
+
+void
+NrV2XLazySinrTestCase::ReportSinr (std::vector<SpectrumValue> sinr)
+{
+  m_reportedSinr = sinr;
+}
+
+void
+NrV2XLazySinrTestCase::AddInterferer (Ptr<SpectrumValue> psd, Time duration)
+{
+  m_lazy->AddSignal (psd, duration);
+  m_chunks->AddSignal (psd, duration);
+}
+
+void
+NrV2XLazySinrTestCase::StartReceptions (Time duration)
+{
+  const uint16_t nRbs = 50;
+  const uint16_t subchannelSize = 10;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  NrV2XSpectrumValueHelper psdHelper;
+  for (uint32_t i = 0; i < m_nSignals; i++)
+    {
+      uint16_t length = uniform->GetInteger (1, nRbs / subchannelSize);
+      uint16_t first = uniform->GetInteger (0, nRbs / subchannelSize - length);
+      std::vector<int> activeRbs;
+      for (int rb = first * subchannelSize; rb < (first + length) * subchannelSize; rb++)
+        {
+          activeRbs.push_back (rb);
+        }
+      Ptr<SpectrumValue> psd = psdHelper.CreateTxPowerSpectralDensity (18100, nRbs, uniform->GetValue (-100, -60), activeRbs);
+      m_lazy->StartRx (psd);
+      m_lazy->AddSignal (psd, duration);
+      m_chunks->StartRx (psd);
+      m_chunks->AddSignal (psd, duration);
+    }
+  // Interferers on part of the band, starting and ending at any time
+  for (uint32_t i = 0; i < m_nInterferers; i++)
+    {
+      std::vector<int> activeRbs;
+      for (int rb = uniform->GetInteger (0, nRbs / 2); rb < nRbs; rb++)
+        {
+          activeRbs.push_back (rb);
+        }
+      Ptr<SpectrumValue> psd = psdHelper.CreateTxPowerSpectralDensity (18100, nRbs, uniform->GetValue (-110, -70), activeRbs);
+      Time start = MicroSeconds (uniform->GetInteger (0, duration.GetMicroSeconds () - 1));
+      Time length = MicroSeconds (uniform->GetInteger (1, 2 * duration.GetMicroSeconds ()));
+      Simulator::Schedule (start, &NrV2XLazySinrTestCase::AddInterferer, this, psd, length);
+    }
+}
+
+void
+NrV2XLazySinrTestCase::EndReceptions (void)
+{
+  m_lazy->PrepareSinrEvaluation ();
+  NS_TEST_ASSERT_MSG_EQ (m_lazy->GetNSignals (), m_nSignals, "Unexpected number of signals");
+  std::vector<SpectrumValue> lazySinr;
+  for (uint32_t i = 0; i < m_nSignals; i++)
+    {
+      lazySinr.push_back (m_lazy->EvaluateSinr (i));
+    }
+  m_lazy->EndRx ();
+  m_chunks->EndRx ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_reportedSinr.size (), m_nSignals, "The SINR chunk processor did not report every signal");
+  for (uint32_t i = 0; i < m_nSignals; i++)
+    {
+      Values::const_iterator reported = m_reportedSinr[i].ConstValuesBegin ();
+      uint32_t rb = 0;
+      for (Values::const_iterator it = lazySinr[i].ConstValuesBegin (); it != lazySinr[i].ConstValuesEnd (); ++it, ++reported, ++rb)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (*it, *reported, 1e-9 * std::max (1.0, std::abs (*reported)),
+                                     "Different SINR of signal " << i << " on RB " << rb);
+        }
+    }
+}
+
+void
+NrV2XLazySinrTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (14);
+  NrV2XSpectrumValueHelper psdHelper;
+  Ptr<SpectrumValue> noise = psdHelper.CreateNoisePowerSpectralDensity (18100, 50, 9.0);
+  m_lazy = CreateObject<NistLteSlInterference> ();
+  m_lazy->SetNoisePowerSpectralDensity (noise);
+  m_lazy->SetLazySinrEvaluation (true);
+  m_chunks = CreateObject<NistLteSlInterference> ();
+  m_chunks->SetNoisePowerSpectralDensity (noise);
+  m_chunks->SetLazySinrEvaluation (false);
+  Ptr<NistLteSlChunkProcessor> sinrProcessor = Create<NistLteSlChunkProcessor> ();
+  sinrProcessor->AddCallback (MakeCallback (&NrV2XLazySinrTestCase::ReportSinr, this));
+  m_chunks->AddSinrChunkProcessor (sinrProcessor);
+
+  Time duration = MicroSeconds (500);
+  Simulator::ScheduleNow (&NrV2XLazySinrTestCase::StartReceptions, this, duration);
+  Simulator::Schedule (duration, &NrV2XLazySinrTestCase::EndReceptions, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_lazy = 0;
+  m_chunks = 0;
+}
+
+/**
+ * Duplicate detection of LTENodeState: every neighbour broadcasts at a fixed
+ * rate, and every packet is received twice (blind retransmission). The
+ * second copy is a duplicate, and the number of remembered packets must not
+ * grow with the simulated time
+ */
+class NrV2XDuplicateDetectionTestCase : public TestCase
+{
+public:
+  NrV2XDuplicateDetectionTestCase (uint32_t nSources, double simTime);
+  virtual ~NrV2XDuplicateDetectionTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void Receive (uint32_t source, uint32_t packetId);
+
+  uint32_t m_nSources;
+  double m_simTime; // (s)
+  Ptr<LTENodeState> m_nodeState;
+  uint64_t m_receptions;
+  uint64_t m_duplicates;
+  uint32_t m_maxRemembered;
+};
+
+NrV2XDuplicateDetectionTestCase::NrV2XDuplicateDetectionTestCase (uint32_t nSources, double simTime)
+  : TestCase ("Duplicate detection"),
+    m_nSources (nSources),
+    m_simTime (simTime)
+{
+}
+
+NrV2XDuplicateDetectionTestCase::~NrV2XDuplicateDetectionTestCase ()
+{
+}
+
+void
+NrV2XDuplicateDetectionTestCase::Receive (uint32_t source, uint32_t packetId)
+{
+  for (uint32_t copy = 0; copy < 2; copy++)
+    {
+      m_receptions++;
+      if (m_nodeState->HasReceivedPacket (source, packetId))
+        {
+          m_duplicates++;
+        }
+      else
+        {
+          m_nodeState->AddNewReceivedPacket (source, packetId);
+        }
+    }
+  m_maxRemembered = std::max (m_maxRemembered, m_nodeState->GetNReceivedPackets ());
+}
+
+void
+NrV2XDuplicateDetectionTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (11);
+  const double period = 0.1; // 10 Hz
+  m_nodeState = CreateObject<LTENodeState> ();
+  m_receptions = 0;
+  m_duplicates = 0;
+  m_maxRemembered = 0;
+
+  // Packet IDs are shared by all the sources, as the IDs of the tags
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uint32_t packetId = 0;
+  for (uint32_t source = 0; source < m_nSources; source++)
+    {
+      double offset = uniform->GetValue (0, period);
+      for (double t = offset; t < m_simTime; t += period)
+        {
+          Simulator::Schedule (Seconds (t), &NrV2XDuplicateDetectionTestCase::Receive, this, source, packetId++);
+        }
+    }
+  Simulator::Run ();
+
+  TimeValue window;
+  m_nodeState->GetAttribute ("DuplicateWindow", window);
+  NS_TEST_ASSERT_MSG_EQ (m_duplicates * 2, m_receptions, "Every second copy is a duplicate");
+  NS_TEST_ASSERT_MSG_EQ ((m_maxRemembered <= m_nSources * (window.Get ().GetSeconds () / period + 2)), true,
+                         "The received packets are not forgotten: " << m_maxRemembered);
+  NS_TEST_ASSERT_MSG_EQ (m_nodeState->HasReceivedPacket (0, 0), false, "The first packet is still remembered");
+
+  Simulator::Destroy ();
+  m_nodeState = 0;
+}
+
+
+/**
+ * Sidelink HARQ state of NistLteHarqPhy: new data, retransmissions and
+ * lookups of random (transmitter, destination) processes, as done by
+ * EndRxV2XSlData. Checked against a list per process capped at 3
+ * transmissions
+ */
+class NrV2XSlHarqStateTestCase : public TestCase
+{
+public:
+  NrV2XSlHarqStateTestCase (uint32_t nTransmitters, uint32_t operations);
+  virtual ~NrV2XSlHarqStateTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nTransmitters;
+  uint32_t m_operations;
+};
+
+NrV2XSlHarqStateTestCase::NrV2XSlHarqStateTestCase (uint32_t nTransmitters, uint32_t operations)
+  : TestCase ("Sidelink HARQ state"),
+    m_nTransmitters (nTransmitters),
+    m_operations (operations)
+{
+}
+
+NrV2XSlHarqStateTestCase::~NrV2XSlHarqStateTestCase ()
+{
+}
+
+void
+NrV2XSlHarqStateTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (12);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  Ptr<NistLteHarqPhy> harq = Create<NistLteHarqPhy> ();
+  std::map<std::pair<uint16_t, uint8_t>, std::vector<double> > reference;
+  for (uint32_t i = 0; i < m_operations; i++)
+    {
+      double u = uniform->GetValue ();
+      uint16_t rnti = uniform->GetInteger (1, m_nTransmitters);
+      uint8_t l1dst = uniform->GetInteger (0, 3);
+      double sinr = uniform->GetValue (0, 100);
+      std::vector<double>& process = reference[std::make_pair (rnti, l1dst)];
+      if (u < 0.2)
+        {
+          harq->ResetSlHarqProcessNistStatus (rnti, l1dst);
+          process.clear ();
+        }
+      else if (u < 0.5)
+        {
+          harq->UpdateSlHarqProcessNistStatus (rnti, l1dst, sinr);
+          if (process.size () < 3)
+            {
+              process.push_back (sinr);
+            }
+        }
+      else
+        {
+          const NistSlHarqProcessInfo_t& info = harq->GetSlHarqProcessInfo (rnti, l1dst);
+          NS_TEST_ASSERT_MSG_EQ (info.size (), process.size (), "Unexpected number of HARQ transmissions");
+          if (!process.empty ())
+            {
+              NS_TEST_ASSERT_MSG_EQ (info.at (info.size () - 1).m_sinr, process.back (), "Unexpected HARQ SINR");
+            }
+          NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoSl (rnti, l1dst).size (), info.size (), "The copy and the process differ");
+        }
+    }
+}
+
+
+/**
+ * Per-link state of the channel model, as read by EndRxV2XSlData: the
+ * vehicles change their velocity at random times and the relative speed
+ * given by the channel model must match the one of the mobility models at
+ * any time
+ */
+class NrV2XLinkStateTestCase : public TestCase
+{
+public:
+  NrV2XLinkStateTestCase (uint32_t nNodes);
+  virtual ~NrV2XLinkStateTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void ChangeCourse (Ptr<ConstantVelocityMobilityModel> mobility, Vector velocity);
+  void CheckLinks (void);
+
+  uint32_t m_nNodes;
+  NodeContainer m_nodes;
+  Ptr<NrV2XPropagationLossModel> m_lossModel;
+  uint32_t m_checkedLinks;
+  uint32_t m_wrongLinks;
+};
+
+NrV2XLinkStateTestCase::NrV2XLinkStateTestCase (uint32_t nNodes)
+  : TestCase ("Link state"),
+    m_nNodes (nNodes),
+    m_checkedLinks (0),
+    m_wrongLinks (0)
+{
+}
+
+NrV2XLinkStateTestCase::~NrV2XLinkStateTestCase ()
+{
+}
+
+void
+NrV2XLinkStateTestCase::ChangeCourse (Ptr<ConstantVelocityMobilityModel> mobility, Vector velocity)
+{
+  mobility->SetVelocity (velocity);
+}
+
+void
+NrV2XLinkStateTestCase::CheckLinks (void)
+{
+  for (NodeContainer::Iterator tx = m_nodes.Begin (); tx != m_nodes.End (); ++tx)
+    {
+      Ptr<MobilityModel> mobTX = (*tx)->GetObject<MobilityModel> ();
+      for (NodeContainer::Iterator rx = m_nodes.Begin (); rx != m_nodes.End (); ++rx)
+        {
+          if (tx == rx)
+            {
+              continue;
+            }
+          double speed = m_lossModel->GetRelativeSpeed ((*tx)->GetId (), (*rx)->GetId ());
+          if (speed != mobTX->GetRelativeSpeed ((*rx)->GetObject<MobilityModel> ()) * 3.6)
+            {
+              m_wrongLinks++;
+            }
+          m_checkedLinks++;
+        }
+    }
+}
+
+void
+NrV2XLinkStateTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (13);
+  m_nodes.Create (m_nNodes);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  for (NodeContainer::Iterator it = m_nodes.Begin (); it != m_nodes.End (); ++it)
+    {
+      Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel> ();
+      mobility->SetPosition (Vector (uniform->GetValue (0, 2000), uniform->GetValue (0, 6 * 4), 1.5));
+      mobility->SetVelocity (Vector (uniform->GetValue (-40, 40), 0, 0));
+      (*it)->AggregateObject (mobility);
+    }
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  m_lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  m_lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+  m_lossModel->InitChannelMatrix (m_nodes);
+
+  // Course changes between the channel updates, and checks in between
+  for (NodeContainer::Iterator it = m_nodes.Begin (); it != m_nodes.End (); ++it)
+    {
+      Simulator::Schedule (MilliSeconds (uniform->GetInteger (1, 249)), &NrV2XLinkStateTestCase::ChangeCourse, this,
+                           (*it)->GetObject<ConstantVelocityMobilityModel> (), Vector (uniform->GetValue (-40, 40), uniform->GetValue (-1, 1), 0));
+    }
+  for (uint32_t ms = 25; ms < 250; ms += 50)
+    {
+      Simulator::Schedule (MilliSeconds (ms), &NrV2XLinkStateTestCase::CheckLinks, this);
+    }
+  Simulator::Stop (MilliSeconds (250));
+  Simulator::Run ();
+
+  CheckLinks ();
+  NS_TEST_ASSERT_MSG_EQ (m_checkedLinks, 6 * m_nNodes * (m_nNodes - 1), "Unexpected number of checked links");
+  NS_TEST_ASSERT_MSG_EQ (m_wrongLinks, 0, "Relative speed differs from the mobility models");
+
+  m_lossModel->Dispose ();
+  m_lossModel = 0;
+  m_nodes = NodeContainer ();
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Links retired during a reception: a receiving PHY gets a PSSCH from a
+ * vehicle, then the transmitter (first round) or the receiver itself (second
+ * round) leaves the scenario before EndRxV2XSlData. The reception must still
+ * complete, without the channel model of the removed link
+ */
+class NrV2XRetiredLinkRxTestCase : public TestCase
+{
+public:
+  NrV2XRetiredLinkRxTestCase (uint16_t nRbs);
+  virtual ~NrV2XRetiredLinkRxTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void StartRx (void);
+  void SlPhyReception (NistPhyReceptionStatParameters params);
+
+  uint16_t m_nRbs;
+  NodeContainer m_nodes;
+  Ptr<NrV2XPropagationLossModel> m_lossModel;
+  Ptr<NrV2XSpectrumPhy> m_phy;
+  uint32_t m_receptions;
+  uint32_t m_linksFound;
+};
+
+NrV2XRetiredLinkRxTestCase::NrV2XRetiredLinkRxTestCase (uint16_t nRbs)
+  : TestCase ("Links retired during a reception"),
+    m_nRbs (nRbs),
+    m_receptions (0),
+    m_linksFound (0)
+{
+}
+
+NrV2XRetiredLinkRxTestCase::~NrV2XRetiredLinkRxTestCase ()
+{
+}
+
+void
+NrV2XRetiredLinkRxTestCase::StartRx (void)
+{
+  uint32_t txId = m_nodes.Get (0)->GetId ();
+  std::vector<int> activeRbs;
+  for (int rb = 0; rb < 10; rb++)
+    {
+      activeRbs.push_back (rb);
+    }
+  NistV2XSciListElement_s sci;
+  sci.m_rnti = txId;
+  sci.m_rbStartPssch = 0;
+  sci.m_rbLenPssch = 10;
+  sci.m_rbLenPssch_TB = 10;
+  sci.m_tbSize = 300;
+  sci.m_mcs = 10;
+  sci.m_groupDstId = 1;
+  sci.m_reTxIndex = 0;
+  sci.m_packetID = m_receptions;
+  sci.m_genTime = Simulator::Now ().GetSeconds ();
+  sci.m_selectionTrigger = 0;
+  sci.m_TxIndex = 1;
+  sci.m_announcedTB = false;
+  Ptr<SciV2XLteControlMessage> msg = Create<SciV2XLteControlMessage> ();
+  msg->SetSci (sci);
+  Ptr<Packet> packet = Create<Packet> (300);
+  packet->AddPacketTag (NistLteRadioBearerTag (txId, 1, txId, 1));
+  Ptr<PacketBurst> burst = CreateObject<PacketBurst> ();
+  burst->AddPacket (packet);
+
+  Ptr<NistLteSpectrumSignalParametersV2XSlFrame> params = Create<NistLteSpectrumSignalParametersV2XSlFrame> ();
+  params->duration = MicroSeconds (900);
+  params->psd = NrV2XSpectrumValueHelper::CreateTxPowerSpectralDensity (18100, m_nRbs, -60, activeRbs);
+  params->nodeId = txId;
+  params->groupId = 0;
+  params->slssId = 0;
+  params->packetBurst = burst;
+  params->ctrlMsgList.push_back (msg);
+  m_phy->StartRx (params);
+}
+
+void
+NrV2XRetiredLinkRxTestCase::SlPhyReception (NistPhyReceptionStatParameters params)
+{
+  m_receptions++;
+  if (m_lossModel->GetChannelModel (m_nodes.Get (0)->GetId (), m_nodes.Get (1)->GetId ()) != 0)
+    {
+      m_linksFound++;
+    }
+}
+
+void
+NrV2XRetiredLinkRxTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (19);
+  m_nodes.Create (2);
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel> ();
+      mobility->SetPosition (Vector (100.0 + i * 50.0, 0.0, 1.5));
+      mobility->SetVelocity (Vector (i == 0 ? 30.0 : 20.0, 0.0, 0.0));
+      m_nodes.Get (i)->AggregateObject (mobility);
+    }
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  m_nodes.Get (1)->AddDevice (device);
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  m_lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  m_lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+  m_lossModel->InitChannelMatrix (m_nodes);
+
+  m_phy = CreateObject<NrV2XSpectrumPhy> ();
+  m_phy->SetDevice (device);
+  m_phy->SetMobility (m_nodes.Get (1)->GetObject<MobilityModel> ());
+  m_phy->SetAttribute ("ChannelMatrix", PointerValue (m_lossModel));
+  m_phy->SetAttribute ("RBsBandwidth", UintegerValue (m_nRbs));
+  m_phy->SetAttribute ("MeasurementSink", BooleanValue (true)); // No MAC to deliver the TBs to
+  m_phy->SetHarqPhyModule (Create<NistLteHarqPhy> ());
+  m_phy->SetNoisePowerSpectralDensity (NrV2XSpectrumValueHelper::CreateNoisePowerSpectralDensity (18100, m_nRbs, 9.0));
+  m_phy->TraceConnectWithoutContext ("SlPhyReception", MakeCallback (&NrV2XRetiredLinkRxTestCase::SlPhyReception, this));
+
+  // The transmitter leaves halfway through the first reception
+  Simulator::Schedule (MilliSeconds (1), &NrV2XRetiredLinkRxTestCase::StartRx, this);
+  Simulator::Schedule (MicroSeconds (1450), &NrV2XPropagationLossModel::RetireNode, m_lossModel, m_nodes.Get (0)->GetId ());
+  // and comes back, then the receiver leaves halfway through the second one
+  Simulator::Schedule (MilliSeconds (2), &NrV2XPropagationLossModel::ActivateNode, m_lossModel, m_nodes.Get (0)->GetId ());
+  Simulator::Schedule (MilliSeconds (3), &NrV2XRetiredLinkRxTestCase::StartRx, this);
+  Simulator::Schedule (MicroSeconds (3450), &NrV2XPropagationLossModel::RetireNode, m_lossModel, m_nodes.Get (1)->GetId ());
+  Simulator::Stop (MilliSeconds (5));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_receptions, 2, "A reception of a retired link did not complete");
+  NS_TEST_ASSERT_MSG_EQ (m_linksFound, 0, "The link was not retired at the end of the reception");
+  NS_TEST_ASSERT_MSG_EQ (m_phy->GetState (), NrV2XSpectrumPhy::IDLE, "The PHY is still receiving");
+
+  m_phy->Dispose ();
+  m_phy = 0;
+  m_lossModel->Dispose ();
+  m_lossModel = 0;
+  m_nodes = NodeContainer ();
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  NrV2XPropagationLossModel::s_retiredNodes.clear ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Building queries of the urban loss model: point-in-building and
+ * segment-crosses-building on a Manhattan grid of N x N blocks of 80 m
+ * separated by 20 m wide streets, through NrV2XBuildingIndex and by a scan
+ * of BuildingList. Also checks the LOS state of the urban loss model
+ */
+class NrV2XBuildingIndexTestCase : public TestCase
+{
+public:
+  NrV2XBuildingIndexTestCase (uint32_t nBlocks, uint32_t queries);
+  virtual ~NrV2XBuildingIndexTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nBlocks;
+  uint32_t m_queries;
+};
+
+NrV2XBuildingIndexTestCase::NrV2XBuildingIndexTestCase (uint32_t nBlocks, uint32_t queries)
+  : TestCase ("Building index"),
+    m_nBlocks (nBlocks),
+    m_queries (queries)
+{
+}
+
+NrV2XBuildingIndexTestCase::~NrV2XBuildingIndexTestCase ()
+{
+}
+
+void
+NrV2XBuildingIndexTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (14);
+  for (uint32_t x = 0; x < m_nBlocks; x++)
+    {
+      for (uint32_t y = 0; y < m_nBlocks; y++)
+        {
+          Ptr<Building> building = CreateObject<Building> ();
+          building->SetBoundaries (Box (x * 100.0, x * 100.0 + 80, y * 100.0, y * 100.0 + 80, 0, 20));
+        }
+    }
+  NrV2XBuildingIndex index;
+  index.Build (50);
+
+  double side = m_nBlocks * 100.0;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uint32_t nLos = 0;
+  for (uint32_t i = 0; i < m_queries; i++)
+    {
+      Vector a (uniform->GetValue (-50, side + 50), uniform->GetValue (-50, side + 50), 1.5);
+      Vector b (a.x + uniform->GetValue (-300, 300), a.y + uniform->GetValue (-300, 300), 1.5);
+      uint32_t scanInside = std::numeric_limits<uint32_t>::max ();
+      bool scanLos = true;
+      for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+        {
+          if ((*bit)->IsInside (a))
+            {
+              scanInside = (*bit)->GetId ();
+            }
+          if (scanLos && NrV2XBuildingIndex::Intersects ((*bit)->GetBoundaries (), a, b))
+            {
+              scanLos = false;
+            }
+        }
+      Ptr<Building> building = index.GetBuilding (a);
+      bool indexLos = index.IsLineOfSight (a, b);
+      NS_TEST_ASSERT_MSG_EQ ((building != 0 ? building->GetId () : std::numeric_limits<uint32_t>::max ()), scanInside, "Unexpected building of point " << a);
+      NS_TEST_ASSERT_MSG_EQ (indexLos, scanLos, "Unexpected LOS state from " << a << " to " << b);
+      nLos += indexLos;
+    }
+  NS_TEST_ASSERT_MSG_GT (nLos, 0, "No LOS segment");
+  NS_TEST_ASSERT_MSG_LT (nLos, m_queries, "No NLOS segment");
+
+  // Along a street and across a block, at the same distance
+  Ptr<NrV2XUrbanPropagationLossModel> lossModel = CreateObject<NrV2XUrbanPropagationLossModel> ();
+  NodeContainer nodes;
+  nodes.Create (3);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+  Ptr<MobilityModel> a = nodes.Get (0)->GetObject<MobilityModel> ();
+  Ptr<MobilityModel> b = nodes.Get (1)->GetObject<MobilityModel> ();
+  Ptr<MobilityModel> c = nodes.Get (2)->GetObject<MobilityModel> ();
+  a->SetPosition (Vector (90, 10, 1.5));
+  b->SetPosition (Vector (90, 210, 1.5));
+  c->SetPosition (Vector (290, 10, 1.5));
+  NS_TEST_ASSERT_MSG_EQ (lossModel->IsLineOfSight (a, b), true, "Street link not in LOS");
+  NS_TEST_ASSERT_MSG_EQ (lossModel->IsLineOfSight (b, c), false, "Link across a block in LOS");
+  NS_TEST_ASSERT_MSG_GT (lossModel->GetLoss (b, c), lossModel->GetLoss (a, b) + 10, "NLOS loss not above the LOS one");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Link state of the urban loss model: N vehicles driving along the streets
+ * of a Manhattan grid, where every vehicle transmits to all the others every
+ * 100 ms, as the spectrum channel evaluates the links. The loss does not
+ * depend on the direction of the link without fast fading. After 1 s only
+ * half of the vehicles keep transmitting, and the links of the others must
+ * expire
+ */
+class NrV2XUrbanLinkStateTestCase : public TestCase
+{
+public:
+  NrV2XUrbanLinkStateTestCase (uint32_t nVehicles, bool nakagami);
+  virtual ~NrV2XUrbanLinkStateTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void Transmit (uint32_t nActive);
+
+  uint32_t m_nVehicles;
+  bool m_nakagami;
+  NodeContainer m_nodes;
+  Ptr<NrV2XUrbanPropagationLossModel> m_lossModel;
+  uint32_t m_asymmetricLinks;
+  uint32_t m_maxLinks;
+};
+
+NrV2XUrbanLinkStateTestCase::NrV2XUrbanLinkStateTestCase (uint32_t nVehicles, bool nakagami)
+  : TestCase ("Urban link state"),
+    m_nVehicles (nVehicles),
+    m_nakagami (nakagami),
+    m_asymmetricLinks (0),
+    m_maxLinks (0)
+{
+}
+
+NrV2XUrbanLinkStateTestCase::~NrV2XUrbanLinkStateTestCase ()
+{
+}
+
+void
+NrV2XUrbanLinkStateTestCase::Transmit (uint32_t nActive)
+{
+  for (uint32_t tx = 0; tx < nActive; tx++)
+    {
+      Ptr<MobilityModel> txMobility = m_nodes.Get (tx)->GetObject<MobilityModel> ();
+      for (uint32_t rx = 0; rx < nActive; rx++)
+        {
+          if (rx == tx)
+            {
+              continue;
+            }
+          Ptr<MobilityModel> rxMobility = m_nodes.Get (rx)->GetObject<MobilityModel> ();
+          double rxPower = m_lossModel->CalcRxPower (23, txMobility, rxMobility);
+          if (!m_nakagami && rxPower != m_lossModel->CalcRxPower (23, rxMobility, txMobility))
+            {
+              m_asymmetricLinks++;
+            }
+        }
+    }
+  m_maxLinks = std::max (m_maxLinks, m_lossModel->GetNChannelModels ());
+}
+
+void
+NrV2XUrbanLinkStateTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (15);
+  for (uint32_t x = 0; x < 10; x++)
+    {
+      for (uint32_t y = 0; y < 10; y++)
+        {
+          Ptr<Building> building = CreateObject<Building> ();
+          building->SetBoundaries (Box (x * 100.0, x * 100.0 + 80, y * 100.0, y * 100.0 + 80, 0, 20));
+        }
+    }
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  m_nodes.Create (m_nVehicles);
+  for (NodeContainer::Iterator it = m_nodes.Begin (); it != m_nodes.End (); ++it)
+    {
+      // Along the vertical streets, between the columns of blocks
+      Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel> ();
+      mobility->SetPosition (Vector (uniform->GetInteger (0, 9) * 100.0 + 90, uniform->GetValue (0, 1000), 1.5));
+      mobility->SetVelocity (Vector (0, uniform->GetValue () < 0.5 ? -14 : 14, 0));
+      (*it)->AggregateObject (mobility);
+    }
+  m_lossModel = CreateObject<NrV2XUrbanPropagationLossModel> ();
+  m_lossModel->SetAttribute ("NakagamiFading", BooleanValue (m_nakagami));
+
+  for (uint32_t ms = 0; ms < 3500; ms += 100)
+    {
+      Simulator::Schedule (MilliSeconds (ms), &NrV2XUrbanLinkStateTestCase::Transmit, this, ms < 1000 ? m_nVehicles : m_nVehicles / 2);
+    }
+  Simulator::Stop (MilliSeconds (3500));
+  Simulator::Run ();
+
+  uint32_t nActive = m_nVehicles / 2;
+  NS_TEST_ASSERT_MSG_EQ (m_asymmetricLinks, 0, "The loss of a link depends on its direction");
+  NS_TEST_ASSERT_MSG_EQ (m_maxLinks, m_nVehicles * (m_nVehicles - 1) / 2, "Unexpected number of links");
+  NS_TEST_ASSERT_MSG_EQ (m_lossModel->GetNChannelModels (), nActive * (nActive - 1) / 2, "The links not evaluated did not expire");
+
+  m_lossModel = 0;
+  m_nodes = NodeContainer ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Offline Mode 2 selection replay: the inputs captured as V2XSelectResources
+ * records them are written, read back and replayed by a MAC without sensing
+ * history, which must reach the recorded outcome
+ */
+class NrV2XSelectionReplayTestCase : public TestCase
+{
+public:
+  NrV2XSelectionReplayTestCase (double pdb, uint32_t nSelections);
+  virtual ~NrV2XSelectionReplayTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  double m_pdb;
+  uint32_t m_nSelections;
+};
+
+NrV2XSelectionReplayTestCase::NrV2XSelectionReplayTestCase (double pdb, uint32_t nSelections)
+  : TestCase ("Selection replay"),
+    m_pdb (pdb),
+    m_nSelections (nSelections)
+{
+}
+
+NrV2XSelectionReplayTestCase::~NrV2XSelectionReplayTestCase ()
+{
+}
+
+void
+NrV2XSelectionReplayTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (16);
+  const uint16_t subchannelSize = 10;
+  const uint16_t nSubCh = 5;
+  const uint16_t lSubCh = 1;
+  std::vector<uint16_t> rriList = {20, 50, 100, 200, 500, 1000};
+
+  Ptr<NrV2XUeMac> mac = NrV2XTestAccess::CreateMode2Mac (subchannelSize, rriList);
+
+  // Current slot SF(600,5): sense the reservations of the previous second, and a few past transmissions
+  SidelinkCommResourcePool::SubframeInfo currentSF;
+  currentSF.frameNo = 600;
+  currentSF.subframeNo = 5;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  NrV2XTestAccess::FillSensingDatabase (mac, currentSF, uniform, rriList, subchannelSize, nSubCh, lSubCh, 0.3, true);
+  NrV2XTestAccess::AddPastTransmissions (mac, currentSF);
+
+  // Record the selections as V2XSelectResources does
+  std::stringstream recording;
+  for (uint32_t i = 0; i < m_nSelections; i++)
+    {
+      NrV2XTestAccess::V2XSidelinkGrant grant;
+      grant.m_RRI = std::max<uint16_t> (rriList[i % rriList.size ()], 100);
+      grant.m_Cresel = uniform->GetInteger (5, 15);
+      double T_2 = m_pdb - 1.0;
+      NrV2XUeMac::SelectionInputs inputs = NrV2XTestAccess::CaptureSelectionInputs (mac, currentSF, grant, m_pdb, nSubCh, lSubCh);
+      NrV2XUeMac::SelectionOutcome outcome;
+      outcome.iterations = 0;
+      outcome.rsrpThreshold = -128;
+      std::map<uint16_t,std::list<SidelinkCommResourcePool::SubframeInfo> > Sa, L1;
+      Sa = NrV2XTestAccess::SelectionWindow (mac, currentSF, T_2, nSubCh - lSubCh + 1);
+      outcome.nCSRinitial = ComputeResidualCSRs (Sa);
+      L1 = NrV2XTestAccess::Mode2Step1 (mac, Sa, currentSF, grant, T_2, nSubCh, lSubCh, &outcome.iterations, &outcome.rsrpThreshold, &outcome.nCSRpastTx, false);
+      outcome.nCSRfinal = ComputeResidualCSRs (L1);
+      NrV2XUeMac::WriteSelectionInputs (recording, inputs, outcome);
+    }
+  mac->Dispose ();
+
+  std::vector<NrV2XUeMac::SelectionInputs> selections;
+  std::vector<NrV2XUeMac::SelectionOutcome> recorded;
+  NrV2XUeMac::SelectionInputs inputs;
+  NrV2XUeMac::SelectionOutcome outcome;
+  while (NrV2XUeMac::ReadSelectionInputs (recording, &inputs, &outcome))
+    {
+      selections.push_back (inputs);
+      recorded.push_back (outcome);
+    }
+  NS_TEST_ASSERT_MSG_EQ (selections.size (), m_nSelections, "Selections lost in the recording");
+
+  Ptr<NrV2XUeMac> replay = CreateObject<NrV2XUeMac> ();
+  for (uint32_t i = 0; i < selections.size (); i++)
+    {
+      outcome = replay->ReplaySelection (selections[i]);
+      NS_TEST_ASSERT_MSG_EQ (outcome.iterations, recorded[i].iterations, "Replayed selection " << i << ": different RSRP threshold increases");
+      NS_TEST_ASSERT_MSG_EQ (outcome.rsrpThreshold, recorded[i].rsrpThreshold, "Replayed selection " << i << ": different RSRP threshold");
+      NS_TEST_ASSERT_MSG_EQ (outcome.nCSRinitial, recorded[i].nCSRinitial, "Replayed selection " << i << ": different selection window");
+      NS_TEST_ASSERT_MSG_EQ (outcome.nCSRpastTx, recorded[i].nCSRpastTx, "Replayed selection " << i << ": different candidates after the past transmissions");
+      NS_TEST_ASSERT_MSG_EQ (outcome.nCSRfinal, recorded[i].nCSRfinal, "Replayed selection " << i << ": different candidates");
+    }
+  NS_TEST_ASSERT_MSG_GT (recorded.back ().nCSRfinal, 0, "The selection left no candidate resource");
+  replay->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Uplink classification of UDP packets among a default bearer and bearers
+ * for ranges of remote ports and a DSCP. The flows cached by
+ * NistEpcTftClassifier are checked against a scan of the TFTs with the
+ * deserialized headers, and must be forgotten when a TFT is added
+ */
+class NrV2XTftClassifierTestCase : public TestCase
+{
+public:
+  NrV2XTftClassifierTestCase (uint32_t nFlows, uint32_t nPackets);
+  virtual ~NrV2XTftClassifierTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nFlows;
+  uint32_t m_nPackets;
+};
+
+NrV2XTftClassifierTestCase::NrV2XTftClassifierTestCase (uint32_t nFlows, uint32_t nPackets)
+  : TestCase ("TFT classifier"),
+    m_nFlows (nFlows),
+    m_nPackets (nPackets)
+{
+}
+
+NrV2XTftClassifierTestCase::~NrV2XTftClassifierTestCase ()
+{
+}
+
+void
+NrV2XTftClassifierTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (17);
+  const uint32_t nTfts = 6;
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+
+  // The default bearer, then bearers for ranges of remote ports and a DSCP
+  std::map<uint32_t, Ptr<NistEpcTft> > tfts;
+  tfts[1] = NistEpcTft::Default ();
+  for (uint32_t id = 2; id <= nTfts; id++)
+    {
+      Ptr<NistEpcTft> tft = Create<NistEpcTft> ();
+      NistEpcTft::NistPacketFilter filter;
+      filter.direction = (id % 2) ? NistEpcTft::BIDIRECTIONAL : NistEpcTft::UPLINK;
+      filter.remotePortStart = 5000 + id * 100;
+      filter.remotePortEnd = 5000 + id * 100 + 49;
+      if (id == nTfts)
+        {
+          filter.typeOfService = 0xb8;
+          filter.typeOfServiceMask = 0xfc;
+        }
+      tft->Add (filter);
+      tfts[id] = tft;
+    }
+  NistEpcTftClassifier classifier;
+  for (std::map<uint32_t, Ptr<NistEpcTft> >::iterator it = tfts.begin (); it != tfts.end (); it++)
+    {
+      classifier.Add (it->second, it->first);
+    }
+
+  std::vector<Ptr<Packet> > flows;
+  for (uint32_t i = 0; i < m_nFlows; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (uniform->GetInteger (50, 300));
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (uniform->GetInteger (49152, 65535));
+      udpHeader.SetDestinationPort (uniform->GetInteger (5000, 5000 + (nTfts + 1) * 100));
+      p->AddHeader (udpHeader);
+      Ipv4Header ipv4Header;
+      ipv4Header.SetSource (Ipv4Address ("7.0.0.2"));
+      ipv4Header.SetDestination (Ipv4Address (0x0a000000 + uniform->GetInteger (1, 1000)));
+      ipv4Header.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+      ipv4Header.SetTos (uniform->GetValue () < 0.5 ? 0xb8 : 0);
+      ipv4Header.SetPayloadSize (p->GetSize ());
+      p->AddHeader (ipv4Header);
+      flows.push_back (p);
+    }
+
+  // Reference: deserialize the headers of every packet and scan the TFTs, as the classifier used to
+  std::set<uint32_t> matched;
+  uint32_t first = 0;
+  for (uint32_t i = 0; i < m_nPackets; i++)
+    {
+      uint32_t flow = uniform->GetInteger (0, m_nFlows - 1);
+      first = i == 0 ? flow : first;
+      Ptr<Packet> pCopy = flows[flow]->Copy ();
+      Ipv4Header ipv4Header;
+      pCopy->RemoveHeader (ipv4Header);
+      UdpHeader udpHeader;
+      pCopy->RemoveHeader (udpHeader);
+      uint32_t expected = 0;
+      for (std::map<uint32_t, Ptr<NistEpcTft> >::reverse_iterator it = tfts.rbegin (); it != tfts.rend (); it++)
+        {
+          if (it->second->Matches (NistEpcTft::UPLINK, ipv4Header.GetDestination (), ipv4Header.GetSource (),
+                                   udpHeader.GetDestinationPort (), udpHeader.GetSourcePort (), ipv4Header.GetTos ()))
+            {
+              expected = it->first;
+              break;
+            }
+        }
+      uint32_t id = classifier.Classify (flows[flow], NistEpcTft::UPLINK);
+      NS_TEST_ASSERT_MSG_EQ (id, expected, "The cached classification of flow " << flow << " differs from the TFT scan");
+      matched.insert (id);
+    }
+  NS_TEST_ASSERT_MSG_GT (matched.size (), 2, "The workload does not exercise several bearers");
+
+  // A new TFT invalidates the cached flows
+  Ptr<NistEpcTft> catchAll = Create<NistEpcTft> ();
+  NistEpcTft::NistPacketFilter filter;
+  catchAll->Add (filter);
+  classifier.Add (catchAll, nTfts + 1);
+  NS_TEST_ASSERT_MSG_EQ (classifier.Classify (flows[first], NistEpcTft::UPLINK), nTfts + 1, "Stale cached classification");
+  Simulator::Destroy ();
+}
+
+/**
+ * AS SAP provider recording the requests of the UE NAS, in place of the RRC
+ */
+class NrV2XRecordingAsSapProvider : public NistLteAsSapProvider
+{
+public:
+  NrV2XRecordingAsSapProvider ()
+    : m_sent (0),
+      m_lastGroup (0),
+      m_activated (0),
+      m_deactivated (0)
+  {
+  }
+
+  virtual void SetCsgWhiteList (uint32_t csgId) {}
+  virtual void StartCellSelection (uint16_t dlEarfcn) {}
+  virtual void ForceCampedOnEnb (uint16_t cellId, uint16_t dlEarfcn) {}
+  virtual void Connect (void) {}
+  virtual void SendData (Ptr<Packet> packet, uint8_t bid) {}
+  virtual void SendData (Ptr<Packet> packet, uint32_t group)
+  {
+    m_sent++;
+    m_lastGroup = group;
+  }
+  virtual void Disconnect () {}
+  virtual void ActivateSidelinkRadioBearer (uint32_t group, bool tx, bool rx)
+  {
+    m_activated++;
+  }
+  virtual void DeactivateSidelinkRadioBearer (uint32_t group)
+  {
+    m_deactivated++;
+  }
+  virtual void AddDiscoveryApps (std::list<uint32_t> apps, bool rxtx) {}
+  virtual void RemoveDiscoveryApps (std::list<uint32_t> apps, bool rxtx) {}
+
+  uint32_t m_sent;
+  uint32_t m_lastGroup;
+  uint32_t m_activated;
+  uint32_t m_deactivated;
+};
+
+/**
+ * Sidelink bearers of the UE NAS, looked up through a cache: a destination
+ * without bearer is cached as a miss, the packets are dropped while its
+ * bearer is being setup, then sent on it once activated, and the cache must
+ * be cleared when the bearer is deactivated
+ */
+class NrV2XSidelinkBearerCacheTestCase : public TestCase
+{
+public:
+  NrV2XSidelinkBearerCacheTestCase ();
+  virtual ~NrV2XSidelinkBearerCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  Ptr<Packet> CreatePacket (Ipv4Address destination);
+};
+
+NrV2XSidelinkBearerCacheTestCase::NrV2XSidelinkBearerCacheTestCase ()
+  : TestCase ("Sidelink bearer cache")
+{
+}
+
+NrV2XSidelinkBearerCacheTestCase::~NrV2XSidelinkBearerCacheTestCase ()
+{
+}
+
+Ptr<Packet>
+NrV2XSidelinkBearerCacheTestCase::CreatePacket (Ipv4Address destination)
+{
+  Ptr<Packet> p = Create<Packet> (200);
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (49152);
+  udpHeader.SetDestinationPort (8000);
+  p->AddHeader (udpHeader);
+  Ipv4Header ipv4Header;
+  ipv4Header.SetSource (Ipv4Address ("7.0.0.2"));
+  ipv4Header.SetDestination (destination);
+  ipv4Header.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+  ipv4Header.SetPayloadSize (p->GetSize ());
+  p->AddHeader (ipv4Header);
+  return p;
+}
+
+void
+NrV2XSidelinkBearerCacheTestCase::DoRun (void)
+{
+  const Ipv4Address groupAddress ("225.0.0.1");
+  const uint32_t groupL2 = 255;
+  NrV2XRecordingAsSapProvider provider;
+  Ptr<NistEpcUeNas> nas = CreateObject<NistEpcUeNas> ();
+  nas->SetAsSapProvider (&provider);
+  Ptr<NistSlTft> tft = Create<NistSlTft> (NistSlTft::BIDIRECTIONAL, groupAddress, groupL2);
+  bool pending = true;
+
+  // No bearer: the miss is cached
+  NS_TEST_ASSERT_MSG_EQ (nas->Send (CreatePacket (groupAddress)), false, "Packet sent without a bearer");
+  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::SlBearerCache (nas).count (groupAddress.Get ()), 1, "The miss was not cached");
+  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::LookupSidelinkBearer (nas, groupAddress.Get (), &pending), 0, "Bearer found before its activation");
+  NS_TEST_ASSERT_MSG_EQ (pending, false, "Missing bearer reported as pending");
+
+  // Bearer being setup: the packets are dropped, and the outcome is not cached
+  nas->ActivateSidelinkBearer (tft);
+  NS_TEST_ASSERT_MSG_EQ (provider.m_activated, 1, "The RRC was not asked to setup the bearer");
+  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::SlBearerCache (nas).size (), 0, "The cache was not cleared when the bearer was requested");
+  NS_TEST_ASSERT_MSG_EQ (nas->Send (CreatePacket (groupAddress)), false, "Packet sent on a pending bearer");
+  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::LookupSidelinkBearer (nas, groupAddress.Get (), &pending), 0, "Pending bearer returned");
+  NS_TEST_ASSERT_MSG_EQ (pending, true, "Pending bearer not reported");
+  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::SlBearerCache (nas).count (groupAddress.Get ()), 0, "Pending bearer cached");
+
+  // Bearer activated by the RRC: found, then served by the cache
+  nas->GetAsSapUser ()->NotifySidelinkRadioBearerActivated (groupL2);
+  NS_TEST_ASSERT_MSG_EQ (nas->Send (CreatePacket (groupAddress)), true, "Packet not sent on the activated bearer");
+  NS_TEST_ASSERT_MSG_EQ (provider.m_sent, 1, "Packet not handed to the RRC");
+  NS_TEST_ASSERT_MSG_EQ (provider.m_lastGroup, groupL2, "Packet sent to the wrong group");
+  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::SlBearerCache (nas)[groupAddress.Get ()], tft, "The activated bearer was not cached");
+  NS_TEST_ASSERT_MSG_EQ (nas->Send (CreatePacket (groupAddress)), true, "Packet not sent through the cached bearer");
+  NS_TEST_ASSERT_MSG_EQ (provider.m_sent, 2, "Packet not handed to the RRC");
+
+  // Bearer deactivated: the cached bearer is forgotten
+  nas->DeactivateSidelinkBearer (tft);
+  NS_TEST_ASSERT_MSG_EQ (provider.m_deactivated, 1, "The RRC was not asked to release the bearer");
+  NS_TEST_ASSERT_MSG_EQ (NrV2XTestAccess::SlBearerCache (nas).size (), 0, "The cache was not cleared when the bearer was deactivated");
+  NS_TEST_ASSERT_MSG_EQ (nas->Send (CreatePacket (groupAddress)), false, "Packet sent on a deactivated bearer");
+  NS_TEST_ASSERT_MSG_EQ (provider.m_sent, 2, "Packet handed to the RRC without a bearer");
+
+  nas->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Maximum coupling loss of the spectrum channel: N vehicles on a 5 km
+ * highway transmit once, through a channel delivering every signal and
+ * through one cut at the coupling loss of a maximum distance plus a
+ * shadowing margin. The signals delivered plus those discarded must add up,
+ * and so must the received energy plus the discarded one
+ */
+class NrV2XCouplingLossCutoffTestCase : public TestCase
+{
+public:
+  NrV2XCouplingLossCutoffTestCase (uint32_t nNodes, double maxDistance);
+  virtual ~NrV2XCouplingLossCutoffTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void SignalDiscarded (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb, double energy, Ptr<const SpectrumSignalParameters> txParams);
+
+  uint32_t m_nNodes;
+  double m_maxDistance;
+  uint64_t m_discarded;
+  double m_discardedEnergy; // (J)
+};
+
+NrV2XCouplingLossCutoffTestCase::NrV2XCouplingLossCutoffTestCase (uint32_t nNodes, double maxDistance)
+  : TestCase ("Coupling loss cutoff"),
+    m_nNodes (nNodes),
+    m_maxDistance (maxDistance),
+    m_discarded (0),
+    m_discardedEnergy (0)
+{
+}
+
+NrV2XCouplingLossCutoffTestCase::~NrV2XCouplingLossCutoffTestCase ()
+{
+}
+
+void
+NrV2XCouplingLossCutoffTestCase::SignalDiscarded (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb, double energy, Ptr<const SpectrumSignalParameters> txParams)
+{
+  m_discarded++;
+  m_discardedEnergy += energy;
+}
+
+void
+NrV2XCouplingLossCutoffTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (18);
+  NodeContainer nodes;
+  nodes.Create (m_nNodes);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (uniform->GetValue (0, 5000), uniform->GetInteger (1, 6) * 4.0, 1.5));
+      (*it)->AggregateObject (mobility);
+    }
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Ptr<NrV2XPropagationLossModel> lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+  lossModel->InitChannelMatrix (nodes);
+  double maxCouplingLoss = lossModel->GetMaxCouplingLoss (m_maxDistance, 10);
+
+  // 23 dBm over 50 RBs, for 1 ms
+  std::vector<double> centerFrequencies;
+  for (uint32_t rb = 0; rb < 50; rb++)
+    {
+      centerFrequencies.push_back (5.9e9 + rb * 180e3);
+    }
+  Ptr<SpectrumModel> spectrumModel = Create<SpectrumModel> (centerFrequencies);
+  Ptr<SpectrumValue> psd = Create<SpectrumValue> (spectrumModel);
+  (*psd) = 0.2 / (50 * 180e3);
+
+  Ptr<MultiModelSpectrumChannel> fullChannel = CreateObject<MultiModelSpectrumChannel> ();
+  Ptr<MultiModelSpectrumChannel> cutChannel = CreateObject<MultiModelSpectrumChannel> ();
+  cutChannel->SetAttribute ("MaxLossDb", DoubleValue (maxCouplingLoss));
+  cutChannel->TraceConnectWithoutContext ("SignalDiscarded", MakeCallback (&NrV2XCouplingLossCutoffTestCase::SignalDiscarded, this));
+  Ptr<MultiModelSpectrumChannel> channels[2] = {fullChannel, cutChannel};
+  std::vector<Ptr<NrV2XCountingSpectrumPhy> > phys[2];
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      channels[c]->AddPropagationLossModel (lossModel);
+      for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+        {
+          Ptr<NrV2XCountingSpectrumPhy> phy = Create<NrV2XCountingSpectrumPhy> ((*it)->GetObject<MobilityModel> (), spectrumModel);
+          channels[c]->AddRx (phy);
+          phys[c].push_back (phy);
+        }
+    }
+
+  uint64_t received[2] = {0, 0};
+  double energy[2] = {0, 0};
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      for (uint32_t i = 0; i < m_nNodes; i++)
+        {
+          Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+          params->psd = psd;
+          params->duration = MilliSeconds (1);
+          params->txPhy = phys[c][i];
+          channels[c]->StartTx (params);
+        }
+      // Before the first update of the channel matrix
+      Simulator::Stop (MilliSeconds (1));
+      Simulator::Run ();
+      for (uint32_t i = 0; i < m_nNodes; i++)
+        {
+          received[c] += phys[c][i]->m_received;
+          energy[c] += phys[c][i]->m_energy;
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (received[0], (uint64_t) m_nNodes * (m_nNodes - 1), "A signal was lost without cutoff");
+  NS_TEST_ASSERT_MSG_GT (m_discarded, 0, "The cutoff discarded no signal");
+  NS_TEST_ASSERT_MSG_EQ (received[1] + m_discarded, received[0], "Signals neither delivered nor discarded");
+  NS_TEST_ASSERT_MSG_EQ_TOL (energy[1] + m_discardedEnergy, energy[0], energy[0] * 1e-9, "Discarded energy not accounted for");
+  NS_TEST_ASSERT_MSG_LT (m_discardedEnergy, energy[0] * 1e-3, "The cutoff discards a significant share of the received energy");
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Receptions of the signals discarded by the maximum coupling loss: a vehicle
+ * transmits once to receivers spread along the road, through a channel
+ * delivering every signal and through one cut at the coupling loss of a
+ * maximum distance. The receivers notified of the discarded signals must
+ * record the same receptions below the sensitivity as those that got them
+ */
+class NrV2XDiscardedSignalRecordTestCase : public TestCase
+{
+public:
+  NrV2XDiscardedSignalRecordTestCase (uint32_t nReceivers, double maxDistance);
+  virtual ~NrV2XDiscardedSignalRecordTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void SignalDiscarded (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb, double energy, Ptr<const SpectrumSignalParameters> txParams);
+  void ReportRssi (double rssi, std::vector<int> rbMap, uint16_t txId);
+  std::map<uint32_t, uint16_t> ReadLossTypes (std::string fileName);
+
+  uint32_t m_nReceivers;
+  double m_maxDistance;
+  uint64_t m_discarded;
+};
+
+NrV2XDiscardedSignalRecordTestCase::NrV2XDiscardedSignalRecordTestCase (uint32_t nReceivers, double maxDistance)
+  : TestCase ("Records of the discarded signals"),
+    m_nReceivers (nReceivers),
+    m_maxDistance (maxDistance),
+    m_discarded (0)
+{
+}
+
+NrV2XDiscardedSignalRecordTestCase::~NrV2XDiscardedSignalRecordTestCase ()
+{
+}
+
+void
+NrV2XDiscardedSignalRecordTestCase::SignalDiscarded (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb, double energy, Ptr<const SpectrumSignalParameters> txParams)
+{
+  m_discarded++;
+  DynamicCast<NrV2XSpectrumPhy> (rxPhy)->NotifyV2XSlSignalDiscarded (txParams);
+}
+
+void
+NrV2XDiscardedSignalRecordTestCase::ReportRssi (double rssi, std::vector<int> rbMap, uint16_t txId)
+{
+}
+
+std::map<uint32_t, uint16_t>
+NrV2XDiscardedSignalRecordTestCase::ReadLossTypes (std::string fileName)
+{
+  // rxTime,packetID,TxDistance,txID,rxID,decoded,lossType,...
+  std::map<uint32_t, uint16_t> lossTypes;
+  std::ifstream log (fileName.c_str ());
+  std::string line;
+  while (std::getline (log, line))
+    {
+      std::istringstream fields (line);
+      std::string field;
+      uint32_t rxId = 0;
+      for (uint32_t i = 0; i < 7 && std::getline (fields, field, ','); i++)
+        {
+          if (i == 4)
+            {
+              rxId = std::atoi (field.c_str ());
+            }
+          else if (i == 6)
+            {
+              NS_TEST_EXPECT_MSG_EQ (lossTypes.count (rxId), 0, "Receiver " << rxId << " recorded the packet twice");
+              lossTypes[rxId] = std::atoi (field.c_str ());
+            }
+        }
+    }
+  log.close ();
+  std::remove (fileName.c_str ());
+  return lossTypes;
+}
+
+void
+NrV2XDiscardedSignalRecordTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (20);
+  const uint16_t nRbs = 50;
+  NodeContainer nodes;
+  nodes.Create (m_nReceivers + 1);
+  for (uint32_t i = 0; i <= m_nReceivers; i++)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (100.0 + i * 2.0 * m_maxDistance / m_nReceivers, 0.0, 1.5));
+      nodes.Get (i)->AggregateObject (mobility);
+    }
+
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Ptr<NrV2XPropagationLossModel> lossModel = CreateObject<NrV2XPropagationLossModel> ();
+  lossModel->SetAttribute ("Frequency", DoubleValue (5.9));
+  lossModel->InitChannelMatrix (nodes);
+
+  Ptr<MultiModelSpectrumChannel> fullChannel = CreateObject<MultiModelSpectrumChannel> ();
+  Ptr<MultiModelSpectrumChannel> cutChannel = CreateObject<MultiModelSpectrumChannel> ();
+  cutChannel->SetAttribute ("MaxLossDb", DoubleValue (lossModel->GetMaxCouplingLoss (m_maxDistance, 10)));
+  cutChannel->TraceConnectWithoutContext ("SignalDiscarded", MakeCallback (&NrV2XDiscardedSignalRecordTestCase::SignalDiscarded, this));
+  Ptr<MultiModelSpectrumChannel> channels[2] = {fullChannel, cutChannel};
+  const std::string outputPaths[2] = {"morev2x-test-full-", "morev2x-test-cut-"};
+  std::vector<Ptr<NrV2XSpectrumPhy> > phys;
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      channels[c]->AddPropagationLossModel (lossModel);
+      // Node 0 transmits, the other nodes receive through one PHY per channel
+      for (uint32_t i = 0; i <= m_nReceivers; i++)
+        {
+          Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+          nodes.Get (i)->AddDevice (device);
+          Ptr<NrV2XSpectrumPhy> phy = CreateObject<NrV2XSpectrumPhy> ();
+          phy->SetDevice (device);
+          phy->SetMobility (nodes.Get (i)->GetObject<MobilityModel> ());
+          phy->SetAttribute ("ChannelMatrix", PointerValue (lossModel));
+          phy->SetAttribute ("RBsBandwidth", UintegerValue (nRbs));
+          phy->SetAttribute ("MeasurementSink", BooleanValue (true)); // No MAC to deliver the TBs to
+          phy->SetAttribute ("SaveCollisionLossesUnimore", BooleanValue (true));
+          phy->SetAttribute ("SavingPeriod", DoubleValue (0.0));
+          phy->SetAttribute ("OutputPath", StringValue (outputPaths[c]));
+          phy->SetHarqPhyModule (Create<NistLteHarqPhy> ());
+          phy->SetNoisePowerSpectralDensity (NrV2XSpectrumValueHelper::CreateNoisePowerSpectralDensity (18100, nRbs, 9.0));
+          phy->SetUnimoreReportRssiCallback (MakeCallback (&NrV2XDiscardedSignalRecordTestCase::ReportRssi, this));
+          if (i > 0)
+            {
+              channels[c]->AddRx (phy);
+            }
+          phys.push_back (phy);
+        }
+    }
+
+  std::vector<int> activeRbs;
+  for (int rb = 0; rb < 10; rb++)
+    {
+      activeRbs.push_back (rb);
+    }
+  NistV2XSciListElement_s sci;
+  sci.m_rnti = nodes.Get (0)->GetId ();
+  sci.m_rbStartPssch = 0;
+  sci.m_rbLenPssch = 10;
+  sci.m_rbLenPssch_TB = 10;
+  sci.m_tbSize = 300;
+  sci.m_mcs = 10;
+  sci.m_groupDstId = 1;
+  sci.m_reTxIndex = 0;
+  sci.m_packetID = 1;
+  sci.m_genTime = 0;
+  sci.m_selectionTrigger = 0;
+  sci.m_TxIndex = 1;
+  sci.m_announcedTB = false;
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      Ptr<SciV2XLteControlMessage> msg = Create<SciV2XLteControlMessage> ();
+      msg->SetSci (sci);
+      Ptr<Packet> packet = Create<Packet> (300);
+      packet->AddPacketTag (NistLteRadioBearerTag (sci.m_rnti, 1, sci.m_rnti, 1));
+      Ptr<PacketBurst> burst = CreateObject<PacketBurst> ();
+      burst->AddPacket (packet);
+      Ptr<NistLteSpectrumSignalParametersV2XSlFrame> params = Create<NistLteSpectrumSignalParametersV2XSlFrame> ();
+      params->duration = MicroSeconds (900);
+      params->psd = NrV2XSpectrumValueHelper::CreateTxPowerSpectralDensity (18100, nRbs, 23.0, activeRbs);
+      params->txPhy = phys[c * (m_nReceivers + 1)];
+      params->nodeId = sci.m_rnti;
+      params->groupId = 0;
+      params->slssId = 0;
+      params->packetBurst = burst;
+      params->ctrlMsgList.push_back (msg);
+      Simulator::Schedule (MilliSeconds (1), &MultiModelSpectrumChannel::StartTx, channels[c], params);
+    }
+  Simulator::Stop (MilliSeconds (3));
+  Simulator::Run ();
+
+  std::map<uint32_t, uint16_t> lossTypes[2];
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      lossTypes[c] = ReadLossTypes (outputPaths[c] + "ReceivedLog.txt");
+      NS_TEST_ASSERT_MSG_EQ (lossTypes[c].size (), m_nReceivers, "A receiver did not record the packet");
+    }
+  NS_TEST_ASSERT_MSG_GT (m_discarded, 0, "The cutoff discarded no signal");
+  uint32_t belowSensitivity = 0;
+  for (std::map<uint32_t, uint16_t>::iterator it = lossTypes[0].begin (); it != lossTypes[0].end (); ++it)
+    {
+      if (it->second == 0)
+        {
+          belowSensitivity++;
+          NS_TEST_EXPECT_MSG_EQ (lossTypes[1][it->first], 0, "Receiver " << it->first << " did not record the packet below the sensitivity");
+        }
+      else
+        {
+          NS_TEST_EXPECT_MSG_NE (lossTypes[1][it->first], 0, "Receiver " << it->first << " recorded a delivered packet below the sensitivity");
+        }
+    }
+  NS_TEST_ASSERT_MSG_GT (belowSensitivity, m_discarded, "The cutoff discarded signals above the sensitivity");
+
+  for (std::vector<Ptr<NrV2XSpectrumPhy> >::iterator it = phys.begin (); it != phys.end (); ++it)
+    {
+      (*it)->Dispose ();
+    }
+  lossModel->Dispose ();
+  NrV2XPropagationLossModel::ChannelMatrix.clear ();
+  Simulator::Destroy ();
+}
+
+class NrV2XTestSuite : public TestSuite
+{
+public:
+  NrV2XTestSuite ();
+};
+
+NrV2XTestSuite::NrV2XTestSuite ()
+  : TestSuite ("nr-v2x", UNIT)
+{
+  std::vector<uint16_t> shortRriList = {100};
+  std::vector<uint16_t> fullRriList = {20, 50, 100, 200, 300, 400, 500, 600, 700, 800, 900, 1000};
+  double pdbs[] = {20, 100};
+  for (uint32_t p = 0; p < 2; p++)
+    {
+      AddTestCase (new NrV2XMode2ReEvaluationTestCase (pdbs[p], shortRriList, 5, 1, 0.2), TestCase::QUICK);
+      AddTestCase (new NrV2XMode2ReEvaluationTestCase (pdbs[p], shortRriList, 5, 1, 0.6), TestCase::QUICK);
+      AddTestCase (new NrV2XMode2ReEvaluationTestCase (pdbs[p], fullRriList, 5, 1, 0.2), TestCase::QUICK);
+      AddTestCase (new NrV2XMode2ReEvaluationTestCase (pdbs[p], shortRriList, 10, 2, 0.2), TestCase::QUICK);
+      AddTestCase (new NrV2XMode2ReEvaluationTestCase (pdbs[p], fullRriList, 10, 1, 0.6), TestCase::EXTENSIVE);
+    }
+
+  AddTestCase (new NrV2XGeoCellLookupTestCase (50, 500), TestCase::QUICK);
+  AddTestCase (new NrV2XGeoCellLookupTestCase (100, 1000), TestCase::QUICK);
+
+  AddTestCase (new NrV2XPolygonCheckTestCase (true), TestCase::QUICK);
+  AddTestCase (new NrV2XPolygonCheckTestCase (false), TestCase::QUICK);
+
+  AddTestCase (new NrV2XPsschOverlapTestCase (50, 10), TestCase::QUICK);
+
+  AddTestCase (new NrV2XPsschRsrpHistoryTestCase (10, 2), TestCase::QUICK);
+
+  AddTestCase (new NrV2XChannelMatrixTestCase (100), TestCase::QUICK);
+
+  AddTestCase (new NrV2XTraceMobilityTestCase (200, 200, false), TestCase::QUICK);
+  AddTestCase (new NrV2XTraceMobilityTestCase (200, 50, true), TestCase::QUICK);
+
+  AddTestCase (new NrV2XTxPsdTestCase (50, false), TestCase::QUICK);
+  AddTestCase (new NrV2XTxPsdTestCase (50, true), TestCase::QUICK);
+
+  AddTestCase (new NrV2XBlerLookupTestCase (15), TestCase::QUICK);
+  AddTestCase (new NrV2XBlerLookupTestCase (30), TestCase::QUICK);
+
+  for (uint16_t numerology = 0; numerology <= 3; numerology++)
+    {
+      AddTestCase (new NrV2XSlotTimingTestCase (numerology), TestCase::QUICK);
+    }
+
+  AddTestCase (new NrV2XParallelSinrTestCase (20, 8, 4), TestCase::QUICK);
+  AddTestCase (new NrV2XLazySinrTestCase (8, 20), TestCase::QUICK);
+
+  AddTestCase (new NrV2XDuplicateDetectionTestCase (50, 30), TestCase::QUICK);
+
+  AddTestCase (new NrV2XSlHarqStateTestCase (100, 20000), TestCase::QUICK);
+
+  AddTestCase (new NrV2XLinkStateTestCase (50), TestCase::QUICK);
+  AddTestCase (new NrV2XRetiredLinkRxTestCase (50), TestCase::QUICK);
+
+  AddTestCase (new NrV2XBuildingIndexTestCase (10, 2000), TestCase::QUICK);
+
+  AddTestCase (new NrV2XUrbanLinkStateTestCase (40, false), TestCase::QUICK);
+  AddTestCase (new NrV2XUrbanLinkStateTestCase (40, true), TestCase::QUICK);
+
+  AddTestCase (new NrV2XSelectionReplayTestCase (20, 20), TestCase::QUICK);
+  AddTestCase (new NrV2XSelectionReplayTestCase (100, 20), TestCase::QUICK);
+
+  AddTestCase (new NrV2XTftClassifierTestCase (10, 2000), TestCase::QUICK);
+  AddTestCase (new NrV2XTftClassifierTestCase (1000, 2000), TestCase::QUICK);
+
+  AddTestCase (new NrV2XSidelinkBearerCacheTestCase (), TestCase::QUICK);
+
+  AddTestCase (new NrV2XCouplingLossCutoffTestCase (150, 1000), TestCase::QUICK);
+  AddTestCase (new NrV2XDiscardedSignalRecordTestCase (40, 1000), TestCase::QUICK);
+}
+
+static NrV2XTestSuite g_nrV2XTestSuite;
+
+} // namespace ns3
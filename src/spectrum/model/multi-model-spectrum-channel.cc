@@ -35,6 +35,7 @@
 #include <ns3/antenna-model.h>
 #include <ns3/angles.h>
 #include <iostream>
+#include <limits>
 #include <utility>
 #include "multi-model-spectrum-channel.h"
 #include "ns3/pointer.h"
@@ -134,6 +135,15 @@ MultiModelSpectrumChannel::GetTypeId (void)
                      "reported in this trace. ",
                      MakeTraceSourceAccessor (&MultiModelSpectrumChannel::m_pathLossTrace),
                      "ns3::SpectrumChannel::LossTracedCallback")
+    .AddTraceSource ("SignalDiscarded",
+                     "This trace is fired whenever a signal is not delivered to a receiver because "
+                     "its loss exceeds MaxLossDb. The parameters are the TX and RX SpectrumPhy "
+                     "instances, the loss value in dB and the energy (J) the receiver would have "
+                     "got, neglecting the SpectrumPropagationLossModel, and the parameters of the signal. "
+                     "It allows to validate MaxLossDb against the interference energy it discards, and the "
+                     "receivers to account for the signals they did not get. Links with infinite loss are not reported.",
+                     MakeTraceSourceAccessor (&MultiModelSpectrumChannel::m_signalDiscardedTrace),
+                     "ns3::MultiModelSpectrumChannel::SignalDiscardedTracedCallback")
   ;
   return tid;
 }
@@ -291,6 +301,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
           NS_ASSERT (rxConverterIterator != txInfoIteratorerator->second.m_spectrumConverterMap.end ());
           convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
         }
+      double txEnergy = -1; // (J) computed for the first discarded signal only
 
 
       for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
@@ -302,9 +313,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
-              NS_LOG_LOGIC (" copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+              Ptr<SpectrumSignalParameters> rxParams;
               Time delay = MicroSeconds (0);
 
               Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
@@ -313,10 +322,10 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                 {
               
                   double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
+                  if (txParams->txAntenna != 0)
                     {
                       Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      double txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
+                      double txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
                       NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
                       pathLossDb -= txAntennaGain;
                     }
@@ -339,9 +348,20 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                   m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
                   if ( pathLossDb > m_maxLossDb)
                     {
-                      // beyond range
+                      // beyond range. The signal is not copied nor scheduled
+                      if (pathLossDb < std::numeric_limits<double>::infinity ())
+                        {
+                          if (txEnergy < 0)
+                            {
+                              txEnergy = Integral (*convertedTxPowerSpectrum) * txParams->duration.GetSeconds ();
+                            }
+                          m_signalDiscardedTrace (txParams->txPhy, *rxPhyIterator, pathLossDb, txEnergy * std::pow (10.0, (-pathLossDb) / 10.0), txParams);
+                        }
                       continue;
                     }
+                  NS_LOG_LOGIC (" copying signal parameters " << txParams);
+                  rxParams = txParams->Copy ();
+                  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
                   double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
                   *(rxParams->psd) *= pathGainLinear;              
 
@@ -355,6 +375,12 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                       delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
                     }
                 }
+              else
+                {
+                  NS_LOG_LOGIC (" copying signal parameters " << txParams);
+                  rxParams = txParams->Copy ();
+                  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+                }
 
               Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
               if (netDev)
@@ -105,6 +105,19 @@ public:
 
   virtual Ptr<SpectrumPropagationLossModel> GetSpectrumPropagationLossModel (void);
 
+  /**
+   * TracedCallback signature for the signals discarded because of MaxLossDb.
+   *
+   * \param [in] txPhy The TX SpectrumPhy instance.
+   * \param [in] rxPhy The RX SpectrumPhy instance.
+   * \param [in] lossDb The loss value, in dB.
+   * \param [in] energy The energy the receiver would have got, in J.
+   * \param [in] txParams The parameters of the discarded signal.
+   */
+  typedef void (* SignalDiscardedTracedCallback)
+    (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb, double energy,
+     Ptr<const SpectrumSignalParameters> txParams);
+
 
 protected:
   void DoDispose ();
@@ -173,6 +186,7 @@ private:
 
   double m_maxLossDb;
   TracedCallback<Ptr<SpectrumPhy>, Ptr<SpectrumPhy>, double > m_pathLossTrace;
+  TracedCallback<Ptr<SpectrumPhy>, Ptr<SpectrumPhy>, double, double, Ptr<const SpectrumSignalParameters> > m_signalDiscardedTrace;
   //NIST
   TracedCallback<Ptr<SpectrumPhy>, Ptr<SpectrumPhy>, double, double, double, double, double, double> m_gainTrace;
   //